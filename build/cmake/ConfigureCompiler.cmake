@@ -40,6 +40,11 @@ if(NOT ${MCRL2_ENABLE_DEBUG_SOUNDNESS_CHECKS})
   add_definitions(-DMCRL2_NO_SOUNDNESS_CHECKS)
 endif()
 
+# Makes the term library thread-safe when multithreading is enabled.
+if(MCRL2_ENABLE_MULTITHREADING)
+  add_definitions(-DMCRL2_ENABLE_MULTITHREADING)
+endif()
+
 # Enable C++17 for all targets.
 set(CMAKE_CXX_STANDARD 17)
 set(CMAKE_CXX_STANDARD_REQUIRED true)
@@ -102,7 +102,7 @@ endfunction()
 # mcrl22lps
 function(gen_mcrl22lps_release_tests MCRL2FILE LPSFILE)
   set(ARGUMENTS "-a" "-b" "-c" "-e" "-f" "-g" "-lregular" "-lregular2" "-lstack" "-m"
-                "-n" "--no-constelm" "-o" "-rjitty" "-rjittyp" ${_JITTYC}
+                "-n" "--no-constelm" "-o" "-rjitty" "-rjittyn" "-rjittyp" ${_JITTYC}
                 "--timings" "-w" "-z")
   foreach(arglist ${ARGUMENTS})
     add_tool_test(mcrl22lps ${arglist} ${tagIN} ${MCRL2FILE})
@@ -127,7 +127,7 @@ function(gen_lps2lts_release_tests LPSFILE LTSFILES ACTIONS)
   #              "-rjitty" "-rjittyp" ${_JITTYC} "-sd" "-sb" "-sp" "-sq\;-l100" "-sr\;-l100"
   #              "--verbose\;--suppress" "--todo-max=10" "-u" "-yno")
   set(ARGUMENTS "-ctau" "-D" "--error-trace"
-                "-rjitty" "-rjittyp" ${_JITTYC} "-sd" "-sb" "-sh\;--todo-max=100"
+                "-rjitty" "-rjittyn" "-rjittyp" ${_JITTYC} "-sd" "-sb" "-sh\;--todo-max=100"
                 "--verbose\;--suppress" "-u")
   if(ACTIONS)
     list(GET ACTIONS 0 ACTION)
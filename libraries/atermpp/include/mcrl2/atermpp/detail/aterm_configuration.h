@@ -16,7 +16,12 @@ namespace detail
 {
 
 /// \brief Enables thread safety for the global term and function symbol pools.
+/// \details Controlled by the MCRL2_ENABLE_MULTITHREADING build option.
+#ifdef MCRL2_ENABLE_MULTITHREADING
+constexpr static bool GlobalThreadSafe = true;
+#else
 constexpr static bool GlobalThreadSafe = false;
+#endif
 
 /// \brief Enable to print garbage collection statistics.
 constexpr static bool EnableGarbageCollectionMetrics = false;
@@ -28,7 +33,7 @@ constexpr static bool EnableTermHashtableMetrics = false;
 constexpr static bool EnableTermCreationMetrics = false;
 
 /// \brief Enable garbage collection.
-constexpr static bool EnableGarbageCollection = true && !GlobalThreadSafe;
+constexpr static bool EnableGarbageCollection = true;
 
 } // namespace detail
 } // namespace atermpp
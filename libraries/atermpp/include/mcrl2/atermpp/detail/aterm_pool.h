@@ -12,6 +12,7 @@
 
 #include "mcrl2/atermpp/detail/aterm_pool_storage.h"
 #include "mcrl2/atermpp/detail/function_symbol_pool.h"
+#include "mcrl2/utilities/shared_mutex.h"
 
 namespace atermpp
 {
@@ -65,6 +66,15 @@ public:
   /// \brief Enable garbage collection when passing true and disable otherwise.
   inline void enable_garbage_collection(bool enable);
 
+  /// \brief Enters a section in which the calling thread creates or accesses terms.
+  /// \details Only has an effect in the thread-safe configuration. Garbage collection never takes place
+  ///          while any thread is inside such a section, and sections can be nested.
+  inline void lock_shared();
+
+  /// \brief Leaves a section entered by lock_shared().
+  /// \details Leaving the outermost section is a safepoint at which a requested garbage collection is performed.
+  inline void unlock_shared();
+
   /// \brief Creates a integral term with the given value.
   inline aterm create_int(std::size_t val);
 
@@ -113,6 +123,18 @@ public:
   /// \returns The pool of function symbols.
   function_symbol_pool& get_symbol_pool() { return m_function_symbol_pool; }
 private:
+  /// \brief Marks all reachable terms and destroys the other ones, requires exclusive access to the pool.
+  inline void collect_impl();
+
+  /// \returns The shared mutex of the calling thread.
+  inline mcrl2::utilities::shared_mutex& thread_mutex();
+
+  /// Data shared by the mutexes of all threads.
+  std::shared_ptr<mcrl2::utilities::shared_mutex_data> m_shared_mutex_data = std::make_shared<mcrl2::utilities::shared_mutex_data>();
+
+  /// Set whenever a collection was triggered in the thread-safe configuration, it takes place at the next safepoint.
+  std::atomic<bool> m_collection_requested{false};
+
 
   /// Storage for the function symbols.
   function_symbol_pool m_function_symbol_pool;
@@ -136,7 +158,7 @@ private:
   arbitrary_function_application_storage m_appl_dynamic_storage;
 
   /// Track the number of  terms destroyed and reduce the freelist.
-  std::size_t m_countUntilCollection;
+  std::conditional<GlobalThreadSafe, std::atomic<std::size_t>, std::size_t>::type m_countUntilCollection;
 
   /// It can happen that during create_appl with converter the converter generates new terms.
   /// As such these terms might only be protected after the term_appl was actually created.
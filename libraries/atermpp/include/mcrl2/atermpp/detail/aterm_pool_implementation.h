@@ -156,30 +156,71 @@ void aterm_pool::trigger_collection()
     return;
   }
 
-  if (m_countUntilCollection > 0)
+  if constexpr (GlobalThreadSafe)
   {
-    --m_countUntilCollection;
+    // Only the thread that decrements the counter to zero requests a collection, which is
+    // performed when the first thread reaches a safepoint.
+    if (m_countUntilCollection-- == 1)
+    {
+      if (m_enable_garbage_collection)
+      {
+        m_collection_requested = true;
+      }
+
+      m_countUntilCollection = size();
+    }
   }
   else
   {
-    if (m_enable_garbage_collection)
+    if (m_countUntilCollection > 0)
     {
-      collect();
+      --m_countUntilCollection;
     }
+    else
+    {
+      if (m_enable_garbage_collection)
+      {
+        collect();
+      }
 
-    // Use some heuristics to determine when the next collection is called.
-    m_countUntilCollection = size();
+      // Use some heuristics to determine when the next collection is called.
+      m_countUntilCollection = size();
+    }
   }
 }
 
 void aterm_pool::collect()
 {
-  if (m_creation_depth > 0)
+  if constexpr (GlobalThreadSafe)
   {
-    m_deferred_garbage_collection = true;
-    return;
+    mcrl2::utilities::shared_mutex& mutex = thread_mutex();
+    if (mutex.is_shared_locked())
+    {
+      // The calling thread might hold unprotected terms, so defer the collection to its next safepoint.
+      m_collection_requested = true;
+      return;
+    }
+
+    // Wait until all other threads have reached a safepoint.
+    mutex.lock();
+    m_collection_requested = false;
+    collect_impl();
+    mutex.unlock();
   }
+  else
+  {
+    if (m_creation_depth > 0)
+    {
+      m_deferred_garbage_collection = true;
+      return;
+    }
+
+    collect_impl();
+  }
+}
 
+void aterm_pool::collect_impl()
+{
   auto timestamp = std::chrono::system_clock::now();
 
   m_deferred_garbage_collection = false;
@@ -223,6 +264,12 @@ void aterm_pool::collect()
   std::get<7>(m_appl_storage).sweep();
   m_appl_dynamic_storage.sweep();
 
+  // Function symbols are not destroyed eagerly in the thread-safe configuration.
+  if (GlobalThreadSafe)
+  {
+    m_function_symbol_pool.sweep();
+  }
+
   // Check that after sweeping the terms are consistent.
   assert(m_int_storage.verify_sweep());
   assert(std::get<0>(m_appl_storage).verify_sweep());
@@ -255,20 +302,60 @@ void aterm_pool::enable_garbage_collection(bool enable)
   m_enable_garbage_collection = enable;
 }
 
+void aterm_pool::lock_shared()
+{
+  if constexpr (GlobalThreadSafe)
+  {
+    thread_mutex().lock_shared();
+  }
+}
+
+void aterm_pool::unlock_shared()
+{
+  if constexpr (GlobalThreadSafe)
+  {
+    mcrl2::utilities::shared_mutex& mutex = thread_mutex();
+    mutex.unlock_shared();
+
+    if (!mutex.is_shared_locked() && m_collection_requested)
+    {
+      mutex.lock();
+
+      // Another thread might have performed the requested collection in the meantime.
+      if (m_collection_requested)
+      {
+        m_collection_requested = false;
+        collect_impl();
+      }
+
+      mutex.unlock();
+    }
+  }
+}
+
 aterm aterm_pool::create_int(size_t val)
 {
-  return m_int_storage.create_int(val);
+  lock_shared();
+  aterm result = m_int_storage.create_int(val);
+  unlock_shared();
+  return result;
 }
 
 aterm aterm_pool::create_term(const atermpp::function_symbol& sym)
 {
-  return std::get<0>(m_appl_storage).create_term(sym);
+  lock_shared();
+  aterm result = std::get<0>(m_appl_storage).create_term(sym);
+  unlock_shared();
+  return result;
 }
 
 template<class ...Terms>
 aterm aterm_pool::create_appl(const function_symbol& sym, const Terms&... arguments)
 {
-  return std::get<sizeof...(Terms)>(m_appl_storage).create_appl(sym, arguments...);
+  lock_shared();
+  aterm result = std::get<sizeof...(Terms)>(m_appl_storage).create_appl(sym, arguments...);
+  unlock_shared();
+  return result;
 }
 
 template<typename ForwardIterator>
@@ -276,37 +363,43 @@ aterm aterm_pool::create_appl_dynamic(const function_symbol& sym,
                             ForwardIterator begin,
                             ForwardIterator end)
 {
+  lock_shared();
+
   const std::size_t arity = sym.arity();
+  aterm result;
 
   switch(arity)
   {
   case 0:
-    return std::get<0>(m_appl_storage).create_term(sym);
+    result = std::get<0>(m_appl_storage).create_term(sym);
     break;
   case 1:
-    return std::get<1>(m_appl_storage).template create_appl_iterator<ForwardIterator>(sym, begin, end);
+    result = std::get<1>(m_appl_storage).template create_appl_iterator<ForwardIterator>(sym, begin, end);
     break;
   case 2:
-    return std::get<2>(m_appl_storage).template create_appl_iterator<ForwardIterator>(sym, begin, end);
+    result = std::get<2>(m_appl_storage).template create_appl_iterator<ForwardIterator>(sym, begin, end);
     break;
   case 3:
-    return std::get<3>(m_appl_storage).template create_appl_iterator<ForwardIterator>(sym, begin, end);
+    result = std::get<3>(m_appl_storage).template create_appl_iterator<ForwardIterator>(sym, begin, end);
     break;
   case 4:
-    return std::get<4>(m_appl_storage).template create_appl_iterator<ForwardIterator>(sym, begin, end);
+    result = std::get<4>(m_appl_storage).template create_appl_iterator<ForwardIterator>(sym, begin, end);
     break;
   case 5:
-    return std::get<5>(m_appl_storage).template create_appl_iterator<ForwardIterator>(sym, begin, end);
+    result = std::get<5>(m_appl_storage).template create_appl_iterator<ForwardIterator>(sym, begin, end);
     break;
   case 6:
-    return std::get<6>(m_appl_storage).template create_appl_iterator<ForwardIterator>(sym, begin, end);
+    result = std::get<6>(m_appl_storage).template create_appl_iterator<ForwardIterator>(sym, begin, end);
     break;
   case 7:
-    return std::get<7>(m_appl_storage).template create_appl_iterator<ForwardIterator>(sym, begin, end);
+    result = std::get<7>(m_appl_storage).template create_appl_iterator<ForwardIterator>(sym, begin, end);
     break;
   default:
-    return m_appl_dynamic_storage.create_appl_dynamic(sym, begin, end);
+    result = m_appl_dynamic_storage.create_appl_dynamic(sym, begin, end);
   }
+
+  unlock_shared();
+  return result;
 }
 
 template<typename InputIterator, typename ATermConverter>
@@ -315,7 +408,12 @@ aterm aterm_pool::create_appl_dynamic(const function_symbol& sym,
                             InputIterator begin,
                             InputIterator end)
 {
-  ++m_creation_depth;
+  // The converter might create terms, which are unprotected until the result has been created.
+  lock_shared();
+  if (!GlobalThreadSafe)
+  {
+    ++m_creation_depth;
+  }
 
   const std::size_t arity = sym.arity();
   aterm result;
@@ -350,18 +448,22 @@ aterm aterm_pool::create_appl_dynamic(const function_symbol& sym,
     result = m_appl_dynamic_storage.create_appl_dynamic(sym, converter, begin, end);
   }
 
-  --m_creation_depth;
-
-  // Trigger a deferred garbage collection when it was requested and the term has been protected.
-  if (m_creation_depth == 0 && m_deferred_garbage_collection)
+  if (!GlobalThreadSafe)
   {
-    if (EnableGarbageCollectionMetrics)
+    --m_creation_depth;
+
+    // Trigger a deferred garbage collection when it was requested and the term has been protected.
+    if (m_creation_depth == 0 && m_deferred_garbage_collection)
     {
-      mCRL2log(mcrl2::log::info, "Performance") << "g_term_pool(): Deferred garbage collection.\n";
+      if (EnableGarbageCollectionMetrics)
+      {
+        mCRL2log(mcrl2::log::info, "Performance") << "g_term_pool(): Deferred garbage collection.\n";
+      }
+      collect();
     }
-    collect();
   }
 
+  unlock_shared();
   return result;
 }
 
@@ -385,6 +487,13 @@ void aterm_pool::print_performance_statistics() const
   }
 }
 
+mcrl2::utilities::shared_mutex& aterm_pool::thread_mutex()
+{
+  // Every thread registers its own mutex on first use, which is removed again when the thread terminates.
+  thread_local mcrl2::utilities::shared_mutex mutex(m_shared_mutex_data);
+  return mutex;
+}
+
 std::size_t aterm_pool::size() const
 {
   // Determine the total number of terms in any storage.
@@ -14,6 +14,8 @@
 #include "mcrl2/utilities/cache_metric.h"
 #include "mcrl2/utilities/unordered_set.h"
 
+#include <array>
+#include <mutex>
 #include <stack>
 #include <utility>
 
@@ -147,6 +149,10 @@ private:
   template<typename ...Args>
   aterm emplace(Args&&... args);
 
+  /// \brief Doubles the number of buckets when the maximum load factor has been reached.
+  /// \details Only used in the thread-safe configuration, where the set is not resized by emplace.
+  void rehash();
+
   /// \returns True if and only if this term storage can store term applications with a dynamic
   ///          number of arguments.
   constexpr bool is_dynamic_storage() const;
@@ -171,6 +177,16 @@ private:
   /// A reusable todo stack.
   std::stack<std::reference_wrapper<_aterm>> todo;
 
+  /// The number of locks that protect the buckets of the term set in the thread-safe configuration,
+  /// which must be a power of two that is at most the (initial) number of buckets.
+  static constexpr std::size_t NumberOfStripes = ThreadSafe ? 64 : 1;
+
+  /// The bucket with index i is protected by the stripe with index i % NumberOfStripes.
+  std::array<std::mutex, NumberOfStripes> m_stripes;
+
+  /// Ensures that the creation hooks are not executed concurrently.
+  std::mutex m_hook_mutex;
+
   // Various performance statistics.
 
   mcrl2::utilities::cache_metric m_term_metric; ///< Count the number of times a term has been found in or is added to the set.
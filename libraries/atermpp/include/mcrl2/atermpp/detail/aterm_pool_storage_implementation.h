@@ -16,6 +16,7 @@
 #include "mcrl2/utilities/stack_array.h"
 
 #include <cstring>
+#include <mutex>
 
 namespace atermpp
 {
@@ -222,6 +223,13 @@ void ATERM_POOL_STORAGE::sweep()
 ATERM_POOL_STORAGE_TEMPLATES
 void ATERM_POOL_STORAGE::call_creation_hook(unprotected_aterm term)
 {
+  // The hooks maintain global data structures, so only one hook is executed at the same time.
+  std::unique_lock<std::mutex> hook_guard;
+  if (ThreadSafe && !m_creation_hooks.empty())
+  {
+    hook_guard = std::unique_lock<std::mutex>(m_hook_mutex);
+  }
+
   for (const auto& [symbol, callback] : m_creation_hooks)
   {
     if (symbol == term.function())
@@ -294,9 +302,28 @@ ATERM_POOL_STORAGE_TEMPLATES
 template<typename ...Args>
 aterm ATERM_POOL_STORAGE::emplace(Args&&... args)
 {
+  // In the thread-safe configuration only the stripe of the bucket in which this term resides is locked.
+  // The stripe is determined by the lower bits of the hash, which coincide with the bucket index.
+  std::unique_lock<std::mutex> stripe_guard;
+  if (ThreadSafe)
+  {
+    stripe_guard = std::unique_lock<std::mutex>(m_stripes[m_term_set.hash_function()(args...) & (NumberOfStripes - 1)]);
+  }
+
   auto [it, added] = m_term_set.emplace(std::forward<Args>(args)...);
 
   aterm term(&(*it));
+  if (ThreadSafe)
+  {
+    bool resize = m_term_set.load_factor() >= m_term_set.max_load_factor();
+    stripe_guard.unlock();
+
+    if (resize)
+    {
+      rehash();
+    }
+  }
+
   if (added)
   {
     // A new term was created
@@ -313,6 +340,27 @@ aterm ATERM_POOL_STORAGE::emplace(Args&&... args)
   return term;
 }
 
+ATERM_POOL_STORAGE_TEMPLATES
+void ATERM_POOL_STORAGE::rehash()
+{
+  // Acquire all stripes in a fixed order, which waits for all ongoing insertions to finish.
+  for (std::mutex& stripe : m_stripes)
+  {
+    stripe.lock();
+  }
+
+  // Another thread might have resized the table in the meantime.
+  if (m_term_set.load_factor() >= m_term_set.max_load_factor())
+  {
+    m_term_set.rehash(m_term_set.bucket_count() * 2);
+  }
+
+  for (std::mutex& stripe : m_stripes)
+  {
+    stripe.unlock();
+  }
+}
+
 ATERM_POOL_STORAGE_TEMPLATES
 constexpr bool ATERM_POOL_STORAGE::is_dynamic_storage() const
 {
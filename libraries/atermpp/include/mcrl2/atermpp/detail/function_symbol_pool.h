@@ -14,6 +14,8 @@
 #include "mcrl2/utilities/cache_metric.h"
 #include "mcrl2/utilities/unordered_set.h"
 
+#include <mutex>
+
 namespace atermpp
 {
 namespace detail
@@ -42,6 +44,11 @@ public:
   /// \brief Frees the memory used by the passed element and remove it from the set.
   void destroy(const _function_symbol& f);
 
+  /// \brief Destroys all function symbols that are no longer referenced.
+  /// \details In the thread-safe configuration function symbols are not destroyed when their reference count
+  ///          becomes zero, because another thread might obtain the same function symbol concurrently.
+  void sweep();
+
   /// \brief Restore the index back to index before registering this prefix.
   void deregister(const std::string& prefix);
 
@@ -80,6 +87,9 @@ private:
   /// \brief Stores the underlying function symbols.
   unordered_set m_symbol_set;
 
+  /// \brief Protects the set of function symbols and the registered prefixes in the thread-safe configuration.
+  mutable std::mutex m_mutex;
+
   /// \brief A map that records a function for each prefix that must be called to set the
   ///        postfix number to a sufficiently high number if a function symbol with the same
   ///        prefix string is registered.
@@ -43,6 +43,26 @@ static aterm_pool& g_term_pool()
 }
 
 } // namespace detail
+
+/// \brief Keeps the calling thread inside a shared section of the global term pool during its lifetime.
+/// \details Only has an effect in the thread-safe configuration. Garbage collection stops all threads at
+///          their next safepoint, which is the point where a thread leaves its outermost shared section.
+///          As such, worker threads that access (and copy) terms should do so inside a shared section
+///          and leave it regularly, for example after processing a state.
+class shared_guard : private mcrl2::utilities::noncopyable
+{
+public:
+  shared_guard()
+  {
+    detail::g_term_pool().lock_shared();
+  }
+
+  ~shared_guard()
+  {
+    detail::g_term_pool().unlock_shared();
+  }
+};
+
 } // namespace atermpp
 
 #endif // MCRL2_ATERMPP_DETAIL_GLOBAL_ATERM_POOL_H_
@@ -0,0 +1,60 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/atermpp/detail/threads_option.h
+/// \brief The option --threads that is shared by the tools with multi-threaded algorithms.
+
+#ifndef MCRL2_ATERMPP_DETAIL_THREADS_OPTION_H
+#define MCRL2_ATERMPP_DETAIL_THREADS_OPTION_H
+
+#include "mcrl2/atermpp/detail/aterm_configuration.h"
+#include "mcrl2/utilities/command_line_interface.h"
+
+namespace atermpp
+{
+namespace detail
+{
+
+/// \brief Adds the option --threads=NUM to the interface description.
+/// \param description Explains what is done by the NUM threads.
+/// \param requires_thread_safe_terms Indicates that the threads create terms, in which case more than one thread
+///        can only be used if the toolset is built with MCRL2_ENABLE_MULTITHREADING.
+inline
+void add_threads_option(mcrl2::utilities::interface_description& desc, const std::string& description, bool requires_thread_safe_terms = true)
+{
+  desc.add_option("threads", mcrl2::utilities::make_mandatory_argument("NUM"),
+                  description + (requires_thread_safe_terms ? " More than one thread requires a toolset that is built "
+                                                              "with MCRL2_ENABLE_MULTITHREADING." : ""));
+}
+
+/// \brief Returns the number of threads given by the option --threads, or 1 if the option is not present.
+/// \details Reports an error if the number is not positive, or if more than one thread is requested for an algorithm
+///          that creates terms while the term library is not thread-safe.
+inline
+std::size_t parse_threads_option(const mcrl2::utilities::command_line_parser& parser, bool requires_thread_safe_terms = true)
+{
+  if (!parser.has_option("threads"))
+  {
+    return 1;
+  }
+  const std::size_t number_of_threads = parser.option_argument_as<std::size_t>("threads");
+  if (number_of_threads == 0)
+  {
+    parser.error("The number of threads must be positive.");
+  }
+  if (requires_thread_safe_terms && number_of_threads > 1 && !GlobalThreadSafe)
+  {
+    parser.error("Option 'threads' requires a toolset that is built with MCRL2_ENABLE_MULTITHREADING.");
+  }
+  return number_of_threads;
+}
+
+} // namespace detail
+} // namespace atermpp
+
+#endif // MCRL2_ATERMPP_DETAIL_THREADS_OPTION_H
@@ -43,7 +43,9 @@ public:
     if (m_function_symbol.defined())
     {
       m_function_symbol->decrement_reference_count();
-      if (m_function_symbol->reference_count() == 0)
+
+      // In the thread-safe configuration unreferenced function symbols are removed during garbage collection.
+      if (!detail::GlobalThreadSafe && m_function_symbol->reference_count() == 0)
       {
         destroy();
       }
@@ -15,6 +15,12 @@ using namespace atermpp;
 using namespace atermpp::detail;
 using namespace mcrl2::utilities;
 
+/// \returns A lock on the given mutex in the thread-safe configuration, and an empty lock otherwise.
+static std::unique_lock<std::mutex> lock_if_thread_safe(std::mutex& mutex)
+{
+  return GlobalThreadSafe ? std::unique_lock<std::mutex>(mutex) : std::unique_lock<std::mutex>();
+}
+
 function_symbol_pool::function_symbol_pool()
 {
   // Initialize the default function symbols.
@@ -35,6 +41,8 @@ function_symbol_pool::~function_symbol_pool()
 
 function_symbol function_symbol_pool::create(const std::string& name, const std::size_t arity, const bool check_for_registered_functions)
 {
+  auto guard = lock_if_thread_safe(m_mutex);
+
   auto it = m_symbol_set.find(name, arity);
   if (it != m_symbol_set.end())
   {
@@ -48,6 +56,12 @@ function_symbol function_symbol_pool::create(const std::string& name, const std:
     if (EnableFunctionSymbolMetrics) { m_function_symbol_metrics.miss(); }
 
     const _function_symbol& symbol = *m_symbol_set.emplace(name, arity).first;
+    if (GlobalThreadSafe && m_symbol_set.load_factor() >= m_symbol_set.max_load_factor())
+    {
+      // The thread-safe set is never resized implicitly, but it is safe to do so while holding the lock.
+      m_symbol_set.rehash(m_symbol_set.bucket_count() * 2);
+    }
+
     if (check_for_registered_functions)
     {
       // Check whether there is a registered prefix p such that name equal pn where n is a number.
@@ -87,13 +101,32 @@ void function_symbol_pool::destroy(const _function_symbol& f)
   m_symbol_set.erase(f);
 }
 
+void function_symbol_pool::sweep()
+{
+  auto guard = lock_if_thread_safe(m_mutex);
+
+  for (auto it = m_symbol_set.begin(); it != m_symbol_set.end(); )
+  {
+    if (it->reference_count() == 0)
+    {
+      it = m_symbol_set.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
 void function_symbol_pool::deregister(const std::string& prefix)
 {
+  auto guard = lock_if_thread_safe(m_mutex);
   m_prefix_to_register_function_map.erase(prefix);
 }
 
 std::shared_ptr<std::size_t> function_symbol_pool::register_prefix(const std::string& prefix)
 {
+  auto guard = lock_if_thread_safe(m_mutex);
   auto it = m_prefix_to_register_function_map.find(prefix);
   if (it != m_prefix_to_register_function_map.end())
   {
@@ -0,0 +1,103 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file thread_aterm_pool_test.cpp
+/// \brief Creates and garbage collects terms from several threads.
+
+#define BOOST_TEST_MODULE thread_aterm_pool_test
+#include <boost/test/included/unit_test_framework.hpp>
+
+#include <thread>
+
+#include "mcrl2/atermpp/aterm_appl.h"
+#include "mcrl2/atermpp/aterm_int.h"
+#include "mcrl2/atermpp/aterm_list.h"
+
+using namespace atermpp;
+
+/// \brief Only the thread-safe configuration supports creating terms from several threads.
+static std::size_t number_of_threads()
+{
+  return detail::GlobalThreadSafe ? 4 : 1;
+}
+
+/// \brief Creates the list [f(0,id), ..., f(length-1,id)] in which every term is protected.
+static aterm_list create_list(const function_symbol& f, std::size_t id, std::size_t length)
+{
+  aterm_list result;
+  for (std::size_t i = 0; i < length; ++i)
+  {
+    result.push_front(aterm_appl(f, aterm_int(i), aterm_int(id)));
+  }
+  return result;
+}
+
+/// \brief Checks that the given list is still equal to create_list(f, id, length).
+static bool check_list(const aterm_list& list, const function_symbol& f, std::size_t id, std::size_t length)
+{
+  std::size_t i = length;
+  for (const aterm& t: list)
+  {
+    --i;
+    const aterm_appl& appl = down_cast<aterm_appl>(t);
+    if (appl.function() != f
+        || down_cast<aterm_int>(appl[0]).value() != i
+        || down_cast<aterm_int>(appl[1]).value() != id)
+    {
+      return false;
+    }
+  }
+  return i == 0;
+}
+
+BOOST_AUTO_TEST_CASE(test_concurrent_creation_and_collection)
+{
+  const std::size_t iterations = 50;
+  const std::size_t length = 1000;
+  const function_symbol f("f", 2);
+
+  std::vector<std::thread> threads;
+  std::vector<int> correct(number_of_threads(), 0);
+  for (std::size_t id = 0; id < number_of_threads(); ++id)
+  {
+    threads.emplace_back([&, id]()
+    {
+      // This list is kept alive during all collections performed by the other threads.
+      const aterm_list kept = create_list(f, id, length);
+
+      bool result = true;
+      for (std::size_t i = 0; i < iterations; ++i)
+      {
+        // Every thread creates the same terms, so that they also race on finding existing terms.
+        aterm_list garbage = create_list(f, id, length);
+        result = result && garbage == kept && check_list(garbage, f, id, length);
+        garbage = aterm_list();
+
+        // Explicitly collect from every thread, which has to wait for all other threads to reach a safepoint.
+        detail::g_term_pool().collect();
+        result = result && check_list(kept, f, id, length);
+      }
+
+      correct[id] = result;
+    });
+  }
+
+  for (std::thread& thread: threads)
+  {
+    thread.join();
+  }
+
+  for (std::size_t id = 0; id < number_of_threads(); ++id)
+  {
+    BOOST_CHECK(correct[id]);
+  }
+
+  // All the lists have become garbage, except for the integers and the function symbol itself.
+  detail::g_term_pool().collect();
+  BOOST_CHECK(check_list(create_list(f, 0, length), f, 0, length));
+}
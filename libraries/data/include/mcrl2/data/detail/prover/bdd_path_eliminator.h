@@ -17,6 +17,7 @@
 #include "mcrl2/data/detail/prover/manipulator.h"
 #include "mcrl2/data/detail/prover/smt_lib_solver.h"
 #include "mcrl2/data/detail/prover/solver_type.h"
+#include "mcrl2/utilities/fixed_size_cache.h"
 
 namespace mcrl2
 {
@@ -58,6 +59,27 @@ class BDD_Path_Eliminator: public BDD_Simplifier
     /// \brief Class that provides information about the structure of BDDs.
     BDD_Info f_bdd_info;
 
+    /// \brief The satisfiability of the conditions passed to the SMT solver most recently. The guards of every condition
+    /// \brief are sorted, such that conditions that only differ in the order of their guards share an entry.
+    utilities::fifo_cache<data_expression_list, bool> f_satisfiable_cache;
+
+    /// \brief Returns true if the conjunction of the guards in a_condition is satisfiable. The SMT solver is only
+    /// \brief called for conditions that are not in the cache.
+    /// \param a_condition A list of guards and negated guards.
+    bool is_satisfiable(const data_expression_list& a_condition)
+    {
+      std::vector<data_expression> v_guards(a_condition.begin(), a_condition.end());
+      std::sort(v_guards.begin(), v_guards.end());
+      const data_expression_list v_key(v_guards.begin(), v_guards.end());
+
+      auto i = f_satisfiable_cache.find(v_key);
+      if (i == f_satisfiable_cache.end())
+      {
+        i = f_satisfiable_cache.emplace(v_key, f_smt_solver->is_satisfiable(v_key)).first;
+      }
+      return i->second;
+    }
+
     /// \brief Returns a list representing the conjunction of all guards in a_path and the guard a_guard.
     /// \param a_path A list of guards and negated guards, representing a path in a BDD.
     /// \param a_guard A guard or a negated guard.
@@ -128,7 +150,7 @@ class BDD_Path_Eliminator: public BDD_Simplifier
       const data_expression v_guard = f_bdd_info.get_guard(a_bdd);
       const data_expression v_negated_guard = sort_bool::not_(v_guard);
       const data_expression_list v_true_condition = create_condition(a_path, v_guard, true);
-      bool v_true_branch_enabled = f_smt_solver->is_satisfiable(v_true_condition);
+      bool v_true_branch_enabled = is_satisfiable(v_true_condition);
       if (!v_true_branch_enabled)
       {
         data_expression_list v_false_path=a_path;
@@ -138,7 +160,7 @@ class BDD_Path_Eliminator: public BDD_Simplifier
       else
       {
         data_expression_list v_false_condition = create_condition(a_path, v_negated_guard, true);
-        bool v_false_branch_enabled = f_smt_solver->is_satisfiable(v_false_condition);
+        bool v_false_branch_enabled = is_satisfiable(v_false_condition);
         if (!v_false_branch_enabled)
         {
           data_expression_list v_true_path = a_path;
@@ -178,9 +200,13 @@ class BDD_Path_Eliminator: public BDD_Simplifier
 
   public:
 
+    /// \brief The maximal number of conditions of which the satisfiability is kept.
+    static constexpr std::size_t satisfiable_cache_size = 1 << 14;
+
     /// \brief Constructor that initializes the field BDD_Path_Eliminator::f_smt_solver.
     /// \param a_solver_type A value of an enumerated type, representing an SMT solver.
     BDD_Path_Eliminator(smt_solver_type a_solver_type)
+      : f_satisfiable_cache(satisfiable_cache_size)
     {
 #if !(defined(_MSC_VER) || defined(__MINGW32__) || defined(__CYGWIN__))
       if (a_solver_type == solver_type_cvc)
@@ -210,6 +236,13 @@ class BDD_Path_Eliminator: public BDD_Simplifier
 #endif // _MSC_VER
     }
 
+    /// \brief Constructor that uses the given SMT solver, which is not deleted by this object.
+    /// \param a_smt_solver An SMT solver.
+    explicit BDD_Path_Eliminator(SMT_Solver* a_smt_solver)
+      : f_smt_solver(a_smt_solver),
+        f_satisfiable_cache(satisfiable_cache_size)
+    {}
+
     /// \brief Returns a BDD without inconsistent paths, equivalent to a_bdd.
     /// precondition: The argument passed as parameter a_bdd is a data expression in internal mCRL2 format with the
     /// following restrictions: It either represents the constant true or the constant false, or it is an if-then-else
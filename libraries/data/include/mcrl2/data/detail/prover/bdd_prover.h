@@ -475,6 +475,7 @@ class BDD_Prover: protected rewriter
       switch (a_rewrite_strategy)
       {
         case(jitty):
+        case(jitty_normal_form_cache):
 #ifdef MCRL2_JITTYC_AVAILABLE
         case(jitty_compiling):
 #endif
@@ -12,6 +12,8 @@
 
 #include "mcrl2/data/detail/rewrite.h"
 #include "mcrl2/data/detail/rewrite/strategy_rule.h"
+#include "mcrl2/utilities/cache_metric.h"
+#include "mcrl2/utilities/fixed_size_cache.h"
 
 namespace mcrl2
 {
@@ -25,7 +27,10 @@ class RewriterJitty: public Rewriter
   public:
     typedef Rewriter::substitution_type substitution_type;
 
-    RewriterJitty(const data_specification& data_spec, const used_data_equation_selector &);
+    /// \brief Constructor.
+    /// \param use_normal_form_cache If true, the normal forms of closed terms are stored in a bounded cache, such
+    ///        that rewriting the same closed term again amounts to a lookup.
+    RewriterJitty(const data_specification& data_spec, const used_data_equation_selector &, bool use_normal_form_cache = false);
     virtual ~RewriterJitty();
 
     rewrite_strategy getStrategy();
@@ -37,6 +42,14 @@ class RewriterJitty: public Rewriter
   private:
     std::map< function_symbol, data_equation_list > jitty_eqns;
     std::vector<strategy> jitty_strat;
+    bool m_use_normal_form_cache;
+    // Maps closed terms to their normal forms.
+    utilities::fifo_cache<data_expression, data_expression> m_normal_form_cache;
+    utilities::cache_metric m_normal_form_cache_metric;
+    // Stores for applications whether they are closed.
+    utilities::fifo_cache<data_expression, bool> m_closed_terms;
+
+    bool is_closed(const data_expression& t);
 
     data_expression rewrite_aux(const data_expression& term, substitution_type& sigma);
 
@@ -45,6 +58,11 @@ class RewriterJitty: public Rewriter
                       const data_expression& term,
                       substitution_type& sigma);
 
+    data_expression rewrite_aux_function_symbol_using_normal_form_cache(
+                      const function_symbol& op,
+                      const data_expression& term,
+                      substitution_type& sigma);
+
     data_expression rewrite_aux_const_function_symbol(
                       const function_symbol& op,
                       substitution_type& sigma);
@@ -21,6 +21,7 @@
 
 #include <utility>
 #include <string>
+#include <unordered_map>
 
 namespace mcrl2
 {
@@ -33,15 +34,18 @@ typedef std::vector < sort_expression_list> sort_list_vector;
 
 ///
 /// \brief The normal_form_cache class stores normal forms of data_expressions that
-///        are inserted in it. By keeping the cache on the stack, the normal forms
-///        in it will not be freed by the ATerm library, and can therefore be used
-///        in the generated jittyc code.
+///        are inserted in it, and other terms that are used by the generated jittyc code.
+///        The terms are stored in a table, and the generated code refers to them by their
+///        position in the table, which is passed to the generated code when it is loaded.
+///        Hence the generated code does not depend on the addresses of the terms, and a
+///        compiled rewriter can be reused by a later run of a tool.
 ///
 class normal_form_cache
 {
   private:
     RewriterJitty& m_rewriter;
-    std::set<data_expression> m_lookup;
+    std::vector<data_expression> m_terms;
+    std::unordered_map<data_expression, std::size_t> m_indices;
   public:
     normal_form_cache(RewriterJitty& rewriter)
       : m_rewriter(rewriter)
@@ -58,11 +62,31 @@ class normal_form_cache
   ///
   std::string insert(const data_expression& t)
   {
-    std::stringstream ss;
     RewriterJitty::substitution_type sigma;
-    auto pair = m_lookup.insert(m_rewriter(t, sigma));
-    ss << "*reinterpret_cast<const data_expression*>(" << (void*)&(*pair.first) << ")";
-    return ss.str();
+    return insert_term(m_rewriter(t, sigma));
+  }
+
+  ///
+  /// \brief insert_term stores t in the cache, without rewriting it, and returns a string
+  ///        that is a C++ representation of t.
+  ///
+  std::string insert_term(const data_expression& t)
+  {
+    auto pair = m_indices.try_emplace(t, m_terms.size());
+    if (pair.second)
+    {
+      m_terms.push_back(t);
+    }
+    return "term_table[" + std::to_string(pair.first->second) + "]";
+  }
+
+  ///
+  /// \brief terms returns the table of terms to which the strings obtained via the insert()
+  ///        method refer.
+  ///
+  const std::vector<data_expression>& terms() const
+  {
+    return m_terms;
   }
 
   ///
@@ -71,7 +95,8 @@ class normal_form_cache
   ///
   void clear()
   {
-    m_lookup.clear();
+    m_terms.clear();
+    m_indices.clear();
   }
 };
 
@@ -127,6 +152,12 @@ class RewriterCompilingJitty: public Rewriter
     std::vector<rewriter_function> functions_when_arguments_are_not_in_normal_form;
     std::vector<rewriter_function> functions_when_arguments_are_in_normal_form;
 
+    // The table of terms that are used by the generated code.
+    const std::vector<data_expression>& term_table() const
+    {
+      return m_nf_cache.terms();
+    }
+
     // Standard assignment operator.
     RewriterCompilingJitty& operator=(const RewriterCompilingJitty& other)=delete;
 
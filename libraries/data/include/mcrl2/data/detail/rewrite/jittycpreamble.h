@@ -45,6 +45,10 @@ static const data_expression& local_rewrite(const data_expression& t)
   return t;
 } 
 
+// The terms to which the generated code refers, such as function symbols and normal forms.
+// The table is owned by the rewriter that loads the library, and is set by init.
+static const data_expression* term_table = nullptr;
+
 //
 // Forward declarations
 //
@@ -349,6 +353,7 @@ bool init(rewriter_interface* i, RewriterCompilingJitty* this_rewriter)
   i->rewrite_external = &rewrite;
   i->rewrite_cleanup = &rewrite_cleanup;
   // this_rewriter = i->rewriter;
+  term_table = this_rewriter->term_table().data();
   set_the_precompiled_rewrite_functions_in_a_lookup_table(this_rewriter);
   i->status = "rewriter loaded successfully.";
   return true;
@@ -0,0 +1,101 @@
+// Author(s): Wieger Wesselink
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/data/enumeration_cache.h
+/// \brief A bounded cache for the results of enumerations.
+
+#ifndef MCRL2_DATA_ENUMERATION_CACHE_H
+#define MCRL2_DATA_ENUMERATION_CACHE_H
+
+#include "mcrl2/atermpp/aterm.h"
+#include "mcrl2/utilities/cache_metric.h"
+#include "mcrl2/utilities/fixed_size_cache.h"
+#include <vector>
+
+namespace mcrl2 {
+
+namespace data {
+
+/// \brief A cache that stores the results of enumerations, for example the solutions of the condition of a
+/// summand in a given state. The key of an entry is a term that contains the enumerated expression and the
+/// values of its free variables. The number of entries is bounded, and the policy determines which entry
+/// is replaced when the cache is full. The hits and misses are counted per group, e.g. per summand.
+/// \details The cache is not thread safe, every thread should use its own cache.
+template <typename Value, template <class> class Policy = utilities::clock_policy>
+class enumeration_cache
+{
+  public:
+    using key_type = atermpp::aterm;
+    using value_type = Value;
+
+  protected:
+    utilities::fixed_size_cache<Policy<utilities::unordered_map<key_type, Value>>> m_cache;
+    std::vector<utilities::cache_metric> m_metrics;
+
+  public:
+    /// \brief Constructor.
+    /// \param max_size The maximum number of entries, where 0 means that the number of entries is unbounded.
+    /// \param number_of_groups The number of groups for which the hits and misses are counted.
+    explicit enumeration_cache(std::size_t max_size, std::size_t number_of_groups = 1)
+      : m_cache(max_size),
+        m_metrics(number_of_groups)
+    {}
+
+    /// \brief Returns the cached value of key, or computes it using compute() and stores it in the cache.
+    /// \details The value is returned by value, since computing another value may replace the entry of key.
+    /// Values are expected to be cheap to copy, e.g. terms. The function compute may use the cache as well.
+    template <typename Compute>
+    Value find_or_compute(const key_type& key, std::size_t group, Compute compute)
+    {
+      assert(group < m_metrics.size());
+      auto i = m_cache.find(key);
+      if (i != m_cache.end())
+      {
+        m_metrics[group].hit();
+        return i->second;
+      }
+      m_metrics[group].miss();
+      Value result = compute();
+      m_cache.emplace(key, result);
+      return result;
+    }
+
+    /// \brief Returns the number of entries in the cache.
+    std::size_t size() const
+    {
+      return m_cache.size();
+    }
+
+    /// \brief Returns the hits and misses of the given group.
+    const utilities::cache_metric& metric(std::size_t group) const
+    {
+      return m_metrics[group];
+    }
+
+    /// \brief Returns the hits and misses of all groups.
+    const std::vector<utilities::cache_metric>& metrics() const
+    {
+      return m_metrics;
+    }
+
+    /// \brief Removes all entries from the cache and resets the counters.
+    void clear()
+    {
+      m_cache.clear();
+      for (utilities::cache_metric& metric: m_metrics)
+      {
+        metric.reset();
+      }
+    }
+};
+
+} // namespace data
+
+} // namespace mcrl2
+
+#endif // MCRL2_DATA_ENUMERATION_CACHE_H
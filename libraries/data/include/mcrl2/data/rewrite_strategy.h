@@ -13,6 +13,7 @@ namespace data
 enum rewrite_strategy
 {
   jitty,                      /** \brief JITty */
+  jitty_normal_form_cache,    /** \brief JITty with a cache of normal forms */
 #ifdef MCRL2_JITTYC_AVAILABLE
   jitty_compiling,            /** \brief Compiling JITty */
   jitty_prover,               /** \brief JITty + Prover */
@@ -28,6 +29,8 @@ rewrite_strategy parse_rewrite_strategy(const std::string& s)
 {
   if(s == "jitty")
     return jitty;
+  else if (s == "jittyn")
+    return jitty_normal_form_cache;
   else if (s == "jittyp")
     return jitty_prover;
 
@@ -65,6 +68,7 @@ inline std::string pp(const rewrite_strategy s)
   switch (s)
   {
     case jitty: return "jitty";
+    case jitty_normal_form_cache: return "jittyn";
 #ifdef MCRL2_JITTYC_AVAILABLE
     case jitty_compiling: return "jittyc";
 #endif
@@ -89,6 +93,7 @@ inline std::string description(const rewrite_strategy s)
   switch (s)
   {
     case jitty: return "jitty rewriting";
+    case jitty_normal_form_cache: return "jitty rewriting with a cache of the normal forms of closed terms";
 #ifdef MCRL2_JITTYC_AVAILABLE
     case jitty_compiling: return "compiled jitty rewriting";
 #endif
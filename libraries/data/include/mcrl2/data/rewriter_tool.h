@@ -43,6 +43,7 @@ class rewriter_tool: public Tool
 
       utilities::interface_description::enum_argument<data::rewrite_strategy> rewriter_option("NAME");
       rewriter_option.add_value(data::jitty, true);
+      rewriter_option.add_value(data::jitty_normal_form_cache);
 #ifdef MCRL2_JITTYC_AVAILABLE
       rewriter_option.add_value(data::jitty_compiling);
 #endif
@@ -160,8 +160,12 @@ void RewriterJitty::rebuild_strategy()
 
 RewriterJitty::RewriterJitty(
            const data_specification& data_spec,
-           const mcrl2::data::used_data_equation_selector& equation_selector):
-        Rewriter(data_spec,equation_selector)
+           const mcrl2::data::used_data_equation_selector& equation_selector,
+           bool use_normal_form_cache):
+        Rewriter(data_spec,equation_selector),
+        m_use_normal_form_cache(use_normal_form_cache),
+        m_normal_form_cache(use_normal_form_cache ? 1 << 16 : 1),
+        m_closed_terms(use_normal_form_cache ? 1 << 16 : 1)
 {
   for (const data_equation& eq: data_spec.equations())
   {
@@ -195,6 +199,40 @@ RewriterJitty::RewriterJitty(
 
 RewriterJitty::~RewriterJitty()
 {
+  if (m_use_normal_form_cache)
+  {
+    mCRL2log(log::verbose) << "Normal form cache of the jitty rewriter: " << m_normal_form_cache_metric.message() << "." << std::endl;
+  }
+}
+
+// Returns true if t contains no variables and no binders. The normal form of such a term does not depend on the
+// substitution with which it is rewritten. The outcome for applications is stored, such that the subterms of a term
+// that has been checked, and which are rewritten subsequently, are not traversed again.
+bool RewriterJitty::is_closed(const data_expression& t)
+{
+  if (is_function_symbol(t))
+  {
+    return true;
+  }
+  if (!is_application(t))
+  {
+    return false;
+  }
+
+  auto i = m_closed_terms.find(t);
+  if (i != m_closed_terms.end())
+  {
+    return i->second;
+  }
+
+  const application& ta = atermpp::down_cast<application>(t);
+  bool result = is_closed(ta.head());
+  for (application::const_iterator j = ta.begin(); result && j != ta.end(); ++j)
+  {
+    result = is_closed(*j);
+  }
+  m_closed_terms.emplace(t, result);
+  return result;
 }
 
 static data_expression subst_values(
@@ -386,6 +424,10 @@ data_expression RewriterJitty::rewrite_aux(
   
     if (is_function_symbol(head) && head!=this_term_is_in_normal_form())
     {
+      if (m_use_normal_form_cache)
+      {
+        return rewrite_aux_function_symbol_using_normal_form_cache(atermpp::down_cast<function_symbol>(head),term,sigma);
+      }
       return rewrite_aux_function_symbol(atermpp::down_cast<function_symbol>(head),term,sigma);
     }
   
@@ -458,6 +500,30 @@ data_expression RewriterJitty::rewrite_aux(
   }
 }
 
+data_expression RewriterJitty::rewrite_aux_function_symbol_using_normal_form_cache(
+                      const function_symbol& op,
+                      const data_expression& term,
+                      substitution_type& sigma)
+{
+  if (!is_closed(term))
+  {
+    return rewrite_aux_function_symbol(op,term,sigma);
+  }
+
+  // As terms are maximally shared, looking up a term in the cache only requires its address.
+  auto i = m_normal_form_cache.find(term);
+  if (i != m_normal_form_cache.end())
+  {
+    m_normal_form_cache_metric.hit();
+    return i->second;
+  }
+
+  m_normal_form_cache_metric.miss();
+  const data_expression result = rewrite_aux_function_symbol(op,term,sigma);
+  m_normal_form_cache.emplace(term, result);
+  return result;
+}
+
 data_expression RewriterJitty::rewrite_aux_function_symbol(
                       const function_symbol& op,
                       const data_expression& term,
@@ -681,7 +747,7 @@ data_expression RewriterJitty::rewrite(
 
 rewrite_strategy RewriterJitty::getStrategy()
 {
-  return jitty;
+  return m_use_normal_form_cache?jitty_normal_form_cache:jitty;
 }
 }
 }
@@ -16,6 +16,10 @@
 
 #include <unistd.h>
 #include <sys/stat.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
 #include "mcrl2/utilities/basename.h"
 #include "mcrl2/utilities/stopwatch.h"
 #include "mcrl2/atermpp/algorithm.h"
@@ -1011,17 +1015,20 @@ class rewr_function_spec
     const function_symbol m_fs;
     const std::size_t m_arity;
     const bool m_delayed;
+    const std::size_t m_number; // The number of m_fs in the generated code, see ImplementTree::function_symbol_number.
 
   public:
-    rewr_function_spec(function_symbol fs, std::size_t arity, const bool delayed)
-      : m_fs(fs), m_arity(arity), m_delayed(delayed)
+    rewr_function_spec(function_symbol fs, std::size_t arity, const bool delayed, std::size_t number)
+      : m_fs(fs), m_arity(arity), m_delayed(delayed), m_number(number)
     { }
 
+    // The order is based on the numbers of the function symbols, such that the generated code does not depend on
+    // the addresses of the function symbols.
     bool operator<(const rewr_function_spec& other) const
     {
-      return m_fs < other.m_fs ||
-             (m_fs == other.m_fs && m_arity < other.m_arity) ||
-             (m_fs == other.m_fs && m_arity == other.m_arity && m_delayed<other.m_delayed);
+      return m_number < other.m_number ||
+             (m_number == other.m_number && m_arity < other.m_arity) ||
+             (m_number == other.m_number && m_arity == other.m_arity && m_delayed<other.m_delayed);
     }
 
     function_symbol fs() const
@@ -1051,8 +1058,7 @@ class rewr_function_spec
       {
         name << "delayed_";
       }
-      name << "rewr_" << core::index_traits<data::function_symbol,function_symbol_key_type, 2>::index(m_fs)
-           << "_" << m_arity;
+      name << "rewr_" << m_number << "_" << m_arity;
       return name.str();
     }
 };
@@ -1085,6 +1091,11 @@ class RewriterCompilingJitty::ImplementTree
   RewriterCompilingJitty& m_rewriter;
   std::stack<rewr_function_spec> m_rewr_functions;
   std::set<rewr_function_spec> m_rewr_functions_implemented;
+  // The function symbols are numbered in the order in which they are used by the generated code. Unlike their
+  // indices, these numbers do not depend on the other function symbols that exist, which allows to reuse the
+  // generated code in other runs.
+  std::map<function_symbol, std::size_t> m_function_symbol_numbers;
+  std::size_t m_auxiliary_method_name_index = 0;
   std::set<std::size_t>m_delayed_application_functions; // Recalls the arities of the required functions 'delayed_application';
   std::vector<bool> m_used;
   std::vector<int> m_stack;
@@ -1205,10 +1216,15 @@ class RewriterCompilingJitty::ImplementTree
     return "make_term_with_many_arguments";
   }
 
+  std::size_t function_symbol_number(const function_symbol& f)
+  {
+    return m_function_symbol_numbers.insert(std::make_pair(f, m_function_symbol_numbers.size())).first->second;
+  }
+
   inline
   const std::string rewr_function_name(const function_symbol& f, std::size_t arity)
   {
-    rewr_function_spec spec(f, arity, false);
+    rewr_function_spec spec(f, arity, false, function_symbol_number(f));
     if (m_rewr_functions_implemented.insert(spec).second)
     {
       m_rewr_functions.push(spec);
@@ -1219,7 +1235,7 @@ class RewriterCompilingJitty::ImplementTree
   inline
   const std::string delayed_rewr_function_name(const function_symbol& f, std::size_t arity)
   {
-    rewr_function_spec spec(f, arity, true);
+    rewr_function_spec spec(f, arity, true, function_symbol_number(f));
     if (m_rewr_functions_implemented.insert(spec).second)
     {
       m_rewr_functions.push(spec);
@@ -1725,23 +1741,21 @@ class RewriterCompilingJitty::ImplementTree
     */
     if (brackets.bracket_nesting_level>brackets.MCRL2_BRACKET_NESTING_LEVEL)
     {
-      static std::size_t auxiliary_method_name_index=0;
-
       m_stream << m_padding 
-               << "const data_expression& result" << auxiliary_method_name_index << "= auxiliary_function_to_reduce_bracket_nesting" << auxiliary_method_name_index << "("
+               << "const data_expression& result" << m_auxiliary_method_name_index << "= auxiliary_function_to_reduce_bracket_nesting" << m_auxiliary_method_name_index << "("
                << brackets.current_data_arguments.top() << ",this_rewriter);\n";
       m_stream << m_padding 
-               << "if (result" << auxiliary_method_name_index << " != data_expression()) { return result" << auxiliary_method_name_index << "; }\n";
+               << "if (result" << m_auxiliary_method_name_index << " != data_expression()) { return result" << m_auxiliary_method_name_index << "; }\n";
 
       const std::size_t old_indent=m_padding.reset();
       std::stringstream s;
       s << "  template < " << brackets.current_template_parameters << ">\n"
-        << "  static inline data_expression auxiliary_function_to_reduce_bracket_nesting" << auxiliary_method_name_index 
+        << "  static inline data_expression auxiliary_function_to_reduce_bracket_nesting" << m_auxiliary_method_name_index 
         << "(" 
         << brackets.current_data_parameters.top() << (brackets.current_data_parameters.top().empty()?"":", ") << "RewriterCompilingJitty* this_rewriter)\n" 
         << "  {\n";
       
-      auxiliary_method_name_index++;
+      m_auxiliary_method_name_index++;
 
       std::size_t old_bracket_nesting_level=brackets.bracket_nesting_level;
       brackets.bracket_nesting_level=0;
@@ -1921,7 +1935,7 @@ class RewriterCompilingJitty::ImplementTree
              std::map<variable,std::string>& type_of_code_variables)
   {
     bool reset_current_data_parameters=false;
-    const void* func = (void*)(atermpp::detail::address(tree.function()));
+    const std::string func = "uint_address(" + m_rewriter.m_nf_cache.insert_term(tree.function()) + ")";
     m_stream << m_padding;
     brackets.bracket_nesting_level++;
     if (level == 0)
@@ -2397,7 +2411,7 @@ public:
     else
     {
       std::stringstream ss;
-      ss << "atermpp::down_cast<data_expression>(atermpp::aterm(reinterpret_cast<atermpp::detail::_aterm*>(" << (void*)atermpp::detail::address(opid) << ")))";
+      ss << m_rewriter.m_nf_cache.insert_term(opid);
       std::size_t used_arguments = 0;
       m_stream << rewr_function_finish_term(arity, ss.str(), down_cast<function_sort>(opid.sort()), used_arguments) << ";\n";
       assert(used_arguments == arity);
@@ -2448,8 +2462,8 @@ public:
     bracket_level_data brackets;
     std::stack<std::string> auxiliary_code_fragments;
 
-    std::size_t index = core::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(func);
-    m_stream << m_padding << "// [" << index << "] " << func << ": " << func.sort() << "\n";
+    std::size_t index = function_symbol_number(func);
+    m_stream << m_padding << "// " << func << ": " << func.sort() << "\n";
     rewr_function_signature(m_stream, index, arity, brackets);
     m_stream << "\n" << m_padding << "{\n";
     m_padding.indent();
@@ -2493,8 +2507,8 @@ public:
 
   void generate_delayed_normal_form_generating_function(std::ostream& m_stream, const data::function_symbol& func, std::size_t arity)
   {
-    std::size_t index = core::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(func);
-    m_stream << m_padding << "// [" << index << "] " << func << ": " << func.sort() << "\n";
+    std::size_t index = function_symbol_number(func);
+    m_stream << m_padding << "// " << func << ": " << func.sort() << "\n";
     if (arity>0)
     {
       m_stream << m_padding << "template < ";
@@ -2604,6 +2618,178 @@ static std::string generate_cpp_filename(std::size_t unique)
   return filename.str();
 }
 
+///
+/// \brief read_file returns the contents of a file.
+/// \param filename The name of the file.
+/// \return The contents of the file, or the empty string if it cannot be read.
+///
+static std::string read_file(const std::string& filename)
+{
+  std::ifstream in(filename, std::ios::binary);
+  std::ostringstream contents;
+  contents << in.rdbuf();
+  return contents.str();
+}
+
+///
+/// \brief jittyc_cache_directory returns the directory in which compiled rewriters are kept
+///        for reuse by later runs. It is set by the environment variable MCRL2_JITTYC_CACHE. If
+///        this variable is not set, the empty string is returned and compiled rewriters are not kept.
+///
+static std::string jittyc_cache_directory()
+{
+  const char* env_dir = std::getenv("MCRL2_JITTYC_CACHE");
+  return env_dir == nullptr ? std::string() : std::string(env_dir);
+}
+
+///
+/// \brief jittyc_cache_size returns the maximal number of compiled rewriters in the cache, which
+///        is set by the environment variable MCRL2_JITTYC_CACHE_SIZE, and is 32 by default.
+///
+static std::size_t jittyc_cache_size()
+{
+  const char* env_size = std::getenv("MCRL2_JITTYC_CACHE_SIZE");
+  return env_size == nullptr ? 32 : std::max<std::size_t>(1, std::strtoul(env_size, nullptr, 10));
+}
+
+///
+/// \brief jittyc_compiler_identity returns the version information of the compiler that is used by the default
+///        compile script, which it selects in the same way as the script does.
+///
+static std::string jittyc_compiler_identity()
+{
+  std::string result;
+  FILE* output = popen("if [ -z \"$CXX\" ]; then CXX=`which c++ || which clang++ || which g++`; fi; "
+                       "echo \"$CXX\"; \"$CXX\" --version 2>&1", "r");
+  if (output != nullptr)
+  {
+    char buffer[256];
+    std::size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), output)) > 0)
+    {
+      result.append(buffer, n);
+    }
+    pclose(output);
+  }
+  return result;
+}
+
+///
+/// \brief jittyc_cache_key computes the name under which a compiled rewriter is stored in the cache.
+/// \details The generated code determines the rewriter completely, as it contains the rewrite rules, and
+///          it contains neither addresses of terms nor indices of function symbols. The key also covers
+///          everything else that the compiled rewriter depends on:
+///          - the compile script, which contains the compiler flags and include directories;
+///          - the compiler and its version;
+///          - the moment at which this file was compiled. This file includes the headers that are included
+///            by the generated code, so it is recompiled whenever one of them changes. It also identifies
+///            the build of the library that loads the rewriter, and hence its ABI;
+///          - the toolset version.
+///          The key is the FNV-1a hash of all of these. As the cache also stores the generated code,
+///          which is compared when looking up a rewriter, a collision leads to a recompilation, and
+///          not to the wrong rewriter.
+///
+static std::string jittyc_cache_key(const std::string& code, const std::string& compile_script)
+{
+  std::uint64_t hash = 14695981039346656037ull;
+  for (const std::string& part: { std::string(mcrl2::utilities::get_toolset_version()),
+                                   std::string(__DATE__ " " __TIME__),
+                                   read_file(compile_script),
+                                   jittyc_compiler_identity(),
+                                   code })
+  {
+    for (const char c: part + '\0')
+    {
+      hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    }
+  }
+  std::ostringstream key;
+  key << "jittyc_" << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return key.str();
+}
+
+///
+/// \brief load_from_jittyc_cache looks up a compiled rewriter for the given code in the cache.
+/// \details If it is found, it is copied to library_file, such that different rewriters in the
+///          same process do not share the static variables of the library. The library is removed
+///          when the rewriter is cleaned up.
+/// \return Whether the rewriter was found.
+///
+static bool load_from_jittyc_cache(uncompiled_library& library,
+                                   const std::string& cache_file,
+                                   const std::string& code,
+                                   const std::string& library_file)
+{
+  std::error_code error;
+  if (!std::filesystem::exists(cache_file + ".so", error) || read_file(cache_file + ".cpp") != code)
+  {
+    return false;
+  }
+  if (!std::filesystem::copy_file(cache_file + ".so", library_file, std::filesystem::copy_options::overwrite_existing, error))
+  {
+    return false;
+  }
+  // Mark the rewriter as recently used, such that it is evicted last.
+  std::filesystem::last_write_time(cache_file + ".so", std::filesystem::file_time_type::clock::now(), error);
+  library.use_compiled(library_file);
+  return true;
+}
+
+///
+/// \brief store_in_jittyc_cache stores a compiled rewriter and its code in the cache, after which
+///        the least recently used rewriters are removed if the cache holds more than jittyc_cache_size().
+/// \details The files are written under a temporary name and then renamed, such that tools that run
+///          concurrently never see a partially written rewriter. Failures are reported, but are not fatal.
+///
+static void store_in_jittyc_cache(const std::string& directory,
+                                  const std::string& cache_file,
+                                  const std::string& code,
+                                  const std::string& library_file)
+{
+  namespace fs = std::filesystem;
+  std::error_code error;
+  const std::string temporary_suffix = ".tmp" + std::to_string(getpid());
+  fs::create_directories(directory, error);
+  {
+    std::ofstream out(cache_file + ".cpp" + temporary_suffix, std::ios::binary);
+    out << code;
+  }
+  fs::rename(cache_file + ".cpp" + temporary_suffix, cache_file + ".cpp", error);
+  if (!error)
+  {
+    fs::copy_file(library_file, cache_file + ".so" + temporary_suffix, fs::copy_options::overwrite_existing, error);
+  }
+  if (!error)
+  {
+    fs::rename(cache_file + ".so" + temporary_suffix, cache_file + ".so", error);
+  }
+  if (error)
+  {
+    mCRL2log(warning) << "Could not store the compiled rewriter in " << directory << ": " << error.message() << std::endl;
+    fs::remove(cache_file + ".cpp" + temporary_suffix, error);
+    fs::remove(cache_file + ".so" + temporary_suffix, error);
+    return;
+  }
+
+  std::vector<std::pair<fs::file_time_type, fs::path>> libraries;
+  for (const fs::directory_entry& entry: fs::directory_iterator(directory, error))
+  {
+    if (entry.path().extension() == ".so" && entry.path().filename().string().compare(0, 7, "jittyc_") == 0)
+    {
+      libraries.emplace_back(fs::last_write_time(entry.path(), error), entry.path());
+    }
+  }
+  if (libraries.size() > jittyc_cache_size())
+  {
+    std::sort(libraries.begin(), libraries.end());
+    for (std::size_t i = 0; i < libraries.size() - jittyc_cache_size(); ++i)
+    {
+      fs::remove(libraries[i].second, error);
+      fs::remove(fs::path(libraries[i].second).replace_extension(".cpp"), error);
+    }
+  }
+}
+
 ///
 /// \brief filter_function_symbols selects the function symbols from source for which filter
 ///        returns true, and copies them to dest.
@@ -2668,6 +2854,20 @@ void RewriterCompilingJitty::generate_code(const std::string& filename)
   filter_function_symbols(m_data_specification_for_enumeration.constructors(), function_symbols, data_equation_selector);
   filter_function_symbols(m_data_specification_for_enumeration.mappings(), function_symbols, data_equation_selector);
 
+  // The function symbols are numbered in this order by the code generator, so they are ordered on their names and
+  // sorts, and not on their addresses.
+  std::vector<std::pair<std::string, function_symbol>> named_function_symbols;
+  for (const function_symbol& f: function_symbols)
+  {
+    named_function_symbols.emplace_back(pp(f) + ": " + pp(f.sort()), f);
+  }
+  std::sort(named_function_symbols.begin(), named_function_symbols.end(),
+            [](const auto& f1, const auto& f2) { return f1.first < f2.first; });
+  function_symbols.clear();
+  for (const std::pair<std::string, function_symbol>& f: named_function_symbols)
+  {
+    function_symbols.push_back(f.second);
+  }
 
   // The rewrite functions are first stored in a separate buffer (rewrite_functions),
   // because during the generation process, new function symbols are created. This
@@ -2680,8 +2880,9 @@ void RewriterCompilingJitty::generate_code(const std::string& filename)
   functions_when_arguments_are_not_in_normal_form = std::vector<rewriter_function>(arity_bound * index_bound);
   functions_when_arguments_are_in_normal_form = std::vector<rewriter_function>(arity_bound * index_bound);
 
-  cpp_file << "#define INDEX_BOUND__ " << index_bound << "// These values are not used anymore.\n"
-              "#define ARITY_BOUND__ " << arity_bound << "// These values are not used anymore.\n";
+  // The generated code does not contain addresses of terms, nor indices of function symbols, as these differ
+  // between runs. The rewrite functions are named after the numbers of their function symbols, see
+  // ImplementTree::function_symbol_number. This allows to reuse the compiled code, see BuildRewriteSystem.
   cpp_file << "#include \"mcrl2/data/detail/rewrite/jittycpreamble.h\"\n";
 
   cpp_file << "namespace {\n"
@@ -2726,13 +2927,13 @@ void RewriterCompilingJitty::generate_code(const std::string& filename)
   {
     if (!it->delayed())
     {
+      const std::string index = "mcrl2::core::index_traits<function_symbol, function_symbol_key_type, 2>::index(down_cast<function_symbol>("
+                                + m_nf_cache.insert_term(it->fs()) + "))";
       cpp_file << "  this_rewriter->functions_when_arguments_are_not_in_normal_form[this_rewriter->arity_bound * "
-               << core::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(it->fs())
-               << " + " << it->arity() << "] = rewr_functions::"
+               << index << " + " << it->arity() << "] = rewr_functions::"
                << it->name() << "_term;\n";
       cpp_file << "  this_rewriter->functions_when_arguments_are_in_normal_form[this_rewriter->arity_bound * "
-               << core::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(it->fs())
-               << " + " << it->arity() << "] = rewr_functions::"
+               << index << " + " << it->arity() << "] = rewr_functions::"
                << it->name() << "_term_arg_in_normal_form;\n";
     }
   }
@@ -2775,29 +2976,62 @@ void RewriterCompilingJitty::BuildRewriteSystem()
   mCRL2log(verbose) << "using '" << compile_script << "' to compile rewriter." << std::endl;
   stopwatch time;
 
+  // The rules are ordered on their text, and not on their addresses, such that the generated code is the same in
+  // every run, which allows to reuse it.
+  std::vector<std::pair<std::string, data_equation>> rules;
+  for (const data_equation& rule: rewrite_rules)
+  {
+    rules.emplace_back(pp(rule.variables()) + " . " + pp(rule), rule);
+  }
+  std::sort(rules.begin(), rules.end(), [](const auto& r1, const auto& r2) { return r1.first < r2.first; });
   jittyc_eqns.clear();
-  for(std::set < data_equation >::const_iterator it = rewrite_rules.begin(); it != rewrite_rules.end(); ++it)
+  for (const std::pair<std::string, data_equation>& rule: rules)
   {
-    jittyc_eqns[down_cast<function_symbol>(get_nested_head(it->lhs()))].push_front(*it);
+    jittyc_eqns[down_cast<function_symbol>(get_nested_head(rule.second.lhs()))].push_front(rule.second);
   }
 
   std::string cpp_file = generate_cpp_filename(reinterpret_cast<std::size_t>(this));
   generate_code(cpp_file);
 
-  mCRL2log(verbose) << "generated " << cpp_file << " in " << time.time() << "ms, compiling..." << std::endl;
-  time.reset();
-
-  try
+  // If a cache directory is set, a rewriter that was compiled before from the same code is reused.
+  const std::string cache_directory = jittyc_cache_directory();
+  std::string code;
+  std::string cache_file;
+  if (!cache_directory.empty())
   {
-    rewriter_so->compile(cpp_file);
+    code = read_file(cpp_file);
+    cache_file = (std::filesystem::path(cache_directory) / jittyc_cache_key(code, compile_script)).string();
   }
-  catch(std::runtime_error& e)
+
+  if (!cache_directory.empty() &&
+      load_from_jittyc_cache(*rewriter_so, cache_file, code, std::filesystem::path(cpp_file).replace_extension(".so").string()))
   {
-    rewriter_so->leave_files();
-    throw mcrl2::runtime_error(std::string("Could not compile rewriter: ") + e.what());
+    std::remove(cpp_file.c_str());
+    mCRL2log(verbose) << "generated " << cpp_file << " in " << time.time() << "ms, using the compiled rewriter "
+                      << cache_file << ".so, loading rewriter..." << std::endl;
   }
+  else
+  {
+    mCRL2log(verbose) << "generated " << cpp_file << " in " << time.time() << "ms, compiling..." << std::endl;
+    time.reset();
 
-  mCRL2log(verbose) << "compiled in " << time.time() << "ms, loading rewriter..." << std::endl;
+    try
+    {
+      rewriter_so->compile(cpp_file);
+    }
+    catch(std::runtime_error& e)
+    {
+      rewriter_so->leave_files();
+      throw mcrl2::runtime_error(std::string("Could not compile rewriter: ") + e.what());
+    }
+
+    mCRL2log(verbose) << "compiled in " << time.time() << "ms, loading rewriter..." << std::endl;
+
+    if (!cache_directory.empty())
+    {
+      store_in_jittyc_cache(cache_directory, cache_file, code, rewriter_so->filename());
+    }
+  }
 
   bool (*init)(rewriter_interface*, RewriterCompilingJitty* this_rewriter);
   rewriter_interface interface = { mcrl2::utilities::get_toolset_version(), "Unknown error when loading rewriter.", this, NULL, NULL };
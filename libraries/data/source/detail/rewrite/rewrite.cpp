@@ -459,6 +459,8 @@ std::shared_ptr<Rewriter> createRewriter(
   {
     case jitty:
       return std::shared_ptr<Rewriter>(new RewriterJitty(data_spec,equations_selector));
+    case jitty_normal_form_cache:
+      return std::shared_ptr<Rewriter>(new RewriterJitty(data_spec,equations_selector,true));
 #ifdef MCRL2_JITTYC_AVAILABLE
     case jitty_compiling:
       return std::shared_ptr<Rewriter>(new RewriterCompilingJitty(data_spec,equations_selector));
@@ -0,0 +1,70 @@
+// Author(s): Luc Engelen
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file bdd_path_eliminator_test.cpp
+/// \brief Tests that the BDD path eliminator only passes conditions to the SMT solver that are not cached.
+
+#define BOOST_TEST_MODULE bdd_path_eliminator_test
+#include <boost/test/included/unit_test_framework.hpp>
+
+#include "mcrl2/data/detail/prover/bdd_path_eliminator.h"
+
+using namespace mcrl2;
+using namespace mcrl2::data;
+
+/// \brief An SMT solver that counts the conditions that it is asked about, and considers all of them satisfiable.
+class counting_smt_solver: public detail::SMT_Solver
+{
+  public:
+    std::size_t number_of_calls = 0;
+
+    bool is_satisfiable(const data_expression_list&) override
+    {
+      ++number_of_calls;
+      return true;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(test_repeated_condition)
+{
+  const variable b("b", sort_bool::bool_());
+  const variable c("c", sort_bool::bool_());
+  const data_expression bdd = if_(b, if_(c, sort_bool::true_(), sort_bool::false_()), sort_bool::false_());
+
+  counting_smt_solver solver;
+  detail::BDD_Path_Eliminator eliminator(&solver);
+  eliminator.set_time_limit(0);
+
+  BOOST_CHECK(eliminator.simplify(bdd) == bdd);
+  const std::size_t number_of_calls = solver.number_of_calls;
+  BOOST_CHECK(number_of_calls > 0);
+
+  // The same conditions are encountered again, and are all found in the cache.
+  BOOST_CHECK(eliminator.simplify(bdd) == bdd);
+  BOOST_CHECK_EQUAL(solver.number_of_calls, number_of_calls);
+}
+
+BOOST_AUTO_TEST_CASE(test_bounded_cache)
+{
+  counting_smt_solver solver;
+  detail::BDD_Path_Eliminator eliminator(&solver);
+  eliminator.set_time_limit(0);
+
+  // Every guard gives rise to two new conditions, so the first guards are evicted from the cache.
+  const std::size_t n = 4 * detail::BDD_Path_Eliminator::satisfiable_cache_size;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    const variable b("b" + std::to_string(i), sort_bool::bool_());
+    eliminator.simplify(if_(b, sort_bool::true_(), sort_bool::false_()));
+  }
+  BOOST_CHECK_EQUAL(solver.number_of_calls, 2 * n);
+
+  const variable b0("b0", sort_bool::bool_());
+  eliminator.simplify(if_(b0, sort_bool::true_(), sort_bool::false_()));
+  BOOST_CHECK_EQUAL(solver.number_of_calls, 2 * n + 2);
+}
@@ -0,0 +1,178 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file jittyc_cache_test.cpp
+/// \brief Tests the reuse of compiled rewriters through the directory MCRL2_JITTYC_CACHE.
+
+#define BOOST_TEST_MODULE jittyc_cache_test
+#include <boost/test/included/unit_test_framework.hpp>
+
+#include "mcrl2/data/parse.h"
+#include "mcrl2/data/rewriter.h"
+
+#include <cstdlib>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+using namespace mcrl2;
+using namespace mcrl2::data;
+
+#ifdef MCRL2_JITTYC_AVAILABLE
+
+namespace fs = std::filesystem;
+
+/// \brief Returns the last write time of every file in the cache directory.
+static std::map<fs::path, fs::file_time_type> cache_contents(const fs::path& directory)
+{
+  std::map<fs::path, fs::file_time_type> result;
+  for (const fs::directory_entry& entry: fs::directory_iterator(directory))
+  {
+    result[entry.path()] = fs::last_write_time(entry.path());
+  }
+  return result;
+}
+
+/// \brief Creates a compiled rewriter and checks that it rewrites f(x) to x.
+static void create_rewriter(const std::string& spec)
+{
+  data_specification data_spec = parse_data_specification(spec);
+  rewriter R(data_spec, jitty_compiling);
+  data_expression e = parse_data_expression("f(true)", data_spec);
+  BOOST_CHECK(R(e) == sort_bool::true_());
+}
+
+static const std::string spec1 =
+  "map f: Bool -> Bool;\n"
+  "var x: Bool;\n"
+  "eqn f(x) = x;\n";
+
+/// \brief Runs the test case test_jittyc_cache_in_other_process in a new process of this test, and returns
+///        whether it succeeded.
+static bool run_in_other_process()
+{
+  const pid_t pid = fork();
+  if (pid == 0)
+  {
+    char* const argv[] = { boost::unit_test::framework::master_test_suite().argv[0],
+                           const_cast<char*>("--run_test=test_jittyc_cache_in_other_process"),
+                           nullptr };
+    execv(argv[0], argv);
+    _exit(127);
+  }
+  int status = 0;
+  return pid > 0 && waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+// Only does something when it is started by test_jittyc_cache. Before creating the rewriter, other function
+// symbols are created, such that the function symbols of the specification have other indices than in the
+// process that stored the rewriter.
+BOOST_AUTO_TEST_CASE(test_jittyc_cache_in_other_process)
+{
+  if (std::getenv("MCRL2_JITTYC_CACHE_TEST_OTHER_PROCESS") == nullptr)
+  {
+    return;
+  }
+  data_specification data_spec = parse_data_specification(
+    "map h, i: Nat -> Bool;\n"
+    "var n: Nat;\n"
+    "eqn h(n) = n > 2;\n"
+    "    i(n) = n < 2;\n");
+  parse_data_expression("h(1) && i(3)", data_spec);
+  create_rewriter(spec1);
+}
+
+BOOST_AUTO_TEST_CASE(test_jittyc_cache)
+{
+  const std::string spec2 =
+    "map f, g: Bool -> Bool;\n"
+    "var x: Bool;\n"
+    "eqn f(x) = x;\n"
+    "    g(x) = !x;\n";
+
+  const fs::path directory = fs::temp_directory_path() / ("jittyc_cache_test_" + std::to_string(getpid()));
+  fs::remove_all(directory);
+  setenv("MCRL2_JITTYC_CACHE", directory.string().c_str(), 1);
+  setenv("MCRL2_JITTYC_CACHE_SIZE", "1", 1);
+
+  // A miss stores the generated code and the compiled rewriter.
+  create_rewriter(spec1);
+  const std::map<fs::path, fs::file_time_type> first = cache_contents(directory);
+  BOOST_CHECK_EQUAL(first.size(), 2u);
+
+  // A hit does not store the code again.
+  create_rewriter(spec1);
+  const std::map<fs::path, fs::file_time_type> second = cache_contents(directory);
+  BOOST_CHECK_EQUAL(second.size(), 2u);
+  for (const auto& [path, time]: first)
+  {
+    BOOST_CHECK(second.count(path) == 1);
+    if (path.extension() == ".cpp")
+    {
+      BOOST_CHECK(second.at(path) == time);
+    }
+  }
+
+  // Another process finds the rewriter as well, which shows that the key does not depend on the process.
+  setenv("MCRL2_JITTYC_CACHE_TEST_OTHER_PROCESS", "1", 1);
+  BOOST_CHECK(run_in_other_process());
+  unsetenv("MCRL2_JITTYC_CACHE_TEST_OTHER_PROCESS");
+  const std::map<fs::path, fs::file_time_type> other = cache_contents(directory);
+  BOOST_CHECK_EQUAL(other.size(), 2u);
+  for (const auto& [path, time]: first)
+  {
+    BOOST_CHECK(other.count(path) == 1);
+    if (path.extension() == ".cpp")
+    {
+      BOOST_CHECK(other.at(path) == time);
+    }
+  }
+
+  // A rewriter for another specification is a miss, which evicts the first rewriter from a cache of size one.
+  create_rewriter(spec2);
+  const std::map<fs::path, fs::file_time_type> third = cache_contents(directory);
+  BOOST_CHECK_EQUAL(third.size(), 2u);
+  for (const auto& entry: first)
+  {
+    BOOST_CHECK(third.count(entry.first) == 0);
+  }
+
+  // A cached rewriter of which the code does not match is not used, but compiled and stored again.
+  for (const auto& entry: third)
+  {
+    if (entry.first.extension() == ".cpp")
+    {
+      std::ofstream(entry.first) << "// Invalidated\n";
+    }
+  }
+  create_rewriter(spec2);
+  for (const auto& entry: cache_contents(directory))
+  {
+    if (entry.first.extension() == ".cpp")
+    {
+      std::ifstream in(entry.first);
+      std::string line;
+      std::getline(in, line);
+      BOOST_CHECK(line != "// Invalidated");
+    }
+  }
+
+  unsetenv("MCRL2_JITTYC_CACHE");
+  unsetenv("MCRL2_JITTYC_CACHE_SIZE");
+  fs::remove_all(directory);
+}
+
+#else // MCRL2_JITTYC_AVAILABLE
+
+BOOST_AUTO_TEST_CASE(test_jittyc_cache)
+{
+}
+
+#endif // MCRL2_JITTYC_AVAILABLE
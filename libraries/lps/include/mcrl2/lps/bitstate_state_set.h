@@ -0,0 +1,160 @@
+// Author(s): Wieger Wesselink
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/lps/bitstate_state_set.h
+/// \brief A set of states that only records the hash values of the states.
+
+#ifndef MCRL2_LPS_BITSTATE_STATE_SET_H
+#define MCRL2_LPS_BITSTATE_STATE_SET_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "mcrl2/lps/state.h"
+#include "mcrl2/utilities/hash_utility.h"
+
+namespace mcrl2 {
+
+namespace lps {
+
+/// \brief A set of states that uses bitstate hashing.
+/// \details Every state is mapped to a number of positions in a table of bits, and a state is considered to be in
+/// the set if all of its bits are set. Hence the memory usage does not depend on the number of states, but a new state
+/// may wrongly be considered to be in the set, in which case it is not explored. Different seeds result in independent
+/// hash functions, such that different explorations miss different states.
+class bitstate_state_set
+{
+  protected:
+    std::vector<std::uint64_t> m_bits;
+    std::size_t m_size;     // the number of bits
+    std::uint64_t m_seed;
+    std::size_t m_count = 0;     // the number of states that were inserted
+    std::size_t m_bits_set = 0;
+
+    // Caches the hash values of subterms. The cache is bounded, and since its keys are protected the addresses of
+    // the cached terms cannot be reused by other terms.
+    std::unordered_map<atermpp::aterm, std::size_t> m_hash_cache;
+    static constexpr std::size_t max_hash_cache_size = 1 << 16;
+
+    static std::uint64_t mix(std::uint64_t x)
+    {
+      // The finalizer of splitmix64.
+      x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+      return x ^ (x >> 31);
+    }
+
+    // Returns a hash value of x that depends only on the structure of x. The hash function of terms cannot be used,
+    // since it is based on addresses, and the address of a state that is not kept in memory may be reused by another
+    // state.
+    std::size_t structural_hash(const atermpp::aterm& x)
+    {
+      if (x.type_is_int())
+      {
+        return mix(atermpp::down_cast<atermpp::aterm_int>(x).value());
+      }
+      auto i = m_hash_cache.find(x);
+      if (i != m_hash_cache.end())
+      {
+        return i->second;
+      }
+      const atermpp::aterm_appl& x_ = atermpp::down_cast<atermpp::aterm_appl>(x);
+      std::size_t result = std::hash<std::string>()(x_.function().name()) + x_.size();
+      for (const atermpp::aterm& arg: x_)
+      {
+        result = utilities::detail::hash_combine(result, mix(structural_hash(arg)));
+      }
+      if (m_hash_cache.size() >= max_hash_cache_size)
+      {
+        m_hash_cache.clear();
+      }
+      m_hash_cache.emplace(x, result);
+      return result;
+    }
+
+  public:
+    /// \brief The number of bits that is set for each state.
+    static constexpr std::size_t number_of_hash_functions = 3;
+
+    /// \brief Value returned by index, since the set cannot retrieve the index of a state.
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    /// \brief Constructor.
+    /// \param size The number of bits in the table.
+    /// \param seed The seed of the hash functions.
+    explicit bitstate_state_set(std::size_t size = 64, std::size_t seed = 0)
+      : m_bits((std::max(size, std::size_t(64)) + 63) / 64, 0),
+        m_size(m_bits.size() * 64),
+        m_seed(mix(seed + 0x9e3779b97f4a7c15ULL))
+    {}
+
+    /// \brief Inserts a state in the set.
+    /// \return If the state is new, its index and true, and otherwise npos and false.
+    std::pair<std::size_t, bool> insert(const state& s)
+    {
+      std::uint64_t h1 = mix(structural_hash(s) ^ m_seed);
+      std::uint64_t h2 = mix(h1) | 1;
+      bool is_new = false;
+      for (std::size_t i = 0; i < number_of_hash_functions; ++i)
+      {
+        std::size_t position = (h1 + i * h2) % m_size;
+        std::uint64_t mask = std::uint64_t(1) << (position % 64);
+        std::uint64_t& word = m_bits[position / 64];
+        if ((word & mask) == 0)
+        {
+          word |= mask;
+          ++m_bits_set;
+          is_new = true;
+        }
+      }
+      return is_new ? std::make_pair(m_count++, true) : std::make_pair(npos, false);
+    }
+
+    /// \brief Returns the number of states that were inserted.
+    std::size_t size() const
+    {
+      return m_count;
+    }
+
+    /// \brief Returns the number of bits in the table.
+    std::size_t table_size() const
+    {
+      return m_size;
+    }
+
+    /// \brief Returns the fraction of the bits that are set.
+    double fill_ratio() const
+    {
+      return static_cast<double>(m_bits_set) / m_size;
+    }
+
+    /// \brief Returns the probability that a state that is not in the set is considered to be in the set.
+    /// \details This is the current probability, which is an upper bound of the probability of the earlier insertions.
+    double omission_probability() const
+    {
+      return std::pow(fill_ratio(), number_of_hash_functions);
+    }
+
+    void clear()
+    {
+      std::fill(m_bits.begin(), m_bits.end(), 0);
+      m_count = 0;
+      m_bits_set = 0;
+      m_hash_cache.clear();
+    }
+};
+
+} // namespace lps
+
+} // namespace mcrl2
+
+#endif // MCRL2_LPS_BITSTATE_STATE_SET_H
@@ -17,7 +17,10 @@
 
 #include "mcrl2/lps/disjointness_checker.h"
 #include "mcrl2/lps/invariant_checker.h"
+#include <atomic>
+#include <deque>
 #include <iomanip>
+#include <thread>
 
 
 /** \brief A class that takes a linear process specification and checks all tau-summands of that LPS for confluence.
@@ -115,6 +118,12 @@
     condition is an invariant of the LPS passed as parameter a_lps. If the reduced confluence condition is an invariant,
     the two summands are confluent.
 
+    If the parameter a_number_of_threads is larger than one, the confluence conditions of a tau-summand with all other
+    summands are proven by a pool of a_number_of_threads workers, each with its own prover. The results are reported,
+    and invariants are checked, in the order of the summands, so the output and the resulting LPS do not depend on the
+    number of threads. This requires a toolset that is built with MCRL2_ENABLE_MULTITHREADING; otherwise a single thread is
+    used.
+
     The function Confluence_Checker::check_confluence_and_mark returns an LPS with all tau-actions of confluent
     tau-summands renamed to ctau, unless the parameter a_no_marking is set to true. In case the parameter a_no_marking
     was set to true, the confluent tau-summands will not be marked, only the results of the confluence checking will be
@@ -209,20 +218,44 @@ class Confluence_Checker
     /// \brief Identifier generator to allow variables to be uniquely renamed.
     data::set_identifier_generator f_set_identifier_generator;
 
-    /// \brief Writes a dot file of the BDD created when checking the confluence of summands a_summand_number_1 and a_summand_number_2.
-    void save_dot_file(std::size_t a_summand_number_1, std::size_t a_summand_number_2);
+    /// \brief The number of workers that prove confluence conditions.
+    std::size_t f_number_of_threads;
+
+    /// \brief The provers of the workers other than the calling thread, which uses f_bdd_prover.
+    std::deque<data::detail::BDD_Prover> f_worker_bdd_provers;
+
+    /// \brief The outcome of proving the confluence condition of two summands.
+    struct proof_result
+    {
+      /// \brief '+' if the condition is a tautology, '-' if it is not and '?' if it has not been proven.
+      char verdict = '?';
+
+      /// \brief The BDD of the condition, if it is not a tautology.
+      data::data_expression bdd;
+
+      /// \brief A valuation for which the condition does not hold, if counter examples are requested.
+      data::data_expression counter_example;
+    };
+
+    /// \brief Writes a dot file of the BDD a_bdd created when checking the confluence of summands a_summand_number_1 and a_summand_number_2.
+    void save_dot_file(const data::data_expression& a_bdd, std::size_t a_summand_number_1, std::size_t a_summand_number_2);
 
     /// \brief Outputs a path in the BDD corresponding to the condition at hand that leads to a node labelled false.
-    void print_counter_example();
+    void print_counter_example(const proof_result& a_result);
+
+    /// \brief Proves the confluence condition a_condition with the prover of worker a_worker.
+    proof_result prove_condition(const data::data_expression& a_condition, const std::size_t a_worker);
 
-    /// \brief Checks the confluence of summand a_summand_1 and a_summand_2
+    /// \brief Proves the conditions in a_conditions using f_number_of_threads workers. If not all summands are
+    /// \brief checked, conditions after the first condition that cannot be proven are skipped.
+    std::vector<proof_result> prove_conditions(const std::vector<data::data_expression>& a_conditions);
+
+    /// \brief Checks the confluence of summand a_summand_number_1 and a_summand_number_2, given the result
+    /// \brief a_result of proving their confluence condition.
     bool check_summands(
-      const data::data_expression& a_invariant,
-      const action_summand_type a_summand_1,
+      const proof_result& a_result,
       const std::size_t a_summand_number_1,
-      const action_summand_type a_summand_2,
-      const std::size_t a_summand_number_2,
-      const char a_condition_type);
+      const std::size_t a_summand_number_2);
 
     /// \brief Checks and updates the confluence of summand a_summand concerning all other tau-summands.
     void check_confluence_and_mark_summand(
@@ -255,7 +288,8 @@ class Confluence_Checker
       std::string a_conditions = "c",
       bool a_counter_example = false,
       bool a_generate_invariants = false,
-      std::string const& a_dot_file_name = std::string()
+      std::string const& a_dot_file_name = std::string(),
+      std::size_t a_number_of_threads = 1
     );
 
     /// \brief Check the confluence of the LPS Confluence_Checker::f_lps.
@@ -571,23 +605,22 @@ bool has_ctau_action(const Specification& a_lps)
 // Class Confluence_Checker - Functions declared private ----------------------------------------
 
 template <typename Specification>
-void Confluence_Checker<Specification>::save_dot_file(std::size_t a_summand_number_1, std::size_t a_summand_number_2)
+void Confluence_Checker<Specification>::save_dot_file(const data::data_expression& a_bdd, std::size_t a_summand_number_1, std::size_t a_summand_number_2)
 {
   if (!f_dot_file_name.empty())
   {
-    f_bdd2dot.output_bdd(f_bdd_prover.get_bdd(), f_dot_file_name + "-" + std::to_string(a_summand_number_1) + "-" + std::to_string(a_summand_number_2) + ".dot");
+    f_bdd2dot.output_bdd(a_bdd, f_dot_file_name + "-" + std::to_string(a_summand_number_1) + "-" + std::to_string(a_summand_number_2) + ".dot");
   }
 }
 
 // --------------------------------------------------------------------------------------------
 
 template <typename Specification>
-void Confluence_Checker<Specification>::print_counter_example()
+void Confluence_Checker<Specification>::print_counter_example(const proof_result& a_result)
 {
   if (f_counter_example)
   {
-    const data::data_expression v_counter_example(f_bdd_prover.get_counter_example());
-    mCRL2log(log::info) << "  Counter example: " << v_counter_example << "\n";
+    mCRL2log(log::info) << "  Counter example: " << a_result.counter_example << "\n";
   }
 }
 
@@ -663,79 +696,137 @@ void Confluence_Checker<Specification>::uniquely_rename_summutation_variables(
 // --------------------------------------------------------------------------------------------
 
 template <typename Specification>
-bool Confluence_Checker<Specification>::check_summands(
-  const data::data_expression& a_invariant,
-  const action_summand_type a_summand_1,
-  const std::size_t a_summand_number_1,
-  const action_summand_type a_summand_2,
-  const std::size_t a_summand_number_2,
-  const char a_condition_type)
+typename Confluence_Checker<Specification>::proof_result Confluence_Checker<Specification>::prove_condition(
+  const data::data_expression& a_condition,
+  const std::size_t a_worker)
 {
-  assert(a_summand_1.is_tau());
+  data::detail::BDD_Prover& v_bdd_prover = (a_worker == 0 ? f_bdd_prover : f_worker_bdd_provers[a_worker - 1]);
+  proof_result v_result;
 
-  const data::variable_list v_variables = f_lps.process().process_parameters();
-  bool v_is_confluent = true;
+  v_bdd_prover.set_formula(a_condition);
+  if (v_bdd_prover.is_tautology() == data::detail::answer_yes)
+  {
+    v_result.verdict = '+';
+    return v_result;
+  }
 
-  if ((a_condition_type == 'c' || a_condition_type == 'd') && f_disjointness_checker.disjoint(a_summand_number_1, a_summand_number_2))
+  v_result.verdict = '-';
+  v_result.bdd = v_bdd_prover.get_bdd();
+  if (f_counter_example)
   {
-    mCRL2log(log::info) << ":";
+    v_result.counter_example = v_bdd_prover.get_counter_example();
   }
-  else
+  return v_result;
+}
+
+// --------------------------------------------------------------------------------------------
+
+template <typename Specification>
+std::vector<typename Confluence_Checker<Specification>::proof_result> Confluence_Checker<Specification>::prove_conditions(
+  const std::vector<data::data_expression>& a_conditions)
+{
+  std::vector<proof_result> v_results(a_conditions.size());
+  const std::size_t v_number_of_workers = std::max<std::size_t>(1, std::min(f_number_of_threads, a_conditions.size()));
+
+  // The conditions are handed out in order. Once a condition cannot be proven, the later conditions are only needed
+  // if all summands are checked. The caller proves skipped conditions that turn out to be needed after all, which
+  // happens if an invariant shows that the summands are confluent.
+  std::atomic<std::size_t> v_next(0);
+  std::atomic<std::size_t> v_first_failure(a_conditions.size());
+  std::vector<std::exception_ptr> v_errors(v_number_of_workers);
+
+  auto v_work = [&](const std::size_t a_worker)
   {
-    action_summand_type tagged = a_summand_2;
+    try
+    {
+      for (std::size_t i = v_next++; i < a_conditions.size() && (f_check_all || i < v_first_failure); i = v_next++)
+      {
+        // Leaving the shared section after every condition gives the garbage collector a safepoint.
+        atermpp::shared_guard v_guard;
+        v_results[i] = prove_condition(a_conditions[i], a_worker);
+        if (v_results[i].verdict == '-')
+        {
+          std::size_t v_failure = v_first_failure;
+          while (i < v_failure && !v_first_failure.compare_exchange_weak(v_failure, i))
+          {}
+        }
+      }
+    }
+    catch (...)
+    {
+      v_errors[a_worker] = std::current_exception();
+    }
+  };
 
-    if (!f_no_sums)
+  std::vector<std::thread> v_threads;
+  for (std::size_t v_worker = 1; v_worker < v_number_of_workers; ++v_worker)
+  {
+    v_threads.emplace_back(v_work, v_worker);
+  }
+  v_work(0);
+  for (std::thread& v_thread: v_threads)
+  {
+    v_thread.join();
+  }
+
+  for (const std::exception_ptr& v_error: v_errors)
+  {
+    if (v_error)
     {
-      uniquely_rename_summutation_variables(tagged);
+      std::rethrow_exception(v_error);
     }
+  }
+  return v_results;
+}
+
+// --------------------------------------------------------------------------------------------
 
-    const data::data_expression v_condition = get_confluence_condition(a_invariant, a_summand_1, tagged, v_variables, a_condition_type);
-    f_bdd_prover.set_formula(v_condition);
-    if (f_bdd_prover.is_tautology() == data::detail::answer_yes)
+template <typename Specification>
+bool Confluence_Checker<Specification>::check_summands(
+  const proof_result& a_result,
+  const std::size_t a_summand_number_1,
+  const std::size_t a_summand_number_2)
+{
+  assert(a_result.verdict != '?');
+  bool v_is_confluent = true;
+
+  if (a_result.verdict == '+')
+  {
+    mCRL2log(log::info) << "+";
+  }
+  else
+  {
+    if (f_generate_invariants)
     {
-      mCRL2log(log::info) << "+";
+      mCRL2log(log::verbose) << "\nChecking invariant: " << data::pp(a_result.bdd) << "\n";
+      if (f_invariant_checker.check_invariant(a_result.bdd))
+      {
+        mCRL2log(log::verbose) << "Invariant holds" << std::endl;
+        mCRL2log(log::info) << "i";
+      }
+      else
+      {
+        mCRL2log(log::verbose) << "Invariant doesn't hold" << std::endl;
+        v_is_confluent = false;
+      }
     }
     else
     {
-      if (f_generate_invariants)
+      v_is_confluent = false;
+    }
+
+    if (!v_is_confluent)
+    {
+      if (f_check_all)
       {
-        const data::data_expression v_new_invariant(f_bdd_prover.get_bdd());
-        mCRL2log(log::verbose) << "\nChecking invariant: " << data::pp(v_new_invariant) << "\n";
-        if (f_invariant_checker.check_invariant(v_new_invariant))
-        {
-          mCRL2log(log::verbose) << "Invariant holds" << std::endl;
-          mCRL2log(log::info) << "i";
-        }
-        else
-        {
-          mCRL2log(log::verbose) << "Invariant doesn't hold" << std::endl;
-          v_is_confluent = false;
-          if (f_check_all)
-          {
-            mCRL2log(log::info) << "-";
-          }
-          else
-          {
-            mCRL2log(log::info) << "Not confluent with summand " << a_summand_number_2 << ".";
-          }
-          print_counter_example();
-          save_dot_file(a_summand_number_1, a_summand_number_2);
-        }
+        mCRL2log(log::info) << "-";
       }
       else
       {
-        v_is_confluent = false;
-        if (f_check_all)
-        {
-          mCRL2log(log::info) << "-";
-        }
-        else
-        {
-          mCRL2log(log::info) << "Not confluent with summand " << a_summand_number_2 << ".";
-        }
-        print_counter_example();
-        save_dot_file(a_summand_number_1, a_summand_number_2);
+        mCRL2log(log::info) << "Not confluent with summand " << a_summand_number_2 << ".";
       }
+      print_counter_example(a_result);
+      save_dot_file(a_result.bdd, a_summand_number_1, a_summand_number_2);
     }
   }
   return v_is_confluent;
@@ -751,10 +842,9 @@ void Confluence_Checker<Specification>::check_confluence_and_mark_summand(
   const char a_condition_type,
   bool& a_is_marked)
 {
-  typedef typename Specification::process_type::action_summand_type action_summand_type;
   assert(a_summand.is_tau());
-  std::vector<action_summand_type>& v_summands = f_lps.process().action_summands();
-  std::size_t v_summand_number = 1;
+  const action_summand_vector_type& v_summands = f_lps.process().action_summands();
+  const data::variable_list v_variables = f_lps.process().process_parameters();
   bool v_is_confluent = true;
 
   // Add here that the sum variables of a_summand must be empty otherwise
@@ -772,41 +862,98 @@ void Confluence_Checker<Specification>::check_confluence_and_mark_summand(
     }
   }
 
-  for (typename std::vector<action_summand_type>::const_iterator i=v_summands.begin(); i!=v_summands.end() && (v_is_confluent || f_check_all); ++i)
+  // Summands that are disjoint from a_summand are confluent with it, without a proof.
+  auto v_is_disjoint = [&](const std::size_t a_summand_number_2)
+  {
+    return (a_condition_type == 'c' || a_condition_type == 'd') && f_disjointness_checker.disjoint(a_summand_number, a_summand_number_2);
+  };
+  auto v_condition = [&](const std::size_t a_summand_number_2)
+  {
+    action_summand_type tagged = v_summands[a_summand_number_2 - 1];
+    if (!f_no_sums)
+    {
+      uniquely_rename_summutation_variables(tagged);
+    }
+    return get_confluence_condition(a_invariant, a_summand, tagged, v_variables, a_condition_type);
+  };
+
+  // With more than one thread, the confluence conditions of the summands for which neither the cache nor the
+  // disjointness check settles confluence are generated up front, and proven in parallel. The condition of summand
+  // number n is v_conditions[v_condition_index[n - 1]]; summands without a condition have index v_summands.size().
+  // With a single thread, every condition is generated when it is proven, such that no conditions are generated
+  // beyond the first summand that is not confluent.
+  std::vector<data::data_expression> v_conditions;
+  std::vector<std::size_t> v_condition_index(v_summands.size(), v_summands.size());
+  std::vector<proof_result> v_results;
+
+  if (f_number_of_threads > 1)
+  {
+    for (std::size_t v_summand_number = 1; v_summand_number <= v_summands.size() && (v_is_confluent || f_check_all); ++v_summand_number)
+    {
+      if (v_summand_number < a_summand_number && f_intermediate[v_summand_number] >= a_summand_number)
+      {
+        if (f_intermediate[v_summand_number] == a_summand_number && !f_check_all)
+        {
+          // The cache shows that this summand is not confluent with a_summand, so checking stops here.
+          break;
+        }
+      }
+      else if (!v_is_disjoint(v_summand_number))
+      {
+        v_condition_index[v_summand_number - 1] = v_conditions.size();
+        v_conditions.push_back(v_condition(v_summand_number));
+      }
+    }
+    v_results = prove_conditions(v_conditions);
+  }
+
+  // Report the results in the order of the summands.
+  std::size_t v_summand_number = 1;
+  while (v_summand_number <= v_summands.size() && (v_is_confluent || f_check_all))
   {
-    const action_summand_type v_summand = *i;
+    const std::size_t v_index = v_condition_index[v_summand_number - 1];
 
-    if (v_summand_number < a_summand_number)
+    if (v_summand_number < a_summand_number && f_intermediate[v_summand_number] > a_summand_number)
     {
       // Check the cache
-      if (f_intermediate[v_summand_number] > a_summand_number)
+      mCRL2log(log::info) << ".";
+    }
+    else if (v_summand_number < a_summand_number && f_intermediate[v_summand_number] == a_summand_number)
+    {
+      if (f_check_all)
       {
-        mCRL2log(log::info) << ".";
+        mCRL2log(log::info) << "-";
       }
       else
       {
-        if (f_intermediate[v_summand_number] == a_summand_number)
-        {
-          if (f_check_all)
-          {
-            mCRL2log(log::info) << "-";
-          }
-          else
-          {
-            mCRL2log(log::info) << "Not confluent with summand " << v_summand_number << ".";
-          }
-          v_is_confluent = false;
-        }
-        else
-        {
-          v_is_confluent &= check_summands(a_invariant, a_summand, a_summand_number, v_summand, v_summand_number, a_condition_type);
-        }
+        mCRL2log(log::info) << "Not confluent with summand " << v_summand_number << ".";
+      }
+      v_is_confluent = false;
+    }
+    else if (f_number_of_threads == 1)
+    {
+      if (v_is_disjoint(v_summand_number))
+      {
+        mCRL2log(log::info) << ":";
+      }
+      else
+      {
+        v_is_confluent &= check_summands(prove_condition(v_condition(v_summand_number), 0), a_summand_number, v_summand_number);
       }
     }
+    else if (v_index == v_summands.size())
+    {
+      mCRL2log(log::info) << ":";
+    }
     else
     {
-      v_is_confluent &= check_summands(a_invariant, a_summand, a_summand_number, v_summand, v_summand_number, a_condition_type);
+      if (v_results[v_index].verdict == '?')
+      {
+        v_results[v_index] = prove_condition(v_conditions[v_index], 0);
+      }
+      v_is_confluent &= check_summands(v_results[v_index], a_summand_number, v_summand_number);
     }
+
     if (v_is_confluent || f_check_all)
     {
       // Only increase number if we will continue
@@ -842,7 +989,8 @@ Confluence_Checker<Specification>::Confluence_Checker(
   std::string a_conditions,
   bool a_counter_example,
   bool a_generate_invariants,
-  std::string const& a_dot_file_name):
+  std::string const& a_dot_file_name,
+  std::size_t a_number_of_threads):
   f_disjointness_checker(a_lps.process()),
   f_invariant_checker(a_lps, a_rewrite_strategy, a_time_limit, a_path_eliminator, a_solver_type, false, false, 0),
   f_bdd_prover(a_lps.data(), data::used_data_equation_selector(a_lps.data()), a_rewrite_strategy,
@@ -853,7 +1001,8 @@ Confluence_Checker<Specification>::Confluence_Checker(
   f_conditions(a_conditions),
   f_counter_example(a_counter_example),
   f_dot_file_name(a_dot_file_name),
-  f_generate_invariants(a_generate_invariants)
+  f_generate_invariants(a_generate_invariants),
+  f_number_of_threads(atermpp::detail::GlobalThreadSafe ? std::max<std::size_t>(1, a_number_of_threads) : 1)
 {
   if (has_ctau_action(a_lps))
   {
@@ -876,6 +1025,12 @@ Confluence_Checker<Specification>::Confluence_Checker(
       throw mcrl2::runtime_error(msg);
     }
   }
+
+  for (std::size_t i = 1; i < f_number_of_threads; ++i)
+  {
+    f_worker_bdd_provers.emplace_back(a_lps.data(), data::used_data_equation_selector(a_lps.data()), a_rewrite_strategy,
+                                      a_time_limit, a_path_eliminator, a_solver_type, a_apply_induction);
+  }
 }
 
 // --------------------------------------------------------------------------------------------
@@ -12,10 +12,21 @@
 #ifndef MCRL2_LPS_EXPLORER_H
 #define MCRL2_LPS_EXPLORER_H
 
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <mutex>
 #include <random>
+#include <sstream>
+#include <thread>
+#include "mcrl2/atermpp/aterm_io_binary.h"
+#include "mcrl2/atermpp/detail/global_aterm_pool.h"
 #include "mcrl2/data/consistency.h"
+#include "mcrl2/data/enumeration_cache.h"
 #include "mcrl2/data/enumerator.h"
 #include "mcrl2/data/substitution_utility.h"
+#include "mcrl2/lps/bitstate_state_set.h"
 #include "mcrl2/lps/detail/instantiate_global_variables.h"
 #include "mcrl2/lps/explorer_options.h"
 #include "mcrl2/lps/find_representative.h"
@@ -24,7 +35,10 @@
 #include "mcrl2/lps/replace_constants_by_variables.h"
 #include "mcrl2/lps/resolve_name_clashes.h"
 #include "mcrl2/lps/stochastic_state.h"
+#include "mcrl2/lps/tree_compressed_state_set.h"
+#include "mcrl2/utilities/concurrent_indexed_set.h"
 #include "mcrl2/utilities/detail/io.h"
+#include "mcrl2/utilities/logger.h"
 #include "mcrl2/utilities/skip.h"
 
 namespace mcrl2::lps {
@@ -56,6 +70,8 @@ class todo_set
     std::deque<state> todo;
 
   public:
+    todo_set() = default;
+
     explicit todo_set(const state& init)
       : todo{init}
     {}
@@ -74,12 +90,12 @@ class todo_set
     virtual void finish_state()
     { }
 
-    bool empty() const
+    virtual bool empty() const
     {
       return todo.empty();
     }
 
-    std::size_t size() const
+    virtual std::size_t size() const
     {
       return todo.size();
     }
@@ -110,6 +126,148 @@ class breadth_first_todo_set : public todo_set
     }
 };
 
+/// \brief A breadth first todo set that stores states on disk when it becomes too large.
+/// \details The states are kept in memory as long as there are less than max_states of them. After that, newly
+/// inserted states are collected in batches that are written to temporary files in the binary aterm format. When the
+/// states in memory have been processed, the oldest batch is read back. The contents of the next batch are read from
+/// disk in the background while the current batch is being processed. Note that states that are stored in the set of
+/// discovered states remain in memory anyway, so this only reduces the memory usage if tree compression is used.
+class disk_breadth_first_todo_set : public todo_set
+{
+  protected:
+    std::size_t m_max_states;
+    std::size_t m_batch_size;
+    std::deque<state> m_tail;           // the most recently inserted states, that come after the batches
+    std::deque<std::string> m_batches;  // the files that contain the batches, the oldest first
+    std::size_t m_disk_size = 0;        // the number of states in the batches
+    std::size_t m_batch_count = 0;
+    std::string m_filename_prefix;
+    std::future<std::string> m_prefetched; // the contents of m_batches.front(), if valid
+
+    static std::string read_file(const std::string& filename)
+    {
+      std::ifstream in(filename, std::ios::binary);
+      return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    void prefetch()
+    {
+      if (!m_prefetched.valid() && !m_batches.empty())
+      {
+        m_prefetched = std::async(std::launch::async, read_file, m_batches.front());
+      }
+    }
+
+    void write_batch()
+    {
+      std::string filename = m_filename_prefix + std::to_string(m_batch_count++);
+      std::ofstream out(filename, std::ios::binary);
+      {
+        atermpp::binary_aterm_ostream stream(out);
+        for (const state& s: m_tail)
+        {
+          stream << s;
+        }
+      }
+      out.close();
+      if (out.fail())
+      {
+        std::remove(filename.c_str());
+        throw mcrl2::runtime_error("Could not write the todo list to file " + filename + ".");
+      }
+      mCRL2log(log::debug) << "wrote " << m_tail.size() << " states of the todo list to " << filename << std::endl;
+      m_disk_size += m_tail.size();
+      m_tail.clear();
+      m_batches.push_back(filename);
+      prefetch();
+    }
+
+    void read_batch()
+    {
+      prefetch();
+      std::istringstream in(m_prefetched.get());
+      std::remove(m_batches.front().c_str());
+      m_batches.pop_front();
+      prefetch();
+
+      atermpp::binary_aterm_istream stream(in);
+      for (atermpp::aterm t = stream.get(); t.defined(); t = stream.get())
+      {
+        todo.push_back(atermpp::down_cast<state>(t));
+      }
+      m_disk_size -= todo.size();
+    }
+
+  public:
+    template<typename ForwardIterator>
+    disk_breadth_first_todo_set(ForwardIterator first, ForwardIterator last, std::size_t max_states)
+      : todo_set(first, last),
+        m_max_states(std::max(max_states, std::size_t(2))),
+        m_batch_size(m_max_states / 2)
+    {
+      std::random_device device;
+      m_filename_prefix = (std::filesystem::temp_directory_path() / ("mcrl2_todo_" + std::to_string(device()) + "_")).string();
+    }
+
+    disk_breadth_first_todo_set(const state& init, std::size_t max_states)
+      : disk_breadth_first_todo_set(&init, &init + 1, max_states)
+    {}
+
+    ~disk_breadth_first_todo_set() override
+    {
+      if (m_prefetched.valid())
+      {
+        m_prefetched.wait();
+      }
+      for (const std::string& filename: m_batches)
+      {
+        std::remove(filename.c_str());
+      }
+    }
+
+    state choose_element() override
+    {
+      if (todo.empty())
+      {
+        if (!m_batches.empty())
+        {
+          read_batch();
+        }
+        else
+        {
+          std::swap(todo, m_tail);
+        }
+      }
+      auto s = todo.front();
+      todo.pop_front();
+      return s;
+    }
+
+    void insert(const state& s) override
+    {
+      if (m_batches.empty() && m_tail.empty() && todo.size() < m_max_states)
+      {
+        todo.push_back(s);
+        return;
+      }
+      m_tail.push_back(s);
+      if (m_tail.size() >= m_batch_size)
+      {
+        write_batch();
+      }
+    }
+
+    bool empty() const override
+    {
+      return todo.empty() && m_batches.empty() && m_tail.empty();
+    }
+
+    std::size_t size() const override
+    {
+      return todo.size() + m_disk_size + m_tail.size();
+    }
+};
+
 class depth_first_todo_set : public todo_set
 {
   public:
@@ -202,6 +360,280 @@ class highway_todo_set : public todo_set
     }
 };
 
+// A todo set that is shared by the workers of the parallel exploration. Every worker inserts the states
+// that it discovers into its own queue, and takes states from its own queue first. A worker with an
+// empty queue steals the oldest state of another queue.
+class work_stealing_todo_set
+{
+  protected:
+    struct queue
+    {
+      std::deque<state> todo;
+      std::mutex mutex;
+    };
+
+    std::vector<queue> m_queues;
+    bool m_depth_first;
+
+    // The number of states in the queues.
+    std::atomic<std::size_t> m_size{0};
+
+    // The number of states that have been inserted, but have not been finished yet.
+    std::atomic<std::size_t> m_pending{0};
+
+    bool steal(std::size_t worker, state& s)
+    {
+      for (std::size_t i = 1; i < m_queues.size(); i++)
+      {
+        queue& q = m_queues[(worker + i) % m_queues.size()];
+        std::lock_guard<std::mutex> guard(q.mutex);
+        if (!q.todo.empty())
+        {
+          s = q.todo.front();
+          q.todo.pop_front();
+          return true;
+        }
+      }
+      return false;
+    }
+
+  public:
+    work_stealing_todo_set(std::size_t number_of_workers, bool depth_first)
+      : m_queues(number_of_workers),
+        m_depth_first(depth_first)
+    {}
+
+    void insert(std::size_t worker, const state& s)
+    {
+      queue& q = m_queues[worker];
+      std::lock_guard<std::mutex> guard(q.mutex);
+      q.todo.push_back(s);
+      ++m_pending;
+      ++m_size;
+    }
+
+    // Assigns a state to s and returns true, or returns false if no state is available at the moment.
+    bool choose_element(std::size_t worker, state& s)
+    {
+      bool found = false;
+      {
+        queue& q = m_queues[worker];
+        std::lock_guard<std::mutex> guard(q.mutex);
+        if (!q.todo.empty())
+        {
+          if (m_depth_first)
+          {
+            s = q.todo.back();
+            q.todo.pop_back();
+          }
+          else
+          {
+            s = q.todo.front();
+            q.todo.pop_front();
+          }
+          found = true;
+        }
+      }
+      found = found || steal(worker, s);
+      if (found)
+      {
+        --m_size;
+      }
+      return found;
+    }
+
+    // Must be called after the successors of a chosen state have been inserted.
+    void finish_state()
+    {
+      --m_pending;
+    }
+
+    // Returns true if all inserted states have been finished, in which case no more states can appear.
+    bool finished() const
+    {
+      return m_pending == 0;
+    }
+
+    std::size_t size() const
+    {
+      return m_size;
+    }
+};
+
+/// \brief The set of discovered states of the explorer. Assigns consecutive indices to the states.
+/// \details The states are either stored as terms, using tree compression (see tree_compressed_state_set), or
+/// using bitstate hashing (see bitstate_state_set). In the latter case states cannot be retrieved, and the index
+/// of a state is only known when it is inserted for the first time.
+/// After enable_concurrent_access() the functions insert, index and operator[] can be called by multiple threads.
+/// States that are stored as terms are then kept in a concurrent_indexed_set, which does not require a lock,
+/// whereas the tree compressed and bitstate storages are protected by a mutex.
+class discovered_state_set
+{
+  protected:
+    enum class storage { terms, concurrent_terms, tree_compression, bitstate };
+
+    utilities::indexed_set<state> m_states;
+    std::unique_ptr<utilities::concurrent_indexed_set<state>> m_concurrent_states;
+    tree_compressed_state_set m_compressed_states;
+    bitstate_state_set m_bitstate_states;
+    storage m_storage = storage::terms;
+    bool m_concurrent = false;
+    mutable std::mutex m_mutex;
+
+    // Locks m_mutex if the set can be accessed by multiple threads.
+    std::unique_lock<std::mutex> lock() const
+    {
+      return m_concurrent ? std::unique_lock<std::mutex>(m_mutex) : std::unique_lock<std::mutex>();
+    }
+
+  public:
+    static constexpr std::size_t npos = utilities::indexed_set<state>::npos;
+
+    discovered_state_set() = default;
+
+    explicit discovered_state_set(const explorer_options& options)
+    {
+      if (options.bitstate_size > 0)
+      {
+        m_storage = storage::bitstate;
+        m_bitstate_states = bitstate_state_set(options.bitstate_size, options.bitstate_seed);
+      }
+      else if (options.tree_compression)
+      {
+        m_storage = storage::tree_compression;
+      }
+    }
+
+    /// \brief Allows the set to be accessed by multiple threads. Must be called while the set is empty.
+    void enable_concurrent_access()
+    {
+      m_concurrent = true;
+      if (m_storage == storage::terms)
+      {
+        m_storage = storage::concurrent_terms;
+        m_concurrent_states = std::make_unique<utilities::concurrent_indexed_set<state>>();
+      }
+    }
+
+    std::pair<std::size_t, bool> insert(const state& s)
+    {
+      switch (m_storage)
+      {
+        case storage::concurrent_terms: return m_concurrent_states->insert(s);
+        case storage::tree_compression: { auto guard = lock(); return m_compressed_states.insert(s); }
+        case storage::bitstate: { auto guard = lock(); return m_bitstate_states.insert(s); }
+        default: return m_states.insert(s);
+      }
+    }
+
+    /// \brief Returns the index of the given state, or npos if it is not in the set. With bitstate hashing the
+    /// result is always npos.
+    std::size_t index(const state& s) const
+    {
+      switch (m_storage)
+      {
+        case storage::concurrent_terms: return m_concurrent_states->index(s);
+        case storage::tree_compression: { auto guard = lock(); return m_compressed_states.index(s); }
+        case storage::bitstate: return npos;
+        default: return m_states.index(s);
+      }
+    }
+
+    /// \brief Returns the state with the given index. If tree compression is used, the state is reconstructed.
+    state operator[](std::size_t index) const
+    {
+      switch (m_storage)
+      {
+        case storage::concurrent_terms: return (*m_concurrent_states)[index];
+        case storage::tree_compression: { auto guard = lock(); return m_compressed_states[index]; }
+        case storage::bitstate: throw mcrl2::runtime_error("The states cannot be retrieved when bitstate hashing is used.");
+        default: return m_states[index];
+      }
+    }
+
+    std::size_t size() const
+    {
+      switch (m_storage)
+      {
+        case storage::concurrent_terms: return m_concurrent_states->size();
+        case storage::tree_compression: return m_compressed_states.size();
+        case storage::bitstate: return m_bitstate_states.size();
+        default: return m_states.size();
+      }
+    }
+
+    void clear()
+    {
+      m_states.clear();
+      if (m_concurrent_states)
+      {
+        m_concurrent_states->clear();
+      }
+      m_compressed_states.clear();
+      m_bitstate_states.clear();
+    }
+
+    bool tree_compression() const
+    {
+      return m_storage == storage::tree_compression;
+    }
+
+    bool bitstate() const
+    {
+      return m_storage == storage::bitstate;
+    }
+
+    const tree_compressed_state_set& compressed_states() const
+    {
+      return m_compressed_states;
+    }
+
+    const bitstate_state_set& bitstate_states() const
+    {
+      return m_bitstate_states;
+    }
+};
+
+/// \brief A breadth first todo set for states that are stored using tree compression.
+/// \details In breadth first search the states are explored in the order in which they are discovered. So the
+/// todo set consists of the discovered states from index m_next onwards, which are reconstructed when they are
+/// chosen. Unlike the other todo sets it does not keep the states in memory. It requires that every state is
+/// inserted right after it is added to the discovered states for the first time.
+class tree_compressed_breadth_first_todo_set : public todo_set
+{
+  protected:
+    const discovered_state_set& m_discovered;
+    std::size_t m_next = 0;
+
+  public:
+    explicit tree_compressed_breadth_first_todo_set(const discovered_state_set& discovered)
+      : m_discovered(discovered)
+    {
+      assert(discovered.tree_compression());
+    }
+
+    state choose_element() override
+    {
+      return m_discovered[m_next++];
+    }
+
+    void insert(const state& s) override
+    {
+      utilities::mcrl2_unused(s);
+      assert(m_discovered.index(s) == m_discovered.size() - 1);
+    }
+
+    bool empty() const override
+    {
+      return m_next == m_discovered.size();
+    }
+
+    std::size_t size() const override
+    {
+      return m_discovered.size() - m_next;
+    }
+};
+
 template <typename Summand>
 const stochastic_distribution& summand_distribution(const Summand& /* summand */)
 {
@@ -241,7 +673,6 @@ struct explorer_summand
   caching cache_strategy;
   std::vector<data::variable> gamma;
   atermpp::function_symbol f_gamma;
-  mutable utilities::unordered_map<atermpp::term_appl<data::data_expression>, std::list<data::data_expression_list>> local_cache;
 
   template <typename ActionSummand>
   explorer_summand(const ActionSummand& summand, std::size_t summand_index, const data::variable_list& process_parameters, caching cache_strategy_)
@@ -258,7 +689,9 @@ struct explorer_summand
     {
       gamma.insert(gamma.begin(), data::variable());
     }
-    f_gamma = atermpp::function_symbol("@gamma", gamma.size());
+    // The keys of all summands are stored in the same cache. A local key contains the index of the summand,
+    // whereas a global key is shared by all summands with the same condition.
+    f_gamma = atermpp::function_symbol(cache_strategy_ == caching::global ? std::string("@gamma") : "@gamma" + std::to_string(summand_index), gamma.size());
   }
 
   template <typename T>
@@ -345,6 +778,16 @@ class explorer: public abortable
       {}
     };
 
+    // A transition that is computed by a worker of the parallel exploration. The target is reported to
+    // examine_transition, whereas discovered_target is the corresponding element of the discovered states.
+    struct parallel_transition
+    {
+      process::timed_multi_action action;
+      state target;
+      state discovered_target;
+      std::size_t summand_index;
+    };
+
     const explorer_options& m_options;
     data::rewriter m_rewr;
     mutable data::mutable_indexed_substitution<> m_sigma;
@@ -358,15 +801,22 @@ class explorer: public abortable
     std::vector<explorer_summand> m_regular_summands;
     std::vector<explorer_summand> m_confluent_summands;
 
-    volatile bool m_must_abort = false;
+    std::atomic<bool> m_must_abort{false};
 
+    // The solutions of the conditions of the summands, shared by all summands and states. The hits and misses are
+    // counted per summand index.
     // N.B. The keys are stored in term_appl instead of data_expression_list for performance reasons.
-    utilities::unordered_map<atermpp::term_appl<data::data_expression>, std::list<data::data_expression_list>> global_cache;
-    utilities::indexed_set<state> m_discovered;
+    using enumeration_cache_type = data::enumeration_cache<atermpp::term_list<data::data_expression_list>>;
+    std::unique_ptr<enumeration_cache_type> m_enumeration_cache;
+    discovered_state_set m_discovered;
 
     // used by make_timed_state, to avoid needless creation of vectors
     mutable std::vector<data::data_expression> timed_state;
 
+    // The workers of the parallel exploration. Each worker has its own rewriter, substitution and enumerator.
+    explorer_options m_worker_options;
+    std::vector<std::unique_ptr<explorer>> m_workers;
+
     Specification preprocess(const Specification& lpsspec)
     {
       Specification result = lpsspec;
@@ -524,28 +974,28 @@ class explorer: public abortable
       }
       else
       {
-        auto key = summand.compute_key(m_sigma);
-        auto& cache = summand.cache_strategy == caching::global ? global_cache : summand.local_cache;
-        auto q = cache.find(key);
-        if (q == cache.end())
-        {
-          data::data_expression condition = m_rewr(summand.condition, m_sigma);
-          std::list<data::data_expression_list> solutions;
-          if (!data::is_false(condition))
+        // N.B. The solutions are copied, since report_transition may explore further states that replace the cache entry.
+        const atermpp::term_list<data::data_expression_list> solutions = m_enumeration_cache->find_or_compute(summand.compute_key(m_sigma), summand.index,
+          [&]()
           {
-            m_enumerator.enumerate(enumerator_element(summand.variables, condition),
-                        m_sigma,
-                        [&](const enumerator_element& p) {
-                          check_enumerator_solution(p, summand);
-                          solutions.push_back(p.assign_expressions(summand.variables, m_rewr));
-                          return false;
-                        },
-                        data::is_false
-            );
+            data::data_expression condition = m_rewr(summand.condition, m_sigma);
+            std::vector<data::data_expression_list> result;
+            if (!data::is_false(condition))
+            {
+              m_enumerator.enumerate(enumerator_element(summand.variables, condition),
+                          m_sigma,
+                          [&](const enumerator_element& p) {
+                            check_enumerator_solution(p, summand);
+                            result.push_back(p.assign_expressions(summand.variables, m_rewr));
+                            return false;
+                          },
+                          data::is_false
+              );
+            }
+            return atermpp::term_list<data::data_expression_list>(result.begin(), result.end());
           }
-          q = cache.insert({key, solutions}).first;
-        }
-        for (const data::data_expression_list& e: q->second)
+        );
+        for (const data::data_expression_list& e: solutions)
         {
           data::add_assignments(m_sigma, summand.variables, e);
           process::timed_multi_action a = rewrite_action(summand.multi_action);
@@ -608,6 +1058,165 @@ class explorer: public abortable
       return transitions;
     }
 
+    // Computes the outgoing transitions of s, using the regular and confluent summands of this explorer.
+    void generate_parallel_transitions(const state& s, std::vector<parallel_transition>& transitions)
+    {
+      transitions.clear();
+      data::add_assignments(m_sigma, m_process_parameters, s);
+      for (const explorer_summand& summand: m_regular_summands)
+      {
+        generate_transitions(
+          summand,
+          m_confluent_summands,
+          [&](const process::timed_multi_action& a, const state& s1)
+          {
+            if constexpr (Timed)
+            {
+              const data::data_expression& t = s[m_n];
+              if (a.has_time() && less_equal(a.time(), t))
+              {
+                return;
+              }
+              data::data_expression t1 = a.has_time() ? a.time() : t;
+              transitions.push_back(parallel_transition{a, s1, make_timed_state(s1, t1), summand.index});
+            }
+            else
+            {
+              transitions.push_back(parallel_transition{a, s1, s1, summand.index});
+            }
+          }
+        );
+      }
+    }
+
+    // Generates the state space using the workers in m_workers. The outgoing transitions of a state are computed
+    // and looked up in the discovered states concurrently. Only the callback functions are invoked by one worker at
+    // a time, hence all transitions of a state are reported consecutively, in between the corresponding calls of
+    // start_state and finish_state. A discovered state is only handed to the other workers after discover_state has
+    // been invoked on it. The callback functions are invoked while the workers do not use this explorer, so if
+    // recursive is true they may use it to generate transitions.
+    // pre: s0 is in normal form
+    template <
+      typename DiscoverState,
+      typename ExamineTransition,
+      typename StartState,
+      typename FinishState
+    >
+    void generate_state_space_parallel(
+      bool recursive,
+      const state& s0,
+      DiscoverState& discover_state,
+      ExamineTransition& examine_transition,
+      StartState& start_state,
+      FinishState& finish_state
+    )
+    {
+      work_stealing_todo_set todo(m_workers.size(), m_options.search_strategy == lps::es_depth);
+      std::mutex callback_mutex;
+      std::exception_ptr error;
+
+      m_recursive = recursive;
+      m_discovered.clear();
+      std::size_t s0_index = m_discovered.insert(s0).first;
+      discover_state(s0, s0_index);
+      todo.insert(0, s0);
+
+      // The index of the target state, and whether it was discovered by the transition.
+      struct target_index
+      {
+        std::size_t index;
+        bool is_new;
+      };
+
+      auto run = [&](std::size_t worker_index)
+      {
+        explorer& worker = *m_workers[worker_index];
+        std::vector<parallel_transition> transitions;
+        std::vector<target_index> targets;
+        state s;
+        try
+        {
+          while (!m_must_abort)
+          {
+            // Leaving this section at the end of every iteration allows the garbage collection to proceed.
+            atermpp::shared_guard guard;
+            if (!todo.choose_element(worker_index, s))
+            {
+              if (todo.finished())
+              {
+                break;
+              }
+              std::this_thread::yield();
+              continue;
+            }
+            worker.generate_parallel_transitions(s, transitions);
+
+            std::size_t s_index = m_discovered.index(s);
+            targets.clear();
+            for (const parallel_transition& t: transitions)
+            {
+              auto [s1_index, is_new] = m_discovered.insert(t.discovered_target);
+              targets.push_back(target_index{s1_index, is_new});
+            }
+
+            {
+              std::lock_guard<std::mutex> lock(callback_mutex);
+              if (!m_must_abort)
+              {
+                start_state(s, s_index);
+                for (std::size_t i = 0; i < transitions.size(); i++)
+                {
+                  const parallel_transition& t = transitions[i];
+                  if (targets[i].is_new)
+                  {
+                    discover_state(t.discovered_target, targets[i].index);
+                  }
+                  examine_transition(s, s_index, t.action, t.target, targets[i].index, t.summand_index);
+                }
+                finish_state(s, s_index, todo.size());
+              }
+            }
+
+            for (std::size_t i = 0; i < transitions.size(); i++)
+            {
+              if (targets[i].is_new)
+              {
+                todo.insert(worker_index, transitions[i].discovered_target);
+              }
+            }
+            todo.finish_state();
+          }
+        }
+        catch (...)
+        {
+          std::lock_guard<std::mutex> lock(callback_mutex);
+          if (!error)
+          {
+            error = std::current_exception();
+          }
+          m_must_abort = true;
+        }
+      };
+
+      std::vector<std::thread> threads;
+      for (std::size_t i = 1; i < m_workers.size(); i++)
+      {
+        threads.emplace_back(run, i);
+      }
+      run(0);
+      for (std::thread& thread: threads)
+      {
+        thread.join();
+      }
+
+      m_must_abort = false;
+      m_recursive = false;
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
+    }
+
     // pre: d0 is in normal form
     template <typename SummandSequence>
     std::vector<state> generate_successors(
@@ -643,11 +1252,24 @@ class explorer: public abortable
       return result;
     }
 
-    std::unique_ptr<todo_set> make_todo_set(const state& init)
+    // If the states are stored using tree compression, the breadth first todo set is taken from discovered, and
+    // the initial states must be added to discovered afterwards.
+    std::unique_ptr<todo_set> make_todo_set(const state& init, const discovered_state_set& discovered)
     {
       switch (m_options.search_strategy)
       {
-        case lps::es_breadth: return std::make_unique<breadth_first_todo_set>(init);
+        case lps::es_breadth:
+        {
+          if (m_options.todo_disk_threshold != std::numeric_limits<std::size_t>::max())
+          {
+            return std::make_unique<disk_breadth_first_todo_set>(init, m_options.todo_disk_threshold);
+          }
+          if (discovered.tree_compression())
+          {
+            return std::make_unique<tree_compressed_breadth_first_todo_set>(discovered);
+          }
+          return std::make_unique<breadth_first_todo_set>(init);
+        }
         case lps::es_depth: return std::make_unique<depth_first_todo_set>(init);
         case lps::es_highway: return std::make_unique<highway_todo_set>(init, m_options.highway_todo_max);
         default: throw mcrl2::runtime_error("unsupported search strategy");
@@ -655,11 +1277,22 @@ class explorer: public abortable
     }
 
     template <typename ForwardIterator>
-    std::unique_ptr<todo_set> make_todo_set(ForwardIterator first, ForwardIterator last)
+    std::unique_ptr<todo_set> make_todo_set(ForwardIterator first, ForwardIterator last, const discovered_state_set& discovered)
     {
       switch (m_options.search_strategy)
       {
-        case lps::es_breadth: return std::make_unique<breadth_first_todo_set>(first, last);
+        case lps::es_breadth:
+        {
+          if (m_options.todo_disk_threshold != std::numeric_limits<std::size_t>::max())
+          {
+            return std::make_unique<disk_breadth_first_todo_set>(first, last, m_options.todo_disk_threshold);
+          }
+          if (discovered.tree_compression())
+          {
+            return std::make_unique<tree_compressed_breadth_first_todo_set>(discovered);
+          }
+          return std::make_unique<breadth_first_todo_set>(first, last);
+        }
         case lps::es_depth: return std::make_unique<depth_first_todo_set>(first, last);
         case lps::es_highway: return std::make_unique<highway_todo_set>(first, last, m_options.highway_todo_max);
         default: throw mcrl2::runtime_error("unsupported search strategy");
@@ -697,7 +1330,8 @@ class explorer: public abortable
     explorer(const Specification& lpsspec, const explorer_options& options_)
       : m_options(options_),
         m_rewr(construct_rewriter(lpsspec, m_options.remove_unused_rewrite_rules)),
-        m_enumerator(m_rewr, lpsspec.data(), m_rewr, m_id_generator, false)
+        m_enumerator(m_rewr, lpsspec.data(), m_rewr, m_id_generator, false),
+        m_discovered(m_options)
     {
       Specification lpsspec_ = preprocess(lpsspec);
       const auto& params = lpsspec_.process().process_parameters();
@@ -722,6 +1356,43 @@ class explorer: public abortable
           m_regular_summands.emplace_back(summand, i, lpsspec_.process().process_parameters(), cache_strategy);
         }
       }
+
+      if (m_options.cached)
+      {
+        m_enumeration_cache = std::make_unique<enumeration_cache_type>(m_options.cache_size, lpsspec_summands.size());
+      }
+
+      // The runs of a swarm exploration use different seeds, and explore the summands in different orders.
+      if (m_options.bitstate_seed != 0)
+      {
+        std::mt19937 generator(m_options.bitstate_seed);
+        std::shuffle(m_regular_summands.begin(), m_regular_summands.end(), generator);
+      }
+
+      if (m_options.number_of_threads > 1)
+      {
+        if (!atermpp::detail::GlobalThreadSafe)
+        {
+          throw mcrl2::runtime_error("Parallel exploration requires a toolset that is built with MCRL2_ENABLE_MULTITHREADING.");
+        }
+        if (Stochastic || m_options.search_strategy == lps::es_highway)
+        {
+          mCRL2log(log::warning) << "Parallel exploration is not supported for stochastic specifications or the highway search strategy; "
+                                    "the state space is explored by a single thread." << std::endl;
+        }
+        else
+        {
+          m_worker_options = m_options;
+          m_worker_options.number_of_threads = 1;
+          m_worker_options.tree_compression = false;
+          m_worker_options.bitstate_size = 0; // the workers do not store discovered states
+          for (std::size_t i = 0; i < m_options.number_of_threads; i++)
+          {
+            m_workers.push_back(std::make_unique<explorer>(lpsspec, m_worker_options));
+          }
+          m_discovered.enable_concurrent_access();
+        }
+      }
     }
 
     ~explorer() = default;
@@ -766,7 +1437,7 @@ class explorer: public abortable
       const StateType& s0,
       const SummandSequence& regular_summands,
       const SummandSequence& confluent_summands,
-      utilities::indexed_set<state>& discovered,
+      discovered_state_set& discovered,
       DiscoverState discover_state = DiscoverState(),
       ExamineTransition examine_transition = ExamineTransition(),
       StartState start_state = StartState(),
@@ -780,35 +1451,40 @@ class explorer: public abortable
       std::unique_ptr<todo_set> todo;
       discovered.clear();
 
-      if constexpr (Stochastic)
       {
-        state_type s0_ = make_state(s0);
-        const auto& S = s0_.states;
-        todo = make_todo_set(S.begin(), S.end());
-        discovered.clear();
-        std::list<std::size_t> s0_index;
-        for (const state& s: S)
+        atermpp::shared_guard guard;
+        if constexpr (Stochastic)
         {
-          // TODO: join duplicate targets
-          std::size_t s_index = discovered.index(s);
-          if (s_index >= discovered.size())
+          state_type s0_ = make_state(s0);
+          const auto& S = s0_.states;
+          todo = make_todo_set(S.begin(), S.end(), discovered);
+          discovered.clear();
+          std::list<std::size_t> s0_index;
+          for (const state& s: S)
           {
-            s_index = discovered.insert(s).first;
-            discover_state(s, s_index);
+            // TODO: join duplicate targets
+            auto [s_index, is_new] = discovered.insert(s);
+            if (is_new)
+            {
+              discover_state(s, s_index);
+            }
+            s0_index.push_back(s_index);
           }
-          s0_index.push_back(s_index);
+          discover_initial_state(s0_, s0_index);
+        }
+        else
+        {
+          todo = make_todo_set(s0, discovered);
+          std::size_t s0_index = discovered.insert(s0).first;
+          discover_state(s0, s0_index);
         }
-        discover_initial_state(s0_, s0_index);
-      }
-      else
-      {
-        todo = make_todo_set(s0);
-        std::size_t s0_index = discovered.insert(s0).first;
-        discover_state(s0, s0_index);
       }
 
       while (!todo->empty() && !m_must_abort)
       {
+        // As in generate_state_space_parallel, a state is explored inside a shared section of the term pool, which
+        // is left in between states to allow garbage collection when other threads explore at the same time.
+        atermpp::shared_guard guard;
         state s = todo->choose_element();
         std::size_t s_index = discovered.index(s);
         start_state(s, s_index);
@@ -835,11 +1511,10 @@ class explorer: public abortable
                 // TODO: join duplicate targets
                 for (const state& s1_: S1)
                 {
-                  std::size_t k = discovered.index(s1_);
-                  if (k >= discovered.size())
+                  auto [k, is_new] = discovered.insert(s1_);
+                  if (is_new)
                   {
                     todo->insert(s1_);
-                    k = discovered.insert(s1_).first;
                     discover_state(s1_, k);
                   }
                   s1_index.push_back(k);
@@ -848,21 +1523,26 @@ class explorer: public abortable
               }
               else
               {
-                std::size_t s1_index = discovered.index(s1);
-                if (s1_index >= discovered.size())
+                std::size_t s1_index;
+                if constexpr (Timed)
                 {
-                  if constexpr (Timed)
+                  const data::data_expression& t = s[m_n];
+                  data::data_expression t1 = a.has_time() ? a.time() : t;
+                  state s1_at_t1 = make_timed_state(s1, t1);
+                  bool is_new;
+                  std::tie(s1_index, is_new) = discovered.insert(s1_at_t1);
+                  if (is_new)
                   {
-                    const data::data_expression& t = s[m_n];
-                    data::data_expression t1 = a.has_time() ? a.time() : t;
-                    state s1_at_t1 = make_timed_state(s1, t1);
-                    s1_index = discovered.insert(s1_at_t1).first;
                     discover_state(s1_at_t1, s1_index);
                     todo->insert(s1_at_t1);
                   }
-                  else
+                }
+                else
+                {
+                  bool is_new;
+                  std::tie(s1_index, is_new) = discovered.insert(s1);
+                  if (is_new)
                   {
-                    s1_index = discovered.insert(s1).first;
                     discover_state(s1, s1_index);
                     todo->insert(s1);
                   }
@@ -901,25 +1581,53 @@ class explorer: public abortable
     )
     {
       state_type s0;
-      if constexpr (Stochastic)
-      {
-        s0 = compute_stochastic_state(m_initial_distribution, m_initial_state);
-      }
-      else
       {
-        s0 = compute_state(m_initial_state);
-        if (!m_confluent_summands.empty())
+        atermpp::shared_guard guard;
+        if constexpr (Stochastic)
         {
-          s0 = find_representative(s0, m_confluent_summands);
+          s0 = compute_stochastic_state(m_initial_distribution, m_initial_state);
         }
-        if constexpr (Timed)
+        else
         {
-          s0 = make_timed_state(s0, real_zero());
+          s0 = compute_state(m_initial_state);
+          if (!m_confluent_summands.empty())
+          {
+            s0 = find_representative(s0, m_confluent_summands);
+          }
+          if constexpr (Timed)
+          {
+            s0 = make_timed_state(s0, real_zero());
+          }
+        }
+      }
+      if constexpr (!Stochastic)
+      {
+        if (!m_workers.empty())
+        {
+          generate_state_space_parallel(recursive, s0, discover_state, examine_transition, start_state, finish_state);
+          return;
         }
       }
       generate_state_space(recursive, s0, m_regular_summands, m_confluent_summands, m_discovered, discover_state, examine_transition, start_state, finish_state, discover_initial_state);
     }
 
+    /// \brief Returns the initial state, which is the starting point of generate_transitions.
+    /// \details Not available for stochastic specifications.
+    state initial_state()
+    {
+      static_assert(!Stochastic, "initial_state is not supported for stochastic specifications");
+      state s0 = compute_state(m_initial_state);
+      if (!m_confluent_summands.empty())
+      {
+        s0 = find_representative(s0, m_confluent_summands);
+      }
+      if constexpr (Timed)
+      {
+        s0 = make_timed_state(s0, real_zero());
+      }
+      return s0;
+    }
+
     /// \brief Generates outgoing transitions for a given state.
     std::vector<std::pair<lps::multi_action, state_type>> generate_transitions(const state& d0)
     {
@@ -1206,11 +1914,43 @@ class explorer: public abortable
     }
 
     /// \brief Returns a mapping containing all discovered states.
-    const utilities::indexed_set<state>& state_map() const
+    const discovered_state_set& state_map() const
     {
       return m_discovered;
     }
 
+    /// \brief Returns the number of entries in the enumeration caches of this explorer and its workers.
+    std::size_t enumeration_cache_size() const
+    {
+      std::size_t result = m_enumeration_cache ? m_enumeration_cache->size() : 0;
+      for (const std::unique_ptr<explorer>& worker: m_workers)
+      {
+        result += worker->enumeration_cache_size();
+      }
+      return result;
+    }
+
+    /// \brief Returns the hits and misses of the enumeration caches of this explorer and its workers, indexed by
+    /// the summand index. The result is empty if no caching is used.
+    std::vector<utilities::cache_metric> enumeration_cache_metrics() const
+    {
+      std::vector<utilities::cache_metric> result;
+      if (m_enumeration_cache)
+      {
+        result = m_enumeration_cache->metrics();
+      }
+      for (const std::unique_ptr<explorer>& worker: m_workers)
+      {
+        std::vector<utilities::cache_metric> worker_metrics = worker->enumeration_cache_metrics();
+        result.resize(std::max(result.size(), worker_metrics.size()));
+        for (std::size_t i = 0; i < worker_metrics.size(); i++)
+        {
+          result[i] += worker_metrics[i];
+        }
+      }
+      return result;
+    }
+
     const std::vector<explorer_summand>& regular_summands() const
     {
       return m_regular_summands;
@@ -43,9 +43,16 @@ struct explorer_options
   bool save_at_end = false;
   bool dfs_recursive = false;
   bool discard_lts_state_labels = false;
+  bool tree_compression = false;
   std::size_t max_states = std::numeric_limits<std::size_t>::max();
   std::size_t max_traces = 0;
   std::size_t highway_todo_max = std::numeric_limits<std::size_t>::max();
+  std::size_t number_of_threads = 1;
+  std::size_t cache_size = 1 << 20; // the maximum number of entries of the enumeration cache, 0 means that it is unbounded
+  std::size_t todo_disk_threshold = std::numeric_limits<std::size_t>::max();
+  std::size_t bitstate_size = 0; // the number of bits used for bitstate hashing, 0 means that it is not used
+  std::size_t bitstate_seed = 0;
+  std::size_t swarm_size = 0;    // the number of independent runs of a swarm exploration, 0 means that it is not used
   std::string trace_prefix;
   std::set<core::identifier_string> trace_actions;
   std::set<lps::multi_action> trace_multiactions;
@@ -60,6 +67,7 @@ std::ostream& operator<<(std::ostream& out, const explorer_options& options)
   out << "search-strategy = " << options.search_strategy << std::endl;
   out << "cached = " << std::boolalpha << options.cached << std::endl;
   out << "global-cache = " << std::boolalpha << options.global_cache << std::endl;
+  out << "cache-size = " << options.cache_size << std::endl;
   out << "confluence = " << std::boolalpha << options.confluence << std::endl;
   out << "confluence-action = " << options.confluence << std::endl;
   out << "one-point-rule-rewrite = " << std::boolalpha << options.one_point_rule_rewrite << std::endl;
@@ -76,9 +84,15 @@ std::ostream& operator<<(std::ostream& out, const explorer_options& options)
   out << "suppress-progress-messages = " << std::boolalpha << options.suppress_progress_messages << std::endl;
   out << "save-aut-at-end = " << std::boolalpha << options.save_at_end << std::endl;
   out << "dfs-recursive = " << std::boolalpha << options.dfs_recursive << std::endl;
+  out << "tree-compression = " << std::boolalpha << options.tree_compression << std::endl;
   out << "max-states = " << options.max_states << std::endl;
   out << "max-traces = " << options.max_traces << std::endl;
   out << "todo-max = " << options.highway_todo_max << std::endl;
+  out << "threads = " << options.number_of_threads << std::endl;
+  out << "todo-disk = " << options.todo_disk_threshold << std::endl;
+  out << "bitstate-size = " << options.bitstate_size << std::endl;
+  out << "bitstate-seed = " << options.bitstate_seed << std::endl;
+  out << "swarm-size = " << options.swarm_size << std::endl;
   out << "trace-prefix = " << options.trace_prefix << std::endl;
   out << "trace-actions = " << core::detail::print_set(options.trace_actions) << std::endl;
   out << "trace-multiactions = " << core::detail::print_set(options.trace_multiactions) << std::endl;
@@ -41,7 +41,11 @@ struct t_lin_options
   bool apply_alphabet_axioms;
   bool balance_summands;      // Used to balance long expressions of the shape p1 + p2 + ... + pn. By default the parser delivers
                               // such expressions in a skewed form, causing stack overflow. 
+  bool alphabet_pruning;      // Do not generate summands in parallel compositions of which the multi-actions cannot pass the
+                              // enclosing allow, block, comm, hide and rename operators. Only applies if time is ignored.
   mcrl2::data::rewriter::strategy rewrite_strategy;
+  std::size_t number_of_threads; // The number of threads that combine summands in parallel and communication compositions.
+                                 // More than one thread requires a toolset that is built with MCRL2_ENABLE_MULTITHREADING.
 
   t_lin_options()
     : lin_method(lmRegular),
@@ -58,7 +62,9 @@ struct t_lin_options
       do_not_apply_constelm(false),
       apply_alphabet_axioms(false),
       balance_summands(false),              
-      rewrite_strategy(mcrl2::data::jitty)
+      alphabet_pruning(false),
+      rewrite_strategy(mcrl2::data::jitty),
+      number_of_threads(1)
   {}
 };
 
@@ -0,0 +1,198 @@
+// Author(s): Wieger Wesselink
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/lps/tree_compressed_state_set.h
+/// \brief A set of states that is stored using tree compression.
+
+#ifndef MCRL2_LPS_TREE_COMPRESSED_STATE_SET_H
+#define MCRL2_LPS_TREE_COMPRESSED_STATE_SET_H
+
+#include <utility>
+#include <vector>
+#include "mcrl2/lps/state.h"
+#include "mcrl2/utilities/hash_utility.h"
+#include "mcrl2/utilities/indexed_set.h"
+
+namespace mcrl2 {
+
+namespace lps {
+
+/// \brief A set that assigns each state a unique index, and that stores the states using tree compression.
+/// \details A state with n parameters is split in the same way as a term_balanced_tree. Each parameter value is
+/// stored once in a table of values, and each node of the tree is stored as a pair of indices of its children in a
+/// table of nodes. The roots are stored in a separate table, such that their indices are the consecutive indices of
+/// the states. Since successor states typically differ in a few parameters only, most nodes are shared between
+/// states. A state is not kept in memory as a term, instead it is reconstructed by operator[].
+/// All states in the set must have the same number of parameters.
+class tree_compressed_state_set
+{
+  protected:
+    typedef std::pair<std::size_t, std::size_t> node;
+
+    utilities::indexed_set<data::data_expression> m_values;
+    utilities::indexed_set<node> m_nodes;
+    utilities::indexed_set<node> m_states;
+    std::size_t m_arity = 0;
+
+    static const data::data_expression& value(const state& x)
+    {
+      return atermpp::down_cast<data::data_expression>(static_cast<const atermpp::aterm&>(x));
+    }
+
+    // Inserts the children of the tree x with the given number of elements, and returns their indices.
+    node insert_children(const state& x, std::size_t size)
+    {
+      if (size > 1)
+      {
+        return node(insert_tree(x.left_branch(), (size + 1) >> 1), insert_tree(x.right_branch(), size >> 1));
+      }
+      if (size == 1)
+      {
+        return node(m_values.insert(value(x)).first, 0);
+      }
+      return node(0, 0);
+    }
+
+    std::size_t insert_tree(const state& x, std::size_t size)
+    {
+      if (size == 1)
+      {
+        return m_values.insert(value(x)).first;
+      }
+      return m_nodes.insert(insert_children(x, size)).first;
+    }
+
+    // Returns the indices of the children of the tree x with the given number of elements. If one of them is not
+    // in the set, the first index is npos.
+    node find_children(const state& x, std::size_t size) const
+    {
+      if (size > 1)
+      {
+        std::size_t left = find_tree(x.left_branch(), (size + 1) >> 1);
+        if (left == npos)
+        {
+          return node(npos, 0);
+        }
+        std::size_t right = find_tree(x.right_branch(), size >> 1);
+        return right == npos ? node(npos, 0) : node(left, right);
+      }
+      if (size == 1)
+      {
+        return node(m_values.index(value(x)), 0);
+      }
+      return node(0, 0);
+    }
+
+    std::size_t find_tree(const state& x, std::size_t size) const
+    {
+      if (size == 1)
+      {
+        return m_values.index(value(x));
+      }
+      node n = find_children(x, size);
+      return n.first == npos ? npos : m_nodes.index(n);
+    }
+
+    void decompress(std::size_t index, std::size_t size, std::vector<data::data_expression>& result) const
+    {
+      if (size == 1)
+      {
+        result.push_back(m_values[index]);
+        return;
+      }
+      decompress_children(m_nodes[index], size, result);
+    }
+
+    void decompress_children(const node& n, std::size_t size, std::vector<data::data_expression>& result) const
+    {
+      if (size > 1)
+      {
+        decompress(n.first, (size + 1) >> 1, result);
+        decompress(n.second, size >> 1, result);
+      }
+      else if (size == 1)
+      {
+        decompress(n.first, 1, result);
+      }
+    }
+
+  public:
+    /// \brief Value returned by index when a state does not exist in the set.
+    static constexpr std::size_t npos = utilities::indexed_set<node>::npos;
+
+    /// \brief Inserts a state in the set.
+    /// \return The index of the state and a boolean indicating whether the state was actually inserted.
+    std::pair<std::size_t, bool> insert(const state& x)
+    {
+      if (m_states.size() == 0)
+      {
+        m_arity = x.size();
+      }
+      assert(x.size() == m_arity);
+      return m_states.insert(insert_children(x, m_arity));
+    }
+
+    /// \brief Returns the index of the given state, or npos if the state is not in the set.
+    std::size_t index(const state& x) const
+    {
+      if (m_states.size() == 0)
+      {
+        return npos;
+      }
+      node n = find_children(x, m_arity);
+      return n.first == npos ? npos : m_states.index(n);
+    }
+
+    /// \brief Returns the state with the given index.
+    state operator[](std::size_t index) const
+    {
+      std::vector<data::data_expression> values;
+      values.reserve(m_arity);
+      decompress_children(m_states[index], m_arity, values);
+      return state(values.begin(), m_arity);
+    }
+
+    /// \brief Returns the state with the given index. Throws an out_of_range exception if the index is too large.
+    state at(std::size_t index) const
+    {
+      m_states.at(index);
+      return (*this)[index];
+    }
+
+    /// \brief Returns the number of states in the set.
+    std::size_t size() const
+    {
+      return m_states.size();
+    }
+
+    /// \brief Returns the number of nodes that are used to store the states, excluding the roots.
+    std::size_t node_count() const
+    {
+      return m_nodes.size();
+    }
+
+    /// \brief Returns the number of distinct parameter values that occur in the states.
+    std::size_t value_count() const
+    {
+      return m_values.size();
+    }
+
+    void clear()
+    {
+      m_values.clear();
+      m_nodes.clear();
+      m_states.clear();
+      m_arity = 0;
+    }
+};
+
+} // namespace lps
+
+} // namespace mcrl2
+
+#endif // MCRL2_LPS_TREE_COMPRESSED_STATE_SET_H
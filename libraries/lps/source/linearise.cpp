@@ -25,6 +25,8 @@
    the use of this software.
 */
 
+#include <thread>
+
 //mCRL2 data
 #include "mcrl2/data/substitutions/maintain_variables_in_rhs.h"
 #include "mcrl2/data/fourier_motzkin.h"
@@ -38,6 +40,7 @@
 #include "mcrl2/lps/replace_capture_avoiding_with_an_identifier_generator.h"
 
 // Process libraries.
+#include "mcrl2/process/allow_set.h"
 #include "mcrl2/process/alphabet_reduce.h"
 #include "mcrl2/process/balance_nesting_depth.h"
 
@@ -67,6 +70,10 @@ typedef enum { unknown,
                error
              } processstatustype;
 
+/* The rewriter that RewriteTerm uses in a thread that is started by
+   parallel_for_summands. It is a null pointer in the linearising thread. */
+static thread_local rewriter* thread_rewriter=nullptr;
+
 
 
 /**************** Definitions of object class  ***********************/
@@ -175,6 +182,11 @@ class specification_basic_type
        com, bound, at, name, delta,
        tau, hide, rename, encap */
     mcrl2::data::rewriter rewr; /* The rewriter used while linearising */
+    std::vector < rewriter > thread_rewriters; /* The rewriters of the threads started by parallel_for_summands */
+    std::vector < allow_set > alphabet_bounds; /* If alphabet pruning is enabled, the last element contains the multi-actions
+                                                  of the current subterm that may pass the enclosing allow, block, comm,
+                                                  hide and rename operators. Empty if no multi-action can be removed. */
+    std::atomic < std::size_t > number_of_pruned_summands;
     action terminationAction;   /* A list of length one with the action that denotes termination */
     process_identifier terminatedProcId; /* A process identifier of which the body consists of the termination
                                             action */
@@ -208,6 +220,7 @@ class specification_basic_type
       global_variables(glob_vars),
       data(ds),
       rewr(data,opt.rewrite_strategy),
+      number_of_pruned_summands(0),
       options(opt),
       timeIsBeingUsed(false),
       stochastic_operator_is_being_used(false),
@@ -555,20 +568,170 @@ class specification_basic_type
       return n;
     }
 
+    void update_rewriters()
+    {
+      if (fresh_equation_added)
+      {
+        rewr=rewriter(data,options.rewrite_strategy);
+        thread_rewriters.clear();
+        fresh_equation_added=false;
+      }
+    }
+
     data_expression RewriteTerm(const data_expression& t)
     {
       if (!options.norewrite)
       {
-        if (fresh_equation_added)
+        if (thread_rewriter!=nullptr)
         {
-          rewr=rewriter(data,options.rewrite_strategy);
-          fresh_equation_added=false;
+          return (*thread_rewriter)(t);
         }
+        update_rewriters();
         return rewr(t);
       }
       return t;
     }
 
+    /* Applies f(i,result) to every i in [0,n), where f adds the summands that
+       it generates for i to result. The summands are appended to output in the
+       order of i, such that the output does not depend on the number of threads.
+       If options.number_of_threads is larger than one, consecutive ranges of
+       [0,n) are handled by separate threads. In that case f can only rewrite
+       using RewriteTerm, which uses a separate rewriter in every thread, and
+       must not change the data specification or other shared data. */
+    template < typename Summand, typename Function >
+    void parallel_for_summands(const std::size_t n, std::vector < Summand >& output, Function f)
+    {
+      const std::size_t number_of_threads=atermpp::detail::GlobalThreadSafe?std::min(options.number_of_threads,n):1;
+      if (number_of_threads<=1)
+      {
+        for (std::size_t i=0; i<n; ++i)
+        {
+          f(i,output);
+        }
+        return;
+      }
+
+      if (!options.norewrite)
+      {
+        update_rewriters();
+        while (thread_rewriters.size()+1<number_of_threads)
+        {
+          thread_rewriters.emplace_back(data,options.rewrite_strategy);
+        }
+      }
+
+      const std::size_t chunk=(n+number_of_threads-1)/number_of_threads;
+      std::vector < std::vector < Summand > > results(number_of_threads);
+      std::vector < std::exception_ptr > errors(number_of_threads);
+      auto run=[&](const std::size_t index)
+      {
+        if (index>0 && !options.norewrite)
+        {
+          thread_rewriter=&thread_rewriters[index-1];
+        }
+        try
+        {
+          for (std::size_t i=index*chunk; i<std::min(n,(index+1)*chunk); ++i)
+          {
+            // Leaving the shared section after every element gives the garbage collector a safepoint.
+            atermpp::shared_guard guard;
+            f(i,results[index]);
+          }
+        }
+        catch (...)
+        {
+          errors[index]=std::current_exception();
+        }
+        thread_rewriter=nullptr;
+      };
+
+      std::vector < std::thread > threads;
+      for (std::size_t index=1; index<number_of_threads; ++index)
+      {
+        threads.emplace_back(run,index);
+      }
+      run(0);
+      for (std::thread& thread: threads)
+      {
+        thread.join();
+      }
+      for (const std::exception_ptr& error: errors)
+      {
+        if (error)
+        {
+          std::rethrow_exception(error);
+        }
+      }
+      for (std::vector < Summand >& result: results)
+      {
+        std::move(result.begin(),result.end(),std::back_inserter(output));
+      }
+    }
+
+    /* Alphabet pruning removes the summands of parallel compositions of which the
+       multi-actions cannot pass the enclosing allow, block, comm, hide and rename
+       operators. Like inline allow and block, it is only applied when time is ignored,
+       as summands are removed without adding delta summands. */
+    bool alphabet_pruning_enabled() const
+    {
+      return options.alphabet_pruning && !options.nodeltaelimination && options.ignore_time;
+    }
+
+    allow_set current_alphabet_bound() const
+    {
+      if (!alphabet_bounds.empty())
+      {
+        return alphabet_bounds.back();
+      }
+      // Every multi-action passes. This is represented by hiding all action names.
+      std::set < identifier_string > names;
+      for (const process::action_label& a: acts)
+      {
+        names.insert(a.name());
+      }
+      return allow_set(multi_action_name_set(),false,names);
+    }
+
+    /* Sets the bound of the operand of an operator to f(b), where b is the bound of the operator itself. */
+    template < typename Function >
+    void push_alphabet_bound(Function f)
+    {
+      if (alphabet_pruning_enabled())
+      {
+        alphabet_bounds.push_back(f(current_alphabet_bound()));
+      }
+    }
+
+    void pop_alphabet_bound()
+    {
+      if (alphabet_pruning_enabled())
+      {
+        alphabet_bounds.pop_back();
+      }
+    }
+
+    /* Returns true if the multiaction cannot pass the enclosing operators. Can be used by
+       the threads of parallel_for_summands. */
+    bool is_pruned(const action_list& multiaction)
+    {
+      if (alphabet_bounds.empty() || multiaction==action_list({ terminationAction }))
+      {
+        return false;
+      }
+      multi_action_name alpha;
+      for (const action& a: multiaction)
+      {
+        alpha.insert(a.label().name());
+      }
+      if (alphabet_bounds.back().contains(alpha))
+      {
+        return false;
+      }
+      number_of_pruned_summands++;
+      return true;
+    }
+
     data_expression_list RewriteTermList(const data_expression_list& t)
     {
       data_expression_vector v;
@@ -8273,27 +8436,22 @@ class specification_basic_type
       }
       action_name_multiset_list allowlist((is_allow)?sort_multi_action_labels(allowlist1):allowlist1);
 
-      for (stochastic_action_summand_vector::const_iterator sourcesumlist=action_summands.begin();
-           sourcesumlist!=action_summands.end(); ++sourcesumlist)
+      if (!inline_allow)
       {
-        const stochastic_action_summand smmnd=*sourcesumlist;
-        const variable_list& sumvars=smmnd.summation_variables();
-        const action_list multiaction=smmnd.multi_action().actions();
-        const data_expression& condition=smmnd.condition();
-        const assignment_list& nextstate=smmnd.assignments();
-        const stochastic_distribution& dist=smmnd.distribution();
+        /* Recall a delta summand for every non delta summand.
+         * The reason for this is that with communication, the
+         * conditions for summands can become much more complex.
+         * Many of the actions in these summands are replaced by
+         * delta's later on. Due to the more complex conditions it
+         * will be hard to remove them. By adding a default delta
+         * with a simple condition, makes this job much easier
+         * later on, and will in general reduce the number of delta
+         * summands in the whole system */
 
-        if (!inline_allow)
+        for (const stochastic_action_summand& smmnd: action_summands)
         {
-          /* Recall a delta summand for every non delta summand.
-           * The reason for this is that with communication, the
-           * conditions for summands can become much more complex.
-           * Many of the actions in these summands are replaced by
-           * delta's later on. Due to the more complex conditions it
-           * will be hard to remove them. By adding a default delta
-           * with a simple condition, makes this job much easier
-           * later on, and will in general reduce the number of delta
-           * summands in the whole system */
+          const variable_list& sumvars=smmnd.summation_variables();
+          const data_expression& condition=smmnd.condition();
 
           /* But first remove free variables from sumvars */
 
@@ -8313,60 +8471,75 @@ class specification_basic_type
                                                             condition,
                                                             smmnd.multi_action().has_time()?deadlock(smmnd.multi_action().time()):deadlock()));
         }
+      }
 
-        /* the multiactionconditionlist is a list containing
-           tuples, with a multiaction and the condition,
-           expressing whether the multiaction can happen. All
-           conditions exclude each other. Furthermore, the list
-           is not empty. If no communications can take place,
-           the original multiaction is delivered, with condition
-           true. */
+      /* The communications of the summands are calculated in parallel, where the summands are divided over the threads. */
+      parallel_for_summands(action_summands.size(),resultsumlist,
+        [&](const std::size_t j, stochastic_action_summand_vector& result)
+        {
+          const stochastic_action_summand& smmnd=action_summands[j];
+          const variable_list& sumvars=smmnd.summation_variables();
+          const action_list multiaction=smmnd.multi_action().actions();
+          const data_expression& condition=smmnd.condition();
+          const assignment_list& nextstate=smmnd.assignments();
+          const stochastic_distribution& dist=smmnd.distribution();
 
-        const tuple_list multiactionconditionlist=
-          makeMultiActionConditionList(
-            multiaction,
-            communications1);
+          /* the multiactionconditionlist is a list containing
+             tuples, with a multiaction and the condition,
+             expressing whether the multiaction can happen. All
+             conditions exclude each other. Furthermore, the list
+             is not empty. If no communications can take place,
+             the original multiaction is delivered, with condition
+             true. */
 
-        assert(multiactionconditionlist.actions.size()==
-               multiactionconditionlist.conditions.size());
-        for (std::size_t i=0 ; i<multiactionconditionlist.actions.size(); ++i)
-        {
-          const action_list multiaction=multiactionconditionlist.actions[i];
+          const tuple_list multiactionconditionlist=
+            makeMultiActionConditionList(
+              multiaction,
+              communications1);
 
-          if (is_allow && !allow_(allowlist,multiaction))
-          {
-            continue;
-          }
-          if (is_block && encap(allowlist,multiaction))
+          assert(multiactionconditionlist.actions.size()==
+                 multiactionconditionlist.conditions.size());
+          for (std::size_t i=0 ; i<multiactionconditionlist.actions.size(); ++i)
           {
-            continue;
-          }
+            const action_list multiaction=multiactionconditionlist.actions[i];
 
-          const data_expression communicationcondition=
-            RewriteTerm(multiactionconditionlist.conditions[i]);
+            if (is_allow && !allow_(allowlist,multiaction))
+            {
+              continue;
+            }
+            if (is_block && encap(allowlist,multiaction))
+            {
+              continue;
+            }
+            if (is_pruned(multiaction))
+            {
+              continue;
+            }
 
-          const data_expression newcondition=RewriteTerm(
-                                               lazy::and_(condition,communicationcondition));
-          stochastic_action_summand new_summand(sumvars,
-                                     newcondition,
-                                     smmnd.multi_action().has_time()?multi_action(multiaction, smmnd.multi_action().time()):multi_action(multiaction),
-                                     nextstate,
-                                     dist);
-          if (!options.nosumelm)
-          {
-            if (sumelm(new_summand))
+            const data_expression communicationcondition=
+              RewriteTerm(multiactionconditionlist.conditions[i]);
+
+            const data_expression newcondition=RewriteTerm(
+                                                 lazy::and_(condition,communicationcondition));
+            stochastic_action_summand new_summand(sumvars,
+                                       newcondition,
+                                       smmnd.multi_action().has_time()?multi_action(multiaction, smmnd.multi_action().time()):multi_action(multiaction),
+                                       nextstate,
+                                       dist);
+            if (!options.nosumelm)
             {
-              new_summand.condition() = RewriteTerm(new_summand.condition());
+              if (sumelm(new_summand))
+              {
+                new_summand.condition() = RewriteTerm(new_summand.condition());
+              }
             }
-          }
 
-          if (new_summand.condition()!=sort_bool::false_())
-          {
-            resultsumlist.push_back(new_summand);
+            if (new_summand.condition()!=sort_bool::false_())
+            {
+              result.push_back(new_summand);
+            }
           }
-        }
-
-      }
+        });
 
       /* Now the resulting delta summands must be added again */
 
@@ -8799,6 +8972,10 @@ class specification_basic_type
           {
             continue;
           }
+          if (is_pruned(multiaction1))
+          {
+            continue;
+          }
 
           if (!options.ignore_time)
           {
@@ -8927,94 +9104,100 @@ class specification_basic_type
           const bool is_block,
           stochastic_action_summand_vector& action_summands)
     {
-      // First combine the action summands.
-      for (const stochastic_action_summand& summand1: action_summands1)
-      {
-        const variable_list& sumvars1=summand1.summation_variables();
-        const action_list multiaction1=summand1.multi_action().actions();
-        const data_expression actiontime1=summand1.multi_action().time();
-        const data_expression& condition1=summand1.condition();
-        const assignment_list& nextstate1=summand1.assignments();
-        const stochastic_distribution& distribution1=summand1.distribution();
-
-        for (const stochastic_action_summand& summand2: action_summands2)
+      // First combine the action summands. The summands of action_summands1 are divided over the threads.
+      parallel_for_summands(action_summands1.size(),action_summands,
+        [&](const std::size_t i, stochastic_action_summand_vector& result)
         {
-          const variable_list& sumvars2=summand2.summation_variables();
-          const action_list multiaction2=summand2.multi_action().actions();
-          const data_expression actiontime2=summand2.multi_action().time();
-          const data_expression& condition2=summand2.condition();
-          const assignment_list& nextstate2=summand2.assignments();
-          const stochastic_distribution& distribution2=summand2.distribution();
+          const stochastic_action_summand& summand1=action_summands1[i];
+          const variable_list& sumvars1=summand1.summation_variables();
+          const action_list multiaction1=summand1.multi_action().actions();
+          const data_expression actiontime1=summand1.multi_action().time();
+          const data_expression& condition1=summand1.condition();
+          const assignment_list& nextstate1=summand1.assignments();
+          const stochastic_distribution& distribution1=summand1.distribution();
 
-          if ((multiaction1 == action_list({ terminationAction })) == (multiaction2 == action_list({ terminationAction })))
+          for (const stochastic_action_summand& summand2: action_summands2)
           {
-            action_list multiaction3;
-            if ((multiaction1 == action_list({ terminationAction })) && (multiaction2 == action_list({ terminationAction })))
-            {
-              multiaction3.push_front(terminationAction);
-            }
-            else
-            {
-              multiaction3=linMergeMultiActionList(multiaction1,multiaction2);
-            }
+            const variable_list& sumvars2=summand2.summation_variables();
+            const action_list multiaction2=summand2.multi_action().actions();
+            const data_expression actiontime2=summand2.multi_action().time();
+            const data_expression& condition2=summand2.condition();
+            const assignment_list& nextstate2=summand2.assignments();
+            const stochastic_distribution& distribution2=summand2.distribution();
 
-            if (is_allow && !allow_(allowlist,multiaction3))
-            {
-              continue;
-            }
-            if (is_block && encap(allowlist,multiaction3))
+            if ((multiaction1 == action_list({ terminationAction })) == (multiaction2 == action_list({ terminationAction })))
             {
-              continue;
-            }
-
-            const variable_list allsums=sumvars1+sumvars2;
-            data_expression condition3= lazy::and_(condition1,condition2);
-            data_expression action_time3;
-            bool has_time3=summand1.has_time()||summand2.has_time();
+              action_list multiaction3;
+              if ((multiaction1 == action_list({ terminationAction })) && (multiaction2 == action_list({ terminationAction })))
+              {
+                multiaction3.push_front(terminationAction);
+              }
+              else
+              {
+                multiaction3=linMergeMultiActionList(multiaction1,multiaction2);
+              }
 
-            if (!summand1.has_time())
-            {
-              if (summand2.has_time())
+              if (is_allow && !allow_(allowlist,multiaction3))
               {
-                /* summand 2 has time*/
-                action_time3=actiontime2;
+                continue;
               }
-            }
-            else
-            {
-              /* summand 1 has time */
-              if (!summand2.has_time())
+              if (is_block && encap(allowlist,multiaction3))
+              {
+                continue;
+              }
+              if (is_pruned(multiaction3))
               {
-                action_time3=actiontime1;
+                continue;
+              }
+
+              const variable_list allsums=sumvars1+sumvars2;
+              data_expression condition3= lazy::and_(condition1,condition2);
+              data_expression action_time3;
+              bool has_time3=summand1.has_time()||summand2.has_time();
+
+              if (!summand1.has_time())
+              {
+                if (summand2.has_time())
+                {
+                  /* summand 2 has time*/
+                  action_time3=actiontime2;
+                }
               }
               else
               {
-                /* both summand 1 and 2 have time */
-                action_time3=actiontime1;
-                condition3=lazy::and_(
-                             condition3,
-                             equal_to(actiontime1,actiontime2));
+                /* summand 1 has time */
+                if (!summand2.has_time())
+                {
+                  action_time3=actiontime1;
+                }
+                else
+                {
+                  /* both summand 1 and 2 have time */
+                  action_time3=actiontime1;
+                  condition3=lazy::and_(
+                               condition3,
+                               equal_to(actiontime1,actiontime2));
+                }
               }
-            }
 
-            const assignment_list nextstate3=nextstate1+nextstate2;
-            const stochastic_distribution distribution3(
-                                              distribution1.variables()+distribution2.variables(),
-                                              real_times_optimized(distribution1.distribution(),distribution2.distribution()));
+              const assignment_list nextstate3=nextstate1+nextstate2;
+              const stochastic_distribution distribution3(
+                                                distribution1.variables()+distribution2.variables(),
+                                                real_times_optimized(distribution1.distribution(),distribution2.distribution()));
 
-            condition3=RewriteTerm(condition3);
-            if (condition3!=sort_bool::false_())
-            {
-              action_summands.push_back(stochastic_action_summand(
-                                           allsums,
-                                           condition3,
-                                           has_time3?multi_action(multiaction3,action_time3):multi_action(multiaction3),
-                                           nextstate3,
-                                           distribution3));
+              condition3=RewriteTerm(condition3);
+              if (condition3!=sort_bool::false_())
+              {
+                result.push_back(stochastic_action_summand(
+                                             allsums,
+                                             condition3,
+                                             has_time3?multi_action(multiaction3,action_time3):multi_action(multiaction3),
+                                             nextstate3,
+                                             distribution3));
+              }
             }
           }
-        }
-      }
+        });
     }
 
     void calculate_communication_merge_action_deadlock_summands(
@@ -9380,10 +9563,12 @@ class specification_basic_type
         stochastic_action_summand_vector action_summands1, action_summands2;
         deadlock_summand_vector deadlock_summands1, deadlock_summands2;
         lps::detail::ultimate_delay ultimate_delay_condition1, ultimate_delay_condition2;
+        push_alphabet_bound([](const allow_set& A){ return process::alphabet_operations::subsets(A); });
         generateLPEmCRLterm(action_summands1,deadlock_summands1,process::merge(t).left(),
                               regular,rename_variables,pars1,init1,initial_stochastic_distribution1,ultimate_delay_condition1);
         generateLPEmCRLterm(action_summands2,deadlock_summands2,process::merge(t).right(),
                               regular,true,pars2,init2,initial_stochastic_distribution2,ultimate_delay_condition2);
+        pop_alphabet_bound();
         parallelcomposition(action_summands1,deadlock_summands1,pars1,init1,initial_stochastic_distribution1,ultimate_delay_condition1,
                               action_summands2,deadlock_summands2,pars2,init2,initial_stochastic_distribution2,ultimate_delay_condition2,
                               action_name_multiset_list(),false,false,
@@ -9393,8 +9578,10 @@ class specification_basic_type
 
       if (is_hide(t))
       {
+        push_alphabet_bound([&](const allow_set& A){ return process::alphabet_operations::hide_inverse(hide(t).hide_set(),A); });
         generateLPEmCRLterm(action_summands,deadlock_summands,hide(t).operand(),
                               regular,rename_variables,pars,init,initial_stochastic_distribution,ultimate_delay_condition);
+        pop_alphabet_bound();
         hidecomposition(hide(t).hide_set(),action_summands);
         return;
       }
@@ -9402,6 +9589,7 @@ class specification_basic_type
       if (is_allow(t))
       {
         process_expression par = allow(t).operand();
+        push_alphabet_bound([&](const allow_set& A){ return process::alphabet_operations::allow(allow(t).allow_set(),A); });
         if (!options.nodeltaelimination && options.ignore_time && is_merge(par))
         {
           // Perform parallel composition with inline allow.
@@ -9411,25 +9599,32 @@ class specification_basic_type
           stochastic_action_summand_vector action_summands1, action_summands2;
           deadlock_summand_vector deadlock_summands1, deadlock_summands2;
           lps::detail::ultimate_delay ultimate_delay_condition1, ultimate_delay_condition2;
+          push_alphabet_bound([](const allow_set& A){ return process::alphabet_operations::subsets(A); });
           generateLPEmCRLterm(action_summands1,deadlock_summands1,process::merge(par).left(),
                                 regular,rename_variables,pars1,init1,initial_stochastic_distribution1,ultimate_delay_condition1);
           generateLPEmCRLterm(action_summands2,deadlock_summands2,process::merge(par).right(),
                                 regular,true,pars2,init2,initial_stochastic_distribution2,ultimate_delay_condition2);
+          pop_alphabet_bound();
           parallelcomposition(action_summands1,deadlock_summands1,pars1,init1,initial_stochastic_distribution1,ultimate_delay_condition1,
                                 action_summands2,deadlock_summands2,pars2,init2,initial_stochastic_distribution2,ultimate_delay_condition2,
                                 allow(t).allow_set(),true,false,
                                 action_summands,deadlock_summands,pars,init,initial_stochastic_distribution,ultimate_delay_condition);
+          pop_alphabet_bound();
           return;
         }
         else if (!options.nodeltaelimination && options.ignore_time && is_comm(par))
         {
+          push_alphabet_bound([&](const allow_set& A){ return process::alphabet_operations::comm_inverse(comm(par).comm_set(),A); });
           generateLPEmCRLterm(action_summands,deadlock_summands,comm(par).operand(),
                                 regular,rename_variables,pars,init,initial_stochastic_distribution,ultimate_delay_condition);
+          pop_alphabet_bound();
           communicationcomposition(comm(par).comm_set(),allow(t).allow_set(),true,false,action_summands,deadlock_summands);
+          pop_alphabet_bound();
           return;
         }
 
         generateLPEmCRLterm(action_summands,deadlock_summands,par,regular,rename_variables,pars,init,initial_stochastic_distribution,ultimate_delay_condition);
+        pop_alphabet_bound();
         allowblockcomposition(allow(t).allow_set(),true,action_summands,deadlock_summands);
         return;
       }
@@ -9437,6 +9632,7 @@ class specification_basic_type
       if (is_block(t))
       {
         process_expression par = block(t).operand();
+        push_alphabet_bound([&](const allow_set& A){ return process::alphabet_operations::block(block(t).block_set(),A); });
         if (!options.nodeltaelimination && options.ignore_time && is_merge(par))
         {
           // Perform parallel composition with inline block.
@@ -9446,28 +9642,35 @@ class specification_basic_type
           stochastic_action_summand_vector action_summands1, action_summands2;
           deadlock_summand_vector deadlock_summands1, deadlock_summands2;
           lps::detail::ultimate_delay ultimate_delay_condition1, ultimate_delay_condition2;
+          push_alphabet_bound([](const allow_set& A){ return process::alphabet_operations::subsets(A); });
           generateLPEmCRLterm(action_summands1,deadlock_summands1,process::merge(par).left(),
                                 regular,rename_variables,pars1,init1,initial_stochastic_distribution1,ultimate_delay_condition1);
           generateLPEmCRLterm(action_summands2,deadlock_summands2,process::merge(par).right(),
                                 regular,true,pars2,init2,initial_stochastic_distribution2,ultimate_delay_condition2);
+          pop_alphabet_bound();
           // Encode the actions of the block list in one multi action.
           parallelcomposition(action_summands1,deadlock_summands1,pars1,init1,initial_stochastic_distribution1,ultimate_delay_condition1,
                                 action_summands2,deadlock_summands2,pars2,init2,initial_stochastic_distribution2,ultimate_delay_condition2,
                                 action_name_multiset_list({action_name_multiset(block(t).block_set())}),false,true,
                                 action_summands,deadlock_summands,pars,init,initial_stochastic_distribution,ultimate_delay_condition);
+          pop_alphabet_bound();
           return;
         }
         else if (!options.nodeltaelimination && options.ignore_time && is_comm(par))
         {
+          push_alphabet_bound([&](const allow_set& A){ return process::alphabet_operations::comm_inverse(comm(par).comm_set(),A); });
           generateLPEmCRLterm(action_summands,deadlock_summands,comm(par).operand(),
                                 regular,rename_variables,pars,init,initial_stochastic_distribution,ultimate_delay_condition);
+          pop_alphabet_bound();
           // Encode the actions of the block list in one multi action.
           communicationcomposition(comm(par).comm_set(),action_name_multiset_list( { action_name_multiset(block(t).block_set())} ),
                                                      false,true,action_summands,deadlock_summands);
+          pop_alphabet_bound();
           return;
         }
 
         generateLPEmCRLterm(action_summands,deadlock_summands,par,regular,rename_variables,pars,init,initial_stochastic_distribution,ultimate_delay_condition);
+        pop_alphabet_bound();
         // Encode the actions of the block list in one multi action.
         allowblockcomposition(action_name_multiset_list({action_name_multiset(block(t).block_set())}),false,action_summands,deadlock_summands);
         return;
@@ -9475,16 +9678,20 @@ class specification_basic_type
 
       if (is_rename(t))
       {
+        push_alphabet_bound([&](const allow_set& A){ return process::alphabet_operations::rename_inverse(process::rename(t).rename_set(),A); });
         generateLPEmCRLterm(action_summands,deadlock_summands,process::rename(t).operand(),
                               regular,rename_variables,pars,init,initial_stochastic_distribution,ultimate_delay_condition);
+        pop_alphabet_bound();
         renamecomposition(process::rename(t).rename_set(),action_summands);
         return;
       }
 
       if (is_comm(t))
       {
+        push_alphabet_bound([&](const allow_set& A){ return process::alphabet_operations::comm_inverse(comm(t).comm_set(),A); });
         generateLPEmCRLterm(action_summands,deadlock_summands,comm(t).operand(),
                               regular,rename_variables,pars,init,initial_stochastic_distribution,ultimate_delay_condition);
+        pop_alphabet_bound();
         communicationcomposition(comm(t).comm_set(),action_name_multiset_list(),false,false,action_summands,deadlock_summands);
         return;
       }
@@ -11265,6 +11472,11 @@ class specification_basic_type
          first variable in a sequence is always an actionvariable */
       procstorealGNF(init_,options.lin_method!=lmStack);
 
+      if (options.alphabet_pruning && !alphabet_pruning_enabled())
+      {
+        mCRL2log(mcrl2::log::warning) << "Alphabet pruning is not applied, as it cannot be combined with timed linearisation or the option no-deltaelm.\n";
+      }
+
       lps::detail::ultimate_delay dummy_ultimate_delay_condition;
       generateLPEmCRL(action_summands,
                       deadlock_summands,
@@ -11274,6 +11486,11 @@ class specification_basic_type
                       initial_state,
                       initial_stochastic_distribution,
                       dummy_ultimate_delay_condition);
+      if (alphabet_pruning_enabled())
+      {
+        mCRL2log(mcrl2::log::verbose) << "- alphabet pruning removed " << number_of_pruned_summands <<
+              " multi-actions while combining summands.\n";
+      }
       allowblockcomposition(action_name_multiset_list({action_name_multiset()}),false,action_summands,deadlock_summands); // This removes superfluous delta summands.
       if (options.final_cluster)
       {
@@ -0,0 +1,66 @@
+// Author(s): Wieger Wesselink
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file bitstate_state_set_test.cpp
+/// \brief Tests for the bitstate state set.
+
+#define BOOST_TEST_MODULE bitstate_state_set_test
+#include "mcrl2/data/standard_numbers_utility.h"
+#include "mcrl2/lps/bitstate_state_set.h"
+
+#include <boost/test/included/unit_test_framework.hpp>
+
+using namespace mcrl2;
+using namespace mcrl2::lps;
+
+inline
+state make_state(std::size_t x, std::size_t y)
+{
+  std::vector<data::data_expression> v = { data::sort_nat::nat(x), data::sort_nat::nat(y) };
+  return state(v.begin(), v.size());
+}
+
+BOOST_AUTO_TEST_CASE(test_bitstate_state_set)
+{
+  // With a large table, omissions are very unlikely.
+  bitstate_state_set states(1 << 20, 1);
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    auto [index, is_new] = states.insert(make_state(i, i + 1));
+    BOOST_CHECK(is_new);
+    BOOST_CHECK_EQUAL(index, i);
+  }
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    auto [index, is_new] = states.insert(make_state(i, i + 1));
+    BOOST_CHECK(!is_new);
+    BOOST_CHECK_EQUAL(index, bitstate_state_set::npos);
+  }
+  BOOST_CHECK_EQUAL(states.size(), 100u);
+  BOOST_CHECK(states.fill_ratio() > 0);
+  BOOST_CHECK(states.omission_probability() < 1e-6);
+
+  states.clear();
+  BOOST_CHECK_EQUAL(states.size(), 0u);
+  BOOST_CHECK_EQUAL(states.fill_ratio(), 0);
+  BOOST_CHECK(states.insert(make_state(0, 1)).second);
+}
+
+// A state that is no longer in memory must still be recognized when it is created again.
+BOOST_AUTO_TEST_CASE(test_bitstate_state_set_recreated_states)
+{
+  bitstate_state_set states(1 << 20, 2);
+  for (std::size_t i = 0; i < 1000; ++i)
+  {
+    BOOST_CHECK(states.insert(make_state(i, 2 * i)).second);
+  }
+  for (std::size_t i = 0; i < 1000; ++i)
+  {
+    BOOST_CHECK(!states.insert(make_state(i, 2 * i)).second);
+  }
+}
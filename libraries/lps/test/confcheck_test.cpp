@@ -54,6 +54,19 @@ void run_confluence_test_case(const std::string& s, const std::size_t ctau_count
   checker1.check_confluence_and_mark(data::sort_bool::true_(),0);
 
   BOOST_CHECK_EQUAL(count_ctau(s0), ctau_count);
+
+  // The marked specification does not depend on the number of threads that prove the confluence conditions.
+  if (atermpp::detail::GlobalThreadSafe)
+  {
+    for (std::size_t number_of_threads: { 2, 4 })
+    {
+      specification s1 = parse_linear_process_specification(s);
+      Confluence_Checker<specification> checker2(s1, data::jitty, 0, false, data::detail::solver_type_cvc, false,
+                                                 false, false, "c", false, false, std::string(), number_of_threads);
+      checker2.check_confluence_and_mark(data::sort_bool::true_(),0);
+      BOOST_CHECK(s1 == s0);
+    }
+  }
 }
 
 BOOST_AUTO_TEST_CASE(case_1)
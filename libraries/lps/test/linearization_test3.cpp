@@ -124,6 +124,71 @@ BOOST_AUTO_TEST_CASE(type_checking_a_finite_set_with_numbers_can_go_astray)
   run_linearisation_test_case(spec,true);
 }
 
+// The summands of parallel and communication compositions are combined by several threads when
+// the term library is thread-safe. The resulting LPS must not depend on the number of threads.
+BOOST_AUTO_TEST_CASE(parallel_linearisation_does_not_depend_on_the_number_of_threads)
+{
+  const std::string spec =
+     "act\n"
+     "  s1, r1, c1, s2, r2, c2: Nat;\n"
+     "  done;\n"
+     "\n"
+     "proc\n"
+     "  P(n: Nat) = sum m: Nat . (m < 3) -> s1(m) . P(n + m) + (n > 4) -> done . P(0);\n"
+     "  Q(n: Nat) = sum m: Nat . r1(m) . s2(m + n) . Q(m) + tau . Q(n);\n"
+     "  R(n: Nat) = sum m: Nat . (m < n + 2) -> r2(m) . R(m) + done . R(n);\n"
+     "\n"
+     "init\n"
+     "  allow({c1, c2, done}, comm({s1|r1 -> c1, s2|r2 -> c2}, P(0) || Q(1) || R(2) || Q(2)));\n";
+
+  t_lin_options options;
+  options.no_intermediate_cluster=true;
+  const lps::stochastic_specification expected=linearise(spec, options);
+  BOOST_CHECK(expected != lps::stochastic_specification());
+
+  if (atermpp::detail::GlobalThreadSafe)
+  {
+    for (std::size_t number_of_threads: { 2, 3, 4 })
+    {
+      options.number_of_threads=number_of_threads;
+      BOOST_CHECK(linearise(spec, options) == expected);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(alphabet_pruning_does_not_change_the_action_summands)
+{
+  const std::string spec =
+     "act\n"
+     "  a, b, c, d, e;\n"
+     "\n"
+     "proc\n"
+     "  P = a . P + d . P;\n"
+     "  Q = b . Q + e . Q;\n"
+     "  R = c . R + d . R;\n"
+     "\n"
+     "init\n"
+     "  allow({a|b, c, e}, hide({d}, P || Q) || R);\n";
+
+  t_lin_options options;
+  options.apply_alphabet_axioms=false;
+  const lps::stochastic_specification expected=linearise(spec, options);
+  options.alphabet_pruning=true;
+  const lps::stochastic_specification pruned=linearise(spec, options);
+
+  std::multiset<lps::multi_action> expected_actions;
+  for (const lps::stochastic_action_summand& summand: expected.process().action_summands())
+  {
+    expected_actions.insert(summand.multi_action());
+  }
+  std::multiset<lps::multi_action> pruned_actions;
+  for (const lps::stochastic_action_summand& summand: pruned.process().action_summands())
+  {
+    pruned_actions.insert(summand.multi_action());
+  }
+  BOOST_CHECK(expected_actions == pruned_actions);
+}
+
 #ifndef MCRL2_SKIP_LONG_TESTS 
 
 BOOST_AUTO_TEST_CASE(Type_checking_of_function_can_be_problematic)
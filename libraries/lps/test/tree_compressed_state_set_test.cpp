@@ -0,0 +1,82 @@
+// Author(s): Wieger Wesselink
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file tree_compressed_state_set_test.cpp
+/// \brief Tests for the tree compressed state set.
+
+#define BOOST_TEST_MODULE tree_compressed_state_set_test
+#include "mcrl2/data/standard_numbers_utility.h"
+#include "mcrl2/lps/tree_compressed_state_set.h"
+
+#include <boost/test/included/unit_test_framework.hpp>
+
+using namespace mcrl2;
+using namespace mcrl2::lps;
+
+inline
+state make_state(const std::vector<std::size_t>& values)
+{
+  std::vector<data::data_expression> v;
+  for (std::size_t x: values)
+  {
+    v.push_back(data::sort_nat::nat(x));
+  }
+  return state(v.begin(), v.size());
+}
+
+void test_arity(std::size_t arity)
+{
+  tree_compressed_state_set states;
+  std::vector<state> inserted;
+
+  // Generate states that differ in one or two parameters, such that nodes are shared.
+  for (std::size_t i = 0; i < 50; ++i)
+  {
+    std::vector<std::size_t> values(arity, 0);
+    if (arity > 0)
+    {
+      values[i % arity] = i;
+      values[(3 * i) % arity] += 1;
+    }
+    state s = make_state(values);
+    auto [index, is_new] = states.insert(s);
+    if (is_new)
+    {
+      BOOST_CHECK_EQUAL(index, inserted.size());
+      inserted.push_back(s);
+    }
+    else
+    {
+      BOOST_CHECK(inserted[index] == s);
+    }
+  }
+
+  BOOST_CHECK_EQUAL(states.size(), inserted.size());
+  for (std::size_t i = 0; i < inserted.size(); ++i)
+  {
+    BOOST_CHECK(states[i] == inserted[i]);
+    BOOST_CHECK_EQUAL(states.index(inserted[i]), i);
+  }
+
+  if (arity > 0)
+  {
+    BOOST_CHECK_EQUAL(states.index(make_state(std::vector<std::size_t>(arity, 1000))), tree_compressed_state_set::npos);
+  }
+
+  states.clear();
+  BOOST_CHECK_EQUAL(states.size(), 0u);
+  BOOST_CHECK_EQUAL(states.index(inserted.front()), tree_compressed_state_set::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_tree_compressed_state_set)
+{
+  for (std::size_t arity: { 0, 1, 2, 3, 5, 8, 13 })
+  {
+    test_arity(arity);
+  }
+}
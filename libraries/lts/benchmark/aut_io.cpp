@@ -0,0 +1,80 @@
+// Author(s): Jan Friso Groote
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/lts/lts_aut.h"
+#include "mcrl2/utilities/stopwatch.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace mcrl2;
+using namespace mcrl2::utilities;
+
+static void report(const std::string& what, const std::size_t bytes, const long long milliseconds)
+{
+  std::cerr << what << " " << bytes / (1 << 20) << " MB took " << milliseconds << " milliseconds ("
+            << (milliseconds == 0 ? 0.0 : static_cast<double>(bytes) / (1 << 20) / (milliseconds / 1000.0)) << " MB/s).\n";
+}
+
+/// \brief Benchmark writing and reading a random lts in .aut format, and report the throughput. The optional
+///        arguments are the number of transitions and the name of the file that is used.
+int main(int argc, char* argv[])
+{
+  const std::size_t number_of_transitions = argc > 1 ? std::stoul(argv[1]) : 10000000;
+  const std::string filename = argc > 2 ? argv[2] : "benchmark_lts_aut_io.aut";
+  const std::size_t number_of_states = number_of_transitions / 4 + 1;
+  const std::size_t number_of_labels = 100;
+
+  lts::lts_aut_t l;
+  l.set_num_states(number_of_states, false);
+  for (std::size_t i = 1; i < number_of_labels; ++i)
+  {
+    l.add_action(lts::action_label_string("a" + std::to_string(i) + "(" + std::to_string(i * i) + ", true)"));
+  }
+  std::mt19937 generator(1);
+  std::uniform_int_distribution<std::size_t> state(0, number_of_states - 1);
+  std::uniform_int_distribution<std::size_t> label(0, number_of_labels - 1);
+  for (std::size_t i = 0; i < number_of_transitions; ++i)
+  {
+    l.add_transition(lts::transition(state(generator), label(generator), state(generator)));
+  }
+
+  stopwatch timer;
+  l.save(filename);
+  std::size_t bytes = 0;
+  {
+    std::ifstream is(filename, std::ifstream::binary | std::ifstream::ate);
+    bytes = is.tellg();
+  }
+  report("Writing", bytes, timer.time());
+
+  timer.reset();
+  lts::lts_aut_t from_file;
+  from_file.load(filename);
+  report("Reading from a file", bytes, timer.time());
+
+  timer.reset();
+  lts::lts_aut_t from_stream;
+  {
+    std::ifstream is(filename);
+    from_stream.load(is);
+  }
+  report("Reading from a stream", bytes, timer.time());
+
+  std::remove(filename.c_str());
+  if (from_file.num_transitions() != l.num_transitions() || from_file.get_transitions() != from_stream.get_transitions())
+  {
+    std::cerr << "The lts that is read from the file differs from the lts that is read from the stream.\n";
+    return 1;
+  }
+  return 0;
+}
@@ -18,6 +18,7 @@
 #ifndef _LIBLTS_COUNTER_EXAMPLE_H
 #define _LIBLTS_COUNTER_EXAMPLE_H
 
+#include "mcrl2/lts/action_label_string.h"
 #include "mcrl2/lts/lts_lts.h"
 #include "mcrl2/trace/trace.h"
 
@@ -0,0 +1,533 @@
+// Author(s): Jeroen Keiren
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file lts/detail/liblts_bisim_par.h
+///
+/// \brief Parallel partition refinement for strong and (divergence-preserving)
+/// branching bisimulation.
+///
+/// \details The algorithm maintains a partition of the states in blocks, which
+/// are refined in rounds, in the spirit of the parallel partition refinement
+/// algorithms of Martens, Groote, van den Haak, Hijma and Wijs (2021).  In a
+/// round, the signatures of the states in all unstable blocks are computed in
+/// parallel, as in [Blom/Orzan 2003].  Every unstable block is then split into
+/// the sets of states with the same signature; the largest set keeps the block
+/// number and the other sets become new blocks.  A block is only unstable in
+/// the next round if it contains a predecessor of a state that moved to a new
+/// block (for branching bisimulation also the new blocks themselves), as the
+/// signatures of the states in other blocks do not change.  Contrary to the
+/// signature refinement in sigref.h, the work of a round is therefore
+/// proportional to the part of the LTS that is refined, and not to the LTS as
+/// a whole.
+
+#ifndef MCRL2_LTS_LIBLTS_BISIM_PAR_H
+#define MCRL2_LTS_LIBLTS_BISIM_PAR_H
+
+#include <atomic>
+#include <memory>
+#include "mcrl2/lts/sigref.h"
+
+namespace mcrl2
+{
+namespace lts
+{
+namespace detail
+{
+
+/// \brief Sorts [first, last) using \a number_of_threads threads. Every thread sorts a consecutive part of the
+///        range, after which the parts are merged pairwise, again in parallel.
+template <typename Iterator, typename Compare>
+void parallel_sort(Iterator first, Iterator last, Compare less, const std::size_t number_of_threads)
+{
+  const std::size_t n = last - first;
+  if (number_of_threads <= 1 || n < number_of_threads)
+  {
+    std::sort(first, last, less);
+    return;
+  }
+  std::vector<std::size_t> bounds(number_of_threads + 1);
+  for (std::size_t i = 0; i <= number_of_threads; ++i)
+  {
+    bounds[i] = i * n / number_of_threads;
+  }
+  sigref_parallel_for(number_of_threads, number_of_threads,
+    [&](std::size_t, std::size_t part_first, std::size_t part_last)
+    {
+      for (std::size_t part = part_first; part < part_last; ++part)
+      {
+        std::sort(first + bounds[part], first + bounds[part + 1], less);
+      }
+    });
+  for (std::size_t width = 1; width < number_of_threads; width *= 2)
+  {
+    const std::size_t number_of_merges = (number_of_threads + 2 * width - 1) / (2 * width);
+    sigref_parallel_for(number_of_merges, number_of_threads,
+      [&](std::size_t, std::size_t merge_first, std::size_t merge_last)
+      {
+        for (std::size_t merge = merge_first; merge < merge_last; ++merge)
+        {
+          const std::size_t low = 2 * width * merge;
+          const std::size_t middle = std::min(low + width, number_of_threads);
+          const std::size_t high = std::min(low + 2 * width, number_of_threads);
+          if (middle < high)
+          {
+            std::inplace_merge(first + bounds[low], first + bounds[middle], first + bounds[high], less);
+          }
+        }
+      });
+  }
+}
+
+template <class LTS_TYPE>
+class bisim_partitioner_par
+{
+  protected:
+    /// \brief A block consists of the states m_states[begin], ..., m_states[end - 1].
+    struct block_t
+    {
+      std::size_t begin;
+      std::size_t end;
+    };
+
+    /// \brief The minimal amount of work per thread, below which a single thread is used.
+    static constexpr std::size_t m_grain_size = 1024;
+
+    LTS_TYPE& m_lts;
+    const bool m_branching;
+    const bool m_preserve_divergence;
+    const std::size_t m_number_of_threads;
+
+    /// \brief The outgoing and incoming transitions, as shared with the LTS.
+    const std::shared_ptr<const indexed_transitions> m_outgoing_transitions;
+    const indexed_transitions& m_outgoing;
+    const std::shared_ptr<const indexed_transitions> m_incoming_transitions;
+    const indexed_transitions& m_incoming;
+
+    /// \brief The hidden label map, applied to each label.
+    std::vector<std::size_t> m_label_map;
+
+    /// \brief The block of each state.
+    std::vector<std::size_t> m_block;
+
+    /// \brief The states, ordered such that the states of a block are consecutive.
+    std::vector<std::size_t> m_states;
+
+    /// \brief The blocks. There are never more blocks than states, such that new blocks can be
+    ///        stored by different threads without reallocating this vector.
+    std::vector<block_t> m_blocks;
+    std::atomic<std::size_t> m_number_of_blocks;
+
+    /// \brief Indicates per block whether it has been found to be unstable in the current round.
+    std::unique_ptr<std::atomic<bool>[]> m_unstable;
+
+    /// \brief The level of each state in the graph of tau transitions; only used for branching bisimulation.
+    std::vector<std::size_t> m_level;
+
+    /// \brief Indicates per state whether it has a tau-loop; only used if divergence is preserved.
+    std::vector<bool> m_divergent;
+
+    /// \brief The signature of each state, and its hash, which are only up to date for the states of the
+    ///        blocks that are refined in the current round.
+    std::vector<signature_t> m_sig;
+    std::vector<std::size_t> m_hash;
+
+    std::size_t label_of(const std::size_t i) const
+    {
+      return m_label_map[m_outgoing.get_transitions()[i].label()];
+    }
+
+    std::size_t target_of(const std::size_t i) const
+    {
+      return m_outgoing.get_transitions()[i].state();
+    }
+
+    bool is_inert(const std::size_t s, const std::size_t label, const std::size_t t) const
+    {
+      return m_branching && m_lts.is_tau(label) && m_block[s] == m_block[t];
+    }
+
+    /// \brief Applies f(index, first, last) to ranges that together form [0, n), in parallel if there is enough
+    ///        work for the threads.
+    template <typename Function>
+    void parallel_for(const std::size_t n, Function f) const
+    {
+      sigref_parallel_for(n, n < m_grain_size * m_number_of_threads ? 1 : m_number_of_threads, f);
+    }
+
+    /// \brief Computes the signatures and their hashes for the given states, which form a set of blocks.
+    void compute_signatures(const std::vector<std::size_t>& states)
+    {
+      // Compute the pairs of the non-inert transitions.
+      parallel_for(states.size(), [&](std::size_t, std::size_t first, std::size_t last)
+        {
+          for (std::size_t j = first; j < last; ++j)
+          {
+            const std::size_t s = states[j];
+            signature_t& sig = m_sig[s];
+            sig.clear();
+            for (std::size_t i = m_outgoing.lowerbound(s); i < m_outgoing.upperbound(s); ++i)
+            {
+              const std::size_t t = target_of(i);
+              if (!is_inert(s, label_of(i), t) || (m_preserve_divergence && m_divergent[t]))
+              {
+                sig.emplace_back(label_of(i), m_block[t]);
+              }
+            }
+            normalise_signature(sig);
+          }
+        });
+
+      if (m_branching)
+      {
+        // Add the signatures of the inert tau-successors, which are in the same block and in lower levels.
+        std::vector<std::size_t> states_by_level;
+        for (const std::size_t s: states)
+        {
+          if (m_level[s] > 0)
+          {
+            states_by_level.push_back(s);
+          }
+        }
+        std::sort(states_by_level.begin(), states_by_level.end(),
+                  [&](std::size_t s, std::size_t t) { return m_level[s] < m_level[t]; });
+        for (std::size_t begin = 0; begin < states_by_level.size(); )
+        {
+          std::size_t end = begin;
+          while (end < states_by_level.size() && m_level[states_by_level[end]] == m_level[states_by_level[begin]])
+          {
+            ++end;
+          }
+          parallel_for(end - begin, [&](std::size_t, std::size_t first, std::size_t last)
+            {
+              for (std::size_t j = begin + first; j < begin + last; ++j)
+              {
+                const std::size_t s = states_by_level[j];
+                signature_t& sig = m_sig[s];
+                const std::size_t size = sig.size();
+                for (std::size_t i = m_outgoing.lowerbound(s); i < m_outgoing.upperbound(s); ++i)
+                {
+                  const std::size_t t = target_of(i);
+                  if (t != s && is_inert(s, label_of(i), t))
+                  {
+                    sig.insert(sig.end(), m_sig[t].begin(), m_sig[t].end());
+                  }
+                }
+                if (sig.size() != size)
+                {
+                  normalise_signature(sig);
+                }
+              }
+            });
+          begin = end;
+        }
+      }
+
+      parallel_for(states.size(), [&](std::size_t, std::size_t first, std::size_t last)
+        {
+          for (std::size_t j = first; j < last; ++j)
+          {
+            m_hash[states[j]] = hash_signature(m_sig[states[j]]);
+          }
+        });
+    }
+
+    /// \brief Splits block b into the sets of states with the same signature. The largest set keeps the block
+    ///        number b.
+    void split_block(const std::size_t b, const std::size_t number_of_threads)
+    {
+      auto less = [&](std::size_t s, std::size_t t)
+        {
+          return m_hash[s] < m_hash[t] || (m_hash[s] == m_hash[t] && m_sig[s] < m_sig[t]);
+        };
+      auto equal = [&](std::size_t s, std::size_t t)
+        {
+          return m_hash[s] == m_hash[t] && m_sig[s] == m_sig[t];
+        };
+
+      const block_t block = m_blocks[b];
+      parallel_sort(m_states.begin() + block.begin, m_states.begin() + block.end, less, number_of_threads);
+
+      auto end_of_set = [&](const std::size_t begin)
+        {
+          std::size_t end = begin + 1;
+          while (end < block.end && equal(m_states[begin], m_states[end]))
+          {
+            ++end;
+          }
+          return end;
+        };
+
+      // Find the number of sets and the largest set.
+      std::size_t number_of_sets = 0;
+      block_t largest{ block.begin, block.begin };
+      std::size_t begin = block.begin;
+      while (begin < block.end)
+      {
+        const std::size_t end = end_of_set(begin);
+        ++number_of_sets;
+        if (end - begin > largest.end - largest.begin)
+        {
+          largest = block_t{ begin, end };
+        }
+        begin = end;
+      }
+      if (number_of_sets == 1)
+      {
+        return;
+      }
+
+      std::size_t new_block = m_number_of_blocks.fetch_add(number_of_sets - 1);
+      begin = block.begin;
+      while (begin < block.end)
+      {
+        const std::size_t end = end_of_set(begin);
+        if (begin != largest.begin)
+        {
+          m_blocks[new_block] = block_t{ begin, end };
+          for (std::size_t j = begin; j < end; ++j)
+          {
+            m_block[m_states[j]] = new_block;
+          }
+          ++new_block;
+        }
+        begin = end;
+      }
+      m_blocks[b] = largest;
+    }
+
+    /// \brief Returns the blocks that must be refined after the blocks first_block, ..., last_block - 1 have
+    ///        been split off, and hence their states have moved to another block.
+    std::vector<std::size_t> unstable_blocks(const std::size_t first_block, const std::size_t last_block)
+    {
+      std::vector<std::vector<std::size_t> > found(m_number_of_threads);
+      auto mark = [&](std::size_t index, std::size_t b)
+        {
+          if (!m_unstable[b].exchange(true))
+          {
+            found[index].push_back(b);
+          }
+        };
+      parallel_for(last_block - first_block, [&](std::size_t index, std::size_t first, std::size_t last)
+        {
+          for (std::size_t b = first_block + first; b < first_block + last; ++b)
+          {
+            if (m_branching)
+            {
+              // The transitions to the old block may no longer be inert.
+              mark(index, b);
+            }
+            for (std::size_t j = m_blocks[b].begin; j < m_blocks[b].end; ++j)
+            {
+              const std::size_t s = m_states[j];
+              for (std::size_t i = m_incoming.lowerbound(s); i < m_incoming.upperbound(s); ++i)
+              {
+                mark(index, m_block[m_incoming.get_transitions()[i].state()]);
+              }
+            }
+          }
+        });
+
+      std::vector<std::size_t> result;
+      for (const std::vector<std::size_t>& blocks: found)
+      {
+        result.insert(result.end(), blocks.begin(), blocks.end());
+      }
+      for (const std::size_t b: result)
+      {
+        m_unstable[b] = false;
+      }
+      return result;
+    }
+
+    /// \brief Refines the partition until it is stable.
+    void refine()
+    {
+      std::vector<std::size_t> unstable(1, 0);
+      std::vector<std::size_t> states;
+      std::size_t iterations = 0;
+      while (!unstable.empty())
+      {
+        mCRL2log(log::verbose) << "Iteration " << iterations << ": refining " << unstable.size() << " of "
+                               << m_number_of_blocks << " blocks" << std::endl;
+
+        // Collect the states of the unstable blocks.
+        std::vector<std::size_t> offsets(unstable.size() + 1, 0);
+        for (std::size_t i = 0; i < unstable.size(); ++i)
+        {
+          offsets[i + 1] = offsets[i] + m_blocks[unstable[i]].end - m_blocks[unstable[i]].begin;
+        }
+        states.resize(offsets.back());
+        parallel_for(unstable.size(), [&](std::size_t, std::size_t first, std::size_t last)
+          {
+            for (std::size_t i = first; i < last; ++i)
+            {
+              std::copy(m_states.begin() + m_blocks[unstable[i]].begin, m_states.begin() + m_blocks[unstable[i]].end,
+                        states.begin() + offsets[i]);
+            }
+          });
+
+        compute_signatures(states);
+
+        // Split the blocks that have a large share of the states one by one, using all threads, and the other
+        // blocks in parallel.
+        const std::size_t first_new_block = m_number_of_blocks;
+        std::vector<std::size_t> small_blocks;
+        for (const std::size_t b: unstable)
+        {
+          const std::size_t size = m_blocks[b].end - m_blocks[b].begin;
+          if (m_number_of_threads > 1 && size >= m_grain_size && size * m_number_of_threads >= states.size())
+          {
+            split_block(b, m_number_of_threads);
+          }
+          else
+          {
+            small_blocks.push_back(b);
+          }
+        }
+        sigref_parallel_for(small_blocks.size(), states.size() < m_grain_size * m_number_of_threads ? 1 : m_number_of_threads,
+          [&](std::size_t, std::size_t first, std::size_t last)
+          {
+            for (std::size_t i = first; i < last; ++i)
+            {
+              split_block(small_blocks[i], 1);
+            }
+          });
+
+        unstable = unstable_blocks(first_new_block, m_number_of_blocks);
+        ++iterations;
+      }
+      mCRL2log(log::verbose) << "Done after " << iterations << " iterations with " << m_number_of_blocks
+                             << " blocks" << std::endl;
+    }
+
+  public:
+    /// \brief Constructor
+    /// \pre If branching is true, the LTS does not contain tau-cycles, other than tau-loops.
+    bisim_partitioner_par(LTS_TYPE& l, const bool branching, const bool preserve_divergence,
+                          const std::size_t number_of_threads)
+      : m_lts(l),
+        m_branching(branching),
+        m_preserve_divergence(branching && preserve_divergence),
+        m_number_of_threads(std::max<std::size_t>(1, number_of_threads)),
+        m_outgoing_transitions(l.outgoing_transitions()),
+        m_outgoing(*m_outgoing_transitions),
+        m_incoming_transitions(l.incoming_transitions()),
+        m_incoming(*m_incoming_transitions),
+        m_label_map(l.num_action_labels()),
+        m_block(l.num_states(), 0),
+        m_states(l.num_states()),
+        m_blocks(l.num_states(), block_t{ 0, l.num_states() }),
+        m_number_of_blocks(1),
+        m_unstable(new std::atomic<bool>[l.num_states()]),
+        m_sig(l.num_states()),
+        m_hash(l.num_states())
+    {
+      for (std::size_t i = 0; i < m_label_map.size(); ++i)
+      {
+        m_label_map[i] = m_lts.apply_hidden_label_map(i);
+      }
+      std::iota(m_states.begin(), m_states.end(), 0);
+      for (std::size_t b = 0; b < l.num_states(); ++b)
+      {
+        m_unstable[b] = false;
+      }
+      if (m_branching)
+      {
+        m_level = compute_tau_levels(m_lts, m_outgoing, m_label_map);
+      }
+      if (m_preserve_divergence)
+      {
+        m_divergent.assign(l.num_states(), false);
+        for (std::size_t s = 0; s < l.num_states(); ++s)
+        {
+          for (std::size_t i = m_outgoing.lowerbound(s); i < m_outgoing.upperbound(s); ++i)
+          {
+            if (target_of(i) == s && m_lts.is_tau(label_of(i)))
+            {
+              m_divergent[s] = true;
+            }
+          }
+        }
+      }
+      refine();
+    }
+
+    /// \brief Replaces the LTS by its quotient with respect to the computed partition.
+    /// \details The blocks are numbered in the order of their first state, starting with the block of the
+    ///          initial state, such that the result does not depend on the order in which the threads split
+    ///          the blocks. Inert transitions are removed, except the tau-loops of divergent states if divergence
+    ///          is preserved.
+    void finalize_minimized_LTS()
+    {
+      const std::size_t number_of_blocks = m_number_of_blocks;
+      std::vector<std::size_t> block_number(number_of_blocks, number_of_blocks);
+      std::size_t next_block = 0;
+      block_number[m_block[m_lts.initial_state()]] = next_block++;
+      for (std::size_t s = 0; s < m_block.size(); ++s)
+      {
+        if (block_number[m_block[s]] == number_of_blocks)
+        {
+          block_number[m_block[s]] = next_block++;
+        }
+      }
+
+      std::vector<transition> transitions;
+      for (std::size_t s = 0; s < m_lts.num_states(); ++s)
+      {
+        for (std::size_t i = m_outgoing.lowerbound(s); i < m_outgoing.upperbound(s); ++i)
+        {
+          const std::size_t t = target_of(i);
+          if (!is_inert(s, label_of(i), t) || (m_preserve_divergence && t == s && m_divergent[s]))
+          {
+            transitions.emplace_back(block_number[m_block[s]], label_of(i), block_number[m_block[t]]);
+          }
+        }
+      }
+      std::sort(transitions.begin(), transitions.end());
+      transitions.erase(std::unique(transitions.begin(), transitions.end()), transitions.end());
+
+      m_lts.set_num_states(number_of_blocks);
+      m_lts.set_initial_state(block_number[m_block[m_lts.initial_state()]]);
+      m_lts.clear_transitions(transitions.size());
+      for (const transition& t: transitions)
+      {
+        m_lts.add_transition(t);
+      }
+    }
+};
+
+/// \brief Reduce transition system l with respect to strong or (divergence-preserving) branching bisimulation,
+///        using parallel partition refinement.
+/// \param[in,out] l                   The transition system that is reduced.
+/// \param         branching           If true branching bisimulation is applied, otherwise strong bisimulation.
+/// \param         preserve_divergence Indicates whether loops of internal actions on states must be preserved.
+/// \param         number_of_threads   The number of threads that is used. Small LTSs are always reduced using a
+///                                    single thread.
+template <class LTS_TYPE>
+void bisimulation_reduce_par(LTS_TYPE& l, const bool branching = false, const bool preserve_divergence = false,
+                             const std::size_t number_of_threads = 1)
+{
+  l.clear_state_labels();
+  if (branching)
+  {
+    scc_reduce(l, preserve_divergence, number_of_threads);
+  }
+  if (l.num_states() == 0)
+  {
+    return;
+  }
+  bisim_partitioner_par<LTS_TYPE> bisim_part(l, branching, preserve_divergence,
+                                             l.num_states() < 10000 ? 1 : number_of_threads);
+  bisim_part.finalize_minimized_LTS();
+}
+
+} // namespace detail
+} // namespace lts
+} // namespace mcrl2
+
+#endif // MCRL2_LTS_LIBLTS_BISIM_PAR_H
@@ -96,8 +96,8 @@ namespace detail
   {
     protected:
       LTS_TYPE& m_l;
+      std::shared_ptr<const indexed_transitions> m_outgoing_transitions;
       std::vector<std::vector<state_type> > m_tau_reachable_states;
-      std::vector<std::vector<transition> > m_sorted_transitions;
       std::vector<bool> m_divergent;
       std::vector<action_label_set> m_enabled_actions;
 
@@ -105,21 +105,21 @@ namespace detail
       void calculate_weak_property_cache(const bool weak_reduction)
       {
         scc_partitioner<LTS_TYPE> strongly_connected_component_partitioner(m_l);
-        for(const transition& t: m_l.get_transitions())
+        for(state_type s=0; s<m_l.num_states(); ++s)
         {
-          assert(t.from()<m_l.num_states());
-          if (m_l.is_tau(m_l.apply_hidden_label_map(t.label())) && weak_reduction)
+          for(const label_state_pair& t: m_outgoing_transitions->transitions(s))
           {
-            m_tau_reachable_states[t.from()].push_back(t.to());  // There is an outgoing tau.
-          }
-          m_sorted_transitions[t.from()].push_back(t);
-
-          if (weak_reduction && m_l.is_tau(m_l.apply_hidden_label_map(t.label())) &&
-              strongly_connected_component_partitioner.in_same_class(t.from(),t.to()))
-          {
-            m_divergent[t.from()]=true;  // There is a self loop.
+            const label_type a=m_l.apply_hidden_label_map(t.label());
+            if (m_l.is_tau(a) && weak_reduction)
+            {
+              m_tau_reachable_states[s].push_back(t.state());  // There is an outgoing tau.
+              if (strongly_connected_component_partitioner.in_same_class(s,t.state()))
+              {
+                m_divergent[s]=true;  // There is a self loop.
+              }
+            }
+            m_enabled_actions[s].insert(a);
           }
-          m_enabled_actions[t.from()].insert(m_l.apply_hidden_label_map(t.label()));
         }
       }
 
@@ -127,8 +127,8 @@ namespace detail
 
       lts_cache(/* const */ LTS_TYPE& l, const bool weak_reduction)    /* l is not changed, but the use of the scc partitioner requires l to be non const */
         : m_l(l),
+          m_outgoing_transitions(l.outgoing_transitions()),
           m_tau_reachable_states(l.num_states()),
-          m_sorted_transitions(l.num_states()),
           m_divergent(l.num_states(),false),
           m_enabled_actions(l.num_states())
       {
@@ -145,10 +145,10 @@ namespace detail
         return m_tau_reachable_states[s];
       }
 
-      const std::vector<transition>& transitions(const state_type s) const
+      indexed_transitions::range transitions(const state_type s) const
       {
-        assert(s<m_sorted_transitions.size());
-        return m_sorted_transitions[s];
+        assert(s<m_outgoing_transitions->num_states());
+        return m_outgoing_transitions->transitions(s);
       }
 
       bool diverges(const state_type s) const
@@ -369,7 +369,7 @@ bool destructive_refinement_checker(
         }
       }
 
-      for(const transition& t: weak_property_cache.transitions(impl_spec.state()))
+      for(const label_state_pair& t: weak_property_cache.transitions(impl_spec.state()))
       {
         const typename COUNTER_EXAMPLE_CONSTRUCTOR::index_type new_counterexample_index=
                generate_counter_example.add_transition(t.label(),impl_spec.counter_example_index());
@@ -396,7 +396,7 @@ bool destructive_refinement_checker(
                                                     // if (impl',spec') in antichain is not true then
         ++stats.antichain_inserts;
         const detail::state_states_counter_example_index_triple < COUNTER_EXAMPLE_CONSTRUCTOR >
-                          impl_spec_counterex(t.to(),spec_prime,new_counterexample_index);
+                          impl_spec_counterex(t.state(),spec_prime,new_counterexample_index);
         if (detail::antichain_insert(anti_chain, impl_spec_counterex))
         {
           ++stats.antichain_misses;
@@ -476,13 +476,12 @@ namespace detail
     set_of_states states_reachable_via_e;
     for(const state_type s: set_before_action_e)
     {
-      for(const transition& t: weak_property_cache.transitions(s))
+      for(const label_state_pair& t: weak_property_cache.transitions(s))
       {
         {
           if (l.apply_hidden_label_map(t.label())==e)
           {
-            assert(set_before_action_e.count(t.from())>0);
-            states_reachable_via_e.insert(t.to());
+            states_reachable_via_e.insert(t.state());
           }
         }
       }
@@ -0,0 +1,543 @@
+// Author(s): Jan Friso Groote
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file lts/detail/liblts_on_the_fly_refinement.h
+
+// This file contains an on-the-fly variant of the antichain based refinement checks
+// in liblts_failures_refinement.h. Instead of two labelled transition systems it gets
+// two linear process specifications. The states and transitions of both are only
+// generated by an lps::explorer when the refinement check needs them. As the
+// check stops at the first counterexample, only a small part of the state spaces
+// is generated when the refinement does not hold.
+
+#ifndef LIBLTS_ON_THE_FLY_REFINEMENT_H
+#define LIBLTS_ON_THE_FLY_REFINEMENT_H
+
+#include "mcrl2/lps/explorer.h"
+#include "mcrl2/lts/detail/liblts_failures_refinement.h"
+#include "mcrl2/lts/lts_equivalence.h"
+#include "mcrl2/lts/lts_preorder.h"
+#include "mcrl2/utilities/indexed_set.h"
+
+namespace mcrl2
+{
+namespace lts
+{
+namespace detail
+{
+  /// \brief The action labels of the transitions generated for both specifications.
+  /// \details Actions with a name in tau_actions are removed from the multi-actions. The
+  ///          internal action has index 0.
+  class on_the_fly_action_labels
+  {
+    protected:
+      const std::vector<std::string> m_tau_actions;
+      utilities::indexed_set<lps::multi_action> m_labels;
+
+    public:
+      explicit on_the_fly_action_labels(const std::vector<std::string>& tau_actions)
+        : m_tau_actions(tau_actions)
+      {
+        m_labels.insert(action_label_lts::tau_action());
+      }
+
+      /// \brief Returns the index of the label of a transition with multi-action a.
+      label_type index(const lps::multi_action& a)
+      {
+        action_label_lts label(lps::multi_action(a.actions()));
+        if (!m_tau_actions.empty())
+        {
+          label.hide_actions(m_tau_actions);
+          label = action_label_lts(lps::multi_action(label.actions()));
+        }
+        return m_labels.insert(label).first;
+      }
+
+      bool is_tau(const label_type l) const
+      {
+        return l == 0;
+      }
+
+      /// \brief The action label with index l. The name matches the LTS classes such
+      ///        that a counter_example_constructor can save traces of these labels.
+      action_label_lts action_label(const label_type l) const
+      {
+        return action_label_lts(m_labels[l]);
+      }
+  };
+
+  /// \brief A transition system of which the states and transitions are generated on request.
+  /// \details The states are numbered in the order in which they are encountered. The outgoing
+  ///          transitions of a state are generated once, when they are requested for the first time.
+  class on_the_fly_lts
+  {
+    public:
+      typedef std::vector<std::pair<label_type, state_type> > transition_list;
+
+    protected:
+      typedef lps::explorer<false, false, lps::specification> explorer_type;
+
+      explorer_type m_explorer;
+      on_the_fly_action_labels& m_labels;
+      const bool m_weak_reduction;
+      utilities::indexed_set<lps::state> m_states;
+      std::vector<transition_list> m_transitions;
+      std::vector<bool> m_generated;
+      std::vector<action_label_set> m_enabled_actions;
+      std::vector<bool> m_stable;
+
+      // The divergence of a state is only known after the strongly connected component of
+      // internal transitions that contains the state has been determined.
+      enum class divergence : unsigned char { unknown, no, yes };
+      std::vector<divergence> m_divergent;
+
+      state_type add_state(const lps::state& s)
+      {
+        const std::pair<std::size_t, bool> p = m_states.insert(s);
+        if (p.second)
+        {
+          m_transitions.emplace_back();
+          m_generated.push_back(false);
+          m_enabled_actions.emplace_back();
+          m_stable.push_back(true);
+          m_divergent.push_back(divergence::unknown);
+        }
+        return p.first;
+      }
+
+      void generate_transitions(const state_type s)
+      {
+        transition_list transitions;
+        action_label_set enabled_actions;
+        bool stable = true;
+        const lps::state state = m_states[s];
+        for (const std::pair<lps::multi_action, lps::state>& t: m_explorer.generate_transitions(state))
+        {
+          const label_type a = m_labels.index(t.first);
+          transitions.emplace_back(a, add_state(t.second));
+          if (m_labels.is_tau(a) && m_weak_reduction)
+          {
+            stable = false;
+          }
+          enabled_actions.insert(a);
+        }
+        std::sort(transitions.begin(), transitions.end());
+        transitions.erase(std::unique(transitions.begin(), transitions.end()), transitions.end());
+        m_transitions[s].swap(transitions);
+        m_enabled_actions[s].swap(enabled_actions);
+        m_stable[s] = stable;
+        m_generated[s] = true;
+      }
+
+      // Determines with Tarjan's algorithm the strongly connected components of internal
+      // transitions that are reachable from s via internal steps, and whose divergence is not
+      // yet known. A state diverges iff its component contains a cycle.
+      void compute_divergence(const state_type s)
+      {
+        std::unordered_map<state_type, std::size_t> dfs_number;
+        std::unordered_map<state_type, std::size_t> low_link;
+        std::vector<state_type> component_stack;
+        std::vector<std::pair<state_type, std::size_t> > call_stack; // Pairs of a state and the position of the next transition.
+
+        auto discover = [&](const state_type t)
+        {
+          const std::size_t number = dfs_number.size();
+          dfs_number[t] = number;
+          low_link[t] = number;
+          component_stack.push_back(t);
+          call_stack.emplace_back(t, 0);
+        };
+
+        discover(s);
+        while (!call_stack.empty())
+        {
+          const state_type current = call_stack.back().first;
+          const transition_list& current_transitions = transitions(current);
+          std::size_t& position = call_stack.back().second;
+          if (position < current_transitions.size())
+          {
+            const std::pair<label_type, state_type> t = current_transitions[position++];
+            if (!m_labels.is_tau(t.first) || m_divergent[t.second] != divergence::unknown)
+            {
+              continue;
+            }
+            const std::unordered_map<state_type, std::size_t>::const_iterator i = dfs_number.find(t.second);
+            if (i == dfs_number.end())
+            {
+              discover(t.second);
+            }
+            else
+            {
+              // The target is still on the component stack, as the divergence of all states in
+              // completed components is known.
+              low_link[current] = std::min(low_link[current], i->second);
+            }
+            continue;
+          }
+
+          call_stack.pop_back();
+          if (!call_stack.empty())
+          {
+            const state_type parent = call_stack.back().first;
+            low_link[parent] = std::min(low_link[parent], low_link[current]);
+          }
+          if (low_link[current] == dfs_number[current])
+          {
+            // current is the root of a component, consisting of the states above it on the component stack.
+            const std::size_t root_position = std::find(component_stack.rbegin(), component_stack.rend(), current).base() - component_stack.begin() - 1;
+            bool cycle = component_stack.size() - root_position > 1;
+            if (!cycle)
+            {
+              cycle = std::binary_search(current_transitions.begin(), current_transitions.end(), std::make_pair(label_type(0), current));
+            }
+            for (std::size_t i = root_position; i < component_stack.size(); ++i)
+            {
+              m_divergent[component_stack[i]] = cycle ? divergence::yes : divergence::no;
+            }
+            component_stack.resize(root_position);
+          }
+        }
+      }
+
+    public:
+      on_the_fly_lts(const lps::specification& lpsspec,
+                     const lps::explorer_options& options,
+                     on_the_fly_action_labels& labels,
+                     const bool weak_reduction)
+        : m_explorer(lpsspec, options),
+          m_labels(labels),
+          m_weak_reduction(weak_reduction)
+      {
+        add_state(m_explorer.initial_state());
+      }
+
+      state_type initial_state() const
+      {
+        return 0;
+      }
+
+      std::size_t num_states() const
+      {
+        return m_states.size();
+      }
+
+      /// \brief The outgoing transitions of s, sorted on labels.
+      /// \details The reference is invalidated when transitions of another state are generated.
+      const transition_list& transitions(const state_type s)
+      {
+        if (!m_generated[s])
+        {
+          generate_transitions(s);
+        }
+        return m_transitions[s];
+      }
+
+      /// \brief A state is stable if it has no outgoing internal transitions. Without weak
+      ///        reduction all states are stable.
+      bool stable(const state_type s)
+      {
+        transitions(s);
+        return m_stable[s];
+      }
+
+      const action_label_set& action_labels(const state_type s)
+      {
+        transitions(s);
+        return m_enabled_actions[s];
+      }
+
+      /// \brief Indicates whether s lies on a cycle of internal transitions.
+      bool diverges(const state_type s)
+      {
+        if (!m_weak_reduction)
+        {
+          return false;
+        }
+        if (m_divergent[s] == divergence::unknown)
+        {
+          compute_divergence(s);
+        }
+        return m_divergent[s] == divergence::yes;
+      }
+
+      /// \brief The states reachable from the states in s via internal transitions, if weak
+      ///        reduction is used. Otherwise s itself.
+      set_of_states tau_closure(const set_of_states& s)
+      {
+        set_of_states result(s);
+        if (!m_weak_reduction)
+        {
+          return result;
+        }
+        std::vector<state_type> todo(s.begin(), s.end());
+        while (!todo.empty())
+        {
+          const state_type current = todo.back();
+          todo.pop_back();
+          for (const std::pair<label_type, state_type>& t: transitions(current))
+          {
+            if (!m_labels.is_tau(t.first))
+            {
+              break; // The transitions are sorted, and tau has label 0.
+            }
+            if (result.insert(t.second).second)
+            {
+              todo.push_back(t.second);
+            }
+          }
+        }
+        return result;
+      }
+
+      /// \brief The states reachable from the (tau closed) set s via an a-transition, followed by internal transitions.
+      set_of_states after(const set_of_states& s, const label_type a)
+      {
+        set_of_states result;
+        for (const state_type u: s)
+        {
+          const transition_list& ts = transitions(u);
+          for (transition_list::const_iterator i = std::lower_bound(ts.begin(), ts.end(), std::make_pair(a, state_type(0)));
+               i != ts.end() && i->first == a; ++i)
+          {
+            result.insert(i->second);
+          }
+        }
+        return tau_closure(result);
+      }
+  };
+
+  /// \brief Checks whether the enabled actions of every stable state in spec are included in those
+  ///        of impl, if impl is stable. See refusals_contained_in for LTSs.
+  inline bool on_the_fly_refusals_contained_in(
+                const state_type impl,
+                on_the_fly_lts& impl_lts,
+                const set_of_states& spec,
+                on_the_fly_lts& spec_lts)
+  {
+    if (!impl_lts.stable(impl))
+    {
+      return true;
+    }
+    const action_label_set& impl_action_labels = impl_lts.action_labels(impl);
+    for (const state_type s: spec)
+    {
+      if (spec_lts.stable(s))
+      {
+        const action_label_set& spec_action_labels = spec_lts.action_labels(s);
+        if (std::includes(impl_action_labels.begin(), impl_action_labels.end(),
+                          spec_action_labels.begin(), spec_action_labels.end()))
+        {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+} // namespace detail
+
+/// \brief Checks whether the state space of impl is included in that of spec, in the sense of
+///        trace inclusion, failures inclusion or failures-divergence inclusion, without generating
+///        the state spaces first.
+/// \details The algorithm is that of destructive_refinement_checker. The product of the implementation
+///          and the determinised specification is explored, and the exploration stops at the first
+///          counterexample. No bisimulation preprocessing is applied, as this requires the full state spaces.
+/// \param impl The specification of the implementation, at the left of the refinement.
+/// \param spec The specification at the right of the refinement.
+/// \param options The options of the explorers that generate the states and transitions.
+/// \param tau_actions Actions with these names are considered to be internal.
+/// \param generate_counter_example If set, a trace leading to the first counterexample is saved.
+template < class COUNTER_EXAMPLE_CONSTRUCTOR = detail::dummy_counter_example_constructor >
+bool on_the_fly_refinement_checker(
+                        const lps::specification& impl,
+                        const lps::specification& spec,
+                        const refinement_type refinement,
+                        const bool weak_reduction,
+                        const lps::exploration_strategy strategy,
+                        const lps::explorer_options& options = lps::explorer_options(),
+                        const std::vector<std::string>& tau_actions = std::vector<std::string>(),
+                        COUNTER_EXAMPLE_CONSTRUCTOR generate_counter_example = detail::dummy_counter_example_constructor())
+{
+  assert(strategy == lps::exploration_strategy::es_breadth || strategy == lps::exploration_strategy::es_depth); // Need a valid strategy.
+
+  typedef detail::state_states_counter_example_index_triple<COUNTER_EXAMPLE_CONSTRUCTOR> triple_type;
+
+  detail::on_the_fly_action_labels labels(tau_actions);
+  detail::on_the_fly_lts impl_lts(impl, options, labels, weak_reduction);
+  detail::on_the_fly_lts spec_lts(spec, options, labels, weak_reduction);
+
+  auto report = [&](refinement_statistics<triple_type>& stats)
+  {
+    report_statistics(stats);
+    mCRL2log(log::verbose) << "Generated " << impl_lts.num_states() << " state" << (impl_lts.num_states() == 1 ? "" : "s")
+                           << " of the implementation and " << spec_lts.num_states() << " state" << (spec_lts.num_states() == 1 ? "" : "s")
+                           << " of the specification.\n";
+  };
+
+  std::deque<triple_type> working(
+              { triple_type(impl_lts.initial_state(),
+                            spec_lts.tau_closure({ spec_lts.initial_state() }),
+                            generate_counter_example.root_index()) });
+  detail::anti_chain_type anti_chain;
+  detail::antichain_insert(anti_chain, working.front());
+  refinement_statistics<triple_type> stats(anti_chain, working);
+
+  while (!working.empty())
+  {
+    triple_type impl_spec;
+    impl_spec.swap(working.front());
+    stats.max_working   = std::max(working.size(), stats.max_working);
+    stats.max_antichain = std::max(anti_chain.size(), stats.max_antichain);
+    working.pop_front();
+
+    if (refinement == failures_divergence)
+    {
+      // A diverging specification allows any behaviour.
+      if (std::any_of(impl_spec.states().begin(), impl_spec.states().end(), [&](const detail::state_type s){ return spec_lts.diverges(s); }))
+      {
+        continue;
+      }
+      if (impl_lts.diverges(impl_spec.state()))
+      {
+        generate_counter_example.save_counter_example(impl_spec.counter_example_index(), labels);
+        report(stats);
+        return false;
+      }
+    }
+
+    if (refinement == failures || refinement == failures_divergence)
+    {
+      if (!detail::on_the_fly_refusals_contained_in(impl_spec.state(), impl_lts, impl_spec.states(), spec_lts))
+      {
+        generate_counter_example.save_counter_example(impl_spec.counter_example_index(), labels);
+        report(stats);
+        return false;
+      }
+    }
+
+    // The transitions are copied, as generating the transitions of other states invalidates references.
+    const detail::on_the_fly_lts::transition_list transitions = impl_lts.transitions(impl_spec.state());
+    for (const std::pair<detail::label_type, detail::state_type>& t: transitions)
+    {
+      const typename COUNTER_EXAMPLE_CONSTRUCTOR::index_type new_counterexample_index =
+             generate_counter_example.add_transition(t.first, impl_spec.counter_example_index());
+      const detail::set_of_states spec_prime = labels.is_tau(t.first) && weak_reduction
+                                                 ? impl_spec.states()
+                                                 : spec_lts.after(impl_spec.states(), t.first);
+      if (spec_prime.empty())
+      {
+        generate_counter_example.save_counter_example(new_counterexample_index, labels);
+        report(stats);
+        return false;
+      }
+
+      ++stats.antichain_inserts;
+      const triple_type impl_spec_counterex(t.second, spec_prime, new_counterexample_index);
+      if (detail::antichain_insert(anti_chain, impl_spec_counterex))
+      {
+        ++stats.antichain_misses;
+        if (strategy == lps::exploration_strategy::es_breadth)
+        {
+          working.push_back(impl_spec_counterex);
+        }
+        else if (strategy == lps::exploration_strategy::es_depth)
+        {
+          working.push_front(impl_spec_counterex);
+        }
+      }
+    }
+  }
+
+  report(stats);
+  return true;
+}
+
+/// \brief Checks whether the state space of impl is included in that of spec according to the preorder,
+///        while generating only the states that are needed.
+/// \details Only the antichain based preorders are supported, i.e. trace-ac, weak-trace-ac and the failures refinements.
+/// \param generate_counter_example If set, a trace to the first counterexample is saved.
+/// \param structured_output If set, the counterexample is printed on stdout instead of saved to a file.
+inline bool on_the_fly_compare(
+                const lps::specification& impl,
+                const lps::specification& spec,
+                const lts_preorder pre,
+                const bool generate_counter_example,
+                const bool structured_output = false,
+                const lps::exploration_strategy strategy = lps::es_breadth,
+                const lps::explorer_options& options = lps::explorer_options(),
+                const std::vector<std::string>& tau_actions = std::vector<std::string>())
+{
+  refinement_type refinement = trace;
+  bool weak_reduction = false;
+  std::string counter_example_name;
+  switch (pre)
+  {
+    case lts_pre_trace_anti_chain:
+      counter_example_name = "counter_example_trace_preorder";
+      break;
+    case lts_pre_weak_trace_anti_chain:
+      weak_reduction = true;
+      counter_example_name = "counter_example_weak_trace_preorder";
+      break;
+    case lts_pre_failures_refinement:
+      refinement = failures;
+      counter_example_name = "counter_example_failures_refinement";
+      break;
+    case lts_pre_weak_failures_refinement:
+      refinement = failures;
+      weak_reduction = true;
+      counter_example_name = "counter_example_weak_failures_refinement";
+      break;
+    case lts_pre_failures_divergence_refinement:
+      refinement = failures_divergence;
+      weak_reduction = true;
+      counter_example_name = "counter_example_failures_divergence_refinement";
+      break;
+    default:
+      throw mcrl2::runtime_error("The preorder " + description(pre) + " cannot be checked on-the-fly.");
+  }
+
+  if (generate_counter_example)
+  {
+    detail::counter_example_constructor cec(counter_example_name, structured_output);
+    return on_the_fly_refinement_checker(impl, spec, refinement, weak_reduction, strategy, options, tau_actions, cec);
+  }
+  return on_the_fly_refinement_checker(impl, spec, refinement, weak_reduction, strategy, options, tau_actions);
+}
+
+/// \brief Checks whether impl and spec are (weak) trace equivalent by checking the inclusion in both directions.
+inline bool on_the_fly_compare(
+                const lps::specification& impl,
+                const lps::specification& spec,
+                const lts_equivalence eq,
+                const bool generate_counter_example,
+                const bool structured_output = false,
+                const lps::exploration_strategy strategy = lps::es_breadth,
+                const lps::explorer_options& options = lps::explorer_options(),
+                const std::vector<std::string>& tau_actions = std::vector<std::string>())
+{
+  lts_preorder pre = lts_pre_none;
+  switch (eq)
+  {
+    case lts_eq_trace:
+      pre = lts_pre_trace_anti_chain;
+      break;
+    case lts_eq_weak_trace:
+      pre = lts_pre_weak_trace_anti_chain;
+      break;
+    default:
+      throw mcrl2::runtime_error("The equivalence " + description(eq) + " cannot be checked on-the-fly.");
+  }
+  return on_the_fly_compare(impl, spec, pre, generate_counter_example, structured_output, strategy, options, tau_actions) &&
+         on_the_fly_compare(spec, impl, pre, generate_counter_example, structured_output, strategy, options, tau_actions);
+}
+
+} // namespace lts
+} // namespace mcrl2
+
+#endif //  LIBLTS_ON_THE_FLY_REFINEMENT_H
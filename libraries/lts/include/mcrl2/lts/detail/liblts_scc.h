@@ -10,7 +10,14 @@
 
 #ifndef _LIBLTS_SCC_H
 #define _LIBLTS_SCC_H
-#include <unordered_set>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <thread>
 #include "mcrl2/lts/lts.h"
 #include "mcrl2/utilities/logger.h"
 
@@ -21,105 +28,6 @@ namespace lts
 
 namespace detail
 {
-  // An indexed sorted vector below contains the outgoing or incoming tau transitions per state,
-  // grouped per state. The input consists of an automaton with transitions. The incoming/outcoming
-  // tau transitions are grouped by state in the m_states_with_outgoing_or_incoming_tau_transition. 
-  // It is as long as the lts aut has tau transitions. The vector m_indices is as long as the number
-  // of states. For each state it contains the place in the other vector where its tau transitions
-  // start. So, the tau transitions reside at position indices[s] to indices[s+1]. These indices
-  // can be acquired using the functions lowerbound and upperbound. 
-  // This data structure is chosen due to its minimal memory and time footprint. 
-  template <class LTS_TYPE>
-  class indexed_sorted_vector_for_tau_transitions
-  {
-    protected:
-      typedef std::size_t state_type;
-      typedef std::size_t label_type;
-
-      std::vector <state_type> m_states_with_outgoing_or_incoming_tau_transition;
-      std::vector <size_t> m_indices;
-
-    public:
-
-      indexed_sorted_vector_for_tau_transitions(const LTS_TYPE& aut, bool outgoing)
-       : m_indices(aut.num_states()+1,0)
-      {
-        // First count the number of outgoing transitions per state and put it in indices.
-        for(const transition& t: aut.get_transitions())
-        {
-          if (aut.is_tau(aut.apply_hidden_label_map(t.label())))
-          {
-            m_indices[outgoing?t.from():t.to()]++;
-          }
-        }
-
-        // Calculate the m_indices where the states with outgoing/incoming tau transition must be placed.
-        // Put the starting index for state i at position i-1. When placing the transitions these indices
-        // are decremented properly. 
-        
-        size_t sum=0;
-        for(state_type& i: m_indices)  // The vector is changed. This must be a reference. 
-        {
-          sum=sum+i;
-          i=sum;
-        }
-
-        // Now declare enough space for all transitions and store them in reverse order, while
-        // at the same time decrementing the indices in m_indices. 
-        m_states_with_outgoing_or_incoming_tau_transition.resize(sum);
-        for(const transition& t: aut.get_transitions())
-        {
-          if (aut.is_tau(aut.apply_hidden_label_map(t.label())))
-          {
-            if (outgoing)
-            {
-              assert(t.from()<m_indices.size());
-              assert(m_indices[t.from()]>0);
-              m_indices[t.from()]--;
-              assert(m_indices[t.from()] < m_states_with_outgoing_or_incoming_tau_transition.size());
-              m_states_with_outgoing_or_incoming_tau_transition[m_indices[t.from()]]=t.to();
-            }
-            else
-            {
-              assert(t.to()<m_indices.size());
-              assert(m_indices[t.to()]>0);
-              m_indices[t.to()]--;
-              assert(m_indices[t.to()] < m_states_with_outgoing_or_incoming_tau_transition.size());
-              m_states_with_outgoing_or_incoming_tau_transition[m_indices[t.to()]]=t.from();
-            }
-          }
-        }
-        assert(m_indices.at(aut.num_states())==m_states_with_outgoing_or_incoming_tau_transition.size());
-      }
-
-      // Get the indexed transitions. 
-      const std::vector<state_type>& get_transitions() const
-      {
-        return m_states_with_outgoing_or_incoming_tau_transition;
-      }
-    
-      // Get the lowest index of incoming/outging transitions stored in m_states_with_outgoing_or_incoming_tau_transition.
-      size_t lowerbound(const state_type s) const
-      {
-        assert(s+1<m_indices.size());
-        return m_indices[s];
-      }
-
-      // Get 1 beyond the higest index of incoming/outging transitions stored in m_states_with_outgoing_or_incoming_tau_transition.
-      size_t upperbound(const state_type s) const
-      {
-        assert(s+1<m_indices.size());
-        return m_indices[s+1];
-      }
-
-      // Drastically clear the vectors by resetting its memory usage to minimal. 
-      void clear()   
-      {
-        std::vector <state_type>().swap(m_states_with_outgoing_or_incoming_tau_transition);
-        std::vector <size_t>().swap(m_indices);
-        
-      }
-  };
 
 /// \brief This class contains an scc partitioner removing inert tau loops.
 
@@ -140,8 +48,18 @@ class scc_partitioner
      *  When applying the function \ref replace_transition_system the
      *  automaton l is replaced by (aka shrinked to) the automaton modulo the
      *  calculated partition.
-     *  \param[in] l reference to an LTS. */
-    scc_partitioner(LTS_TYPE& l);
+     *
+     *  The depth first searches use an explicit stack, such that long sequences of
+     *  internal actions do not exhaust the call stack. If more than one thread is used,
+     *  the components are instead determined by the forward-backward algorithm with
+     *  trimming of L.K. Fleischer, B. Hendrickson and A. Pinar, On identifying strongly
+     *  connected components in parallel, Proc. IPDPS 2000, in which the subproblems are
+     *  handled by different threads. In both cases the equivalence classes are numbered in
+     *  the order of their smallest state, such that they do not depend on the number of threads.
+     *  \param[in] l reference to an LTS.
+     *  \param[in] number_of_threads The number of threads that is used. Small LTSs are
+     *             always partitioned using a single thread. */
+    scc_partitioner(LTS_TYPE& l, const std::size_t number_of_threads = 1);
 
     /** \brief Destroys this partitioner. */
     ~scc_partitioner()=default;
@@ -192,44 +110,69 @@ class scc_partitioner
 
     LTS_TYPE& aut;
 
+    // Indicates for each action label whether it is internal, taking the hidden label set into account.
+    std::vector<bool> m_is_tau_label;
+
     std::vector < state_type > block_index_of_a_state;
     std::vector < state_type > dfsn2state;
     state_type equivalence_class_index;
 
+    // The stack of the depth first search, with for each state the position of its next transition.
+    std::vector < std::pair < state_type, std::size_t > > dfs_stack;
+    // The states of which the predecessors still need to be grouped in a component.
+    std::vector < state_type > group_stack;
+
+    // The indices that are passed to the following functions only contain the internal transitions.
     void group_components(const state_type t,
                           const state_type equivalence_class_index,
-                          const indexed_sorted_vector_for_tau_transitions<LTS_TYPE>& src_tgt_src,
+                          const indexed_transitions& tgt_src,
                           std::vector < bool >& visited);
     void dfs_numbering(const state_type t,
-                       const indexed_sorted_vector_for_tau_transitions<LTS_TYPE>& src_tgt,
+                       const indexed_transitions& src_tgt,
                        std::vector < bool >& visited);
+    void partition_in_parallel(const std::size_t number_of_threads);
 
 };
 
 
 template < class LTS_TYPE>
-scc_partitioner<LTS_TYPE>::scc_partitioner(LTS_TYPE& l)
+scc_partitioner<LTS_TYPE>::scc_partitioner(LTS_TYPE& l, const std::size_t number_of_threads)
   :aut(l),
+    m_is_tau_label(aut.num_action_labels()),
     block_index_of_a_state(aut.num_states(),0),
     equivalence_class_index(0)
 {
   mCRL2log(log::debug) << "Tau loop (SCC) partitioner created for " << l.num_states() << " states and " <<
               l.num_transitions() << " transitions" << std::endl;
 
+  for (label_type a=0; a<aut.num_action_labels(); ++a)
+  {
+    m_is_tau_label[a]=aut.is_tau(aut.apply_hidden_label_map(a));
+  }
+
+  if (number_of_threads>1 && aut.num_states()>=10000)
+  {
+    partition_in_parallel(number_of_threads);
+    mCRL2log(log::debug) << "Tau loop (SCC) partitioner reduces lts to " << equivalence_class_index << " states." << std::endl;
+    return;
+  }
+
   dfsn2state.reserve(aut.num_states());
 
-  // Initialise the data structures used in the recursive DFS procedure.
+  // Initialise the data structures used in the DFS procedure.
   std::vector<bool> visited(aut.num_states(),false); 
-  indexed_sorted_vector_for_tau_transitions<LTS_TYPE> src_tgt(aut,true); // Group the tau transitions ordered per outgoing states. 
 
-  // Number the states via a depth first search
-  for (state_type i=0; i<aut.num_states(); ++i)
+  // Number the states via a depth first search, using the internal transitions grouped per source state.
+  // Only one index of internal transitions exists at any time, to limit the memory that is used.
   {
-    dfs_numbering(i,src_tgt,visited);
+    const indexed_transitions src_tgt(aut.get_transitions(), aut.num_states(), true, m_is_tau_label);
+    for (state_type i=0; i<aut.num_states(); ++i)
+    {
+      dfs_numbering(i,src_tgt,visited);
+    }
   }
-  src_tgt.clear();
 
-  indexed_sorted_vector_for_tau_transitions<LTS_TYPE> tgt_src(aut,false);
+  const indexed_transitions tgt_src(aut.get_transitions(), aut.num_states(), false, m_is_tau_label);
   for (std::vector < state_type >::reverse_iterator i=dfsn2state.rbegin();
        i!=dfsn2state.rend(); ++i)
   {
@@ -239,39 +182,54 @@ scc_partitioner<LTS_TYPE>::scc_partitioner(LTS_TYPE& l)
       equivalence_class_index++;
     }
   }
+
+  // Renumber the components in the order of their smallest state, as is done by partition_in_parallel.
+  std::vector<state_type> renumbered(equivalence_class_index, equivalence_class_index);
+  state_type next_index=0;
+  for (state_type& block_index: block_index_of_a_state)
+  {
+    if (renumbered[block_index]==equivalence_class_index)
+    {
+      renumbered[block_index]=next_index++;
+    }
+    block_index=renumbered[block_index];
+  }
   mCRL2log(log::debug) << "Tau loop (SCC) partitioner reduces lts to " << equivalence_class_index << " states." << std::endl;
 
   dfsn2state.clear();
+  dfs_stack.clear();
+  group_stack.clear();
 }
 
 
 template < class LTS_TYPE>
 void scc_partitioner<LTS_TYPE>::replace_transition_system(const bool preserve_divergence_loops)
 {
-  // Put all the non inert transitions in a set. Add the transitions that form a self
-  // loop. Such transitions only exist in case divergence preserving branching bisimulation is
-  // used. A set is used to remove double occurrences of transitions.
-  std::unordered_set < transition > resulting_transitions;
+  // Collect the transitions of the condensed graph, which are all the non inert transitions. Add the
+  // transitions that form a self loop. Such transitions only exist in case divergence preserving
+  // branching bisimulation is used. Double occurrences of transitions are removed by sorting them.
+  std::vector < transition > resulting_transitions;
+  resulting_transitions.reserve(aut.num_transitions());
   for (const transition& t: aut.get_transitions())
   {
-    if (!aut.is_tau(aut.apply_hidden_label_map(t.label())) ||
+    if (!m_is_tau_label[t.label()] ||
         preserve_divergence_loops ||
         block_index_of_a_state[t.from()]!=block_index_of_a_state[t.to()])
     {
-      resulting_transitions.insert(
-        transition(
+      resulting_transitions.emplace_back(
           block_index_of_a_state[t.from()],
           aut.apply_hidden_label_map(t.label()),
-          block_index_of_a_state[t.to()]));
+          block_index_of_a_state[t.to()]);
     }
   }
+  std::sort(resulting_transitions.begin(), resulting_transitions.end());
+  resulting_transitions.erase(std::unique(resulting_transitions.begin(), resulting_transitions.end()),
+                              resulting_transitions.end());
 
   aut.clear_transitions(resulting_transitions.size());
-  // Copy the transitions from the set into the transition system.
-
   for (const transition& t: resulting_transitions)
   {
-    aut.add_transition(transition(t.from(),t.label(),t.to()));
+    aut.add_transition(t);
   }
 
   // Merge the states, by setting the state labels of each state to the concatenation of the state labels of its
@@ -322,26 +280,36 @@ template < class LTS_TYPE>
 void scc_partitioner<LTS_TYPE>::group_components(
   const state_type s,
   const state_type equivalence_class_index,
-  const indexed_sorted_vector_for_tau_transitions<LTS_TYPE>& tgt_src,
+  const indexed_transitions& tgt_src,
   std::vector < bool >& visited)
 {
   if (!visited[s])
   {
     return;
   }
+  // The order in which the states are visited does not matter, so the stack only contains states.
   visited[s] = false;
-  const size_t u=tgt_src.upperbound(s);  // only calculate the upperbound once. 
-  for(state_type i=tgt_src.lowerbound(s); i<u; ++i)
+  group_stack.push_back(s);
+  while (!group_stack.empty())
   {
-    group_components(tgt_src.get_transitions()[i],equivalence_class_index,tgt_src,visited);
+    const state_type u=group_stack.back();
+    group_stack.pop_back();
+    block_index_of_a_state[u]=equivalence_class_index;
+    for(const label_state_pair& t: tgt_src.transitions(u))
+    {
+      if (visited[t.state()])
+      {
+        visited[t.state()] = false;
+        group_stack.push_back(t.state());
+      }
+    }
   }
-  block_index_of_a_state[s]=equivalence_class_index;
 }
 
 template < class LTS_TYPE>
 void scc_partitioner<LTS_TYPE>::dfs_numbering(
   const state_type s,
-  const indexed_sorted_vector_for_tau_transitions<LTS_TYPE>& src_tgt,
+  const indexed_transitions& src_tgt,
   std::vector < bool >& visited)
 {
   if (visited[s])
@@ -349,20 +317,237 @@ void scc_partitioner<LTS_TYPE>::dfs_numbering(
     return;
   }
   visited[s] = true;
-  const size_t u=src_tgt.upperbound(s);  // only calculate the upperbound once. 
-  for(state_type i=src_tgt.lowerbound(s); i<u; ++i)
+  dfs_stack.emplace_back(s, src_tgt.lowerbound(s));
+  while (!dfs_stack.empty())
+  {
+    const state_type u=dfs_stack.back().first;
+    const std::size_t i=dfs_stack.back().second;
+    if (i==src_tgt.upperbound(u))
+    {
+      // All successors of u have been numbered.
+      dfsn2state.push_back(u);
+      dfs_stack.pop_back();
+      continue;
+    }
+    ++dfs_stack.back().second;
+    const label_state_pair& t=src_tgt.get_transitions()[i];
+    if (!visited[t.state()])
+    {
+      visited[t.state()] = true;
+      dfs_stack.emplace_back(t.state(), src_tgt.lowerbound(t.state()));
+    }
+  }
+}
+
+template < class LTS_TYPE>
+void scc_partitioner<LTS_TYPE>::partition_in_parallel(const std::size_t number_of_threads)
+{
+  const std::size_t n=aut.num_states();
+  // Only the internal transitions are indexed.
+  const indexed_transitions src_tgt(aut.get_transitions(), n, true, m_is_tau_label);
+  const indexed_transitions tgt_src(aut.get_transitions(), n, false, m_is_tau_label);
+
+  // Every subproblem consists of the states with the same set number. A state that is put in a
+  // component gets the set number removed. The set of a state can be read by the threads that handle
+  // the sets of its neighbours, and is therefore atomic.
+  const std::size_t removed=std::numeric_limits<std::size_t>::max();
+  std::unique_ptr<std::atomic<std::size_t>[]> set(new std::atomic<std::size_t>[n]);
+  for (state_type s=0; s<n; ++s)
+  {
+    set[s].store(0, std::memory_order_relaxed);
+  }
+  std::atomic<std::size_t> next_set(1);
+  std::atomic<std::size_t> next_component(0);
+  std::vector<std::size_t> component(n);
+  std::vector<std::size_t> in_degree(n);
+  std::vector<std::size_t> out_degree(n);
+
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::deque<std::pair<std::size_t, std::vector<state_type> > > subproblems;
+  std::size_t active=0;
+
+  subproblems.emplace_back(0, std::vector<state_type>(n));
+  std::iota(subproblems.back().second.begin(), subproblems.back().second.end(), 0);
+
+  auto in_set=[&](const state_type s, const std::size_t set_number)
+  {
+    return set[s].load(std::memory_order_relaxed)==set_number;
+  };
+
+  // Determines the components of the given states, which form a set, and adds the remaining subproblems.
+  auto solve=[&](const std::size_t set_number, const std::vector<state_type>& states)
   {
-    dfs_numbering(src_tgt.get_transitions()[i],src_tgt,visited);
+    // Repeatedly remove the states without internal predecessors or successors in the set. Each of
+    // these forms a component on its own.
+    std::vector<state_type> todo;
+    auto remove=[&](const state_type s)
+    {
+      set[s].store(removed, std::memory_order_relaxed);
+      component[s]=next_component++;
+      todo.push_back(s);
+    };
+    for (const state_type s: states)
+    {
+      in_degree[s]=0;
+      out_degree[s]=0;
+      for (const label_state_pair& t: src_tgt.transitions(s))
+      {
+        out_degree[s]+=t.state()!=s && in_set(t.state(), set_number);
+      }
+      for (const label_state_pair& t: tgt_src.transitions(s))
+      {
+        in_degree[s]+=t.state()!=s && in_set(t.state(), set_number);
+      }
+    }
+    for (const state_type s: states)
+    {
+      if (in_degree[s]==0 || out_degree[s]==0)
+      {
+        remove(s);
+      }
+    }
+    while (!todo.empty())
+    {
+      const state_type s=todo.back();
+      todo.pop_back();
+      for (const label_state_pair& t: src_tgt.transitions(s))
+      {
+        if (t.state()!=s && in_set(t.state(), set_number) && --in_degree[t.state()]==0)
+        {
+          remove(t.state());
+        }
+      }
+      for (const label_state_pair& t: tgt_src.transitions(s))
+      {
+        if (t.state()!=s && in_set(t.state(), set_number) && --out_degree[t.state()]==0)
+        {
+          remove(t.state());
+        }
+      }
+    }
+
+    // Take the states that are reachable from and can reach a pivot as a component. The states that are
+    // only reachable from the pivot, the states that can only reach the pivot, and the other states form
+    // three new sets, which do not share components.
+    const typename std::vector<state_type>::const_iterator pivot=
+        std::find_if(states.begin(), states.end(), [&](const state_type s) { return in_set(s, set_number); });
+    if (pivot==states.end())
+    {
+      return;
+    }
+    const std::size_t forward=next_set++;
+    const std::size_t backward=next_set++;
+    set[*pivot].store(forward, std::memory_order_relaxed);
+    todo.push_back(*pivot);
+    while (!todo.empty())
+    {
+      const state_type s=todo.back();
+      todo.pop_back();
+      for (const label_state_pair& t: src_tgt.transitions(s))
+      {
+        if (in_set(t.state(), set_number))
+        {
+          set[t.state()].store(forward, std::memory_order_relaxed);
+          todo.push_back(t.state());
+        }
+      }
+    }
+    const std::size_t pivot_component=next_component++;
+    set[*pivot].store(removed, std::memory_order_relaxed);
+    component[*pivot]=pivot_component;
+    todo.push_back(*pivot);
+    while (!todo.empty())
+    {
+      const state_type s=todo.back();
+      todo.pop_back();
+      for (const label_state_pair& t: tgt_src.transitions(s))
+      {
+        if (in_set(t.state(), forward))
+        {
+          set[t.state()].store(removed, std::memory_order_relaxed);
+          component[t.state()]=pivot_component;
+          todo.push_back(t.state());
+        }
+        else if (in_set(t.state(), set_number))
+        {
+          set[t.state()].store(backward, std::memory_order_relaxed);
+          todo.push_back(t.state());
+        }
+      }
+    }
+
+    std::vector<state_type> remaining[3];
+    for (const state_type s: states)
+    {
+      const std::size_t s_set=set[s].load(std::memory_order_relaxed);
+      if (s_set!=removed)
+      {
+        remaining[s_set==set_number?0:(s_set==forward?1:2)].push_back(s);
+      }
+    }
+    const std::size_t set_numbers[3]={ set_number, forward, backward };
+    std::lock_guard<std::mutex> lock(mutex);
+    for (std::size_t i=0; i<3; ++i)
+    {
+      if (!remaining[i].empty())
+      {
+        subproblems.emplace_back(set_numbers[i], std::move(remaining[i]));
+      }
+    }
+    changed.notify_all();
+  };
+
+  auto worker=[&]()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+      changed.wait(lock, [&]() { return !subproblems.empty() || active==0; });
+      if (subproblems.empty())
+      {
+        return;
+      }
+      std::pair<std::size_t, std::vector<state_type> > subproblem=std::move(subproblems.front());
+      subproblems.pop_front();
+      ++active;
+      lock.unlock();
+      solve(subproblem.first, subproblem.second);
+      lock.lock();
+      --active;
+      changed.notify_all();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (std::size_t i=1; i<number_of_threads; ++i)
+  {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (std::thread& thread: threads)
+  {
+    thread.join();
+  }
+
+  // Number the components in the order of their smallest state.
+  std::vector<std::size_t> class_of_component(next_component, removed);
+  for (state_type s=0; s<n; ++s)
+  {
+    if (class_of_component[component[s]]==removed)
+    {
+      class_of_component[component[s]]=equivalence_class_index++;
+    }
+    block_index_of_a_state[s]=class_of_component[component[s]];
   }
-  dfsn2state.push_back(s);
 }
 
 } // namespace detail
 
 template < class LTS_TYPE>
-void scc_reduce(LTS_TYPE& l,const bool preserve_divergence_loops = false)
+void scc_reduce(LTS_TYPE& l,const bool preserve_divergence_loops = false, const std::size_t number_of_threads = 1)
 {
-  detail::scc_partitioner<LTS_TYPE> scc_part(l);
+  detail::scc_partitioner<LTS_TYPE> scc_part(l, number_of_threads);
   scc_part.replace_transition_system(preserve_divergence_loops);
 }
 
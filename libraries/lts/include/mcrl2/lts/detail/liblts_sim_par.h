@@ -0,0 +1,468 @@
+// Author(s): Jan Friso Groote
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file lts/detail/liblts_sim_par.h
+///
+/// \brief Simulation preorder on a bit matrix, refined in parallel.
+///
+/// \details The simulation preorder is stored as a bit matrix, in which row s
+/// contains the states that simulate s, packed in 64-bit words.  Initially, a
+/// state s is simulated by the states that enable all actions that s enables.
+/// A state t is removed from row s if s has an a-transition to a state s' such
+/// that no a-successor of t is in row s'.  This is done in rounds.  In a round,
+/// every state s' of which the row changed in the previous round computes the
+/// set of states that have an a-transition into row s', and intersects the
+/// rows of its a-predecessors with it, a word at a time.  The states s' are
+/// divided over the threads.  As rows only shrink, a thread reading a row that
+/// is concurrently changed by another thread can only remove too few states;
+/// these are removed in the next round, in which the changed row is processed
+/// again.  A thread that shrinks a row sets the changed flag of that row with
+/// an acquire-release exchange, and a thread processing a row clears it in the
+/// same way before reading the row.  So either the shrink is visible to that
+/// reading thread, or the flag is set anew and the row is processed in the
+/// next round.  As simulation equivalence is coarser than strong bisimulation, the
+/// transition system is reduced modulo strong bisimulation first, which keeps
+/// the matrix small.
+
+#ifndef MCRL2_LTS_LIBLTS_SIM_PAR_H
+#define MCRL2_LTS_LIBLTS_SIM_PAR_H
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <string>
+#include "mcrl2/lts/detail/liblts_bisim_dnj.h"
+#include "mcrl2/lts/detail/liblts_bisim_par.h"
+#include "mcrl2/lts/detail/liblts_merge.h"
+
+namespace mcrl2
+{
+namespace lts
+{
+namespace detail
+{
+
+/// \brief LTSs with fewer states than this are reduced and compared using a single thread, as the
+///        overhead of starting threads and dividing the rows of the matrix exceeds the gain.
+constexpr std::size_t sim_par_minimal_states_for_threads = 1000;
+
+/// \brief The number of threads used by the parallel simulation algorithm for an LTS with the given number of states.
+inline std::size_t sim_par_number_of_threads(const std::size_t number_of_states, const std::size_t number_of_threads)
+{
+  return number_of_states < sim_par_minimal_states_for_threads ? 1 : number_of_threads;
+}
+
+template <class LTS_TYPE>
+class sim_partitioner_par
+{
+  protected:
+    typedef std::uint64_t word_t;
+    static constexpr std::size_t word_size = 64;
+
+    LTS_TYPE& m_lts;
+    const std::size_t m_number_of_threads;
+    const std::size_t m_number_of_states;
+    const std::size_t m_words_per_row;
+
+    /// \brief The outgoing transitions of state s are m_outgoing[m_outgoing_begin[s]], ...,
+    ///        m_outgoing[m_outgoing_begin[s + 1] - 1], as pairs of a (hidden) label and a target,
+    ///        sorted on labels. The incoming transitions are stored likewise, with the sources.
+    std::vector<std::size_t> m_outgoing_begin;
+    std::vector<std::pair<std::size_t, std::size_t>> m_outgoing;
+    std::vector<std::size_t> m_incoming_begin;
+    std::vector<std::pair<std::size_t, std::size_t>> m_incoming;
+
+    /// \brief Bit t of row s, i.e. word t / word_size of m_relation[s * m_words_per_row], indicates that t simulates s.
+    std::unique_ptr<std::atomic<word_t>[]> m_relation;
+
+    /// \brief Indicates whether the row of a state changed after it was processed for the last time.
+    std::unique_ptr<std::atomic<bool>[]> m_changed;
+
+    std::vector<std::size_t> m_class;
+    std::size_t m_number_of_classes = 0;
+
+    /// \brief Allocates the matrix for the simulation preorder, with a clear error if it does not fit in memory.
+    static std::atomic<word_t>* allocate_relation(const std::size_t number_of_states, const std::size_t words_per_row)
+    {
+      const std::size_t maximal_number_of_words = std::numeric_limits<std::size_t>::max() / sizeof(word_t);
+      if (words_per_row > 0 && number_of_states > maximal_number_of_words / words_per_row)
+      {
+        throw mcrl2::runtime_error("The simulation preorder on " + std::to_string(number_of_states) +
+                                   " states is too large to be represented by a bit matrix.");
+      }
+      try
+      {
+        return new std::atomic<word_t>[number_of_states * words_per_row];
+      }
+      catch (const std::bad_alloc&)
+      {
+        throw mcrl2::runtime_error("Could not allocate the " +
+                                   std::to_string(number_of_states * words_per_row * sizeof(word_t) / (1024 * 1024)) +
+                                   "MB that are needed for the simulation preorder on " + std::to_string(number_of_states) +
+                                   " states. Use sim instead of sim-par, which requires less memory.");
+      }
+    }
+
+    std::atomic<word_t>* row(const std::size_t s) const
+    {
+      return &m_relation[s * m_words_per_row];
+    }
+
+    static bool test(const std::atomic<word_t>* r, const std::size_t t)
+    {
+      return (r[t / word_size].load(std::memory_order_relaxed) >> (t % word_size)) & 1;
+    }
+
+    /// \brief The position of the least significant bit that is set in w, which must be non-zero.
+    static std::size_t lowest_bit(word_t w)
+    {
+#if defined(__GNUC__)
+      return __builtin_ctzll(w);
+#else
+      std::size_t result = 0;
+      for (; (w & 1) == 0; w >>= 1)
+      {
+        ++result;
+      }
+      return result;
+#endif
+    }
+
+    /// \brief Applies f to the positions of the bits that are set in the row r.
+    template <typename Function>
+    void for_each_bit(const std::atomic<word_t>* r, Function f) const
+    {
+      for (std::size_t w = 0; w < m_words_per_row; ++w)
+      {
+        for (word_t bits = r[w].load(std::memory_order_relaxed); bits != 0; bits &= bits - 1)
+        {
+          f(w * word_size + lowest_bit(bits));
+        }
+      }
+    }
+
+    /// \brief Stores the transitions (label, state) per state in begin and list, sorted on label and state.
+    void index_transitions(const bool incoming, std::vector<std::size_t>& begin,
+                           std::vector<std::pair<std::size_t, std::size_t>>& list)
+    {
+      begin.assign(m_number_of_states + 1, 0);
+      for (const transition& t: m_lts.get_transitions())
+      {
+        ++begin[(incoming ? t.to() : t.from()) + 1];
+      }
+      std::partial_sum(begin.begin(), begin.end(), begin.begin());
+      list.resize(m_lts.num_transitions());
+      std::vector<std::size_t> position(begin.begin(), begin.end() - 1);
+      for (const transition& t: m_lts.get_transitions())
+      {
+        list[position[incoming ? t.to() : t.from()]++] =
+            std::make_pair(m_lts.apply_hidden_label_map(t.label()), incoming ? t.from() : t.to());
+      }
+      for (std::size_t s = 0; s < m_number_of_states; ++s)
+      {
+        std::sort(list.begin() + begin[s], list.begin() + begin[s + 1]);
+      }
+    }
+
+    /// \brief Row s becomes the set of states that enable all actions that s enables.
+    void initialise_relation()
+    {
+      std::vector<std::size_t> labels;
+      for (const std::pair<std::size_t, std::size_t>& t: m_outgoing)
+      {
+        labels.push_back(t.first);
+      }
+      std::sort(labels.begin(), labels.end());
+      labels.erase(std::unique(labels.begin(), labels.end()), labels.end());
+
+      // enabled[i] is the set of states that enable labels[i].
+      std::vector<std::vector<word_t>> enabled(labels.size(), std::vector<word_t>(m_words_per_row, 0));
+      for (std::size_t s = 0; s < m_number_of_states; ++s)
+      {
+        for (std::size_t i = m_outgoing_begin[s]; i < m_outgoing_begin[s + 1]; ++i)
+        {
+          const std::size_t l = std::lower_bound(labels.begin(), labels.end(), m_outgoing[i].first) - labels.begin();
+          enabled[l][s / word_size] |= word_t(1) << (s % word_size);
+        }
+      }
+
+      const word_t last_word = m_number_of_states % word_size == 0 ? ~word_t(0)
+                                                                   : (word_t(1) << (m_number_of_states % word_size)) - 1;
+      sigref_parallel_for(m_number_of_states, m_number_of_threads,
+        [&](std::size_t, std::size_t first, std::size_t last)
+        {
+          std::vector<word_t> r;
+          for (std::size_t s = first; s < last; ++s)
+          {
+            r.assign(m_words_per_row, ~word_t(0));
+            r.back() = last_word;
+            for (std::size_t i = m_outgoing_begin[s]; i < m_outgoing_begin[s + 1]; ++i)
+            {
+              if (i == m_outgoing_begin[s] || m_outgoing[i].first != m_outgoing[i - 1].first)
+              {
+                const std::vector<word_t>& e = enabled[std::lower_bound(labels.begin(), labels.end(), m_outgoing[i].first) - labels.begin()];
+                for (std::size_t w = 0; w < m_words_per_row; ++w)
+                {
+                  r[w] &= e[w];
+                }
+              }
+            }
+            for (std::size_t w = 0; w < m_words_per_row; ++w)
+            {
+              row(s)[w].store(r[w], std::memory_order_relaxed);
+            }
+          }
+        });
+    }
+
+    /// \brief Removes from the rows of the predecessors of s the states that cannot match the transitions to s.
+    /// \details The states of which the row changes are added to changed. The vector x is used as scratch space.
+    void process(const std::size_t s, std::vector<word_t>& x, std::vector<std::size_t>& changed)
+    {
+      // The exchange synchronises with the exchange of a thread that shrank row s
+      // before, such that this shrink is visible in the reads of row s below.
+      m_changed[s].exchange(false, std::memory_order_acq_rel);
+      const std::atomic<word_t>* row_s = row(s);
+      for (std::size_t begin = m_incoming_begin[s]; begin < m_incoming_begin[s + 1]; )
+      {
+        const std::size_t a = m_incoming[begin].first;
+        std::size_t end = begin;
+        while (end < m_incoming_begin[s + 1] && m_incoming[end].first == a)
+        {
+          ++end;
+        }
+
+        // x becomes the set of states with an a-transition to a state that simulates s.
+        x.assign(m_words_per_row, 0);
+        for_each_bit(row_s, [&](const std::size_t t)
+          {
+            const std::vector<std::pair<std::size_t, std::size_t>>::const_iterator last = m_incoming.cbegin() + m_incoming_begin[t + 1];
+            for (std::vector<std::pair<std::size_t, std::size_t>>::const_iterator i =
+                   std::lower_bound(m_incoming.cbegin() + m_incoming_begin[t], last, std::make_pair(a, std::size_t(0)));
+                 i != last && i->first == a; ++i)
+            {
+              x[i->second / word_size] |= word_t(1) << (i->second % word_size);
+            }
+          });
+
+        for (std::size_t i = begin; i < end; ++i)
+        {
+          const std::size_t predecessor = m_incoming[i].second;
+          std::atomic<word_t>* r = row(predecessor);
+          bool row_changed = false;
+          for (std::size_t w = 0; w < m_words_per_row; ++w)
+          {
+            if ((r[w].load(std::memory_order_relaxed) & ~x[w]) != 0)
+            {
+              r[w].fetch_and(x[w], std::memory_order_relaxed);
+              row_changed = true;
+            }
+          }
+          if (row_changed && !m_changed[predecessor].exchange(true, std::memory_order_acq_rel))
+          {
+            changed.push_back(predecessor);
+          }
+        }
+        begin = end;
+      }
+    }
+
+    void refine()
+    {
+      std::vector<std::size_t> todo(m_number_of_states);
+      std::iota(todo.begin(), todo.end(), 0);
+      std::size_t rounds = 0;
+      while (!todo.empty())
+      {
+        const std::size_t number_of_parts = std::min(m_number_of_threads, todo.size());
+        std::vector<std::vector<std::size_t>> changed(number_of_parts);
+        sigref_parallel_for(todo.size(), number_of_parts,
+          [&](std::size_t index, std::size_t first, std::size_t last)
+          {
+            std::vector<word_t> x;
+            for (std::size_t i = first; i < last; ++i)
+            {
+              process(todo[i], x, changed[index]);
+            }
+          });
+        todo.clear();
+        for (const std::vector<std::size_t>& c: changed)
+        {
+          todo.insert(todo.end(), c.begin(), c.end());
+        }
+        ++rounds;
+      }
+      mCRL2log(log::verbose) << "The simulation preorder is stable after " << rounds << " rounds." << std::endl;
+    }
+
+    /// \brief Numbers the simulation equivalence classes in the order of their smallest state.
+    void compute_classes()
+    {
+      const std::size_t undefined = std::numeric_limits<std::size_t>::max();
+      m_class.assign(m_number_of_states, undefined);
+      for (std::size_t s = 0; s < m_number_of_states; ++s)
+      {
+        if (m_class[s] == undefined)
+        {
+          m_class[s] = m_number_of_classes;
+          for_each_bit(row(s), [&](const std::size_t t)
+            {
+              if (m_class[t] == undefined && test(row(t), s))
+              {
+                m_class[t] = m_number_of_classes;
+              }
+            });
+          ++m_number_of_classes;
+        }
+      }
+    }
+
+  public:
+    /// \brief Computes the simulation preorder of l.
+    /// \param number_of_threads The number of threads that refine the preorder.
+    sim_partitioner_par(LTS_TYPE& l, const std::size_t number_of_threads = 1)
+      : m_lts(l),
+        m_number_of_threads(std::max<std::size_t>(1, number_of_threads)),
+        m_number_of_states(l.num_states()),
+        m_words_per_row((l.num_states() + word_size - 1) / word_size),
+        m_relation(allocate_relation(l.num_states(), m_words_per_row)),
+        m_changed(new std::atomic<bool>[l.num_states()])
+    {
+      mCRL2log(log::verbose) << "The simulation preorder on " << m_number_of_states << " states takes "
+                             << m_number_of_states * m_words_per_row * sizeof(word_t) / (1024 * 1024) << "MB." << std::endl;
+      index_transitions(false, m_outgoing_begin, m_outgoing);
+      index_transitions(true, m_incoming_begin, m_incoming);
+      for (std::size_t s = 0; s < m_number_of_states; ++s)
+      {
+        m_changed[s] = false;
+      }
+      initialise_relation();
+      refine();
+      compute_classes();
+    }
+
+    /// \brief Returns whether s is simulated by t.
+    bool in_preorder(const std::size_t s, const std::size_t t) const
+    {
+      return test(row(s), t);
+    }
+
+    /// \brief Returns whether s and t are simulation equivalent.
+    bool in_same_class(const std::size_t s, const std::size_t t) const
+    {
+      return m_class[s] == m_class[t];
+    }
+
+    std::size_t num_eq_classes() const
+    {
+      return m_number_of_classes;
+    }
+
+    std::size_t get_eq_class(const std::size_t s) const
+    {
+      return m_class[s];
+    }
+
+    /// \brief The transitions between the simulation equivalence classes.
+    /// \details A class has an a-transition to every maximal class, in the simulation preorder, among the
+    ///          a-successors of its states. As equivalent states have the same maximal classes, only the
+    ///          first state of every class is considered.
+    std::vector<transition> get_transitions() const
+    {
+      std::vector<transition> result;
+      std::vector<bool> done(m_number_of_classes, false);
+      for (std::size_t s = 0; s < m_number_of_states; ++s)
+      {
+        if (done[m_class[s]])
+        {
+          continue;
+        }
+        done[m_class[s]] = true;
+        for (std::size_t i = m_outgoing_begin[s]; i < m_outgoing_begin[s + 1]; ++i)
+        {
+          const std::size_t a = m_outgoing[i].first;
+          const std::size_t t = m_outgoing[i].second;
+          bool maximal = true;
+          for (std::size_t j = m_outgoing_begin[s]; j < m_outgoing_begin[s + 1] && maximal; ++j)
+          {
+            const std::size_t u = m_outgoing[j].second;
+            maximal = m_outgoing[j].first != a || m_class[u] == m_class[t] || !in_preorder(t, u);
+          }
+          if (maximal)
+          {
+            result.emplace_back(m_class[s], a, m_class[t]);
+          }
+        }
+      }
+      std::sort(result.begin(), result.end());
+      result.erase(std::unique(result.begin(), result.end()), result.end());
+      return result;
+    }
+};
+
+/// \brief Reduces l modulo strong bisimulation, as a preprocessing step for the simulation preorder, and
+///        returns the state in the reduced LTS corresponding to state s.
+template <class LTS_TYPE>
+std::size_t sim_par_preprocess(LTS_TYPE& l, const std::size_t s)
+{
+  l.clear_state_labels();
+  bisim_partitioner_dnj<LTS_TYPE> bisim_part(l, false, false);
+  const std::size_t result = bisim_part.get_eq_class(s);
+  bisim_part.finalize_minimized_LTS();
+  return result;
+}
+
+/// \brief Reduces l modulo simulation equivalence, using a bit matrix for the simulation preorder.
+/// \param number_of_threads The number of threads that is used. Small LTSs are always reduced using a single thread.
+template <class LTS_TYPE>
+void simulation_reduce_par(LTS_TYPE& l, const std::size_t number_of_threads = 1)
+{
+  bisimulation_reduce_par(l, false, false, number_of_threads);
+  if (l.num_states() == 0)
+  {
+    return;
+  }
+  sim_partitioner_par<LTS_TYPE> sim_part(l, sim_par_number_of_threads(l.num_states(), number_of_threads));
+  const std::vector<transition> transitions = sim_part.get_transitions();
+  l.set_num_states(sim_part.num_eq_classes());
+  l.set_initial_state(sim_part.get_eq_class(l.initial_state()));
+  l.clear_transitions(transitions.size());
+  for (const transition& t: transitions)
+  {
+    l.add_transition(t);
+  }
+  reachability_check(l, true);
+}
+
+/// \brief Checks whether the initial states of l1 and l2 are simulation equivalent, or, if
+///        preorder is true, whether the initial state of l1 is simulated by that of l2.
+/// \details l1 and l2 are destroyed.
+template <class LTS_TYPE>
+bool destructive_simulation_compare_par(LTS_TYPE& l1, LTS_TYPE& l2, const bool preorder,
+                                        const std::size_t number_of_threads = 1)
+{
+  std::size_t init_l2 = l2.initial_state() + l1.num_states();
+  detail::merge(l1, l2);
+  l2.clear(); // l2 is not needed anymore.
+  init_l2 = sim_par_preprocess(l1, init_l2);
+  sim_partitioner_par<LTS_TYPE> sim_part(l1, sim_par_number_of_threads(l1.num_states(), number_of_threads));
+  if (preorder)
+  {
+    return sim_part.in_preorder(l1.initial_state(), init_l2);
+  }
+  return sim_part.in_same_class(l1.initial_state(), init_l2);
+}
+
+} // namespace detail
+} // namespace lts
+} // namespace mcrl2
+
+#endif // MCRL2_LTS_LIBLTS_SIM_PAR_H
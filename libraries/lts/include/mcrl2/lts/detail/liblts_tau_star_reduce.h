@@ -141,7 +141,8 @@ void remove_redundant_transitions(lts<STATE_LABEL_T, ACTION_LABEL_T, LTS_BASE_CL
   typedef typename lts<STATE_LABEL_T, ACTION_LABEL_T, LTS_BASE_CLASS>::states_size_type state_type;
   typedef typename lts<STATE_LABEL_T, ACTION_LABEL_T, LTS_BASE_CLASS>::labels_size_type label_type;
 
-  outgoing_transitions_per_state_t outgoing_transitions(l.get_transitions(),l.num_states(),true);
+  const std::shared_ptr<const indexed_transitions> outgoing_transitions_ptr=l.outgoing_transitions();
+  const indexed_transitions& outgoing_transitions=*outgoing_transitions_ptr;
   l.clear_transitions();
   std::set < state_type > states_reachable_in_one_visible_action;
   std::set < state_type > states_reachable_in_one_hidden_action;
@@ -154,7 +155,7 @@ void remove_redundant_transitions(lts<STATE_LABEL_T, ACTION_LABEL_T, LTS_BASE_CL
     // for(const outgoing_pair_t& p: vec)
     for(size_t j=outgoing_transitions.lowerbound(from); j<outgoing_transitions.upperbound(from); ++j)
     {
-      const outgoing_pair_t& p = outgoing_transitions.get_transitions()[j];
+      const label_state_pair& p = outgoing_transitions.get_transitions()[j];
       const state_type from_=from;         // the start state of a transition under consideration. 
       const label_type label_=label(p);    // the label
       const state_type to_=to(p);          // the target state
@@ -167,7 +168,7 @@ void remove_redundant_transitions(lts<STATE_LABEL_T, ACTION_LABEL_T, LTS_BASE_CL
       // for(const outgoing_pair_t& j: outgoing_transitions[from_])
       for(size_t j_=outgoing_transitions.lowerbound(from_); j_<outgoing_transitions.upperbound(from_); ++j_)
       {
-        const outgoing_pair_t& j = outgoing_transitions.get_transitions()[j_];
+        const label_state_pair& j = outgoing_transitions.get_transitions()[j_];
         if (l.is_tau(l.apply_hidden_label_map(label(j))))
         {
           states_reachable_in_one_hidden_action.insert(to(j));
@@ -190,7 +191,7 @@ void remove_redundant_transitions(lts<STATE_LABEL_T, ACTION_LABEL_T, LTS_BASE_CL
         // for(const outgoing_pair_t& j: outgoing_transitions[middle])
         for(size_t j_=outgoing_transitions.lowerbound(middle); j_<outgoing_transitions.upperbound(middle); ++j_)
         {
-          const outgoing_pair_t& j=outgoing_transitions.get_transitions()[j_];
+          const label_state_pair& j=outgoing_transitions.get_transitions()[j_];
           if (l.is_tau(l.apply_hidden_label_map(label_)))
           { 
             if (l.is_tau(l.apply_hidden_label_map(label(j))) && to(j)==to_)
@@ -219,7 +220,7 @@ void remove_redundant_transitions(lts<STATE_LABEL_T, ACTION_LABEL_T, LTS_BASE_CL
           // for(const outgoing_pair_t& j: outgoing_transitions[middle])
           for(size_t j_=outgoing_transitions.lowerbound(middle); j_<outgoing_transitions.upperbound(middle); ++j_)
           {
-            const outgoing_pair_t& j=outgoing_transitions.get_transitions()[j_];
+            const label_state_pair& j=outgoing_transitions.get_transitions()[j_];
             if (l.is_tau(l.apply_hidden_label_map(label(j))) && to(j)==to_)
             { 
               assert(!found);
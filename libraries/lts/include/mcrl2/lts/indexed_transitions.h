@@ -0,0 +1,369 @@
+// Author(s): Jan Friso Groote
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/** \file
+ *
+ * \brief A compact representation of the transitions of an lts, grouped per state.
+ * \details The transitions are stored in compressed sparse row (CSR) form. For
+ *          each state an offset is stored, and for each transition a label and a
+ *          state of 64 bits each. This is the representation that the lts class
+ *          builds on request, such that algorithms need not construct their own
+ *          adjacency lists. The same layout is used on disk by the memory mapped
+ *          lts format, such that an index can also refer to a mapped file.
+ * \author Jan Friso Groote
+ */
+
+#ifndef MCRL2_LTS_INDEXED_TRANSITIONS_H
+#define MCRL2_LTS_INDEXED_TRANSITIONS_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "mcrl2/lts/transition.h"
+
+namespace mcrl2
+{
+namespace lts
+{
+
+/// \brief A pair of a label and a state, each stored in 64 bits.
+/// \details In an index of outgoing transitions the state is the target of the transition,
+///          and in an index of incoming transitions it is the source.
+class label_state_pair
+{
+  public:
+    /// \brief The type in which labels and states are stored.
+    typedef std::uint64_t index_type;
+
+  protected:
+    index_type m_label;
+    index_type m_state;
+
+  public:
+    label_state_pair() = default;
+
+    label_state_pair(const std::size_t label, const std::size_t state)
+      : m_label(label),
+        m_state(state)
+    {}
+
+    /// \brief The label of the transition.
+    std::size_t label() const
+    {
+      return m_label;
+    }
+
+    /// \brief The state at the other end of the transition.
+    std::size_t state() const
+    {
+      return m_state;
+    }
+
+    bool operator==(const label_state_pair& other) const
+    {
+      return m_label == other.m_label && m_state == other.m_state;
+    }
+
+    bool operator!=(const label_state_pair& other) const
+    {
+      return !(*this == other);
+    }
+
+    /// \brief Orders pairs first on their labels and then on their states.
+    bool operator<(const label_state_pair& other) const
+    {
+      return m_label < other.m_label || (m_label == other.m_label && m_state < other.m_state);
+    }
+};
+
+static_assert(sizeof(label_state_pair) == 16, "A label_state_pair must be stored in 16 bytes, as it is also used in files.");
+
+/// \brief Label of a pair of a label and a state.
+inline std::size_t label(const label_state_pair& p)
+{
+  return p.label();
+}
+
+/// \brief The state of a pair of a label and a state. This is the target state for outgoing transitions.
+inline std::size_t to(const label_state_pair& p)
+{
+  return p.state();
+}
+
+/// \brief The transitions of an lts grouped per source state (outgoing) or per target state (incoming).
+/// \details The transitions of state s are at the positions lowerbound(s) up to upperbound(s) of the
+///          vector get_transitions(). For each state they are sorted on their labels, and transitions
+///          with the same label are sorted on their states. Duplicate transitions are preserved.
+///          The whole structure is built using a counting sort, in time linear in the number of
+///          states and transitions, apart from sorting the transitions of each individual state.
+class indexed_transitions
+{
+  public:
+    typedef std::size_t state_type;
+    typedef std::size_t label_type;
+    typedef std::uint64_t offset_type;
+    typedef const label_state_pair* const_iterator;
+
+    /// \brief The transitions of a single state, which can be traversed using a range based for loop.
+    class range
+    {
+      protected:
+        const_iterator m_begin;
+        const_iterator m_end;
+
+      public:
+        range(const const_iterator begin, const const_iterator end)
+          : m_begin(begin), m_end(end)
+        {}
+
+        const_iterator begin() const
+        {
+          return m_begin;
+        }
+
+        const_iterator end() const
+        {
+          return m_end;
+        }
+
+        std::size_t size() const
+        {
+          return m_end - m_begin;
+        }
+
+        bool empty() const
+        {
+          return m_begin == m_end;
+        }
+    };
+
+  protected:
+    // The memory in which the index is stored when it is constructed from a vector of transitions.
+    struct storage
+    {
+      std::vector<offset_type> offsets;
+      std::vector<label_state_pair> transitions;
+    };
+
+    // Keeps the memory to which m_offsets and m_transitions point alive. This is either a storage
+    // object, or a memory mapped file.
+    std::shared_ptr<const void> m_storage;
+    const offset_type* m_offsets;                 // The transitions of state s start at m_offsets[s]. Entry m_offsets[m_num_states] is the number of transitions.
+    const label_state_pair* m_transitions;
+    std::size_t m_num_states;
+    bool m_outgoing = true;
+
+    // Builds the index, where only transitions with a label l for which selected(l) holds are included.
+    template <typename SELECTION>
+    void build(const std::vector<transition>& transitions, const SELECTION& selected)
+    {
+      std::shared_ptr<storage> store = std::make_shared<storage>();
+      std::vector<offset_type>& offsets = store->offsets;
+      std::vector<label_state_pair>& indexed = store->transitions;
+
+      offsets.assign(m_num_states + 1, 0);
+      for (const transition& t: transitions)
+      {
+        if (selected(t.label()))
+        {
+          const std::size_t s = m_outgoing ? t.from() : t.to();
+          assert(s < m_num_states);
+          ++offsets[s + 1];
+        }
+      }
+      for (std::size_t s = 0; s < m_num_states; ++s)
+      {
+        offsets[s + 1] += offsets[s];
+      }
+
+      indexed.resize(offsets[m_num_states]);
+      std::vector<offset_type> position(offsets.begin(), offsets.end() - 1);
+      for (const transition& t: transitions)
+      {
+        if (!selected(t.label()))
+        {
+          continue;
+        }
+        if (m_outgoing)
+        {
+          indexed[position[t.from()]++] = label_state_pair(t.label(), t.to());
+        }
+        else
+        {
+          indexed[position[t.to()]++] = label_state_pair(t.label(), t.from());
+        }
+      }
+
+      for (std::size_t s = 0; s < m_num_states; ++s)
+      {
+        if (offsets[s + 1] - offsets[s] > 1)
+        {
+          std::sort(indexed.begin() + offsets[s], indexed.begin() + offsets[s + 1]);
+        }
+      }
+
+      m_offsets = offsets.data();
+      m_transitions = indexed.data();
+      m_storage = store;
+    }
+
+  public:
+    /// \brief Constructs an empty index.
+    indexed_transitions()
+      : indexed_transitions(std::vector<transition>(), 0, true)
+    {}
+
+    /// \brief Constructs an index for the given transitions.
+    /// \param transitions The transitions to be indexed.
+    /// \param num_states The number of states. Sources of outgoing and targets of incoming transitions must be smaller.
+    /// \param outgoing If true the transitions are grouped per source state, otherwise per target state.
+    indexed_transitions(const std::vector<transition>& transitions, const std::size_t num_states, const bool outgoing)
+      : m_num_states(num_states),
+        m_outgoing(outgoing)
+    {
+      build(transitions, [](const std::size_t) { return true; });
+    }
+
+    /// \brief Constructs an index for the transitions with a selected label, such as the internal transitions.
+    /// \details Only the selected transitions are stored, which saves memory if they are few.
+    /// \param transitions The transitions to be indexed.
+    /// \param num_states The number of states. Sources of outgoing and targets of incoming transitions must be smaller.
+    /// \param outgoing If true the transitions are grouped per source state, otherwise per target state.
+    /// \param selected_labels Transitions with label l are included if and only if selected_labels[l] holds.
+    indexed_transitions(const std::vector<transition>& transitions,
+                        const std::size_t num_states,
+                        const bool outgoing,
+                        const std::vector<bool>& selected_labels)
+      : m_num_states(num_states),
+        m_outgoing(outgoing)
+    {
+      build(transitions, [&selected_labels](const std::size_t l) { return selected_labels[l]; });
+    }
+
+    /// \brief Constructs an index on memory that is owned by another object, such as a memory mapped file.
+    /// \details No data is copied. The transitions of each state must be sorted as described above.
+    /// \param owner An object that keeps the memory alive as long as this index, or any copy of it, exists.
+    /// \param offsets An array of num_states+1 offsets. The last one is the number of transitions.
+    /// \param transitions An array with the transitions.
+    /// \param num_states The number of states.
+    /// \param outgoing If true the transitions are grouped per source state, otherwise per target state.
+    indexed_transitions(const std::shared_ptr<const void>& owner,
+                        const offset_type* offsets,
+                        const label_state_pair* transitions,
+                        const std::size_t num_states,
+                        const bool outgoing)
+      : m_storage(owner),
+        m_offsets(offsets),
+        m_transitions(transitions),
+        m_num_states(num_states),
+        m_outgoing(outgoing)
+    {
+      assert(offsets[0] == 0);
+    }
+
+    /// \brief Returns true if the transitions are grouped per source state, and false if per target state.
+    bool outgoing() const
+    {
+      return m_outgoing;
+    }
+
+    /// \brief The number of states for which transitions are indexed.
+    std::size_t num_states() const
+    {
+      return m_num_states;
+    }
+
+    /// \brief The number of indexed transitions.
+    std::size_t size() const
+    {
+      return m_offsets[m_num_states];
+    }
+
+    /// \brief Get the indexed transitions, as an array of size() elements.
+    const label_state_pair* get_transitions() const
+    {
+      return m_transitions;
+    }
+
+    /// \brief Get the offsets of the transitions per state, as an array of num_states()+1 elements.
+    const offset_type* get_offsets() const
+    {
+      return m_offsets;
+    }
+
+    /// \brief Get the lowest index of the transitions of state s in get_transitions().
+    std::size_t lowerbound(const state_type s) const
+    {
+      assert(s < m_num_states);
+      return m_offsets[s];
+    }
+
+    /// \brief Get 1 beyond the highest index of the transitions of state s in get_transitions().
+    std::size_t upperbound(const state_type s) const
+    {
+      assert(s < m_num_states);
+      return m_offsets[s + 1];
+    }
+
+    /// \brief An iterator to the first transition of state s.
+    const_iterator begin(const state_type s) const
+    {
+      return m_transitions + lowerbound(s);
+    }
+
+    /// \brief An iterator beyond the last transition of state s.
+    const_iterator end(const state_type s) const
+    {
+      return m_transitions + upperbound(s);
+    }
+
+    /// \brief The transitions of state s.
+    range transitions(const state_type s) const
+    {
+      return range(begin(s), end(s));
+    }
+
+    /// \brief The transitions of state s with the given label.
+    /// \return A pair of iterators delimiting the transitions, which are sorted on their states.
+    std::pair<const_iterator, const_iterator> equal_range(const state_type s, const label_type l) const
+    {
+      return std::equal_range(begin(s), end(s), label_state_pair(l, 0),
+                              [](const label_state_pair& p1, const label_state_pair& p2) { return p1.label() < p2.label(); });
+    }
+
+    /// \brief Checks whether no state has two transitions with the same label to different states.
+    /// \details As the transitions of each state are sorted, this takes linear time.
+    bool is_deterministic() const
+    {
+      for (std::size_t s = 0; s < m_num_states; ++s)
+      {
+        for (std::size_t i = m_offsets[s] + 1; i < m_offsets[s + 1]; ++i)
+        {
+          if (m_transitions[i - 1].label() == m_transitions[i].label() && m_transitions[i - 1].state() != m_transitions[i].state())
+          {
+            return false;
+          }
+        }
+      }
+      return true;
+    }
+
+    /// \brief The number of bytes occupied by the offsets and the transitions.
+    std::size_t memory_usage() const
+    {
+      return (m_num_states + 1) * sizeof(offset_type) + size() * sizeof(label_state_pair);
+    }
+};
+
+} // namespace lts
+} // namespace mcrl2
+
+#endif // MCRL2_LTS_INDEXED_TRANSITIONS_H
@@ -25,7 +25,10 @@
 #include <algorithm>
 #include <cassert>
 #include <set>
+#include <memory>
+#include <mutex>
 #include "mcrl2/lts/transition.h"
+#include "mcrl2/lts/indexed_transitions.h"
 #include "mcrl2/lts/lts_type.h"
 
 
@@ -51,6 +54,13 @@ namespace lts
         'tau' action. This can be indicated for each action label
         separately. Finally, the number of states is recalled as
         a separate variable.
+
+        On request, the transitions are also provided grouped per
+        source or target state in a compact indexed form. These
+        indices are built when they are first requested, and are
+        kept in the lts, such that the algorithms that are applied
+        to it share them. They are released by the lts as soon as
+        the transitions or the number of states can be changed.
 */
 
 template < class STATE_LABEL_T, class ACTION_LABEL_T, class LTS_BASE>
@@ -86,13 +96,66 @@ class lts: public LTS_BASE
 
     states_size_type m_nstates;
     states_size_type m_init_state;
-    std::vector<transition> m_transitions;
+    // If an index of the outgoing transitions is provided, this vector is only filled when it is
+    // requested, which is guarded by m_materialise.
+    mutable std::vector<transition> m_transitions;
     std::vector<STATE_LABEL_T> m_state_labels;
     std::vector<ACTION_LABEL_T> m_action_labels; // At position 0 we always find the label that corresponds to tau.
     // The following set contains the labels that are recorded as being hidden. 
     // This allows tools to apply reductions assuming that these actions are hidden, but still provide
     // feedback, for instance using counter examples, using the original action name. 
     std::set<labels_size_type> m_hidden_label_set; 
+    // The indices of the outgoing and incoming transitions. They are built when they are first requested,
+    // under m_transition_indices_mutex, unless an index of the outgoing transitions is provided from outside,
+    // for instance by a memory mapped file. They are reset to nullptr by any operation that may change the
+    // transitions or the number of states, including obtaining a non const reference to the transitions.
+    mutable std::shared_ptr<const indexed_transitions> m_outgoing_transitions;
+    mutable std::shared_ptr<const indexed_transitions> m_incoming_transitions;
+    mutable std::mutex m_transition_indices_mutex;
+    // If not nullptr, m_outgoing_transitions is provided, and m_transitions must be filled from it before
+    // it is used.
+    std::unique_ptr<std::once_flag> m_materialise;
+
+    // Copies the transitions of a provided index to m_transitions, if this has not been done yet.
+    // This can safely be called by several threads at the same time.
+    void materialise_transitions() const
+    {
+      if (m_materialise)
+      {
+        std::call_once(*m_materialise, [this]()
+        {
+          m_transitions.reserve(m_outgoing_transitions->size());
+          for (std::size_t s = 0; s < m_outgoing_transitions->num_states(); ++s)
+          {
+            for (const label_state_pair& p: m_outgoing_transitions->transitions(s))
+            {
+              m_transitions.emplace_back(s, p.label(), p.state());
+            }
+          }
+        });
+      }
+    }
+
+    // The indices that are kept, which are shared with a copy of this lts.
+    std::shared_ptr<const indexed_transitions> shared_outgoing_transitions() const
+    {
+      std::lock_guard<std::mutex> lock(m_transition_indices_mutex);
+      return m_outgoing_transitions;
+    }
+
+    std::shared_ptr<const indexed_transitions> shared_incoming_transitions() const
+    {
+      std::lock_guard<std::mutex> lock(m_transition_indices_mutex);
+      return m_incoming_transitions;
+    }
+
+    void reset_transition_indices()
+    {
+      materialise_transitions();
+      m_outgoing_transitions.reset();
+      m_incoming_transitions.reset();
+      m_materialise.reset();
+    }
 
   public:
 
@@ -110,10 +173,12 @@ class lts: public LTS_BASE
       LTS_BASE(l), 
       m_nstates(l.m_nstates),
       m_init_state(l.m_init_state),
-      m_transitions(l.m_transitions),
+      m_transitions(l.get_transitions()),
       m_state_labels(l.m_state_labels),
       m_action_labels(l.m_action_labels),
-      m_hidden_label_set(l.m_hidden_label_set)
+      m_hidden_label_set(l.m_hidden_label_set),
+      m_outgoing_transitions(l.shared_outgoing_transitions()),
+      m_incoming_transitions(l.shared_incoming_transitions())
     {
       assert(m_action_labels.size()>0 && m_action_labels[const_tau_label_index]==ACTION_LABEL_T::tau_action());
     }
@@ -123,10 +188,13 @@ class lts: public LTS_BASE
       static_cast<LTS_BASE&>(*this)=l;
       m_nstates = l.m_nstates;
       m_init_state = l.m_init_state;
-      m_transitions = l.m_transitions;
+      m_transitions = l.get_transitions();
+      m_materialise.reset();
       m_state_labels = l.m_state_labels;
       m_action_labels = l.m_action_labels;
       m_hidden_label_set = l.m_hidden_label_set;
+      m_outgoing_transitions = l.shared_outgoing_transitions();
+      m_incoming_transitions = l.shared_incoming_transitions();
       assert(m_action_labels.size()>0 && m_action_labels[const_tau_label_index]==ACTION_LABEL_T::tau_action());
       return *this;
     }
@@ -152,6 +220,9 @@ class lts: public LTS_BASE
       assert(m_action_labels.size()>0 && m_action_labels[const_tau_label_index]==ACTION_LABEL_T::tau_action());
       assert(l.m_action_labels.size()>0 && l.m_action_labels[const_tau_label_index]==ACTION_LABEL_T::tau_action());
       m_hidden_label_set.swap(l.m_hidden_label_set);
+      m_outgoing_transitions.swap(l.m_outgoing_transitions);
+      m_incoming_transitions.swap(l.m_incoming_transitions);
+      m_materialise.swap(l.m_materialise);
     }
 
     /** \brief Gets the number of states of this LTS.
@@ -194,6 +265,7 @@ class lts: public LTS_BASE
     void set_num_states(const states_size_type n, const bool has_state_labels = true)
     {
       m_nstates = n;
+      reset_transition_indices();
       if (has_state_labels)
       {
         if (m_state_labels.size() > 0)
@@ -215,7 +287,7 @@ class lts: public LTS_BASE
      * \return The number of transitions of this LTS. */
     transitions_size_type num_transitions() const
     {
-      return m_transitions.size();
+      return m_materialise ? m_outgoing_transitions->size() : m_transitions.size();
     }
 
     /** \brief Sets the number of action labels of this LTS.
@@ -265,6 +337,7 @@ class lts: public LTS_BASE
         m_state_labels.resize(m_nstates);
         m_state_labels.push_back(label);
       }
+      reset_transition_indices();
       return m_nstates++;
     }
 
@@ -397,6 +470,9 @@ class lts: public LTS_BASE
      *          action labels untouched. */
     void clear_transitions(const std::size_t n=0)
     {
+      m_outgoing_transitions.reset();
+      m_incoming_transitions.reset();
+      m_materialise.reset();
       m_transitions = std::vector<transition>();
       m_transitions.reserve(n);
     }
@@ -439,15 +515,21 @@ class lts: public LTS_BASE
      * \return   A const reference to the vector. */
     const std::vector<transition>& get_transitions() const
     {
+      materialise_transitions();
       return m_transitions;
     }
 
     /** \brief Gets a reference to the vector of transitions of the current lts.
      *  \details As this vector can be huge, it is adviced to avoid
-     *           to copy this vector.
+     *           to copy this vector. As the transitions can be changed
+     *           via the reference, the indices of the transitions that
+     *           are kept in the lts are discarded. The reference must not
+     *           be used to change the transitions after an index has been
+     *           requested, as the kept index would not reflect the change.
      * \return   A reference to the vector. */
     std::vector<transition>& get_transitions()
     {
+      reset_transition_indices();
       return m_transitions;
     }
 
@@ -457,9 +539,57 @@ class lts: public LTS_BASE
      */
     void add_transition(const transition& t)
     {
+      reset_transition_indices();
       m_transitions.push_back(t);
     }
 
+    /** \brief Gets the transitions grouped per source state.
+     *  \details The index is built when it is first requested, unless it is provided
+     *           using set_outgoing_transitions, and is then kept in the lts until the
+     *           transitions or the number of states can be changed. This function can
+     *           safely be called by several threads. An index does not reflect changes
+     *           made to the transitions after it is obtained. The labels are the original
+     *           labels, i.e., the hidden label set is not applied.
+     *  \return  A shared pointer to the index of outgoing transitions. */
+    std::shared_ptr<const indexed_transitions> outgoing_transitions() const
+    {
+      std::lock_guard<std::mutex> lock(m_transition_indices_mutex);
+      if (!m_outgoing_transitions)
+      {
+        m_outgoing_transitions = std::make_shared<const indexed_transitions>(m_transitions, m_nstates, true);
+      }
+      return m_outgoing_transitions;
+    }
+
+    /** \brief Sets the transitions of this lts to those of an index, for instance one that is read from a file.
+     *  \details The index is returned by outgoing_transitions, and the transitions are
+     *           only copied to a vector when get_transitions is called. The index is
+     *           discarded by any operation that may change the transitions.
+     *  \param[in] index An index of outgoing transitions for the states of this lts.
+     */
+    void set_outgoing_transitions(const std::shared_ptr<const indexed_transitions>& index)
+    {
+      assert(index->outgoing() && index->num_states() == m_nstates);
+      m_transitions = std::vector<transition>();
+      m_outgoing_transitions = index;
+      m_incoming_transitions.reset();
+      m_materialise = std::make_unique<std::once_flag>();
+    }
+
+    /** \brief Gets the transitions grouped per target state.
+     *  \details The index is built when it is first requested and kept, as the index
+     *           of outgoing transitions, see outgoing_transitions.
+     *  \return  A shared pointer to the index of incoming transitions. */
+    std::shared_ptr<const indexed_transitions> incoming_transitions() const
+    {
+      std::lock_guard<std::mutex> lock(m_transition_indices_mutex);
+      if (!m_incoming_transitions)
+      {
+        m_incoming_transitions = std::make_shared<const indexed_transitions>(get_transitions(), m_nstates, false);
+      }
+      return m_incoming_transitions;
+    }
+
     /** \brief Checks whether an action is a tau action.
      * \param[in] action The number of the action.
      * \retval true if the action is a tau action;
@@ -502,6 +632,7 @@ class lts: public LTS_BASE
     {
       if (m_hidden_label_set.size()>0)    // Check whether there is something to rename.
       {
+        reset_transition_indices();
         for(transition& t: m_transitions)
         {
           if (m_hidden_label_set.count(t.label()))
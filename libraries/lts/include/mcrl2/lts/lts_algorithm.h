@@ -21,9 +21,11 @@
 
 #include "mcrl2/lts/detail/liblts_bisim.h"
 #include "mcrl2/lts/detail/liblts_bisim_gjkw.h"
+#include "mcrl2/lts/detail/liblts_bisim_par.h"
 #include "mcrl2/lts/detail/liblts_weak_bisim.h"
 #include "mcrl2/lts/detail/liblts_add_an_action_loop.h"
 #include "mcrl2/lts/detail/liblts_ready_sim.h"
+#include "mcrl2/lts/detail/liblts_sim_par.h"
 #include "mcrl2/lts/detail/liblts_failures_refinement.h"
 #include "mcrl2/lts/detail/tree_set.h"
 #include "mcrl2/lts/lts_equivalence.h"
@@ -39,9 +41,12 @@ namespace lts
  * \param[in] l A labelled transition system that must be reduced.
  * \param[in] eq The equivalence with respect to which the LTS will be
  * reduced.
+ * \param[in] number_of_threads The number of threads that the reduction
+ * may use. Only the signature refinement algorithms, the parallel partition
+ * refinement algorithms and sim-par use more than one thread.
  **/
 template <class LTS_TYPE>
-void reduce(LTS_TYPE& l, lts_equivalence eq);
+void reduce(LTS_TYPE& l, lts_equivalence eq, std::size_t number_of_threads = 1);
 
 /** \brief Checks whether this LTS is equivalent to another LTS.
  * \param[in] l1 The first LTS that will be compared.
@@ -49,6 +54,8 @@ void reduce(LTS_TYPE& l, lts_equivalence eq);
  * \param[in] eq The equivalence with respect to which the LTSs will be
  * compared.
  * \param[in] generate_counter_examples
+ * \param[in] number_of_threads The number of threads that the comparison
+ * may use. Only sim-par uses more than one thread.
  * \retval true if the LTSs are found to be equivalent.
  * \retval false otherwise.
  * \warning This function alters the internal data structure of
@@ -61,7 +68,8 @@ bool destructive_compare(LTS_TYPE& l1,
                          LTS_TYPE& l2,
                          const lts_equivalence eq,
                          const bool generate_counter_examples = false,
-                         const bool structured_output = false)
+                         const bool structured_output = false,
+                         const std::size_t number_of_threads = 1)
 {
   // Merge this LTS and l and store the result in this LTS.
   // In the resulting LTS, the initial state i of l will have the
@@ -154,6 +162,14 @@ bool destructive_compare(LTS_TYPE& l1,
 
       return sp.in_same_class(l1.initial_state(),init_l2);
     }
+    case lts_eq_sim_par:
+    {
+      if (generate_counter_examples)
+      {
+        mCRL2log(log::warning) << "Cannot generate counter example traces for simulation equivalence\n";
+      }
+      return detail::destructive_simulation_compare_par(l1, l2, false, number_of_threads);
+    }
     case lts_eq_ready_sim:
     {
       if (generate_counter_examples)
@@ -214,6 +230,7 @@ bool destructive_compare(LTS_TYPE& l1,
  * \param[in] eq The equivalence with respect to which the LTSs will be
  * compared.
  * \param[in] generate_counter_examples If true counter examples are written to file.
+ * \param[in] number_of_threads The number of threads that the comparison may use.
  * \retval true if the LTSs are found to be equivalent.
  * \retval false otherwise.
  */
@@ -222,7 +239,8 @@ bool compare(const LTS_TYPE& l1,
              const LTS_TYPE& l2,
              const lts_equivalence eq,
              const bool generate_counter_examples = false,
-             const bool structured_output = false);
+             const bool structured_output = false,
+             const std::size_t number_of_threads = 1);
 
 /** \brief Checks whether this LTS is smaller than another LTS according
  * to a preorder.
@@ -235,6 +253,8 @@ bool compare(const LTS_TYPE& l1,
  * \param[in] strategy Choose breadth-first or depth-first for exploration strategy
  *            of the antichain algorithms.
  * \param[in] preprocess Whether to allow preprocessing of the given LTSs.
+ * \param[in] number_of_threads The number of threads that the comparison
+ * may use. Only sim-par uses more than one thread.
  * \retval true if LTS \a l1 is smaller than LTS \a l2 according to
  * preorder \a pre.
  * \retval false otherwise.
@@ -252,7 +272,8 @@ bool destructive_compare(LTS_TYPE& l1,
                          const bool generate_counter_example,
                          const bool structured_output = false,
                          const lps::exploration_strategy strategy = lps::es_breadth,
-                         const bool preprocess = true);
+                         const bool preprocess = true,
+                         const std::size_t number_of_threads = 1);
 
 /** \brief Checks whether this LTS is smaller than another LTS according
  * to a preorder.
@@ -264,6 +285,7 @@ bool destructive_compare(LTS_TYPE& l1,
  * \param[in] strategy Choose breadth-first or depth-first for exploration strategy
  *            of the antichain algorithms.
  * \param[in] preprocess Whether to allow preprocessing of the given LTSs.
+ * \param[in] number_of_threads The number of threads that the comparison may use.
  * \retval true if this LTS is smaller than LTS \a l according to
  * preorder \a pre.
  * \retval false otherwise.
@@ -275,7 +297,8 @@ bool compare(const LTS_TYPE&  l1,
              const bool generate_counter_example,
              const bool structured_output = false,
              const lps::exploration_strategy strategy = lps::es_breadth,
-             const bool preprocess = true);
+             const bool preprocess = true,
+             const std::size_t number_of_threads = 1);
 
 /** \brief Determinises this LTS. */
 template <class LTS_TYPE>
@@ -296,7 +319,8 @@ template <class SL, class AL, class BASE>
 bool reachability_check(lts < SL, AL, BASE>& l, bool remove_unreachable = false)
 {
   // First calculate which states can be reached, and store this in the array visited.
-  const outgoing_transitions_per_state_t out_trans(l.get_transitions(),l.num_states(),true);
+  const std::shared_ptr<const indexed_transitions> out_trans_ptr=l.outgoing_transitions();
+  const indexed_transitions& out_trans=*out_trans_ptr;
 
   std::vector < bool > visited(l.num_states(),false);
   std::stack<std::size_t> todo;
@@ -311,7 +335,7 @@ bool reachability_check(lts < SL, AL, BASE>& l, bool remove_unreachable = false)
     // for (const outgoing_pair_t& p: out_trans[state_to_consider])
     for (detail::state_type i=out_trans.lowerbound(state_to_consider); i<out_trans.upperbound(state_to_consider); ++i)
     {
-      const outgoing_pair_t& p=out_trans.get_transitions()[i];
+      const label_state_pair& p=out_trans.get_transitions()[i];
       assert(visited[state_to_consider] && state_to_consider<l.num_states() && to(p)<l.num_states());
       if (!visited[to(p)])
       {
@@ -405,7 +429,8 @@ template <class SL, class AL, class PROBABILISTIC_STATE, class BASE>
 bool reachability_check(probabilistic_lts < SL, AL, PROBABILISTIC_STATE, BASE>&  l, bool remove_unreachable = false)
 {
   // First calculate which states can be reached, and store this in the array visited.
-  const outgoing_transitions_per_state_t out_trans(l.get_transitions(),l.num_states(),true);
+  const std::shared_ptr<const indexed_transitions> out_trans_ptr=l.outgoing_transitions();
+  const indexed_transitions& out_trans=*out_trans_ptr;
 
   std::vector < bool > visited(l.num_states(),false);
   std::stack<std::size_t> todo;
@@ -423,7 +448,7 @@ bool reachability_check(probabilistic_lts < SL, AL, PROBABILISTIC_STATE, BASE>&
     // for (const outgoing_pair_t& p: out_trans[state_to_consider])
     for (detail::state_type i=out_trans.lowerbound(state_to_consider); i<out_trans.upperbound(state_to_consider); ++i)
     {
-      const outgoing_pair_t& p=out_trans.get_transitions()[i];
+      const label_state_pair& p=out_trans.get_transitions()[i];
       assert(visited[state_to_consider] && state_to_consider<l.num_states() && to(p)<l.num_probabilistic_states());
       // Walk through the the states in this probabilistic state.
       for(const typename PROBABILISTIC_STATE::state_probability_pair& pr: l.probabilistic_state(to(p)))
@@ -535,7 +560,7 @@ void merge(LTS_TYPE& l1, const LTS_TYPE& l2)
 
 
 template <class LTS_TYPE>
-void reduce(LTS_TYPE& l,lts_equivalence eq)
+void reduce(LTS_TYPE& l,lts_equivalence eq, std::size_t number_of_threads)
 {
 
   switch (eq)
@@ -559,10 +584,15 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     }
     case lts_eq_bisim_sigref:
     {
-      sigref<LTS_TYPE, signature_bisim<LTS_TYPE> > s(l);
+      sigref<LTS_TYPE, signature_bisim<LTS_TYPE> > s(l, number_of_threads);
       s.run();
       return;
     }
+    case lts_eq_bisim_par:
+    {
+      detail::bisimulation_reduce_par(l, false, false, number_of_threads);
+      return;
+    }
     case lts_eq_branching_bisim:
     {
       detail::bisimulation_reduce_dnj(l,true,false);
@@ -580,10 +610,15 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     }
     case lts_eq_branching_bisim_sigref:
     {
-      sigref<LTS_TYPE, signature_branching_bisim<LTS_TYPE> > s(l);
+      sigref<LTS_TYPE, signature_branching_bisim<LTS_TYPE> > s(l, number_of_threads);
       s.run();
       return;
     }
+    case lts_eq_branching_bisim_par:
+    {
+      detail::bisimulation_reduce_par(l, true, false, number_of_threads);
+      return;
+    }
     case lts_eq_divergence_preserving_branching_bisim:
     {
       detail::bisimulation_reduce_dnj(l,true,true);
@@ -601,10 +636,15 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     }
     case lts_eq_divergence_preserving_branching_bisim_sigref:
     {
-      sigref<LTS_TYPE, signature_divergence_preserving_branching_bisim<LTS_TYPE> > s(l);
+      sigref<LTS_TYPE, signature_divergence_preserving_branching_bisim<LTS_TYPE> > s(l, number_of_threads);
       s.run();
       return;
     }
+    case lts_eq_divergence_preserving_branching_bisim_par:
+    {
+      detail::bisimulation_reduce_par(l, true, true, number_of_threads);
+      return;
+    }
     case lts_eq_weak_bisim:
     {
       detail::weak_bisimulation_reduce(l,false);
@@ -676,6 +716,11 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
 
       return;
     }
+    case lts_eq_sim_par:
+    {
+      detail::simulation_reduce_par(l, number_of_threads);
+      return;
+    }
     case lts_eq_ready_sim:
     {
       // Run the partitioning algorithm on this LTS
@@ -735,7 +780,8 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
 }
 
 template <class LTS_TYPE>
-bool compare(const LTS_TYPE& l1, const LTS_TYPE& l2, const lts_equivalence eq, const bool generate_counter_examples, const bool structured_output)
+bool compare(const LTS_TYPE& l1, const LTS_TYPE& l2, const lts_equivalence eq, const bool generate_counter_examples, const bool structured_output,
+             const std::size_t number_of_threads)
 {
   switch (eq)
   {
@@ -744,21 +790,23 @@ bool compare(const LTS_TYPE& l1, const LTS_TYPE& l2, const lts_equivalence eq, c
     default:
       LTS_TYPE l1_copy(l1);
       LTS_TYPE l2_copy(l2);
-      return destructive_compare(l1_copy,l2_copy,eq,generate_counter_examples,structured_output);
+      return destructive_compare(l1_copy,l2_copy,eq,generate_counter_examples,structured_output,number_of_threads);
   }
   return false;
 }
 
 template <class LTS_TYPE>
-bool compare(const LTS_TYPE& l1, const LTS_TYPE& l2, const lts_preorder pre, const bool generate_counter_example, const bool structured_output, const lps::exploration_strategy strategy, const bool preprocess)
+bool compare(const LTS_TYPE& l1, const LTS_TYPE& l2, const lts_preorder pre, const bool generate_counter_example, const bool structured_output, const lps::exploration_strategy strategy, const bool preprocess,
+             const std::size_t number_of_threads)
 {
   LTS_TYPE l1_copy(l1);
   LTS_TYPE l2_copy(l2);
-  return destructive_compare(l1_copy, l2_copy, pre, generate_counter_example, structured_output, strategy, preprocess);
+  return destructive_compare(l1_copy, l2_copy, pre, generate_counter_example, structured_output, strategy, preprocess, number_of_threads);
 }
 
 template <class LTS_TYPE>
-bool destructive_compare(LTS_TYPE& l1, LTS_TYPE& l2, const lts_preorder pre, const bool generate_counter_example, const bool structured_output, const lps::exploration_strategy strategy, const bool preprocess)
+bool destructive_compare(LTS_TYPE& l1, LTS_TYPE& l2, const lts_preorder pre, const bool generate_counter_example, const bool structured_output, const lps::exploration_strategy strategy, const bool preprocess,
+                         const std::size_t number_of_threads)
 {
   switch (pre)
   {
@@ -780,6 +828,10 @@ bool destructive_compare(LTS_TYPE& l1, LTS_TYPE& l2, const lts_preorder pre, con
 
       return sp.in_preorder(l1.initial_state(),init_l2);
     }
+    case lts_pre_sim_par:
+    {
+      return detail::destructive_simulation_compare_par(l1, l2, true, number_of_threads);
+    }
     case lts_pre_ready_sim:
     {
       // Merge this LTS and l and store the result in this LTS.
@@ -892,6 +944,12 @@ bool is_deterministic(const LTS_TYPE& l)
     return true;
   }
 
+  if (l.hidden_label_set().empty())
+  {
+    // The transitions in the index are sorted per state, so no copy needs to be sorted.
+    return l.outgoing_transitions()->is_deterministic();
+  }
+
   std::vector<transition> temporary_copy_of_transitions = l.get_transitions();
   sort_transitions(temporary_copy_of_transitions, l.hidden_label_set(), src_lbl_tgt);
   
@@ -921,7 +979,7 @@ namespace detail
 {
 
 template <class LTS_TYPE>
-void get_trans(const outgoing_transitions_per_state_t& begin,
+void get_trans(const indexed_transitions& begin,
                tree_set_store& tss,
                std::size_t d,
                std::vector<transition>& d_trans,
@@ -937,7 +995,7 @@ void get_trans(const outgoing_transitions_per_state_t& begin,
       // for(const outgoing_pair_t& p: begin[from])
       for (detail::state_type i=begin.lowerbound(from); i<begin.upperbound(from); ++i)
       {
-        const outgoing_pair_t& p=begin.get_transitions()[i];
+        const label_state_pair& p=begin.get_transitions()[i];
         d_trans.push_back(transition(from, aut.apply_hidden_label_map(label(p)), to(p)));
       }
     }
@@ -964,7 +1022,8 @@ void determinise(LTS_TYPE& l)
   std::ptrdiff_t d_id = tss.set_set_tag(tss.create_set(d_states));
   d_states.clear();
 
-  const outgoing_transitions_per_state_t begin(l.get_transitions(),l.num_states(),true);
+  const std::shared_ptr<const indexed_transitions> begin_ptr=l.outgoing_transitions();
+  const indexed_transitions& begin=*begin_ptr;
 
   l.clear_transitions();
   l.clear_state_labels();
@@ -15,6 +15,7 @@
 #include "mcrl2/lps/explorer.h"
 #include "mcrl2/lts/detail/lts_convert.h"
 #include "mcrl2/lts/lts_io.h"
+#include "mcrl2/lts/lts_mapped.h"
 
 namespace mcrl2 {
 
@@ -42,19 +43,14 @@ struct lts_builder
   std::size_t add_action(const process::timed_multi_action& a)
   {
     process::timed_multi_action sorted_multi_action(a.sort_actions());
-    auto i = m_actions.find(sorted_multi_action);
-    if (i == m_actions.end())
-    {
-      i = m_actions.emplace(std::make_pair(sorted_multi_action, m_actions.size())).first;
-    }
-    return i->second;
+    return m_actions.try_emplace(sorted_multi_action, m_actions.size()).first->second;
   }
 
   // Add a transition to the LTS
   virtual void add_transition(std::size_t from, const process::timed_multi_action& a, std::size_t to) = 0;
 
   // Add actions and states to the LTS
-  virtual void finalize(const utilities::indexed_set<lps::state>& state_map, bool timed) = 0;
+  virtual void finalize(const lps::discovered_state_set& state_map, bool timed) = 0;
 
   // Save the LTS to a file
   virtual void save(const std::string& filename) = 0;
@@ -68,7 +64,7 @@ class lts_none_builder: public lts_builder
     void add_transition(std::size_t /* from */, const process::timed_multi_action& /* a */, std::size_t /* to */) override
     {}
 
-    void finalize(const utilities::indexed_set<lps::state>& /* state_map */, bool /* timed */) override
+    void finalize(const lps::discovered_state_set& /* state_map */, bool /* timed */) override
     {}
 
     void save(const std::string& /* filename */) override
@@ -90,7 +86,7 @@ class lts_aut_builder: public lts_builder
     }
 
     // Add actions and states to the LTS
-    void finalize(const utilities::indexed_set<lps::state>& state_map, bool /* timed */) override
+    void finalize(const lps::discovered_state_set& state_map, bool /* timed */) override
     {
       // add actions
       m_lts.set_num_action_labels(m_actions.size());
@@ -135,7 +131,7 @@ class lts_aut_disk_builder: public lts_builder
     }
 
     // Add actions and states to the LTS
-    void finalize(const utilities::indexed_set<lps::state>& state_map, bool /* timed */) override
+    void finalize(const lps::discovered_state_set& state_map, bool /* timed */) override
     {
       out.flush();
       out.seekp(0);
@@ -174,7 +170,7 @@ class lts_lts_builder: public lts_builder
     }
 
     // Add actions and states to the LTS
-    void finalize(const utilities::indexed_set<lps::state>& state_map, bool timed) override
+    void finalize(const lps::discovered_state_set& state_map, bool timed) override
     {
       // add actions
       m_lts.set_num_action_labels(m_actions.size());
@@ -247,7 +243,7 @@ class lts_lts_disk_builder: public lts_builder
     }
 
     // Add actions and states to the LTS
-    void finalize(const utilities::indexed_set<lps::state>& state_map, bool timed) override
+    void finalize(const lps::discovered_state_set& state_map, bool timed) override
     {
       if (!m_discard_state_labels)
       {
@@ -324,7 +320,8 @@ std::unique_ptr<lts_builder> create_lts_builder(const lps::specification& lpsspe
     case lts_fsm: return std::make_unique<lts_fsm_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters());
     case lts_lts:
     {
-      if (options.save_at_end)
+      // The memory mapped format can only be written when the whole lts is known.
+      if (options.save_at_end || detail::has_mapped_lts_extension(output_filename))
       {
         return std::make_unique<lts_lts_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.discard_lts_state_labels);
       }
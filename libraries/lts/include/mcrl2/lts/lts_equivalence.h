@@ -35,17 +35,21 @@ enum lts_equivalence
   lts_eq_bisim_gv,         /**< Strong bisimulation equivalence using the O(mn) algorithm [Groote/Vaandrager 1990] */
   lts_eq_bisim_gjkw,        /**< Strong bisimulation equivalence using the O(m log m) algorithm [Groote/Jansen/Keiren/Wijs 2017] */
   lts_eq_bisim_sigref,     /**< Strong bisimulation equivalence using the signature refinement algorithm [Blom/Orzan 2003] */
+  lts_eq_bisim_par,        /**< Strong bisimulation equivalence using parallel partition refinement [Martens/Groote/van den Haak/Hijma/Wijs 2021] */
   lts_eq_branching_bisim,  /**< Branching bisimulation equivalence using the O(m log n) algorithm [Jansen/Groote/Keiren/Wijs 2019] */
   lts_eq_branching_bisim_gv,     /**< Branching bisimulation equivalence using the O(mn) algorithm [Groote/Vaandrager 1990] */
   lts_eq_branching_bisim_gjkw,   /**< Branching bisimulation equivalence using the O(m log m) algorithm [Groote/Jansen/Keiren/Wijs 2017 */
   lts_eq_branching_bisim_sigref, /**< Branching bisimulation equivalence using the signature refinement algorithm [Blom/Orzan 2003] */
+  lts_eq_branching_bisim_par,    /**< Branching bisimulation equivalence using parallel partition refinement [Martens/Groote/van den Haak/Hijma/Wijs 2021] */
   lts_eq_divergence_preserving_branching_bisim, /**< Divergence-preserving branching bisimulation equivalence using the O(m log n) algorithm [Jansen/Groote/Keiren/Wijs 2019] */
   lts_eq_divergence_preserving_branching_bisim_gv,    /**< Divergence-preserving branching bisimulation equivalence using the O(mn) algorithm [Groote/Vaandrager 1990] */
   lts_eq_divergence_preserving_branching_bisim_gjkw,   /**< Divergence-preserving branching bisimulation equivalence using the O(m log m) algorithm [Groote/Jansen/Keiren/Wijs 2017] */
   lts_eq_divergence_preserving_branching_bisim_sigref, /** Divergence-preserving branching bisimulation equivalence using the signature refinement algorithm [Blom/Orzan 2003] */
+  lts_eq_divergence_preserving_branching_bisim_par,    /**< Divergence-preserving branching bisimulation equivalence using parallel partition refinement [Martens/Groote/van den Haak/Hijma/Wijs 2021] */
   lts_eq_weak_bisim,  /**< Weak bisimulation equivalence */
   lts_eq_divergence_preserving_weak_bisim, /**< Divergence-preserving weak bisimulation equivalence */
   lts_eq_sim,              /**< Strong simulation equivalence */
+  lts_eq_sim_par,          /**< Strong simulation equivalence using a bit matrix that is refined in parallel */
   lts_eq_ready_sim,       /**< Strong ready-simulation equivalence */  
   lts_eq_trace,            /**< Strong trace equivalence*/
   lts_eq_weak_trace,       /**< Weak trace equivalence */
@@ -62,21 +66,30 @@ enum lts_equivalence
  *          [Groote/Vaandrager 1990];
  * \li "bisim-sig" for strong bisimilarity using the signature refinement
  *          algorithm [Blom/Orzan 2003];
+ * \li "bisim-par" for strong bisimilarity using parallel partition
+ *          refinement [Martens/Groote/van den Haak/Hijma/Wijs 2021];
  * \li "branching-bisim" for branching bisimilarity using the O(m log n)
  *          algorithm [Groote/Jansen/Keiren/Wijs 2017];
  * \li "branching-bisim-gv" for branching bisimilarity using the O(mn)
  *          algorithm [Groote/Vaandrager 1990];
  * \li "branching-bisim-sig" for branching bisimilarity using the signature
  *          refinement algorithm [Blom/Orzan 2003];
+ * \li "branching-bisim-par" for branching bisimilarity using parallel
+ *          partition refinement [Martens/Groote/van den Haak/Hijma/Wijs 2021];
  * \li "dpbranching-bisim" for divergence-preserving branching bisimilarity
  *          using the O(m log n) algorithm [Groote/Jansen/Keiren/Wijs 2017];
  * \li "dpbranching-bisim-gv" for divergence-preserving branching bisimilarity
  *          using the O(mn) algorithm [Groote/Vaandrager 1990];
  * \li "dpbranching-bisim-sig" for divergence-preserving branching bisimilarity
  *          using the signature refinement algorithm [Blom/Orzan 2003];
+ * \li "dpbranching-bisim-par" for divergence-preserving branching bisimilarity
+ *          using parallel partition refinement
+ *          [Martens/Groote/van den Haak/Hijma/Wijs 2021];
  * \li "weak-bisim" for weak bisimilarity;
  * \li "dpweak-bisim" for divergence-preserving weak bisimilarity;
  * \li "sim" for strong simulation equivalence;
+ * \li "sim-par" for strong simulation equivalence using a bit matrix that is
+ *          refined in parallel;
  * \li "trace" for strong trace equivalence;
  * \li "weak-trace" for weak trace equivalence;
  * \li "determinisation" for a determinisation reduction.
@@ -107,6 +120,10 @@ lts_equivalence parse_equivalence(std::string const& s)
   {
     return lts_eq_bisim_sigref;
   }
+  else if (s == "bisim-par")
+  {
+    return lts_eq_bisim_par;
+  }
   else if (s == "branching-bisim")
   {
     return lts_eq_branching_bisim;
@@ -123,6 +140,10 @@ lts_equivalence parse_equivalence(std::string const& s)
   {
     return lts_eq_branching_bisim_sigref;
   }
+  else if (s == "branching-bisim-par")
+  {
+    return lts_eq_branching_bisim_par;
+  }
   else if (s == "dpbranching-bisim")
   {
     return lts_eq_divergence_preserving_branching_bisim;
@@ -139,6 +160,10 @@ lts_equivalence parse_equivalence(std::string const& s)
   {
     return lts_eq_divergence_preserving_branching_bisim_sigref;
   }
+  else if (s == "dpbranching-bisim-par")
+  {
+    return lts_eq_divergence_preserving_branching_bisim_par;
+  }
   else if (s == "weak-bisim")
   {
     return lts_eq_weak_bisim;
@@ -151,6 +176,10 @@ lts_equivalence parse_equivalence(std::string const& s)
   {
     return lts_eq_sim;
   }
+  else if (s == "sim-par")
+  {
+    return lts_eq_sim_par;
+  }
   else if (s == "ready-sim")
   {
     return lts_eq_ready_sim;
@@ -213,6 +242,8 @@ inline std::string print_equivalence(const lts_equivalence eq)
       return "bisim-gjkw";
     case lts_eq_bisim_sigref:
       return "bisim-sig";
+    case lts_eq_bisim_par:
+      return "bisim-par";
     case lts_eq_branching_bisim:
       return "branching-bisim";
     case lts_eq_branching_bisim_gv:
@@ -221,6 +252,8 @@ inline std::string print_equivalence(const lts_equivalence eq)
       return "branching-bisim-gjkw";
     case lts_eq_branching_bisim_sigref:
       return "branching-bisim-sig";
+    case lts_eq_branching_bisim_par:
+      return "branching-bisim-par";
     case lts_eq_divergence_preserving_branching_bisim:
       return "dpbranching-bisim";
     case lts_eq_divergence_preserving_branching_bisim_gv:
@@ -229,12 +262,16 @@ inline std::string print_equivalence(const lts_equivalence eq)
       return "dpbranching-bisim-gjkw";
     case lts_eq_divergence_preserving_branching_bisim_sigref:
       return "dpbranching-bisim-sig";
+    case lts_eq_divergence_preserving_branching_bisim_par:
+      return "dpbranching-bisim-par";
     case lts_eq_weak_bisim:
       return "weak-bisim";
     case lts_eq_divergence_preserving_weak_bisim:
       return "dpweak-bisim";
     case lts_eq_sim:
       return "sim";
+    case lts_eq_sim_par:
+      return "sim-par";
     case lts_eq_ready_sim:
       return "ready-sim";      
     case lts_eq_trace:
@@ -276,6 +313,8 @@ inline std::string description(const lts_equivalence eq)
       return "strong bisimilarity using the O(m log m) algorithm [Groote/Jansen/Keiren/Wijs 2017]";
     case lts_eq_bisim_sigref:
       return "strong bisimilarity using the signature refinement algorithm [Blom/Orzan 2003]";
+    case lts_eq_bisim_par:
+      return "strong bisimilarity using parallel partition refinement [Martens/Groote/van den Haak/Hijma/Wijs 2021]";
     case lts_eq_branching_bisim:
       return "branching bisimilarity using the O(m log n) algorithm [Jansen/Groote/Keiren/Wijs 2019]";
     case lts_eq_branching_bisim_gv:
@@ -284,6 +323,8 @@ inline std::string description(const lts_equivalence eq)
       return "branching bisimilarity using the O(m log m) algorithm [Groote/Jansen/Keiren/Wijs 2017]";
     case lts_eq_branching_bisim_sigref:
       return "branching bisimilarity using the signature refinement algorithm [Blom/Orzan 2003]";
+    case lts_eq_branching_bisim_par:
+      return "branching bisimilarity using parallel partition refinement [Martens/Groote/van den Haak/Hijma/Wijs 2021]";
     case lts_eq_divergence_preserving_branching_bisim:
       return "divergence-preserving branching bisimilarity using the O(m log n) algorithm [Jansen/Groote/Keiren/Wijs 2019]";
     case lts_eq_divergence_preserving_branching_bisim_gv:
@@ -292,12 +333,16 @@ inline std::string description(const lts_equivalence eq)
       return "divergence-preserving branching bisimilarity using the O(m log m) algorithm [Groote/Jansen/Keiren/Wijs 2017]";
     case lts_eq_divergence_preserving_branching_bisim_sigref:
       return "divergence-preserving branching bisimilarity using the signature refinement algorithm [Blom/Orzan 2003]";
+    case lts_eq_divergence_preserving_branching_bisim_par:
+      return "divergence-preserving branching bisimilarity using parallel partition refinement [Martens/Groote/van den Haak/Hijma/Wijs 2021]";
     case lts_eq_weak_bisim:
       return "weak bisimilarity";
     case lts_eq_divergence_preserving_weak_bisim:
       return "divergence-preserving weak bisimilarity";
     case lts_eq_sim:
       return "strong simulation equivalence";
+    case lts_eq_sim_par:
+      return "strong simulation equivalence using a bit matrix that is refined in parallel";
     case lts_eq_ready_sim:
       return "strong ready simulation equivalence";      
     case lts_eq_trace:
@@ -373,12 +373,16 @@ class lts_lts_t : public lts< state_label_lts, action_label_lts, detail::lts_lts
 
     /** \brief Load the labelled transition system from file.
      *  \details If the filename is empty, the result is read from stdout.
+     *           A file in the memory mapped format of lts_mapped.h is
+     *           recognised by its contents.
      *  \param[in] filename Name of the file to which this lts is written.
      */
     void load(const std::string& filename);
 
     /** \brief Save the labelled transition system to file.
      *  \details If the filename is empty, the result is read from stdin.
+     *           If the filename has the extension .mlts, the lts is saved
+     *           in the memory mapped format of lts_mapped.h.
      *  \param[in] filename Name of the file from which this lts is read.
      */
     void save(const std::string& filename) const;
@@ -401,12 +405,16 @@ class probabilistic_lts_lts_t :
 
     /** \brief Load the labelled transition system from file.
      *  \details If the filename is empty, the result is read from stdout.
+     *           A file in the memory mapped format of lts_mapped.h is
+     *           recognised by its contents.
      *  \param[in] filename Name of the file to which this lts is written.
      */
     void load(const std::string& filename);
 
     /** \brief Save the labelled transition system to file.
      *  \details If the filename is empty, the result is read from stdin.
+     *           If the filename has the extension .mlts, the lts is saved
+     *           in the memory mapped format of lts_mapped.h.
      *  \param[in] filename Name of the file from which this lts is read.
      */
     void save(const std::string& filename) const;
@@ -0,0 +1,198 @@
+// Author(s): Jan Friso Groote
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/** \file lts_mapped.h
+ *
+ * \brief A random access file format for labelled transition systems in mCRL2 format,
+ *        that can be memory mapped.
+ * \details A file in this format consists of a fixed size header, a table of sections
+ *          and the sections themselves. The header contains a magic number, a version,
+ *          a byte order mark, the number of states, transitions and action labels, and
+ *          the initial state. Each section is described by its kind, its offset in the
+ *          file and its size. The following sections are written:
+ *          - the data specification, the process parameters and the action label
+ *            declarations, as a binary aterm stream;
+ *          - the action labels except tau, as a binary aterm stream;
+ *          - optionally, the state labels as a binary aterm stream;
+ *          - the offsets of the outgoing transitions of each state, as 64 bit numbers;
+ *          - the outgoing transitions sorted by source state as pairs of a 64 bit label
+ *            and a 64 bit target state.
+ *          The last two sections are aligned at 8 bytes and have exactly the layout of an
+ *          indexed_transitions object, such that the transitions can be used directly from
+ *          the mapped file. Opening a file only requires reading the header and the section
+ *          table. Files are written in the byte order of the machine that writes them, and
+ *          can only be read on machines with the same byte order.
+ *          Files in this format have the extension .mlts. They are read by lts_lts_t::load,
+ *          which recognises the format by its magic number, whatever the extension.
+ * \author Jan Friso Groote
+ */
+
+#ifndef MCRL2_LTS_LTS_MAPPED_H
+#define MCRL2_LTS_LTS_MAPPED_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "mcrl2/lts/lts_lts.h"
+
+namespace mcrl2
+{
+namespace lts
+{
+
+namespace detail
+{
+
+/// \brief A read only view on the contents of a file. Where possible, the file is mapped into
+///        memory using mmap. Otherwise, its contents are read into memory.
+class mapped_file
+{
+  protected:
+    const char* m_data = nullptr;
+    std::size_t m_size = 0;
+    bool m_is_mapped = false;   // If false, m_data is allocated using new[].
+
+  public:
+    /// \brief Maps the file with the given name into memory. Throws an mcrl2::runtime_error if this fails.
+    explicit mapped_file(const std::string& filename);
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    ~mapped_file();
+
+    const char* data() const
+    {
+      return m_data;
+    }
+
+    std::size_t size() const
+    {
+      return m_size;
+    }
+};
+
+/// \brief Returns true if the filename has the extension .mlts, of the memory mapped lts format.
+bool has_mapped_lts_extension(const std::string& filename);
+
+} // namespace detail
+
+/// \brief A labelled transition system in the memory mapped format.
+/// \details Constructing this object maps the file into memory, and only checks its header and
+///          section table. The transitions are available without copying them, via the index
+///          provided by outgoing_transitions. The labels are only decoded when requested.
+class mapped_lts_file
+{
+  public:
+    /// \brief A contiguous part of the mapped file.
+    struct section
+    {
+      const char* data = nullptr;
+      std::size_t size = 0;
+    };
+
+  protected:
+    std::shared_ptr<const detail::mapped_file> m_file;
+    std::string m_filename;
+    std::size_t m_num_states = 0;
+    std::size_t m_num_transitions = 0;
+    std::size_t m_num_action_labels = 0;
+    std::size_t m_initial_state = 0;
+
+    section m_specification;
+    section m_action_labels;
+    section m_state_labels;
+    section m_offsets;
+    section m_transitions;
+
+  public:
+    /// \brief Opens the file, which must be in the memory mapped lts format.
+    /// \details Throws an mcrl2::runtime_error if the file cannot be opened, or its header is not valid.
+    explicit mapped_lts_file(const std::string& filename);
+
+    /// \brief Returns true if the file with the given name exists and starts with the magic number
+    ///        of the memory mapped lts format.
+    static bool is_mapped_lts_file(const std::string& filename);
+
+    std::size_t num_states() const
+    {
+      return m_num_states;
+    }
+
+    std::size_t num_transitions() const
+    {
+      return m_num_transitions;
+    }
+
+    /// \brief The number of action labels, including tau.
+    std::size_t num_action_labels() const
+    {
+      return m_num_action_labels;
+    }
+
+    std::size_t initial_state() const
+    {
+      return m_initial_state;
+    }
+
+    bool has_state_labels() const
+    {
+      return m_state_labels.data != nullptr;
+    }
+
+    /// \brief The outgoing transitions, which refer directly to the mapped file.
+    /// \details The index keeps the file mapped, also when this object is destroyed.
+    std::shared_ptr<const indexed_transitions> outgoing_transitions() const;
+
+    /// \brief Checks that the offsets are increasing and that all labels and target states exist.
+    /// \details This takes time linear in the number of states and transitions. Throws an
+    ///          mcrl2::runtime_error if the file is not consistent. The constructor only
+    ///          validates the header, so this must be called before the transitions are used.
+    void check_transitions() const;
+
+    /// \brief Checks the outgoing transitions of state s, as check_transitions does for all states.
+    /// \details This allows the transitions to be validated while they are being read.
+    void check_transitions(std::size_t s) const;
+
+    /// \brief Reads the data specification, process parameters and action label declarations.
+    void read_specification(data::data_specification& data,
+                            data::variable_list& process_parameters,
+                            process::action_label_list& action_label_declarations) const;
+
+    /// \brief Reads the action labels. The label with index 0 is tau.
+    std::vector<action_label_lts> read_action_labels() const;
+
+    /// \brief Reads the state labels. If there are no state labels, the result is empty.
+    std::vector<state_label_lts> read_state_labels() const;
+};
+
+/// \brief Saves an lts in the memory mapped format. The hidden label set is applied to the transitions.
+/// \param[in] l The lts to be saved.
+/// \param[in] filename The name of the file. Writing to standard output is not supported.
+void save_mapped_lts(const lts_lts_t& l, const std::string& filename);
+
+/// \brief Saves a probabilistic lts in the memory mapped format.
+/// \details This is only possible if all its probabilistic states consist of a single state.
+void save_mapped_lts(const probabilistic_lts_lts_t& l, const std::string& filename);
+
+/// \brief Loads an lts from a file in the memory mapped format.
+/// \details The index of outgoing transitions of \a l refers to the mapped file, so it is not rebuilt,
+///          and the transitions are only copied into memory if get_transitions is called. The
+///          transitions are validated, see mapped_lts_file::check_transitions.
+void load_mapped_lts(lts_lts_t& l, const std::string& filename);
+
+/// \brief Loads a probabilistic lts from a file in the memory mapped format.
+/// \details Every state forms a probabilistic state on its own. The transitions are loaded as for
+///          an lts without probabilities.
+void load_mapped_lts(probabilistic_lts_lts_t& l, const std::string& filename);
+
+} // namespace lts
+} // namespace mcrl2
+
+#endif // MCRL2_LTS_LTS_MAPPED_H
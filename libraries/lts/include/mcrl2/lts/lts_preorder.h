@@ -32,6 +32,7 @@ enum lts_preorder
 {
   lts_pre_none,   /**< Unknown or no preorder */
   lts_pre_sim,    /**< Strong simulation preorder */
+  lts_pre_sim_par,    /**< Strong simulation preorder using a bit matrix that is refined in parallel */
   lts_pre_ready_sim,    /**< Strong ready simulation preorder */  
   lts_pre_trace,  /**< Strong trace preorder */
   lts_pre_weak_trace,   /**< Weak trace preorder */
@@ -47,6 +48,8 @@ enum lts_preorder
 /** \brief Determines the preorder from a string.
  * \details The following strings may be used:
  * \li "sim" for strong simulation preorder;
+ * \li "sim-par" for strong simulation preorder using a bit matrix that is
+ *          refined in parallel;
  * \li "trace" for strong trace preorder;
  * \li "weak-trace" for weak trace preorder.
  *
@@ -64,6 +67,10 @@ lts_preorder parse_preorder(std::string const& s)
   {
     return lts_pre_sim;
   }
+  else if (s == "sim-par")
+  {
+    return lts_pre_sim_par;
+  }
   else if (s == "ready-sim")
   {
     return lts_pre_ready_sim;
@@ -133,6 +140,8 @@ std::string print_preorder(const lts_preorder pre)
       return "unknown";
     case lts_pre_sim:
       return "sim";
+    case lts_pre_sim_par:
+      return "sim-par";
     case lts_pre_ready_sim:
       return "ready-sim";      
     case lts_pre_trace:
@@ -174,6 +183,8 @@ std::string description(const lts_preorder pre)
       return "default void preorder";
     case lts_pre_sim:
       return "strong simulation preorder";
+    case lts_pre_sim_par:
+      return "strong simulation preorder using a bit matrix that is refined in parallel";
     case lts_pre_ready_sim:
       return "strong ready simulation preorder";      
     case lts_pre_trace:
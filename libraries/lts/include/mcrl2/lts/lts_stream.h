@@ -0,0 +1,580 @@
+// Author(s): Jan Friso Groote
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/** \file lts_stream.h
+ *
+ * \brief Reading and writing labelled transition systems without storing them in memory.
+ * \details A reader passes the contents of a file to an lts_stream_writer, in the order in
+ *          which they occur in the file. Writers can be chained, such that an lts can be
+ *          converted from one format into another, while hiding actions, using memory that
+ *          only depends on the number of action labels. This is used by ltsconvert when no
+ *          reduction of the lts is requested, and by ltsinfo to collect its information.
+ * \author Jan Friso Groote
+ */
+
+#ifndef MCRL2_LTS_LTS_STREAM_H
+#define MCRL2_LTS_LTS_STREAM_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "mcrl2/lts/lts_io.h"
+
+namespace mcrl2
+{
+namespace lts
+{
+
+/// \brief Receives the parts of an lts in the order in which they are read.
+/// \details First set_base is called. Then action labels, transitions and state labels
+///          are passed, and the initial state is set, in any order, except that an action
+///          label is always added before it is used. The action labels are numbered in the
+///          order in which they are added, and the first one, with index 0, is tau. State
+///          labels are added in the order of the states, possibly only after the
+///          transitions. Finally, finish is called with the number of states.
+template <class LTS_TYPE>
+class lts_stream_writer
+{
+  public:
+    typedef typename LTS_TYPE::state_label_t state_label_t;
+    typedef typename LTS_TYPE::action_label_t action_label_t;
+    typedef typename LTS_TYPE::base_t base_t;
+
+    virtual ~lts_stream_writer() = default;
+
+    virtual void set_base(const base_t& base) = 0;
+    virtual void add_action_label(const action_label_t& label) = 0;
+    virtual void add_transition(const transition& t) = 0;
+    virtual void add_state_label(const state_label_t& label) = 0;
+    virtual void set_initial_state(std::size_t initial_state) = 0;
+    virtual void finish(std::size_t number_of_states) = 0;
+};
+
+/// \brief Reads an lts in aut format and passes it to the writer.
+/// \details If the filename is empty, the lts is read from standard input.
+void read_lts_stream(const std::string& filename, lts_stream_writer<lts_aut_t>& writer);
+
+/// \brief Reads an lts in mCRL2 format, or in the memory mapped mCRL2 format, and passes it to the writer.
+/// \details If the filename is empty, the lts is read from standard input. The number of
+///          states is determined as by lts_lts_t::load. Probabilistic transitions are not allowed.
+void read_lts_stream(const std::string& filename, lts_stream_writer<lts_lts_t>& writer);
+
+/// \brief Reads an lts in fsm format and passes it to the writer.
+/// \details If the filename is empty, the lts is read from standard input. Probabilistic
+///          transitions and initial states are not allowed.
+void read_lts_stream(const std::string& filename, lts_stream_writer<lts_fsm_t>& writer);
+
+/// \brief Hides actions and removes state labels of an lts that is passed to the next writer.
+/// \details A label is hidden, as by lts::record_hidden_actions, if hiding the given actions
+///          changes it. Transitions with a hidden label get the label tau.
+template <class LTS_TYPE>
+class lts_stream_filter: public lts_stream_writer<LTS_TYPE>
+{
+  public:
+    typedef lts_stream_writer<LTS_TYPE> super;
+    typedef typename super::state_label_t state_label_t;
+    typedef typename super::action_label_t action_label_t;
+    typedef typename super::base_t base_t;
+
+  protected:
+    lts_stream_writer<LTS_TYPE>& m_next;
+    std::vector<std::string> m_tau_actions;
+    bool m_remove_state_labels;
+    std::vector<bool> m_hidden;
+
+  public:
+    lts_stream_filter(lts_stream_writer<LTS_TYPE>& next, const std::vector<std::string>& tau_actions, const bool remove_state_labels)
+      : m_next(next),
+        m_tau_actions(tau_actions),
+        m_remove_state_labels(remove_state_labels)
+    {}
+
+    void set_base(const base_t& base) override
+    {
+      m_next.set_base(base);
+    }
+
+    void add_action_label(const action_label_t& label) override
+    {
+      bool hidden = false;
+      if (!m_tau_actions.empty())
+      {
+        action_label_t a = label;
+        a.hide_actions(m_tau_actions);
+        hidden = (a != label);
+      }
+      m_hidden.push_back(hidden);
+      m_next.add_action_label(label);
+    }
+
+    void add_transition(const transition& t) override
+    {
+      assert(t.label() < m_hidden.size());
+      if (m_hidden[t.label()])
+      {
+        m_next.add_transition(transition(t.from(), const_tau_label_index, t.to()));
+      }
+      else
+      {
+        m_next.add_transition(t);
+      }
+    }
+
+    void add_state_label(const state_label_t& label) override
+    {
+      if (!m_remove_state_labels)
+      {
+        m_next.add_state_label(label);
+      }
+    }
+
+    void set_initial_state(const std::size_t initial_state) override
+    {
+      m_next.set_initial_state(initial_state);
+    }
+
+    void finish(const std::size_t number_of_states) override
+    {
+      m_next.finish(number_of_states);
+    }
+};
+
+/// \brief Converts the labels of an lts of type LTS_IN_TYPE into those of LTS_OUT_TYPE, as lts_convert does.
+template <class LTS_IN_TYPE, class LTS_OUT_TYPE>
+class lts_stream_convertor: public lts_stream_writer<LTS_IN_TYPE>
+{
+  public:
+    typedef lts_stream_writer<LTS_IN_TYPE> super;
+    typedef typename super::state_label_t state_label_t;
+    typedef typename super::action_label_t action_label_t;
+    typedef typename super::base_t base_t;
+    typedef typename LTS_OUT_TYPE::base_t out_base_t;
+
+  protected:
+    lts_stream_writer<LTS_OUT_TYPE>& m_next;
+    const data::data_specification m_data;
+    const process::action_label_list m_action_labels;
+    const data::variable_list m_process_parameters;
+    const bool m_extra_data_is_defined;
+
+    // The convertor refers to the bases, and is constructed when the base is known.
+    base_t m_base_in;
+    out_base_t m_base_out;
+    std::optional<detail::convertor<base_t, out_base_t>> m_convertor;
+
+  public:
+    /// \brief Constructor. The extra information is used as in lts_convert.
+    lts_stream_convertor(lts_stream_writer<LTS_OUT_TYPE>& next,
+                         const data::data_specification& data,
+                         const process::action_label_list& action_labels,
+                         const data::variable_list& process_parameters,
+                         const bool extra_data_is_defined)
+      : m_next(next),
+        m_data(data),
+        m_action_labels(action_labels),
+        m_process_parameters(process_parameters),
+        m_extra_data_is_defined(extra_data_is_defined)
+    {}
+
+    lts_stream_convertor(const lts_stream_convertor&) = delete;
+    lts_stream_convertor& operator=(const lts_stream_convertor&) = delete;
+
+    void set_base(const base_t& base) override
+    {
+      m_base_in = base;
+      detail::lts_convert_base_class(m_base_in, m_base_out, m_data, m_action_labels, m_process_parameters, m_extra_data_is_defined);
+      m_convertor.emplace(m_base_in, m_base_out);
+      m_next.set_base(m_base_out);
+    }
+
+    void add_action_label(const action_label_t& label) override
+    {
+      m_next.add_action_label(detail::lts_convert_translate_label(label, *m_convertor));
+    }
+
+    void add_transition(const transition& t) override
+    {
+      m_next.add_transition(t);
+    }
+
+    void add_state_label(const state_label_t& label) override
+    {
+      typename LTS_OUT_TYPE::state_label_t result;
+      detail::lts_convert_translate_state(label, result, *m_convertor);
+      m_next.add_state_label(result);
+    }
+
+    void set_initial_state(const std::size_t initial_state) override
+    {
+      m_next.set_initial_state(initial_state);
+    }
+
+    void finish(const std::size_t number_of_states) override
+    {
+      m_next.finish(number_of_states);
+    }
+};
+
+/// \brief Collects information about an lts, such as the numbers of states and transitions.
+/// \details Only the action labels and the number of outgoing transitions of each state are
+///          stored. If requested, the state labels are stored as well, and the transitions are
+///          stored until the lts is finished, to check whether all states are reachable and
+///          whether the lts is deterministic.
+template <class LTS_TYPE>
+class lts_stream_statistics: public lts_stream_writer<LTS_TYPE>
+{
+  public:
+    typedef lts_stream_writer<LTS_TYPE> super;
+    typedef typename super::state_label_t state_label_t;
+    typedef typename super::action_label_t action_label_t;
+    typedef typename super::base_t base_t;
+
+  protected:
+    const bool m_keep_state_labels;
+    const bool m_check_transitions;
+    std::vector<action_label_t> m_action_labels;
+    std::vector<state_label_t> m_state_labels;
+    std::vector<transition> m_transitions;
+    std::vector<std::uint64_t> m_branching_factor;
+    std::size_t m_number_of_transitions = 0;
+    std::size_t m_number_of_state_labels = 0;
+    std::size_t m_number_of_states = 0;
+    std::size_t m_initial_state = 0;
+    bool m_is_reachable = true;
+    bool m_is_deterministic = true;
+
+    // Determines reachability and determinism, using the transitions sorted per source state as an index.
+    void check_transitions()
+    {
+      std::sort(m_transitions.begin(), m_transitions.end(), [](const transition& t1, const transition& t2)
+                {
+                  return t1.from() < t2.from() || (t1.from() == t2.from() &&
+                         (t1.label() < t2.label() || (t1.label() == t2.label() && t1.to() < t2.to())));
+                });
+      std::vector<std::size_t> offsets(m_number_of_states + 1, 0);
+      for (std::size_t s = 0; s < m_number_of_states; ++s)
+      {
+        offsets[s + 1] = offsets[s] + m_branching_factor[s];
+      }
+
+      for (std::size_t i = 1; i < m_transitions.size() && m_is_deterministic; ++i)
+      {
+        const transition& t1 = m_transitions[i - 1];
+        const transition& t2 = m_transitions[i];
+        m_is_deterministic = t1.from() != t2.from() || t1.label() != t2.label() || t1.to() == t2.to();
+      }
+
+      std::vector<bool> visited(m_number_of_states, false);
+      std::vector<std::size_t> todo;
+      std::size_t number_of_visited_states = 0;
+      if (m_initial_state < m_number_of_states)
+      {
+        visited[m_initial_state] = true;
+        todo.push_back(m_initial_state);
+        number_of_visited_states = 1;
+      }
+      while (!todo.empty())
+      {
+        const std::size_t s = todo.back();
+        todo.pop_back();
+        for (std::size_t i = offsets[s]; i < offsets[s + 1]; ++i)
+        {
+          const std::size_t t = m_transitions[i].to();
+          if (!visited[t])
+          {
+            visited[t] = true;
+            ++number_of_visited_states;
+            todo.push_back(t);
+          }
+        }
+      }
+      m_is_reachable = number_of_visited_states == m_number_of_states;
+      m_transitions = std::vector<transition>();
+    }
+
+  public:
+    /// \brief Constructor.
+    /// \param keep_state_labels If true, the state labels are stored.
+    /// \param check_transitions If true, reachability and determinism are determined.
+    lts_stream_statistics(const bool keep_state_labels, const bool check_transitions)
+      : m_keep_state_labels(keep_state_labels),
+        m_check_transitions(check_transitions)
+    {}
+
+    void set_base(const base_t&) override
+    {}
+
+    void add_action_label(const action_label_t& label) override
+    {
+      m_action_labels.push_back(label);
+    }
+
+    void add_transition(const transition& t) override
+    {
+      ++m_number_of_transitions;
+      if (t.from() >= m_branching_factor.size())
+      {
+        m_branching_factor.resize(t.from() + 1, 0);
+      }
+      ++m_branching_factor[t.from()];
+      if (m_check_transitions)
+      {
+        m_transitions.push_back(t);
+      }
+    }
+
+    void add_state_label(const state_label_t& label) override
+    {
+      ++m_number_of_state_labels;
+      if (m_keep_state_labels)
+      {
+        m_state_labels.push_back(label);
+      }
+    }
+
+    void set_initial_state(const std::size_t initial_state) override
+    {
+      m_initial_state = initial_state;
+    }
+
+    void finish(const std::size_t number_of_states) override
+    {
+      m_number_of_states = number_of_states;
+      m_branching_factor.resize(number_of_states, 0);
+      if (m_check_transitions)
+      {
+        check_transitions();
+      }
+    }
+
+    /// \brief The action labels, of which the one with index 0 is tau.
+    const std::vector<action_label_t>& action_labels() const
+    {
+      return m_action_labels;
+    }
+
+    /// \brief The state labels. These are only stored if this is requested in the constructor.
+    const std::vector<state_label_t>& state_labels() const
+    {
+      return m_state_labels;
+    }
+
+    /// \brief The number of outgoing transitions of each state.
+    const std::vector<std::uint64_t>& branching_factor() const
+    {
+      return m_branching_factor;
+    }
+
+    std::size_t num_states() const
+    {
+      return m_number_of_states;
+    }
+
+    std::size_t num_action_labels() const
+    {
+      return m_action_labels.size();
+    }
+
+    std::size_t num_transitions() const
+    {
+      return m_number_of_transitions;
+    }
+
+    std::size_t num_state_labels() const
+    {
+      return m_number_of_state_labels;
+    }
+
+    std::size_t initial_state() const
+    {
+      return m_initial_state;
+    }
+
+    /// \brief Returns true if all states are reachable from the initial state.
+    /// \details Only available if the transitions are checked.
+    bool is_reachable() const
+    {
+      assert(m_check_transitions);
+      return m_is_reachable;
+    }
+
+    /// \brief Returns true if no state has two transitions with the same label to different states.
+    /// \details Only available if the transitions are checked.
+    bool is_deterministic() const
+    {
+      assert(m_check_transitions);
+      return m_is_deterministic;
+    }
+};
+
+/// \brief Writes an lts in aut format to a file.
+/// \details The header, which contains the number of transitions and states, is written when
+///          the lts is finished. Therefore, writing to standard output is not possible.
+class aut_stream_writer: public lts_stream_writer<lts_aut_t>
+{
+  protected:
+    // The header is padded with spaces to this length, such that it can be overwritten.
+    static constexpr std::size_t header_size = 80;
+
+    std::ofstream m_stream;
+    std::vector<std::string> m_labels;  // For each label the text between the source and the target.
+    std::string m_buffer;
+    std::size_t m_number_of_transitions = 0;
+    std::size_t m_initial_state = 0;
+
+    void write_buffer()
+    {
+      m_stream.write(m_buffer.data(), m_buffer.size());
+      m_buffer.clear();
+    }
+
+    void append_number(const std::size_t n)
+    {
+      char digits[std::numeric_limits<std::size_t>::digits10 + 1];
+      const std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), n);
+      m_buffer.append(digits, result.ptr);
+    }
+
+  public:
+    explicit aut_stream_writer(const std::string& filename)
+    {
+      if (filename.empty())
+      {
+        throw mcrl2::runtime_error("An .aut file that is written while it is read cannot be written to standard output.");
+      }
+      m_stream.open(filename, std::ofstream::out | std::ofstream::binary);
+      if (!m_stream.is_open())
+      {
+        throw mcrl2::runtime_error("cannot create .aut file '" + filename + ".");
+      }
+      m_buffer.append(header_size, ' ');
+      m_buffer.push_back('\n');
+    }
+
+    void set_base(const detail::lts_aut_base&) override
+    {}
+
+    void add_action_label(const action_label_string& label) override
+    {
+      m_labels.push_back(",\"" + pp(label) + "\",");
+    }
+
+    void add_transition(const transition& t) override
+    {
+      assert(t.label() < m_labels.size());
+      m_buffer.push_back('(');
+      append_number(t.from());
+      m_buffer.append(m_labels[t.label()]);
+      append_number(t.to());
+      m_buffer.append(")\n");
+      ++m_number_of_transitions;
+      if (m_buffer.size() >= (1 << 20))
+      {
+        write_buffer();
+      }
+    }
+
+    void add_state_label(const state_label_empty&) override
+    {}
+
+    void set_initial_state(const std::size_t initial_state) override
+    {
+      m_initial_state = initial_state;
+    }
+
+    void finish(const std::size_t number_of_states) override
+    {
+      write_buffer();
+      m_stream.seekp(0);
+      m_stream << "des (" << m_initial_state << "," << m_number_of_transitions << "," << number_of_states << ")";
+      m_stream.close();
+      if (m_stream.fail())
+      {
+        throw mcrl2::runtime_error("Fail to write the .aut file correctly.");
+      }
+    }
+};
+
+/// \brief Writes an lts in mCRL2 format. If the filename is empty, it is written to standard output.
+class lts_lts_stream_writer: public lts_stream_writer<lts_lts_t>
+{
+  protected:
+    std::ofstream m_fstream;
+    std::unique_ptr<atermpp::binary_aterm_ostream> m_stream;
+    std::vector<process::timed_multi_action> m_labels;
+    std::size_t m_number_of_state_labels = 0;
+    std::size_t m_initial_state = 0;
+
+  public:
+    explicit lts_lts_stream_writer(const std::string& filename)
+    {
+      if (!filename.empty())
+      {
+        m_fstream.open(filename, std::ofstream::out | std::ofstream::binary);
+        if (m_fstream.fail())
+        {
+          throw mcrl2::runtime_error("Fail to open file " + filename + " for writing.");
+        }
+      }
+      m_stream = std::make_unique<atermpp::binary_aterm_ostream>(filename.empty() ? std::cout : m_fstream);
+    }
+
+    void set_base(const detail::lts_lts_base& base) override
+    {
+      write_lts_header(*m_stream, base.data(), base.process_parameters(), base.action_label_declarations());
+    }
+
+    void add_action_label(const action_label_lts& label) override
+    {
+      m_labels.emplace_back(label.actions(), label.time());
+    }
+
+    void add_transition(const transition& t) override
+    {
+      assert(t.label() < m_labels.size());
+      write_transition(*m_stream, t.from(), m_labels[t.label()], t.to());
+    }
+
+    void add_state_label(const state_label_lts& label) override
+    {
+      write_state_label(*m_stream, label);
+      ++m_number_of_state_labels;
+    }
+
+    void set_initial_state(const std::size_t initial_state) override
+    {
+      m_initial_state = initial_state;
+    }
+
+    void finish(const std::size_t number_of_states) override
+    {
+      // As in an lts in memory, either all states or no states have a label.
+      for (std::size_t i = m_number_of_state_labels; 0 < m_number_of_state_labels && i < number_of_states; ++i)
+      {
+        write_state_label(*m_stream, state_label_lts());
+      }
+      write_initial_state(*m_stream, m_initial_state);
+      m_stream.reset();
+      if (m_fstream.is_open())
+      {
+        m_fstream.close();
+      }
+    }
+};
+
+} // namespace lts
+} // namespace mcrl2
+
+#endif // MCRL2_LTS_LTS_STREAM_H
@@ -20,13 +20,16 @@ namespace mcrl2::lts {
 
 namespace detail {
 
+/// \brief A line based parser for .fsm files, that passes what it reads to the builder.
+/// \details The builder must provide the same functions as fsm_builder.
+template <typename Builder = detail::fsm_builder>
 class simple_fsm_parser
 {
   protected:
     enum states { PARAMETERS, STATES, TRANSITIONS, INITIAL_DISTRIBUTION };
 
     // Used for constructing an FSM
-    detail::fsm_builder builder;
+    Builder builder;
 
     boost::xpressive::sregex regex_parameter = boost::xpressive::sregex::compile(R"(\s*([a-zA-Z_][a-zA-Z0-9_'@]*)\((\d+)\)\s*([a-zA-Z_][a-zA-Z0-9_'@#\-> \t=,\\(\\):]*)?\s*((\"[^\"]*\"\s*)*))");
 
@@ -129,8 +132,9 @@ class simple_fsm_parser
     }
 
   public:
-    explicit simple_fsm_parser(probabilistic_lts_fsm_t& fsm)
-      : builder(fsm)
+    template <typename Target>
+    explicit simple_fsm_parser(Target& target)
+      : builder(target)
     {}
 
     void run(std::istream& from)
@@ -169,7 +173,7 @@ class simple_fsm_parser
 inline
 void parse_fsm_specification(std::istream& from, probabilistic_lts_fsm_t& result)
 {
-  detail::simple_fsm_parser fsm_parser(result);
+  detail::simple_fsm_parser<> fsm_parser(result);
   fsm_parser.run(from);
 }
 
@@ -14,17 +14,126 @@
 #ifndef MCRL2_LTS_SIGREF_H
 #define MCRL2_LTS_SIGREF_H
 
+#include <numeric>
+#include <thread>
+#include <unordered_map>
+#include "mcrl2/lts/detail/liblts_scc.h"
 #include "mcrl2/lts/lts_utilities.h"
+#include "mcrl2/utilities/hash_utility.h"
 
 namespace mcrl2
 {
 namespace lts
 {
 
-/** \brief A signature is a pair of an action label and a block */
-typedef std::set<std::pair<std::size_t, std::size_t> > signature_t;
+/** \brief A signature is a sorted vector of pairs of an action label and a block, without duplicates */
+typedef std::vector<std::pair<std::size_t, std::size_t> > signature_t;
 
-/** \brief Base class for signature computation */
+namespace detail
+{
+
+/** \brief Applies f(index, first, last) to at most \a number_of_threads consecutive ranges that together form
+  *        [0, n), each in a separate thread. The index of a range is its position in the sequence of ranges. */
+template <typename Function>
+void sigref_parallel_for(const std::size_t n, const std::size_t number_of_threads, Function f)
+{
+  if (number_of_threads <= 1 || n < number_of_threads)
+  {
+    f(0, 0, n);
+    return;
+  }
+  const std::size_t chunk = (n + number_of_threads - 1) / number_of_threads;
+  std::vector<std::thread> threads;
+  for (std::size_t index = 1; index * chunk < n; ++index)
+  {
+    threads.emplace_back(f, index, index * chunk, std::min(n, (index + 1) * chunk));
+  }
+  f(0, 0, chunk);
+  for (std::thread& thread: threads)
+  {
+    thread.join();
+  }
+}
+
+/** \brief Sorts a signature and removes duplicate pairs */
+inline void normalise_signature(signature_t& sig)
+{
+  std::sort(sig.begin(), sig.end());
+  sig.erase(std::unique(sig.begin(), sig.end()), sig.end());
+}
+
+/** \brief Hash function for signatures */
+inline std::size_t hash_signature(const signature_t& sig)
+{
+  std::size_t hash = sig.size();
+  for (const std::pair<std::size_t, std::size_t>& p: sig)
+  {
+    hash = utilities::detail::hash_combine(hash, utilities::detail::hash_combine(p.first, p.second));
+  }
+  return hash;
+}
+
+/** \brief Computes the levels of the states, where a state without outgoing tau transitions, other than
+  *        tau-loops, has level 0, and any other state has a level that is one higher than the maximal level of
+  *        its tau-successors.
+  * \param[in] l The LTS, which must not contain tau-cycles other than tau-loops.
+  * \param[in] outgoing The outgoing transitions of \a l.
+  * \param[in] label_map The hidden label map, applied to each label. */
+template <class LTS_T>
+std::vector<std::size_t> compute_tau_levels(const LTS_T& l, const indexed_transitions& outgoing, const std::vector<std::size_t>& label_map)
+{
+  const std::size_t n = l.num_states();
+  std::vector<std::size_t> tau_successors(n, 0);
+  for (std::size_t s = 0; s < n; ++s)
+  {
+    for (std::size_t i = outgoing.lowerbound(s); i < outgoing.upperbound(s); ++i)
+    {
+      const label_state_pair& t = outgoing.get_transitions()[i];
+      if (l.is_tau(label_map[t.label()]) && t.state() != s)
+      {
+        ++tau_successors[s];
+      }
+    }
+  }
+  const std::shared_ptr<const indexed_transitions> incoming = l.incoming_transitions();
+
+  // Process the states in reverse topological order of the tau transitions.
+  std::vector<std::size_t> level(n, 0);
+  std::vector<std::size_t> todo;
+  for (std::size_t s = 0; s < n; ++s)
+  {
+    if (tau_successors[s] == 0)
+    {
+      todo.push_back(s);
+    }
+  }
+  for (std::size_t i = 0; i < todo.size(); ++i)
+  {
+    const std::size_t s = todo[i];
+    for (std::size_t j = incoming->lowerbound(s); j < incoming->upperbound(s); ++j)
+    {
+      const label_state_pair& t = incoming->get_transitions()[j];
+      const std::size_t p = t.state();
+      if (!l.is_tau(label_map[t.label()]) || p == s)
+      {
+        continue;
+      }
+      level[p] = std::max(level[p], level[s] + 1);
+      if (--tau_successors[p] == 0)
+      {
+        todo.push_back(p);
+      }
+    }
+  }
+  assert(todo.size() == n); // There are no tau-cycles.
+  return level;
+}
+
+} // namespace detail
+
+/** \brief Base class for signature computation
+  * \details The outgoing transitions are read from the index that the LTS provides per source state, such that
+  *          the signatures of different states can be computed independently, and hence in parallel. */
 template < class LTS_T >
 class signature
 {
@@ -32,15 +141,64 @@ protected:
   /** \brief The labelled transition system for which the signature is computed */
   const LTS_T& m_lts;
 
+  /** \brief The number of threads that are used to compute signatures */
+  std::size_t m_number_of_threads;
+
+  /** \brief The outgoing transitions, as shared with the LTS */
+  std::shared_ptr<const indexed_transitions> m_outgoing_transitions;
+  const indexed_transitions& m_outgoing;
+
+  /** \brief The hidden label map, applied to each label */
+  std::vector<std::size_t> m_label_map;
+
   /** \brief Signature stored per state */
   std::vector<signature_t> m_sig;
 
+  /** \brief Indicates whether the transition with the given label from state s to state t is an internal
+             transition within a block of \a partition */
+  bool is_inert(const std::vector<std::size_t>& partition, const std::size_t s, const std::size_t label_, const std::size_t t) const
+  {
+    return m_lts.is_tau(label_) && partition[s] == partition[t];
+  }
+
 public:
   /** \brief Constructor
     */
-  signature(const LTS_T& lts_)
-    : m_lts(lts_), m_sig(m_lts.num_states(), signature_t())
-  {}
+  signature(const LTS_T& lts_, const std::size_t number_of_threads)
+    : m_lts(lts_),
+      m_number_of_threads(number_of_threads),
+      m_outgoing_transitions(lts_.outgoing_transitions()),
+      m_outgoing(*m_outgoing_transitions),
+      m_label_map(lts_.num_action_labels()),
+      m_sig(lts_.num_states())
+  {
+    for (std::size_t i = 0; i < m_label_map.size(); ++i)
+    {
+      m_label_map[i] = m_lts.apply_hidden_label_map(i);
+    }
+  }
+
+  /** \brief The label of the i-th outgoing transition, to which the hidden label map has been applied */
+  std::size_t label_of(const std::size_t i) const
+  {
+    return m_label_map[m_outgoing.get_transitions()[i].label()];
+  }
+
+  /** \brief The target state of the i-th outgoing transition */
+  std::size_t target_of(const std::size_t i) const
+  {
+    return m_outgoing.get_transitions()[i].state();
+  }
+
+  virtual ~signature() = default;
+
+  /** \brief Prepares the LTS before the signature is constructed. By default the LTS is not changed.
+    * \param[in] lts_ The LTS that is going to be reduced.
+    * \return The LTS \a lts_ */
+  static LTS_T& preprocess(LTS_T& lts_)
+  {
+    return lts_;
+  }
 
   /** \brief Compute a new signature based on \a partition.
     * \param[in] partition The current partition
@@ -49,13 +207,16 @@ public:
 
   /** \brief Compute the transitions for the quotient according to \a partition.
     * \param[in] partition The partition that is used to compute the quotient
-    * \param[out] transitions A set to which the transitions of the quotient are written
+    * \param[out] transitions A vector to which the transitions of the quotient are written; it may contain duplicates
     */
-  virtual void quotient_transitions(std::set<transition>& transitions, const std::vector<std::size_t>& partition)
+  virtual void quotient_transitions(std::vector<transition>& transitions, const std::vector<std::size_t>& partition)
   {
-    for(std::vector<transition>::const_iterator i = m_lts.get_transitions().begin(); i != m_lts.get_transitions().end(); ++i)
+    for (std::size_t s = 0; s < m_lts.num_states(); ++s)
     {
-      transitions.insert(transition(partition[i->from()], i->label(), partition[i->to()]));
+      for (std::size_t i = m_outgoing.lowerbound(s); i < m_outgoing.upperbound(s); ++i)
+      {
+        transitions.emplace_back(partition[s], label_of(i), partition[target_of(i)]);
+      }
     }
   }
 
@@ -63,10 +224,16 @@ public:
     * \param[in] i The state for which to return the signature.
     * \pre i < m_lts.num_states().
     */
-  virtual const signature_t& get_signature(std::size_t i) const
+  const signature_t& get_signature(std::size_t i) const
   {
     return m_sig[i];
   }
+
+  /** \brief The number of threads that are used to compute signatures */
+  std::size_t number_of_threads() const
+  {
+    return m_number_of_threads;
+  }
 };
 
 /** \brief Class for computing the signature for strong bisimulation */
@@ -75,12 +242,16 @@ class signature_bisim: public signature<LTS_T>
 {
 protected:
   using signature<LTS_T>::m_lts;
+  using signature<LTS_T>::m_number_of_threads;
+  using signature<LTS_T>::m_outgoing;
+  using signature<LTS_T>::label_of;
+  using signature<LTS_T>::target_of;
   using signature<LTS_T>::m_sig;
 
 public:
   /** \brief Constructor */
-  signature_bisim(const LTS_T& lts_)
-    : signature<LTS_T>(lts_)
+  signature_bisim(const LTS_T& lts_, const std::size_t number_of_threads = 1)
+    : signature<LTS_T>(lts_, number_of_threads)
   {
     mCRL2log(log::verbose, "sigref") << "initialising signature computation for strong bisimulation" << std::endl;
   }
@@ -89,248 +260,219 @@ public:
   virtual void
   compute_signature(const std::vector<std::size_t>& partition)
   {
-    // compute signatures
-    m_sig = std::vector<signature_t>(m_lts.num_states(), signature_t());
-    for(std::vector<transition>::const_iterator i = m_lts.get_transitions().begin(); i != m_lts.get_transitions().end(); ++i)
-    {
-      m_sig[i->from()].insert(std::make_pair(m_lts.apply_hidden_label_map(i->label()), partition[i->to()]));
-    }
+    detail::sigref_parallel_for(m_lts.num_states(), m_number_of_threads,
+      [&](std::size_t, std::size_t first, std::size_t last)
+      {
+        for (std::size_t s = first; s < last; ++s)
+        {
+          signature_t& sig = m_sig[s];
+          sig.clear();
+          for (std::size_t i = m_outgoing.lowerbound(s); i < m_outgoing.upperbound(s); ++i)
+          {
+            sig.emplace_back(label_of(i), partition[target_of(i)]);
+          }
+          detail::normalise_signature(sig);
+        }
+      });
   }
 
 };
 
-/** \brief Class for computing the signature for branching bisimulation */
+/** \brief Class for computing the signature for branching bisimulation
+  * \details The signature of a state consists of the pairs of its own non-inert transitions, and the signatures
+  *          of the states that it reaches with an inert tau transition, as described in S. Blom, S. Orzan,
+  *          "Distributed Branching Bisimulation Reduction of State Spaces", Proc. PDMC 2003. The tau-cycles of
+  *          the LTS are removed first, such that the signatures can be computed in a fixed order: the states are
+  *          grouped in levels, such that tau transitions only go to states in lower levels. The signatures of the
+  *          states in a level are computed in parallel.
+  */
 template < class LTS_T >
 class signature_branching_bisim: public signature<LTS_T>
 {
 protected:
   using signature<LTS_T>::m_lts;
+  using signature<LTS_T>::m_number_of_threads;
+  using signature<LTS_T>::m_outgoing;
+  using signature<LTS_T>::m_label_map;
+  using signature<LTS_T>::label_of;
+  using signature<LTS_T>::target_of;
   using signature<LTS_T>::m_sig;
+  using signature<LTS_T>::is_inert;
 
-  /** \brief Store the incoming transitions per state */
-  outgoing_transitions_per_state_t m_prev_transitions;
+  /** \brief The states of level l are m_states_per_level[m_level_offsets[l]], ..., m_states_per_level[m_level_offsets[l+1]-1] */
+  std::vector<std::size_t> m_level_offsets;
+  std::vector<std::size_t> m_states_per_level;
 
-  /** \brief Insert function
-    * \param[in] partition The current partition
-    * \param[in] t source state
-    * \param[in] label_ transition label
-    * \param[in] block target block
-    *
-    * Insert function as described in S. Blom, S. Orzan,
-    * "Distributed Branching Bisimulation Reduction of State Spaces",
-    * Proc. PDMC 2003.
-    *
-    * Inserts the pair (label_, block) in the signature of t, as well as
-    * the signatures of all tau-predecessors of t within the same block.
-    */
-  void insert(const std::vector<std::size_t>& partition, const std::size_t t, const std::size_t label_, const std::size_t block)
+  /** \brief Record for each state whether it is divergent. This is only used if m_preserve_divergence is true */
+  std::vector<bool> m_divergent;
+  bool m_preserve_divergence = false;
+
+  /** \brief Groups the states in levels, such that tau transitions only go to states in lower levels. */
+  void compute_levels()
   {
-    if(m_sig[t].insert(std::make_pair(label_, block)).second)
-    {
-      // std::pair<outgoing_transitions_per_state_t::const_iterator, outgoing_transitions_per_state_t::const_iterator> pred_range
-      //    = m_prev_transitions.equal_range(t);
+    const std::size_t n = m_lts.num_states();
+    const std::vector<std::size_t> level = detail::compute_tau_levels(m_lts, m_outgoing, m_label_map);
+    const std::size_t number_of_levels = n == 0 ? 1 : *std::max_element(level.begin(), level.end()) + 1;
 
-      // for(outgoing_transitions_per_state_t::const_iterator i = pred_range.first; i != pred_range.second; ++i)
-      // for(const outgoing_pair_t& p: m_prev_transitions[t])
-      for (std::size_t i=m_prev_transitions.lowerbound(t); i<m_prev_transitions.upperbound(t); ++i)
-      {
-        const outgoing_pair_t& p = m_prev_transitions.get_transitions()[i];
-        if(m_lts.is_tau(m_lts.apply_hidden_label_map(label(p))) && partition[t] == partition[to(p)])
-        {
-          insert(partition, to(p), label_, block);
-        }
-      }
+    m_level_offsets.assign(number_of_levels + 1, 0);
+    for (std::size_t s = 0; s < n; ++s)
+    {
+      ++m_level_offsets[level[s] + 1];
+    }
+    std::partial_sum(m_level_offsets.begin(), m_level_offsets.end(), m_level_offsets.begin());
+    m_states_per_level.resize(n);
+    std::vector<std::size_t> position(m_level_offsets.begin(), m_level_offsets.end() - 1);
+    for (std::size_t s = 0; s < n; ++s)
+    {
+      m_states_per_level[position[level[s]]++] = s;
     }
   }
 
 public:
-  /** \brief Constructor  */
-  signature_branching_bisim(const LTS_T& lts_)
-    : signature<LTS_T>(lts_),
-      m_prev_transitions(lts_.get_transitions(),lts_.num_states(),false)  // transitions stored backward. 
+  /** \brief Constructor
+    * \pre The LTS does not contain tau-cycles, other than tau-loops, which holds after \ref preprocess. */
+  signature_branching_bisim(const LTS_T& lts_, const std::size_t number_of_threads = 1)
+    : signature<LTS_T>(lts_, number_of_threads)
   {
     mCRL2log(log::verbose, "sigref") << "initialising signature computation for branching bisimulation" << std::endl;
+    compute_levels();
   }
 
-  /** \overload */
-  virtual void compute_signature(const std::vector<std::size_t>& partition)
+  /** \brief Replaces the strongly connected components of tau transitions by single states. */
+  static LTS_T& preprocess(LTS_T& lts_)
   {
-    // compute signatures
-    m_sig = std::vector<signature_t>(m_lts.num_states(), signature_t());
-    for(std::vector<transition>::const_iterator i = m_lts.get_transitions().begin(); i != m_lts.get_transitions().end(); ++i)
-    {
-      if (!(m_lts.is_tau(m_lts.apply_hidden_label_map(i->label())) && (partition[i->from()] == partition[i->to()])))
-      {
-        insert(partition, i->from(), m_lts.apply_hidden_label_map(i->label()), partition[i->to()]);
-      }
-    }
+    scc_reduce(lts_, false);
+    return lts_;
   }
 
   /** \overload */
-  virtual void quotient_transitions(std::set<transition>& transitions, const std::vector<std::size_t>& partition)
-  {
-    for(std::vector<transition>::const_iterator i = m_lts.get_transitions().begin(); i != m_lts.get_transitions().end(); ++i)
-    {
-      if(partition[i->from()] != partition[i->to()] || !m_lts.is_tau(m_lts.apply_hidden_label_map(i->label())))
-      {
-        transitions.insert(transition(partition[i->from()], m_lts.apply_hidden_label_map(i->label()), partition[i->to()]));
-      }
-    }
-  }
-};
-
-/** \brief Class for computing the signature for divergence preserving branching bisimulation */
-template < class LTS_T >
-class signature_divergence_preserving_branching_bisim: public signature_branching_bisim<LTS_T>
-{
-protected:
-  using signature_branching_bisim<LTS_T>::m_lts;
-  using signature_branching_bisim<LTS_T>::m_sig;
-  using signature_branching_bisim<LTS_T>::insert;
-
-  /** \brief Record for each vertex whether it is in a tau-scc */
-  std::vector<bool> m_divergent;
-
-  /** \brief Iterative implementation of Tarjan's SCC algorithm.
-   *
-   * based on an earlier implementation by Sjoerd Cranen
-   *
-   * For the non-trivial tau-sccs (i.e. SCCs with more than one state, or
-   * single-state SCCs with a tau-loop, we set \a m_divergent to true.
-   */
-  void compute_tau_sccs()
+  virtual void compute_signature(const std::vector<std::size_t>& partition)
   {
-    std::size_t unused = 1, lastscc = 1;
-    std::vector<std::size_t> scc(m_lts.num_states(), 0);
-    std::vector<std::size_t> low(m_lts.num_states(), 0);
-    std::stack<std::size_t> stack;
-    std::stack<std::size_t> sccstack;
-
-    // Record forward transition relation sorted by state.
-    outgoing_transitions_per_state_t m_lts_succ_transitions(m_lts.get_transitions(),m_lts.num_states(),true);
-
-    for (std::size_t i = 0; i < m_lts.num_states(); ++i)
-    {
-      if (scc[i] == 0)
-        stack.push(i);
-      while (!stack.empty())
+    // Compute the pairs of the non-inert transitions of all states.
+    detail::sigref_parallel_for(m_lts.num_states(), m_number_of_threads,
+      [&](std::size_t, std::size_t first, std::size_t last)
       {
-        const std::size_t vi = stack.top();
-
-        // Outgoing transitions of vi.
-        // std::pair<outgoing_transitions_per_state_t::const_iterator, outgoing_transitions_per_state_t::const_iterator> succ_range
-        //  = m_lts_succ_transitions.equal_range(vi);
-
-        if (low[vi] == 0 && scc[vi] == 0)
+        for (std::size_t s = first; s < last; ++s)
         {
-          scc[vi] = unused;
-          low[vi] = unused++;
-          sccstack.push(vi);
-
-          // for (outgoing_transitions_per_state_t::const_iterator t = succ_range.first; t != succ_range.second; ++t)
-          // for (const outgoing_pair_t& t: m_lts_succ_transitions[vi]) 
-          // for (const outgoing_pair_t& t: m_lts_succ_transitions[vi]) 
-          for (std::size_t i=m_lts_succ_transitions.lowerbound(vi); i<m_lts_succ_transitions.upperbound(vi); ++i)
+          signature_t& sig = m_sig[s];
+          sig.clear();
+          for (std::size_t i = m_outgoing.lowerbound(s); i < m_outgoing.upperbound(s); ++i)
           {
-            const outgoing_pair_t& t=m_lts_succ_transitions.get_transitions()[i];
-            if ((low[to(t)] == 0) && (scc[to(t)] == 0) && (m_lts.is_tau(m_lts.apply_hidden_label_map(label(t)))))
+            const std::size_t t = target_of(i);
+            if (!is_inert(partition, s, label_of(i), t) || (m_preserve_divergence && m_divergent[t]))
             {
-              stack.push(to(t));
+              sig.emplace_back(label_of(i), partition[t]);
             }
           }
+          detail::normalise_signature(sig);
         }
-        else
+      });
+
+    // Add the signatures of the inert tau-successors, which are in lower levels.
+    for (std::size_t l = 1; l + 1 < m_level_offsets.size(); ++l)
+    {
+      detail::sigref_parallel_for(m_level_offsets[l + 1] - m_level_offsets[l], m_number_of_threads,
+        [&](std::size_t, std::size_t first, std::size_t last)
         {
-          // for (outgoing_transitions_per_state_t::const_iterator t = succ_range.first; t != succ_range.second; ++t)
-          for (std::size_t i=m_lts_succ_transitions.lowerbound(vi); i<m_lts_succ_transitions.upperbound(vi); ++i)
+          for (std::size_t j = m_level_offsets[l] + first; j < m_level_offsets[l] + last; ++j)
           {
-            const outgoing_pair_t& t=m_lts_succ_transitions.get_transitions()[i];
-            if ((low[to(t)] != 0) && (m_lts.is_tau(m_lts.apply_hidden_label_map(label(t)))))
-              low[vi] = low[vi] < low[to(t)] ? low[vi] : low[to(t)];
-          }
-          if (low[vi] == scc[vi])
-          {
-            std::size_t tos, scc_id = lastscc++;
-            std::vector<std::size_t> this_scc;
-            do
+            const std::size_t s = m_states_per_level[j];
+            signature_t& sig = m_sig[s];
+            const std::size_t size = sig.size();
+            for (std::size_t i = m_outgoing.lowerbound(s); i < m_outgoing.upperbound(s); ++i)
             {
-              tos = sccstack.top();
-              low[tos] = 0;
-              scc[tos] = scc_id;
-              sccstack.pop();
-              this_scc.push_back(tos);
-            }
-            while (tos != vi);
-
-            // We only consider non-trivial sccs, hence
-            // if the scc consists of a single schate, check whether it has a tau-loop
-            if(this_scc.size() == 1)
-            {
-              // for(outgoing_transitions_per_state_t::const_iterator i = succ_range.first; i != succ_range.second; ++i)
-              // for (const outgoing_pair_t& i: m_lts_succ_transitions[vi]) 
-              for (std::size_t i_=m_lts_succ_transitions.lowerbound(vi); i_<m_lts_succ_transitions.upperbound(vi); ++i_)
+              const std::size_t t = target_of(i);
+              if (t != s && is_inert(partition, s, label_of(i), t))
               {
-                const outgoing_pair_t& i=m_lts_succ_transitions.get_transitions()[i_];
-                if(vi == to(i) && m_lts.is_tau(m_lts.apply_hidden_label_map(label(i))))
-                {
-                  m_divergent[tos] = true;
-                  break;
-                }
+                sig.insert(sig.end(), m_sig[t].begin(), m_sig[t].end());
               }
             }
-            else
+            if (sig.size() != size)
             {
-              m_divergent[tos] = true;
+              detail::normalise_signature(sig);
             }
           }
-          stack.pop();
+        });
+    }
+  }
+
+  /** \overload */
+  virtual void quotient_transitions(std::vector<transition>& transitions, const std::vector<std::size_t>& partition)
+  {
+    for (std::size_t s = 0; s < m_lts.num_states(); ++s)
+    {
+      for (std::size_t i = m_outgoing.lowerbound(s); i < m_outgoing.upperbound(s); ++i)
+      {
+        if (!is_inert(partition, s, label_of(i), target_of(i)))
+        {
+          transitions.emplace_back(partition[s], label_of(i), partition[target_of(i)]);
         }
       }
     }
   }
+};
+
+/** \brief Class for computing the signature for divergence preserving branching bisimulation */
+template < class LTS_T >
+class signature_divergence_preserving_branching_bisim: public signature_branching_bisim<LTS_T>
+{
+protected:
+  using signature_branching_bisim<LTS_T>::m_lts;
+  using signature_branching_bisim<LTS_T>::m_outgoing;
+  using signature_branching_bisim<LTS_T>::label_of;
+  using signature_branching_bisim<LTS_T>::target_of;
+  using signature_branching_bisim<LTS_T>::m_sig;
+  using signature_branching_bisim<LTS_T>::m_divergent;
+  using signature_branching_bisim<LTS_T>::m_preserve_divergence;
+  using signature_branching_bisim<LTS_T>::is_inert;
 
 public:
   /** \brief Constructor
     *
-    * This initialises \a m_divergent to record for each vertex whether it is
-    * in a tau-scc.
+    * This initialises \a m_divergent to record for each state whether it has a tau-loop, which after
+    * \ref preprocess is the case exactly for the states that were on a tau-cycle.
     */
-  signature_divergence_preserving_branching_bisim(const LTS_T& lts_)
-    : signature_branching_bisim<LTS_T>(lts_),
-      m_divergent(lts_.num_states(), false)
+  signature_divergence_preserving_branching_bisim(const LTS_T& lts_, const std::size_t number_of_threads = 1)
+    : signature_branching_bisim<LTS_T>(lts_, number_of_threads)
   {
     mCRL2log(log::verbose, "sigref") << "initialising signature computation for divergence preserving branching bisimulation" << std::endl;
-    compute_tau_sccs();
-  }
-
-  /** \overload
-    *
-    * Compute the signature as in branching bisimulation. In addition, add the
-    * (tau, B) for edges s -tau-> t for which s,t in B and m_divergent[t]
-    */
-  virtual void compute_signature(const std::vector<std::size_t>& partition)
-  {
-    // compute signatures
-    m_sig = std::vector<signature_t>(m_lts.num_states(), signature_t());
-    for(std::vector<transition>::const_iterator i = m_lts.get_transitions().begin(); i != m_lts.get_transitions().end(); ++i)
+    m_preserve_divergence = true;
+    m_divergent.assign(m_lts.num_states(), false);
+    for (std::size_t s = 0; s < m_lts.num_states(); ++s)
     {
-      if(!(partition[i->from()] == partition[i->to()] && m_lts.is_tau(m_lts.apply_hidden_label_map(i->label())))
-         || m_divergent[i->to()])
+      for (std::size_t i = m_outgoing.lowerbound(s); i < m_outgoing.upperbound(s); ++i)
       {
-        insert(partition, i->from(), m_lts.apply_hidden_label_map(i->label()), partition[i->to()]);
+        if (target_of(i) == s && m_lts.is_tau(label_of(i)))
+        {
+          m_divergent[s] = true;
+        }
       }
     }
   }
 
-  /** \overload */
-  virtual void quotient_transitions(std::set<transition>& transitions, const std::vector<std::size_t>& partition)
+  /** \brief Replaces the strongly connected components of tau transitions by single states with a tau-loop. */
+  static LTS_T& preprocess(LTS_T& lts_)
   {
-    for(std::vector<transition>::const_iterator i = m_lts.get_transitions().begin(); i != m_lts.get_transitions().end(); ++i)
+    scc_reduce(lts_, true);
+    return lts_;
+  }
+
+  /** \overload
+    *
+    * As in branching bisimulation, but the inert transitions s -tau-> t for which (tau, B) is in the
+    * signature of s, where B is the block of s and t, are kept. */
+  virtual void quotient_transitions(std::vector<transition>& transitions, const std::vector<std::size_t>& partition)
+  {
+    for (std::size_t s = 0; s < m_lts.num_states(); ++s)
     {
-      if(!(partition[i->from()] == partition[i->to()] && m_lts.is_tau(m_lts.apply_hidden_label_map(i->label())))
-         || m_sig[i->from()].find(std::make_pair(m_lts.apply_hidden_label_map(i->label()), partition[i->to()])) != m_sig[i->from()].end())
+      for (std::size_t i = m_outgoing.lowerbound(s); i < m_outgoing.upperbound(s); ++i)
       {
-        transitions.insert(transition(partition[i->from()], m_lts.apply_hidden_label_map(i->label()), partition[i->to()]));
+        const std::pair<std::size_t, std::size_t> pair(label_of(i), partition[target_of(i)]);
+        if (!is_inert(partition, s, label_of(i), target_of(i))
+            || std::binary_search(m_sig[s].begin(), m_sig[s].end(), pair))
+        {
+          transitions.emplace_back(partition[s], pair.first, pair.second);
+        }
       }
     }
   }
@@ -343,13 +485,19 @@ public:
   * S. Blom, S. Orzan. "Distributed Branching Bisimulation Reduction of State
   * Spaces", in Proc. PDMC 2003.
   *
-  * The specific signature is a parameter of the algorithm.
+  * The specific signature is a parameter of the algorithm. The signatures are
+  * computed in parallel when more than one thread is used. Blocks are assigned
+  * to signatures using a hash table that is split in shards, which are filled
+  * in parallel.
   */
 template < class LTS_T, typename Signature >
 class sigref
 {
 
 protected:
+  /** \brief The LTS that we are reducing */
+  LTS_T& m_lts;
+
   /** \brief Current partition; for each state (std::size_t) the block in which
              it resides is recorded. */
   std::vector<std::size_t> m_partition;
@@ -357,9 +505,6 @@ protected:
   /** \brief The number of blocks in the current partition */
   std::size_t m_count;
 
-  /** \brief The LTS that we are reducing */
-  LTS_T& m_lts;
-
   /** \brief Instance of a class performing the signature computation for the
              current equivalence */
   Signature m_signature;
@@ -377,6 +522,60 @@ protected:
     return os.str();
   }
 
+  /** \brief Map each state to a block, such that states are in the same block iff they have the same signature.
+    * \details The states are distributed over shards based on the hash of their signature. Each shard has its
+    *          own hash table and is handled by a single thread, which numbers the signatures in the shard. */
+  void assign_blocks()
+  {
+    const std::size_t n = m_lts.num_states();
+    const std::size_t number_of_threads = m_signature.number_of_threads();
+    const std::size_t number_of_shards = number_of_threads <= 1 ? 1 : 4 * number_of_threads;
+
+    std::vector<std::size_t> hashes(n);
+    std::vector<std::vector<std::vector<std::size_t> > > states_per_shard(number_of_threads, std::vector<std::vector<std::size_t> >(number_of_shards));
+    detail::sigref_parallel_for(n, number_of_threads,
+      [&](std::size_t index, std::size_t first, std::size_t last)
+      {
+        for (std::size_t s = first; s < last; ++s)
+        {
+          hashes[s] = detail::hash_signature(m_signature.get_signature(s));
+          states_per_shard[index][hashes[s] % number_of_shards].push_back(s);
+        }
+      });
+
+    auto hash = [&](std::size_t s) { return hashes[s] / number_of_shards; };
+    auto equal = [&](std::size_t s, std::size_t t) { return m_signature.get_signature(s) == m_signature.get_signature(t); };
+    std::vector<std::size_t> block_in_shard(n);
+    std::vector<std::size_t> shard_offsets(number_of_shards + 1, 0);
+    detail::sigref_parallel_for(number_of_shards, number_of_threads,
+      [&](std::size_t, std::size_t first, std::size_t last)
+      {
+        for (std::size_t shard = first; shard < last; ++shard)
+        {
+          std::unordered_map<std::size_t, std::size_t, decltype(hash), decltype(equal)> blocks(16, hash, equal);
+          for (const std::vector<std::vector<std::size_t> >& states: states_per_shard)
+          {
+            for (const std::size_t s: states[shard])
+            {
+              block_in_shard[s] = blocks.emplace(s, blocks.size()).first->second;
+            }
+          }
+          shard_offsets[shard + 1] = blocks.size();
+        }
+      });
+    std::partial_sum(shard_offsets.begin(), shard_offsets.end(), shard_offsets.begin());
+
+    detail::sigref_parallel_for(n, number_of_threads,
+      [&](std::size_t, std::size_t first, std::size_t last)
+      {
+        for (std::size_t s = first; s < last; ++s)
+        {
+          m_partition[s] = shard_offsets[hashes[s] % number_of_shards] + block_in_shard[s];
+        }
+      });
+    m_count = shard_offsets.back();
+  }
+
   /** \brief Compute the partition. Repeatedly updates the signatures, and
              the partition, until the partition stabilises */
   void compute_partition()
@@ -384,8 +583,6 @@ protected:
     std::size_t count_prev = m_count;
     std::size_t iterations = 0;
 
-    sort_transitions(m_lts.get_transitions(), m_lts.hidden_label_set(), mcrl2::lts::lbl_tgt_src);
-
     do
     {
       mCRL2log(log::verbose, "sigref") << "Iteration " << iterations
@@ -394,28 +591,28 @@ protected:
       m_signature.compute_signature(m_partition);
 
       count_prev = m_count;
+      assign_blocks();
+      ++iterations;
 
-      // Map signatures to block numbers
-      std::map<signature_t, std::size_t> hashtable;
-      m_count = 0;
-      for(std::size_t i = 0; i < m_lts.num_states(); ++i)
-      {
-        if(hashtable.find(m_signature.get_signature(i)) == hashtable.end())
-        {
-          mCRL2log(log::debug, "sigref") << "Adding block for signature " << print_sig(m_signature.get_signature(i)) << std::endl;
-          hashtable[m_signature.get_signature(i)] = m_count++;
-        }
-      }
+    } while (count_prev != m_count);
 
-      // Map states to block numbers
-      for(std::size_t i = 0; i < m_lts.num_states(); ++i)
+    // Number the blocks in the order of their first state, starting with the block of the initial state, such
+    // that the result does not depend on the number of threads.
+    std::vector<std::size_t> block_number(m_count, m_count);
+    std::size_t next_block = 0;
+    block_number[m_partition[m_lts.initial_state()]] = next_block++;
+    for (std::size_t s = 0; s < m_partition.size(); ++s)
+    {
+      if (block_number[m_partition[s]] == m_count)
       {
-        m_partition[i] = hashtable[m_signature.get_signature(i)];
+        mCRL2log(log::debug, "sigref") << "Adding block for signature " << print_sig(m_signature.get_signature(s)) << std::endl;
+        block_number[m_partition[s]] = next_block++;
       }
+      m_partition[s] = block_number[m_partition[s]];
+    }
 
-      ++iterations;
-
-    } while (count_prev != m_count);
+    // The quotient may depend on the signatures, which must therefore refer to the final block numbers.
+    m_signature.compute_signature(m_partition);
 
     mCRL2log(log::verbose, "sigref") << "Done after " << iterations << " iterations with " << m_count << " blocks" << std::endl;
   }
@@ -424,32 +621,43 @@ protected:
              been computed */
   void quotient()
   {
-    // Assign the reduced LTS
-    m_lts.set_num_states(m_count);
-    m_lts.set_initial_state(m_partition[m_lts.initial_state()]);
-
     // Compute quotient transitions
     // implemented in the signature class because it differs per equivalence.
-    std::set<transition> transitions;
+    std::vector<transition> transitions;
     m_signature.quotient_transitions(transitions, m_partition);
+    std::sort(transitions.begin(), transitions.end());
+    transitions.erase(std::unique(transitions.begin(), transitions.end()), transitions.end());
+
+    // Assign the reduced LTS
+    m_lts.set_num_states(m_count);
+    m_lts.set_initial_state(m_partition[m_lts.initial_state()]);
 
     // Set quotient transitions
-    m_lts.clear_transitions();
-    for(std::set<transition>::const_iterator i = transitions.begin(); i != transitions.end(); ++i)
+    m_lts.clear_transitions(transitions.size());
+    for (const transition& t: transitions)
     {
-      m_lts.add_transition(*i);
+      m_lts.add_transition(t);
     }
   }
 
+  /** \brief Removes the state labels, which are not needed in the reduced LTS, before the LTS is prepared for
+             the signature computation. */
+  static LTS_T& preprocess(LTS_T& lts_)
+  {
+    lts_.clear_state_labels();
+    return Signature::preprocess(lts_);
+  }
+
 public:
   /** \brief Constructor
     * \param[in] lts_ The LTS that is being reduced
+    * \param[in] number_of_threads The number of threads that is used. Small LTSs are always reduced using a single thread.
     */
-  sigref(LTS_T& lts_)
-    : m_partition(std::vector<std::size_t>(lts_.num_states(), 0)),
+  sigref(LTS_T& lts_, const std::size_t number_of_threads = 1)
+    : m_lts(preprocess(lts_)),
+      m_partition(std::vector<std::size_t>(m_lts.num_states(), 0)),
       m_count(0),
-      m_lts(lts_),
-      m_signature(lts_)
+      m_signature(m_lts, m_lts.num_states() < 10000 ? 1 : std::max<std::size_t>(1, number_of_threads))
   {}
 
   /** \brief Perform the reduction, modulo the equivalence for which the
@@ -457,8 +665,6 @@ public:
     */
   void run()
   {
-    // No need for state labels in the reduced LTS.
-    m_lts.clear_state_labels();
     compute_partition();
     quotient();
   }
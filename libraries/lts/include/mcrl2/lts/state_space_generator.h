@@ -37,6 +37,13 @@ const lps::state& first_state(const lps::stochastic_state& s)
 
 namespace detail {
 
+// Returns a description of the state index, which is unknown if bitstate hashing is used.
+inline
+std::string print_state_index(std::size_t s_index)
+{
+  return s_index == lps::discovered_state_set::npos ? "" : " (state index: " + std::to_string(s_index) + ")";
+}
+
 inline
 bool save_trace(
   trace::Trace& tr,
@@ -247,7 +254,7 @@ class action_detector
       }
       bool result = false;
 
-      mCRL2log(log::info) << "Action '" + lps::pp(a) + "' found (state index: " + std::to_string(s0_index) + ")";
+      mCRL2log(log::info) << "Action '" + lps::pp(a) + "' found" + print_state_index(s0_index);
       if (m_trace_count < m_max_trace_count)
       {
         trace::Trace tr = m_trace_constructor.construct_trace(s0);
@@ -288,7 +295,7 @@ class deadlock_detector
 
     void detect_deadlock(const lps::state& s, std::size_t s_index)
     {
-      mCRL2log(log::info) << "Deadlock found (state index: " + std::to_string(s_index) + ")";
+      mCRL2log(log::info) << "Deadlock found" + print_state_index(s_index);
       if (m_trace_count < m_max_trace_count)
       {
         trace::Trace tr = m_trace_constructor.construct_trace(s);
@@ -339,7 +346,7 @@ class nondeterminism_detector
       }
       else if (i->second != s1) // nondeterminism detected
       {
-        mCRL2log(log::info) << "Nondeterministic state found (state index: " + std::to_string(s0_index) + ")";
+        mCRL2log(log::info) << "Nondeterministic state found" + print_state_index(s0_index);
         if (m_trace_count < m_max_trace_count)
         {
           trace::Trace tr = m_trace_constructor.construct_trace(s0);
@@ -633,6 +640,11 @@ struct state_space_generator
       m_nondeterminism_detector(m_trace_constructor, options.trace_prefix, options.max_traces),
       m_progress_monitor(options.search_strategy)
   {
+    // The trace constructor stores a back pointer for every visited state, which defeats bitstate hashing.
+    if (options.generate_traces && options.bitstate_size > 0)
+    {
+      throw mcrl2::runtime_error("Traces cannot be generated in combination with bitstate hashing.");
+    }
     if (options.detect_divergence)
     {
       m_divergence_detector = std::unique_ptr<detail::divergence_detector<explorer_type>>(new detail::divergence_detector<explorer_type>(explorer, options.actions_internal_for_divergencies, options.trace_prefix, options.max_traces));
@@ -742,6 +754,28 @@ struct state_space_generator
         }
       );
       m_progress_monitor.finish_exploration(explorer.state_map().size());
+      if (explorer.state_map().tree_compression())
+      {
+        const lps::tree_compressed_state_set& states = explorer.state_map().compressed_states();
+        mCRL2log(log::verbose) << "the states are stored using " << states.node_count() << " tree nodes and "
+                               << states.value_count() << " distinct parameter values" << std::endl;
+      }
+      if (explorer.state_map().bitstate())
+      {
+        const lps::bitstate_state_set& states = explorer.state_map().bitstate_states();
+        mCRL2log(log::verbose) << "bitstate hashing used " << states.table_size() << " bits, of which "
+                               << 100.0 * states.fill_ratio() << "% are set; the estimated probability that a new state "
+                               << "was missed is " << states.omission_probability() << std::endl;
+      }
+      if (options.cached)
+      {
+        std::vector<utilities::cache_metric> metrics = explorer.enumeration_cache_metrics();
+        mCRL2log(log::verbose) << "the enumeration cache contains " << explorer.enumeration_cache_size() << " entries" << std::endl;
+        for (std::size_t i = 0; i < metrics.size(); i++)
+        {
+          mCRL2log(log::verbose) << "  summand " << i + 1 << ": " << metrics[i].message() << std::endl;
+        }
+      }
       builder.finalize(explorer.state_map(), Timed);
     }
     catch (const data::enumerator_error& e)
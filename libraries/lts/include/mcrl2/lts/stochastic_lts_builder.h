@@ -32,12 +32,7 @@ struct stochastic_lts_builder
 
   std::size_t add_action(const process::timed_multi_action& a)
   {
-    auto i = m_actions.find(a);
-    if (i == m_actions.end())
-    {
-      i = m_actions.emplace(std::make_pair(a, m_actions.size())).first;
-    }
-    return i->second;
+    return m_actions.try_emplace(a, m_actions.size()).first->second;
   }
 
   // Set the initial (stochastic) state of the LTS
@@ -47,7 +42,7 @@ struct stochastic_lts_builder
   virtual void add_transition(std::size_t from, const process::timed_multi_action& a, const std::list<std::size_t>& targets, const std::vector<data::data_expression>& probabilities) = 0;
 
   // Add actions and states to the LTS
-  virtual void finalize(const utilities::indexed_set<lps::state>& state_map, bool timed) = 0;
+  virtual void finalize(const lps::discovered_state_set& state_map, bool timed) = 0;
 
   // Save the LTS to a file
   virtual void save(const std::string& filename) = 0;
@@ -64,7 +59,7 @@ class stochastic_lts_none_builder: public stochastic_lts_builder
     void add_transition(std::size_t /* from */, const process::timed_multi_action& /* a */, const std::list<std::size_t>& /* targets */, const std::vector<data::data_expression>& /* probabilities */) override
     {}
 
-    void finalize(const utilities::indexed_set<lps::state>& /* state_map */, bool /* timed */) override
+    void finalize(const lps::discovered_state_set& /* state_map */, bool /* timed */) override
     {}
 
     void save(const std::string& /* filename */) override
@@ -138,7 +133,7 @@ class stochastic_lts_aut_builder: public stochastic_lts_builder
     }
 
     // Add actions and states to the LTS
-    void finalize(const utilities::indexed_set<lps::state>& state_map, bool /* timed */) override
+    void finalize(const lps::discovered_state_set& state_map, bool /* timed */) override
     {
       m_number_of_states = state_map.size();
     }
@@ -232,7 +227,7 @@ class stochastic_lts_lts_builder: public stochastic_lts_builder
     }
 
     // Add actions and states to the LTS
-    void finalize(const utilities::indexed_set<lps::state>& state_map, bool timed) override
+    void finalize(const lps::discovered_state_set& state_map, bool timed) override
     {
       // add actions
       m_lts.set_num_action_labels(m_actions.size());
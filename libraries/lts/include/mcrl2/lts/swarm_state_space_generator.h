@@ -0,0 +1,203 @@
+// Author(s): Wieger Wesselink
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/lts/swarm_state_space_generator.h
+/// \brief Swarm exploration of a state space using bitstate hashing.
+
+#ifndef MCRL2_LTS_SWARM_STATE_SPACE_GENERATOR_H
+#define MCRL2_LTS_SWARM_STATE_SPACE_GENERATOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include "mcrl2/lts/state_space_generator.h"
+#include "mcrl2/lts/stochastic_lts_builder.h"
+
+namespace mcrl2::lts {
+
+/// \brief Runs a number of independent explorations that use bitstate hashing with different seeds. Each run also
+/// explores the summands in a different order. The runs are used to detect deadlocks and actions in state spaces that
+/// are too large to be explored exhaustively. No LTS is generated.
+/// \details If the toolset is built with MCRL2_ENABLE_MULTITHREADING, options.number_of_threads runs are executed
+/// at the same time. Traces cannot be generated, since they require that all visited states are stored.
+template <bool Stochastic, bool Timed, typename Specification>
+class swarm_state_space_generator: public lps::abortable
+{
+  public:
+    struct run_statistics
+    {
+      std::size_t seed = 0;
+      std::size_t state_count = 0;
+      double fill_ratio = 0;
+      double omission_probability = 1;
+    };
+
+  protected:
+    using generator_type = state_space_generator<Stochastic, Timed, Specification>;
+
+    const Specification& m_lpsspec;
+    const lps::explorer_options& m_options;
+    std::vector<run_statistics> m_statistics;
+
+    std::mutex m_mutex; // serializes the construction of the generators
+    std::vector<std::atomic<lps::abortable*>> m_running; // the explorers of the runs that are in progress
+    std::atomic<bool> m_must_abort{false};
+
+    // The explorer of a run explores each state inside a shared section of the term pool, and leaves it in between
+    // states, such that the runs do not block garbage collection. The terms of the generator are created and
+    // destroyed inside a shared section as well.
+    void run(std::size_t i)
+    {
+      lps::explorer_options options = m_options;
+      options.bitstate_seed = i + 1;
+      options.number_of_threads = 1;
+      options.swarm_size = 0;
+      options.trace_prefix = m_options.trace_prefix + "_swarm" + std::to_string(i);
+
+      std::unique_ptr<generator_type> generator;
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_must_abort)
+        {
+          return;
+        }
+        atermpp::shared_guard guard;
+        generator = std::make_unique<generator_type>(m_lpsspec, options);
+      }
+      m_running[i] = &generator->explorer;
+      if (m_must_abort)
+      {
+        generator->explorer.abort();
+      }
+
+      if constexpr (Stochastic)
+      {
+        stochastic_lts_none_builder builder;
+        generator->explore(builder);
+      }
+      else
+      {
+        lts_none_builder builder;
+        generator->explore(builder);
+      }
+
+      const lps::bitstate_state_set& states = generator->explorer.state_map().bitstate_states();
+      run_statistics& statistics = m_statistics[i];
+      statistics.seed = options.bitstate_seed;
+      statistics.state_count = states.size();
+      statistics.fill_ratio = states.fill_ratio();
+      statistics.omission_probability = states.omission_probability();
+
+      m_running[i] = nullptr;
+      {
+        atermpp::shared_guard guard;
+        generator.reset();
+      }
+      mCRL2log(log::verbose) << "swarm run " << i << " visited " << statistics.state_count << " states, "
+                             << 100.0 * statistics.fill_ratio << "% of the bits are set" << std::endl;
+    }
+
+  public:
+    swarm_state_space_generator(const Specification& lpsspec, const lps::explorer_options& options)
+      : m_lpsspec(lpsspec),
+        m_options(options),
+        m_statistics(std::max(options.swarm_size, std::size_t(1))),
+        m_running(m_statistics.size())
+    {
+      if (options.bitstate_size == 0)
+      {
+        throw mcrl2::runtime_error("Swarm exploration requires that bitstate hashing is used.");
+      }
+    }
+
+    /// \brief Executes all runs, and reports the coverage statistics.
+    void explore()
+    {
+      std::size_t number_of_threads = atermpp::detail::GlobalThreadSafe ? std::min(m_options.number_of_threads, m_statistics.size()) : 1;
+      std::atomic<std::size_t> next_run{0};
+      std::exception_ptr exception;
+      std::mutex exception_mutex;
+      auto worker = [&]()
+        {
+          try
+          {
+            for (std::size_t i = next_run++; i < m_statistics.size() && !m_must_abort; i = next_run++)
+            {
+              run(i);
+            }
+          }
+          catch (...)
+          {
+            std::lock_guard<std::mutex> lock(exception_mutex);
+            if (!exception)
+            {
+              exception = std::current_exception();
+            }
+            abort();
+          }
+        };
+
+      std::vector<std::thread> threads;
+      for (std::size_t t = 1; t < number_of_threads; t++)
+      {
+        threads.emplace_back(worker);
+      }
+      worker();
+      for (std::thread& thread: threads)
+      {
+        thread.join();
+      }
+      if (exception)
+      {
+        std::rethrow_exception(exception);
+      }
+      report();
+    }
+
+    /// \brief Reports the coverage statistics of the runs.
+    /// \details The probability that a state is missed by all runs is estimated by the product of the omission
+    /// probabilities of the runs, which assumes that the hash functions of the runs are independent.
+    void report() const
+    {
+      std::size_t max_state_count = 0;
+      double missed_by_all = 1;
+      for (const run_statistics& statistics: m_statistics)
+      {
+        max_state_count = std::max(max_state_count, statistics.state_count);
+        missed_by_all *= statistics.omission_probability;
+      }
+      mCRL2log(log::info) << "Swarm exploration with " << m_statistics.size() << " run" << (m_statistics.size() == 1 ? "" : "s")
+                          << " of " << m_options.bitstate_size << " bits each visited at most " << max_state_count
+                          << " states in a single run; the estimated probability that a state is missed by all runs is "
+                          << missed_by_all << "." << std::endl;
+    }
+
+    const std::vector<run_statistics>& statistics() const
+    {
+      return m_statistics;
+    }
+
+    void abort() override
+    {
+      m_must_abort = true;
+      for (const std::atomic<lps::abortable*>& explorer: m_running)
+      {
+        lps::abortable* e = explorer.load();
+        if (e != nullptr)
+        {
+          e->abort();
+        }
+      }
+    }
+};
+
+} // namespace mcrl2::lts
+
+#endif // MCRL2_LTS_SWARM_STATE_SPACE_GENERATOR_H
@@ -10,6 +10,7 @@
 
 #include "mcrl2/lts/lts_algorithm.h"
 #include "mcrl2/lts/lts_io.h"
+#include "mcrl2/lts/lts_mapped.h"
 
 using namespace mcrl2::core;
 using namespace mcrl2::core::detail;
@@ -47,6 +48,14 @@ lts_type guess_format(std::string const& s, const bool be_verbose/*=true*/)
       }
       return lts_lts;
     }
+    else if (ext == "mlts")
+    {
+      if (be_verbose)
+      {
+        mCRL2log(verbose) << "Detected memory mapped mCRL2 extension.\n";
+      }
+      return lts_lts;
+    }
     else if (ext == "fsm")
     {
       if (be_verbose)
@@ -65,6 +74,16 @@ lts_type guess_format(std::string const& s, const bool be_verbose/*=true*/)
     }
   }
 
+  // Files in the memory mapped format are recognised by their contents.
+  if (mapped_lts_file::is_mapped_lts_file(s))
+  {
+    if (be_verbose)
+    {
+      mCRL2log(verbose) << "Detected memory mapped mCRL2 format.\n";
+    }
+    return lts_lts;
+  }
+
   return lts_none;
 }
 
@@ -74,7 +93,7 @@ static std::string extension_strings[] = { "", "lts", "aut", "fsm", "dot" };
 
 static std::string type_desc_strings[] = {
     "unknown LTS format",
-    "mCRL2 LTS format",
+    "mCRL2 LTS format (the extension .mlts gives a memory mapped variant)",
     "Aldebaran format (CADP)",
     "Finite State Machine format",
     "GraphViz format (no longer supported as input format)",
@@ -8,9 +8,19 @@
 //
 /// \file liblts_aut.cpp
 
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <deque>
 #include <fstream>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
 #include "mcrl2/utilities/unordered_map.h"
 #include "mcrl2/lts/lts_aut.h"
+#include "mcrl2/lts/lts_mapped.h"
+#include "mcrl2/lts/lts_stream.h"
 #include "mcrl2/lts/detail/liblts_swap_to_from_probabilistic_lts.h"
 
 
@@ -471,6 +481,327 @@ static void read_from_aut(lts_aut_t& l, std::istream& is)
   }
 }
 
+// The functions below read an .aut file that is mapped into memory. The transitions are split into
+// parts at the starts of lines, which are parsed in parallel. Each part numbers its labels in the
+// order in which they occur first, such that the parts can be merged into exactly the lts that
+// read_from_aut yields. Only files with plain transitions in the usual layout, one transition per
+// line, are read this way. For anything else, including errors, the stream based parser is used,
+// which gives precise error messages.
+
+// The transitions of a part of an .aut file. The labels of the transitions are indices in labels.
+struct aut_file_part
+{
+  std::vector<transition> transitions;
+  std::vector<std::string_view> labels;
+  std::deque<std::string> unquoted_labels;  // Unquoted labels from which whitespace has been removed.
+};
+
+static void skip_whitespace(const char*& p, const char* end)
+{
+  while (p != end && std::isspace(static_cast<unsigned char>(*p)))
+  {
+    ++p;
+  }
+}
+
+static bool parse_character(const char*& p, const char* end, const char c)
+{
+  skip_whitespace(p, end);
+  if (p == end || *p != c)
+  {
+    return false;
+  }
+  ++p;
+  return true;
+}
+
+static bool parse_number(const char*& p, const char* end, std::size_t& n)
+{
+  skip_whitespace(p, end);
+  const std::from_chars_result result = std::from_chars(p, end, n);
+  if (result.ec != std::errc())
+  {
+    return false;
+  }
+  p = result.ptr;
+  return true;
+}
+
+// Parses the transitions between p and end, which must consist of complete lines. Returns false if
+// these are not transitions of the shape (from,label,to), with states below number_of_states.
+static bool parse_aut_file_part(const char* p, const char* end, const std::size_t number_of_states, aut_file_part& part)
+{
+  std::unordered_map<std::string_view, std::size_t> label_indices;
+  while (true)
+  {
+    skip_whitespace(p, end);
+    if (p == end)
+    {
+      return true;
+    }
+
+    std::size_t from;
+    std::size_t to;
+    if (*p++ != '(' || !parse_number(p, end, from) || !parse_character(p, end, ','))
+    {
+      return false;
+    }
+
+    skip_whitespace(p, end);
+    if (p == end)
+    {
+      return false;
+    }
+    std::string_view label;
+    if (*p == '"')
+    {
+      // Whitespace in quoted labels is preserved.
+      const char* label_end = static_cast<const char*>(std::memchr(p + 1, '"', end - p - 1));
+      if (label_end == nullptr)
+      {
+        return false;
+      }
+      label = std::string_view(p + 1, label_end - p - 1);
+      p = label_end + 1;
+    }
+    else
+    {
+      // Whitespace is removed from unquoted labels.
+      const char* label_end = static_cast<const char*>(std::memchr(p, ',', end - p));
+      if (label_end == nullptr)
+      {
+        return false;
+      }
+      if (std::any_of(p, label_end, [](const char c) { return std::isspace(static_cast<unsigned char>(c)); }))
+      {
+        std::string& unquoted_label = part.unquoted_labels.emplace_back();
+        std::copy_if(p, label_end, std::back_inserter(unquoted_label), [](const char c) { return !std::isspace(static_cast<unsigned char>(c)); });
+        label = unquoted_label;
+      }
+      else
+      {
+        label = std::string_view(p, label_end - p);
+      }
+      p = label_end;
+    }
+
+    if (!parse_character(p, end, ',') || !parse_number(p, end, to) || !parse_character(p, end, ')'))
+    {
+      return false;
+    }
+
+    // A transition is followed by a newline, possibly preceded by spaces and a carriage return.
+    while (p != end && *p == ' ')
+    {
+      ++p;
+    }
+    if (p != end && *p == '\r')
+    {
+      ++p;
+    }
+    if (p != end && *p++ != '\n')
+    {
+      return false;
+    }
+
+    if (from >= number_of_states || to >= number_of_states)
+    {
+      return false;
+    }
+    const auto [i, inserted] = label_indices.emplace(label, part.labels.size());
+    if (inserted)
+    {
+      part.labels.push_back(label);
+    }
+    part.transitions.emplace_back(from, i->second, to);
+  }
+}
+
+// Splits the text between begin and end in at most number_of_parts parts of roughly equal size. A part
+// starts at a line that starts with an opening bracket. Returns the boundaries of the parts.
+static std::vector<const char*> split_aut_file(const char* begin, const char* end, const std::size_t number_of_parts)
+{
+  std::vector<const char*> boundaries{ begin };
+  for (std::size_t i = 1; i < number_of_parts; ++i)
+  {
+    const char* p = std::max(boundaries.back(), begin + (end - begin) / number_of_parts * i);
+    while (p != end)
+    {
+      const char* newline = static_cast<const char*>(std::memchr(p, '\n', end - p));
+      p = (newline == nullptr ? end : newline + 1);
+      if (p != end && *p == '(')
+      {
+        break;
+      }
+    }
+    if (p == end)
+    {
+      break;
+    }
+    boundaries.push_back(p);
+  }
+  boundaries.push_back(end);
+  return boundaries;
+}
+
+// Reads an .aut file by mapping it into memory and parsing it in parallel. Returns false, in which case
+// l is not changed, if the file cannot be read in this way.
+template <class AUT_LTS_TYPE>
+static bool read_from_aut_in_parallel(AUT_LTS_TYPE& l, const std::string& filename)
+{
+  std::unique_ptr<const mcrl2::lts::detail::mapped_file> file;
+  try
+  {
+    file = std::make_unique<const mcrl2::lts::detail::mapped_file>(filename);
+  }
+  catch (const mcrl2::runtime_error&)
+  {
+    return false;
+  }
+  if (file->size() == 0)
+  {
+    return false;  // This is also the case for pipes.
+  }
+  const char* begin = file->data();
+  const char* end = begin + file->size();
+
+  // An EOT character separates two files.
+  const char* end_of_transmission = static_cast<const char*>(std::memchr(begin, 0x04, end - begin));
+  if (end_of_transmission != nullptr)
+  {
+    end = end_of_transmission;
+  }
+
+  const char* end_of_header = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+  end_of_header = (end_of_header == nullptr ? end : end_of_header + 1);
+  std::size_t ntrans = 0;
+  std::size_t nstate = 0;
+  mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t initial_probabilistic_state;
+  try
+  {
+    std::istringstream header(std::string(begin, end_of_header));
+    read_aut_header(header, initial_probabilistic_state, ntrans, nstate);
+  }
+  catch (const mcrl2::runtime_error&)
+  {
+    return false;
+  }
+  if (nstate == 0 || (std::is_same<AUT_LTS_TYPE, lts_aut_t>::value && initial_probabilistic_state.size() > 1))
+  {
+    return false;
+  }
+  for (const auto& p: initial_probabilistic_state)
+  {
+    if (p.state() >= nstate)
+    {
+      return false;
+    }
+  }
+
+  // The parts are independent of the number of threads, such that the result is always the same.
+  const std::size_t part_size = 1 << 20;
+  const std::vector<const char*> boundaries = split_aut_file(end_of_header, end, 1 + (end - end_of_header) / part_size);
+  std::vector<aut_file_part> parts(boundaries.size() - 1);
+  std::unique_ptr<bool[]> parsed(new bool[parts.size()]);
+  std::atomic<std::size_t> next_part(0);
+  auto parse_parts = [&]()
+    {
+      for (std::size_t i = next_part++; i < parts.size(); i = next_part++)
+      {
+        parsed[i] = parse_aut_file_part(boundaries[i], boundaries[i + 1], nstate, parts[i]);
+      }
+    };
+  std::vector<std::thread> threads;
+  const std::size_t number_of_threads = std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), parts.size());
+  for (std::size_t i = 1; i < number_of_threads; ++i)
+  {
+    threads.emplace_back(parse_parts);
+  }
+  parse_parts();
+  for (std::thread& thread: threads)
+  {
+    thread.join();
+  }
+
+  mCRL2log(mcrl2::log::debug) << "Parsed " << filename << " in " << parts.size() << " parts using " << number_of_threads << " threads.\n";
+  std::size_t number_of_transitions = 0;
+  for (std::size_t i = 0; i < parts.size(); ++i)
+  {
+    if (!parsed[i])
+    {
+      return false;
+    }
+    number_of_transitions += parts[i].transitions.size();
+  }
+  if (number_of_transitions != ntrans)
+  {
+    return false;
+  }
+
+  // Merge the labels and transitions of the parts in the order of the file.
+  l.set_num_states(nstate, false);
+  l.clear_transitions(ntrans);
+  mcrl2::utilities::unordered_map < action_label_string, std::size_t > action_labels;
+  action_labels[action_label_string::tau_action()]=0; // A tau action is always stored at position 0.
+  std::vector<std::size_t> probabilistic_state_indices;
+  if constexpr (std::is_same<AUT_LTS_TYPE, probabilistic_lts_aut_t>::value)
+  {
+    l.set_initial_probabilistic_state(initial_probabilistic_state);
+    probabilistic_state_indices.assign(nstate, std::numeric_limits<std::size_t>::max());
+  }
+  else
+  {
+    l.set_initial_state(initial_probabilistic_state.begin()->state());
+  }
+
+  for (aut_file_part& part: parts)
+  {
+    std::vector<std::size_t> label_indices;
+    label_indices.reserve(part.labels.size());
+    for (const std::string_view& label: part.labels)
+    {
+      label_indices.push_back(find_label_index(std::string(label), action_labels, l));
+    }
+    for (const transition& t: part.transitions)
+    {
+      std::size_t to = t.to();
+      if constexpr (std::is_same<AUT_LTS_TYPE, probabilistic_lts_aut_t>::value)
+      {
+        // As in read_from_aut, the probabilistic states are numbered in the order in which they occur first.
+        std::size_t& index = probabilistic_state_indices[to];
+        if (index == std::numeric_limits<std::size_t>::max())
+        {
+          mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t target(to);
+          index = l.add_and_reset_probabilistic_state(target);
+        }
+        to = index;
+      }
+      l.add_transition(transition(t.from(), label_indices[t.label()], to));
+    }
+    part = aut_file_part();  // Release the memory of this part.
+  }
+  return true;
+}
+
+// Returns for each label the text that is written between the source and the target of a transition.
+template <class AUT_LTS_TYPE>
+static std::vector<std::string> quoted_action_labels(const AUT_LTS_TYPE& l)
+{
+  std::vector<std::string> result;
+  result.reserve(l.num_action_labels());
+  for (std::size_t i = 0; i < l.num_action_labels(); ++i)
+  {
+    result.push_back(",\"" + pp(l.action_label(l.apply_hidden_label_map(i))) + "\",");
+  }
+  return result;
+}
+
+static void append_number(std::string& buffer, const std::size_t n)
+{
+  char digits[std::numeric_limits<std::size_t>::digits10 + 1];
+  const std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), n);
+  buffer.append(digits, result.ptr);
+}
 
 static void write_probabilistic_state(const mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t& prob_state, std::ostream& os)
 {
@@ -500,9 +831,10 @@ static void write_to_aut(const probabilistic_lts_aut_t& l, std::ostream& os)
 
   os << "," << l.num_transitions() << "," << l.num_states() << ")" << "\n";
 
+  const std::vector<std::string> labels = quoted_action_labels(l);
   for (const transition& t: l.get_transitions())
   {
-    os << "(" << t.from() << ",\"" << pp(l.action_label(l.apply_hidden_label_map(t.label()))) << "\",";
+    os << "(" << t.from() << labels[t.label()];
     write_probabilistic_state(l.probabilistic_state(t.to()),os);
     os << ")" << "\n";
   }
@@ -513,14 +845,215 @@ static void write_to_aut(const lts_aut_t& l, std::ostream& os)
   // Do not use "endl" below to avoid flushing. Use "\n" instead.
   os << "des (" << l.initial_state() << "," << l.num_transitions() << "," << l.num_states() << ")" << "\n"; 
 
+  // The transitions are formatted in a buffer, which is written in large blocks.
+  const std::vector<std::string> labels = quoted_action_labels(l);
+  const std::size_t buffer_size = 1 << 20;
+  std::string buffer;
+  buffer.reserve(buffer_size + 128);
   for (const transition& t: l.get_transitions())
   {
-    os << "(" << t.from() << ",\"" 
-       << pp(l.action_label(l.apply_hidden_label_map(t.label()))) << "\"," 
-       << t.to() << ")" << "\n";
+    buffer.push_back('(');
+    append_number(buffer, t.from());
+    buffer.append(labels[t.label()]);
+    append_number(buffer, t.to());
+    buffer.append(")\n");
+    if (buffer.size() >= buffer_size)
+    {
+      os.write(buffer.data(), buffer.size());
+      buffer.clear();
+    }
   }
+  os.write(buffer.data(), buffer.size());
 }
 
+// Passes the labels and transitions of an .aut file to a stream writer, in the order of the file. The
+// labels are numbered in the order in which they occur first, as when the file is loaded. If the file
+// can be mapped into memory, its parts are parsed in parallel, as in read_from_aut_in_parallel, and
+// passed to the writer in batches. A part that cannot be parsed in this way, and the remainder of the
+// file, is read using the stream based parser.
+class aut_stream_reader
+{
+  protected:
+    lts_stream_writer<lts_aut_t>& m_writer;
+    mcrl2::utilities::unordered_map < action_label_string, std::size_t > m_action_labels;
+    std::size_t m_number_of_states = 0;
+    std::size_t m_number_of_transitions = 0;       // The number of transitions according to the header.
+    std::size_t m_transitions_read = 0;
+
+    std::size_t label_index(const std::string& s)
+    {
+      const auto [i, inserted] = m_action_labels.emplace(action_label_string(s), m_action_labels.size());
+      if (inserted)
+      {
+        m_writer.add_action_label(i->first);
+      }
+      return i->second;
+    }
+
+    void start(const mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t& initial_probabilistic_state,
+               const std::size_t ntrans,
+               const std::size_t nstate)
+    {
+      if (initial_probabilistic_state.size()>1)
+      {
+        throw mcrl2::runtime_error("Encountered an initial probability distribution while reading an non probabilistic .aut file.");
+      }
+      check_state(initial_probabilistic_state.begin()->state(), nstate, 1);
+      if (nstate==0)
+      {
+        throw mcrl2::runtime_error("cannot parse AUT input that has no states; at least an initial state is required.");
+      }
+
+      m_number_of_states = nstate;
+      m_number_of_transitions = ntrans;
+      m_writer.set_base(mcrl2::lts::detail::lts_aut_base());
+      label_index(action_label_string::tau_action()); // A tau action is always stored at position 0.
+      m_writer.set_initial_state(initial_probabilistic_state.begin()->state());
+    }
+
+    // Reads the transitions from the stream. The line number is the number of the line before the first transition.
+    void read_transitions(std::istream& is, std::size_t line_no)
+    {
+      std::size_t from, to;
+      std::string s;
+      while (!is.eof())
+      {
+        line_no++;
+
+        if (!read_aut_transition(is,from,s,to,line_no))
+        {
+          break; // eof encountered
+        }
+
+        check_state(from, m_number_of_states, line_no);
+        check_state(to, m_number_of_states, line_no);
+        m_writer.add_transition(transition(from,label_index(s),to));
+        m_transitions_read++;
+      }
+    }
+
+    void add_part(const aut_file_part& part)
+    {
+      std::vector<std::size_t> label_indices;
+      label_indices.reserve(part.labels.size());
+      for (const std::string_view& label: part.labels)
+      {
+        label_indices.push_back(label_index(std::string(label)));
+      }
+      for (const transition& t: part.transitions)
+      {
+        m_writer.add_transition(transition(t.from(), label_indices[t.label()], t.to()));
+      }
+      m_transitions_read += part.transitions.size();
+    }
+
+    void finish()
+    {
+      if (m_number_of_transitions != m_transitions_read)
+      {
+        throw mcrl2::runtime_error("number of transitions read (" + std::to_string(m_transitions_read) +
+                                   ") does not correspond to the number of transition given in the header (" + std::to_string(m_number_of_transitions) + ").");
+      }
+      m_writer.finish(m_number_of_states);
+    }
+
+  public:
+    explicit aut_stream_reader(lts_stream_writer<lts_aut_t>& writer)
+      : m_writer(writer)
+    {}
+
+    void read(std::istream& is)
+    {
+      std::size_t ntrans=0, nstate=0;
+      mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t initial_probabilistic_state;
+      read_aut_header(is,initial_probabilistic_state,ntrans,nstate);
+      start(initial_probabilistic_state, ntrans, nstate);
+      read_transitions(is, 1);
+      finish();
+    }
+
+    void read(const std::string& filename)
+    {
+      std::unique_ptr<const mcrl2::lts::detail::mapped_file> file;
+      try
+      {
+        file = std::make_unique<const mcrl2::lts::detail::mapped_file>(filename);
+      }
+      catch (const mcrl2::runtime_error&)
+      {
+        file.reset();
+      }
+      if (file == nullptr || file->size() == 0)
+      {
+        std::ifstream is(filename.c_str());
+        if (!is.is_open())
+        {
+          throw mcrl2::runtime_error("cannot open .aut file '" + filename + ".");
+        }
+        read(is);
+        return;
+      }
+
+      const char* begin = file->data();
+      const char* end = begin + file->size();
+      const char* end_of_transmission = static_cast<const char*>(std::memchr(begin, 0x04, end - begin));
+      if (end_of_transmission != nullptr)
+      {
+        end = end_of_transmission;
+      }
+      const char* end_of_header = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+      end_of_header = (end_of_header == nullptr ? end : end_of_header + 1);
+
+      std::size_t ntrans=0, nstate=0;
+      mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t initial_probabilistic_state;
+      std::istringstream header(std::string(begin, end_of_header));
+      read_aut_header(header, initial_probabilistic_state, ntrans, nstate);
+      start(initial_probabilistic_state, ntrans, nstate);
+
+      // Parse as many parts in parallel as there are threads, and pass them to the writer in order.
+      const std::size_t part_size = 1 << 20;
+      const std::vector<const char*> boundaries = split_aut_file(end_of_header, end, 1 + (end - end_of_header) / part_size);
+      const std::size_t number_of_parts = boundaries.size() - 1;
+      const std::size_t number_of_threads = std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), number_of_parts);
+      std::vector<aut_file_part> parts(number_of_threads);
+      std::unique_ptr<bool[]> parsed(new bool[number_of_threads]);
+      for (std::size_t first = 0; first < number_of_parts; first += number_of_threads)
+      {
+        const std::size_t batch_size = std::min(number_of_threads, number_of_parts - first);
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < batch_size; ++i)
+        {
+          threads.emplace_back([&, i]() { parsed[i] = parse_aut_file_part(boundaries[first + i], boundaries[first + i + 1], nstate, parts[i]); });
+        }
+        parsed[0] = parse_aut_file_part(boundaries[first], boundaries[first + 1], nstate, parts[0]);
+        for (std::thread& thread: threads)
+        {
+          thread.join();
+        }
+
+        for (std::size_t i = 0; i < batch_size; ++i)
+        {
+          if (!parsed[i])
+          {
+            // Continue with the stream based parser, which gives a precise error message if necessary.
+            std::ifstream is(filename.c_str(), std::ifstream::in | std::ifstream::binary);
+            is.seekg(boundaries[first + i] - begin);
+            if (!is.good())
+            {
+              throw mcrl2::runtime_error("cannot open .aut file '" + filename + ".");
+            }
+            read_transitions(is, std::count(begin, boundaries[first + i], '\n'));
+            finish();
+            return;
+          }
+          add_part(parts[i]);
+          parts[i] = aut_file_part();
+        }
+      }
+      finish();
+    }
+};
+
 namespace mcrl2
 {
 namespace lts
@@ -532,7 +1065,7 @@ void probabilistic_lts_aut_t::load(const std::string& filename)
   {
     read_from_aut(*this, std::cin);
   }
-  else
+  else if (!read_from_aut_in_parallel(*this, filename))
   {
     std::ifstream is(filename.c_str());
 
@@ -577,7 +1110,7 @@ void lts_aut_t::load(const std::string& filename)
   {
     read_from_aut(*this, std::cin);
   }
-  else
+  else if (!read_from_aut_in_parallel(*this, filename))
   {
     std::ifstream is(filename.c_str());
 
@@ -596,6 +1129,19 @@ void lts_aut_t::load(std::istream& is)
   read_from_aut(*this,is);
 }
 
+void read_lts_stream(const std::string& filename, lts_stream_writer<lts_aut_t>& writer)
+{
+  aut_stream_reader reader(writer);
+  if (filename=="" || filename=="-")
+  {
+    reader.read(std::cin);
+  }
+  else
+  {
+    reader.read(filename);
+  }
+}
+
 void lts_aut_t::save(std::string const& filename) const
 {
   if (filename=="" || filename=="-")
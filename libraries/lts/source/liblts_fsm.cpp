@@ -9,6 +9,7 @@
 /// \file liblts_fsm.cpp
 
 #include "mcrl2/lts/lts_io.h"
+#include "mcrl2/lts/lts_stream.h"
 #include "mcrl2/lts/parse.h"
 #include "mcrl2/lts/detail/liblts_swap_to_from_probabilistic_lts.h"
 
@@ -214,6 +215,148 @@ void lts_fsm_t::save(const std::string& filename) const
 }
 
 
+// A builder for the fsm parser that passes what is parsed to a stream writer, instead of storing it in an fsm.
+// The states and labels are numbered as by fsm_builder.
+struct fsm_stream_builder
+{
+  explicit fsm_stream_builder(lts_stream_writer<lts_fsm_t>& writer_)
+    : writer(writer_)
+  {}
+
+  lts_stream_writer<lts_fsm_t>& writer;
+
+  // The parameters of the FSM
+  std::vector<detail::fsm_parameter> parameters;
+
+  // Maps labels of the FSM to numbers
+  std::map<std::string, std::size_t> labels;
+
+  bool m_base_is_set = false;
+  bool m_initial_state_is_set = false;
+  std::size_t m_number_of_states = 0;
+  std::size_t m_number_of_transitions = 0;
+
+  void start()
+  {
+    parameters.clear();
+    labels.clear();
+  }
+
+  void set_base(const detail::lts_fsm_base& base)
+  {
+    writer.set_base(base);
+    writer.add_action_label(action_label_string::tau_action());
+    labels[action_label_string::tau_action()] = 0; // The label 0 is the tau action by default.
+    m_base_is_set = true;
+  }
+
+  void add_transition(const std::string& source, const std::string& target, const std::string& label)
+  {
+    detail::fsm_transition t(source, target, label);
+    m_number_of_transitions++;
+    if (t.target().size() > 1)
+    {
+      throw mcrl2::runtime_error("Transition " + std::to_string(m_number_of_transitions) + " is probabilistic.");
+    }
+    const std::size_t to = t.target().begin()->state();
+    m_number_of_states = std::max(m_number_of_states, std::max(t.source(), to) + 1);
+
+    auto i = labels.find(t.label());
+    std::size_t label_index = 0;
+    if (i == labels.end())
+    {
+      label_index = labels.size();
+      labels[t.label()] = label_index;
+      writer.add_action_label(action_label_string(t.label()));
+    }
+    else
+    {
+      label_index = i->second;
+    }
+    writer.add_transition(transition(t.source(), label_index, to));
+  }
+
+  void add_state(const std::vector<std::size_t>& values)
+  {
+    if (!values.empty())
+    {
+      writer.add_state_label(state_label_fsm(values));
+    }
+    m_number_of_states++;
+  }
+
+  void add_parameter(const std::string& name, const std::string& cardinality, const std::string& sort, const std::vector<std::string>& domain_values)
+  {
+    parameters.emplace_back(name, cardinality, sort, domain_values);
+  }
+
+  void add_initial_distribution(const std::string& distribution)
+  {
+    const detail::lts_fsm_base::probabilistic_state initial_state = detail::parse_distribution(distribution);
+    if (initial_state.size() > 1)
+    {
+      throw mcrl2::runtime_error("Initial state is probabilistic and cannot be transformed into a non probabilistic state.");
+    }
+    writer.set_initial_state(initial_state.begin()->state());
+    m_initial_state_is_set = true;
+  }
+
+  void write_parameters()
+  {
+    detail::lts_fsm_base base;
+    std::size_t index = 0;
+    for (const detail::fsm_parameter& param: parameters)
+    {
+      if (param.cardinality() > 0)
+      {
+        base.add_process_parameter(param.name(), param.sort());
+        for (const std::string& value: param.values())
+        {
+          base.add_state_element_value(index, value);
+        }
+      }
+      index++;
+    }
+    set_base(base);
+  }
+
+  void finish()
+  {
+    if (!m_base_is_set)
+    {
+      set_base(detail::lts_fsm_base());
+    }
+    if (!m_initial_state_is_set)
+    {
+      writer.set_initial_state(0);
+    }
+    // guarantee that the LTS has at least one state
+    writer.finish(std::max<std::size_t>(m_number_of_states, 1));
+  }
+};
+
+void read_lts_stream(const std::string& filename, lts_stream_writer<lts_fsm_t>& writer)
+{
+  std::ifstream is;
+  if (!filename.empty())
+  {
+    is.open(filename.c_str());
+    if (!is.is_open())
+    {
+      throw mcrl2::runtime_error("Cannot open .fsm file " + filename + ".");
+    }
+  }
+  try
+  {
+    detail::simple_fsm_parser<fsm_stream_builder> fsm_parser(writer);
+    fsm_parser.run(filename.empty() ? std::cin : is);
+  }
+  catch (mcrl2::runtime_error& e)
+  {
+    throw mcrl2::runtime_error(std::string("Error parsing .fsm file.\n") + e.what());
+  }
+}
+
 } // namespace lts
 
 } // namespace mcrl2
@@ -10,6 +10,8 @@
 
 #include "mcrl2/lts/lts_lts.h"
 #include "mcrl2/lts/lts_io.h"
+#include "mcrl2/lts/lts_mapped.h"
+#include "mcrl2/lts/lts_stream.h"
 
 #include <fstream>
 #include <optional>
@@ -372,6 +374,144 @@ static void write_to_lts(const LTS_TRANSITION_SYSTEM& lts, const std::string& fi
   }
 }
 
+// Passes the contents of an lts stream to the writer, as read_lts reads them into an lts.
+static void read_lts_stream(atermpp::aterm_istream& stream, lts_stream_writer<lts_lts_t>& writer)
+{
+  atermpp::aterm_stream_state state(stream);
+  stream >> data::detail::add_index_impl;
+
+  atermpp::aterm marker;
+  stream >> marker;
+
+  if (marker != labelled_transition_system_mark())
+  {
+    throw mcrl2::runtime_error("Stream does not contain a labelled transition system (LTS).");
+  }
+
+  data::data_specification spec;
+  data::variable_list parameters;
+  process::action_label_list action_labels;
+
+  stream >> spec;
+  stream >> parameters;
+  stream >> action_labels;
+
+  lts_lts_base base;
+  base.set_data(spec);
+  base.set_process_parameters(parameters);
+  base.set_action_label_declarations(action_labels);
+  writer.set_base(base);
+
+  mcrl2::utilities::indexed_set<action_label_lts> multi_actions;
+  multi_actions.insert(action_label_lts::tau_action());
+  writer.add_action_label(action_label_lts::tau_action());
+
+  std::optional<probabilistic_lts_lts_t::probabilistic_state_t> initial_state;
+  std::size_t number_of_states = 1;
+  std::size_t number_of_state_labels = 0;
+
+  while (true)
+  {
+    aterm term = stream.get();
+    if (!term.defined())
+    {
+      break;
+    }
+
+    if (term == transition_mark())
+    {
+      aterm_int from;
+      process::timed_multi_action action;
+      aterm_int to;
+
+      stream >> from;
+      stream >> action;
+      stream >> to;
+
+      const action_label_lts lts_action(lps::multi_action(action.actions(),action.time()));
+      auto [index, inserted] = multi_actions.insert(lts_action);
+      if (inserted)
+      {
+        writer.add_action_label(lts_action);
+      }
+
+      writer.add_transition(transition(from.value(), index, to.value()));
+      number_of_states = std::max(number_of_states, std::max(from.value() + 1, to.value() + 1));
+    }
+    else if (term == probabilistic_transition_mark())
+    {
+      throw mcrl2::runtime_error("Attempting to read a probabilistic LTS as a regular LTS.");
+    }
+    else if (term.function() == atermpp::detail::g_term_pool().as_list())
+    {
+      writer.add_state_label(reinterpret_cast<const state_label_lts&>(term));
+      number_of_state_labels++;
+    }
+    else if (term == initial_state_mark())
+    {
+      probabilistic_lts_lts_t::probabilistic_state_t state;
+      stream >> state;
+      initial_state = state;
+    }
+    else
+    {
+      throw mcrl2::runtime_error("Unknown mark in labelled transition system (LTS) stream.");
+    }
+  }
+
+  if (!initial_state)
+  {
+    throw mcrl2::runtime_error("Missing initial state in labelled transition system (LTS) stream.");
+  }
+  if (initial_state.value().size() > 1)
+  {
+    throw mcrl2::runtime_error("The initial state of the non probabilistic input lts is probabilistic.");
+  }
+  writer.set_initial_state(initial_state.value().begin()->state());
+
+  // State labels that have already been passed to the writer cannot be removed, as happens when
+  // an lts is loaded. Therefore, states with a label and without transitions are kept.
+  writer.finish(std::max(number_of_states, number_of_state_labels));
+}
+
+// Passes an lts in the memory mapped format to the writer, without storing its transitions in memory.
+static void read_mapped_lts_stream(const std::string& filename, lts_stream_writer<lts_lts_t>& writer)
+{
+  const mapped_lts_file file(filename);
+
+  lts_lts_base base;
+  data::data_specification spec;
+  data::variable_list parameters;
+  process::action_label_list action_labels;
+  file.read_specification(spec, parameters, action_labels);
+  base.set_data(spec);
+  base.set_process_parameters(parameters);
+  base.set_action_label_declarations(action_labels);
+  writer.set_base(base);
+
+  for (const action_label_lts& label: file.read_action_labels())
+  {
+    writer.add_action_label(label);
+  }
+
+  const std::shared_ptr<const indexed_transitions> transitions = file.outgoing_transitions();
+  for (std::size_t s = 0; s < file.num_states(); ++s)
+  {
+    file.check_transitions(s);
+    for (const label_state_pair& p: transitions->transitions(s))
+    {
+      writer.add_transition(transition(s, p.label(), p.state()));
+    }
+  }
+
+  for (const state_label_lts& label: file.read_state_labels())
+  {
+    writer.add_state_label(label);
+  }
+  writer.set_initial_state(file.initial_state());
+  writer.finish(file.num_states());
+}
+
 } // namespace detail
 
 // Implementation of public functions.
@@ -453,24 +593,81 @@ void write_initial_state(atermpp::aterm_ostream& stream, std::size_t index)
 
 void probabilistic_lts_lts_t::save(const std::string& filename) const
 {
+  if (detail::has_mapped_lts_extension(filename))
+  {
+    save_mapped_lts(*this, filename);
+    return;
+  }
   mCRL2log(log::verbose) << "Starting to save a probabilistic lts to the file " << filename << ".\n";
   detail::write_to_lts(*this, filename);
 }
 
 void lts_lts_t::save(std::string const& filename) const
 {
+  if (detail::has_mapped_lts_extension(filename))
+  {
+    save_mapped_lts(*this, filename);
+    return;
+  }
   mCRL2log(log::verbose) << "Starting to save an lts to the file " << filename << ".\n";
   detail::write_to_lts(*this, filename);
 }
 
 void probabilistic_lts_lts_t::load(const std::string& filename)
 {
+  if (mapped_lts_file::is_mapped_lts_file(filename))
+  {
+    load_mapped_lts(*this, filename);
+    return;
+  }
   mCRL2log(log::verbose) << "Starting to load a probabilistic lts from the file " << filename << ".\n";
   detail::read_from_lts(*this, filename);
 }
 
+void read_lts_stream(const std::string& filename, lts_stream_writer<lts_lts_t>& writer)
+{
+  if (!filename.empty() && mapped_lts_file::is_mapped_lts_file(filename))
+  {
+    detail::read_mapped_lts_stream(filename, writer);
+    return;
+  }
+
+  std::ifstream fstream;
+  if (!filename.empty())
+  {
+    fstream.open(filename, std::ifstream::in | std::ifstream::binary);
+    if (fstream.fail())
+    {
+      throw mcrl2::runtime_error("Fail to open file " + filename + " to read an lts.");
+    }
+  }
+
+  try
+  {
+    atermpp::binary_aterm_istream stream(filename.empty() ? std::cin : fstream);
+    detail::read_lts_stream(stream, writer);
+  }
+  catch (const std::exception& ex)
+  {
+    // The reason is passed on instead of being logged, as the caller may handle the exception by loading the lts instead.
+    if (filename.empty())
+    {
+      throw mcrl2::runtime_error(std::string(ex.what()) + "\nFail to correctly read an lts from standard input.");
+    }
+    else
+    {
+      throw mcrl2::runtime_error(std::string(ex.what()) + "\nFail to correctly read an lts from the file " + filename + ".");
+    }
+  }
+}
+
 void lts_lts_t::load(const std::string& filename)
 {
+  if (mapped_lts_file::is_mapped_lts_file(filename))
+  {
+    load_mapped_lts(*this, filename);
+    return;
+  }
   mCRL2log(log::verbose) << "Starting to load an lts from the file " << filename << ".\n";
   detail::read_from_lts(*this, filename);
 }
@@ -0,0 +1,541 @@
+// Author(s): Jan Friso Groote
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file liblts_mapped.cpp
+
+#include "mcrl2/lts/lts_mapped.h"
+#include "mcrl2/lts/lts_io.h"
+#include "mcrl2/atermpp/aterm_io_binary.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <streambuf>
+
+#ifndef MCRL2_PLATFORM_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mcrl2::lts
+{
+
+namespace detail
+{
+
+// The layout of the file. All numbers are stored in the byte order of the machine that wrote the file.
+
+static const char mapped_lts_magic[8] = { '\x89', 'm', 'l', 't', 's', '\r', '\n', '\x1a' };
+static const std::uint32_t mapped_lts_version = 2;
+static const std::uint32_t mapped_lts_byte_order = 0x01020304;
+
+struct mapped_lts_header
+{
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t byte_order;
+  std::uint64_t number_of_states;
+  std::uint64_t number_of_transitions;
+  std::uint64_t number_of_action_labels;
+  std::uint64_t initial_state;
+  std::uint64_t number_of_sections;
+};
+
+struct mapped_lts_section_entry
+{
+  std::uint64_t kind;
+  std::uint64_t offset;
+  std::uint64_t size;
+};
+
+// The kinds of sections. A reader ignores sections of unknown kinds.
+enum mapped_lts_section_kind: std::uint64_t
+{
+  specification_section = 1,
+  action_labels_section = 2,
+  state_labels_section = 3,
+  offsets_section = 4,
+  transitions_section = 5
+};
+
+static_assert(sizeof(mapped_lts_header) == 56, "The header of a memory mapped lts must not contain padding.");
+static_assert(sizeof(mapped_lts_section_entry) == 24, "A section entry of a memory mapped lts must not contain padding.");
+
+// A read only stream buffer on a block of memory, used to read the aterm sections without copying them.
+class memory_streambuf: public std::streambuf
+{
+  public:
+    memory_streambuf(const char* data, const std::size_t size)
+    {
+      char* begin = const_cast<char*>(data);
+      setg(begin, begin, begin + size);
+    }
+};
+
+mapped_file::mapped_file(const std::string& filename)
+{
+#ifndef MCRL2_PLATFORM_WINDOWS
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    throw mcrl2::runtime_error("Fail to open file " + filename + " to read an lts.");
+  }
+  struct stat status;
+  if (::fstat(fd, &status) != 0)
+  {
+    ::close(fd);
+    throw mcrl2::runtime_error("Fail to determine the size of the file " + filename + ".");
+  }
+  m_size = static_cast<std::size_t>(status.st_size);
+  if (m_size > 0)
+  {
+    void* address = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (address != MAP_FAILED)
+    {
+      m_data = static_cast<const char*>(address);
+      m_is_mapped = true;
+    }
+  }
+  ::close(fd);
+  if (m_is_mapped || m_size == 0)
+  {
+    return;
+  }
+#endif
+  // Fall back to reading the whole file into memory.
+  std::ifstream stream(filename, std::ifstream::in | std::ifstream::binary);
+  if (!stream)
+  {
+    throw mcrl2::runtime_error("Fail to open file " + filename + " to read an lts.");
+  }
+  stream.seekg(0, std::ios::end);
+  m_size = static_cast<std::size_t>(stream.tellg());
+  stream.seekg(0, std::ios::beg);
+  char* data = new char[m_size];
+  if (!stream.read(data, m_size))
+  {
+    delete[] data;
+    throw mcrl2::runtime_error("Fail to read the file " + filename + ".");
+  }
+  m_data = data;
+}
+
+mapped_file::~mapped_file()
+{
+#ifndef MCRL2_PLATFORM_WINDOWS
+  if (m_is_mapped)
+  {
+    ::munmap(const_cast<char*>(m_data), m_size);
+    return;
+  }
+#endif
+  delete[] m_data;
+}
+
+bool has_mapped_lts_extension(const std::string& filename)
+{
+  const std::string::size_type pos = filename.find_last_of('.');
+  return pos != std::string::npos && filename.substr(pos + 1) == "mlts";
+}
+
+static void write_section(std::ofstream& stream, std::vector<mapped_lts_section_entry>& table, const std::uint64_t kind, const char* data, const std::size_t size)
+{
+  // Align each section at 8 bytes.
+  static const char padding[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+  const std::uint64_t position = static_cast<std::uint64_t>(stream.tellp());
+  stream.write(padding, (8 - position % 8) % 8);
+
+  mapped_lts_section_entry entry;
+  entry.kind = kind;
+  entry.offset = static_cast<std::uint64_t>(stream.tellp());
+  entry.size = size;
+  table.push_back(entry);
+  stream.write(data, size);
+}
+
+// Write an lts, of which the outgoing transitions are given by the index, to the file.
+template <class LTS>
+static void write_mapped_lts(const LTS& l,
+                             const indexed_transitions& index,
+                             const std::size_t initial_state,
+                             const std::string& filename)
+{
+  if (filename.empty())
+  {
+    throw mcrl2::runtime_error("An lts in the memory mapped format cannot be written to standard output.");
+  }
+
+  std::ostringstream specification;
+  {
+    atermpp::binary_aterm_ostream stream(specification);
+    write_lts_header(stream, l.data(), l.process_parameters(), l.action_label_declarations());
+  }
+
+  std::ostringstream action_labels;
+  {
+    atermpp::binary_aterm_ostream stream(action_labels);
+    stream << data::detail::remove_index_impl;
+    for (std::size_t i = 1; i < l.num_action_labels(); ++i)
+    {
+      const action_label_lts& label = l.action_label(i);
+      stream << process::timed_multi_action(label.actions(), label.time());
+    }
+  }
+
+  std::ostringstream state_labels;
+  if (l.has_state_info())
+  {
+    if (l.num_state_labels() != l.num_states())
+    {
+      throw mcrl2::runtime_error("The number of state labels (" + std::to_string(l.num_state_labels()) +
+                                 ") differs from the number of states (" + std::to_string(l.num_states()) + ").");
+    }
+    atermpp::binary_aterm_ostream stream(state_labels);
+    stream << data::detail::remove_index_impl;
+    for (std::size_t i = 0; i < l.num_state_labels(); ++i)
+    {
+      stream << l.state_label(i);
+    }
+  }
+
+  // The file is written under a temporary name and renamed afterwards. The lts that is saved
+  // may refer to a mapping of the file that is overwritten, which remains valid this way.
+  const std::string temporary_filename = filename + ".tmp";
+  std::ofstream stream(temporary_filename, std::ofstream::out | std::ofstream::binary);
+  if (!stream)
+  {
+    throw mcrl2::runtime_error("Fail to open file " + temporary_filename + " for writing.");
+  }
+
+  mapped_lts_header header;
+  std::memcpy(header.magic, mapped_lts_magic, sizeof(header.magic));
+  header.version = mapped_lts_version;
+  header.byte_order = mapped_lts_byte_order;
+  header.number_of_states = l.num_states();
+  header.number_of_transitions = index.size();
+  header.number_of_action_labels = l.num_action_labels();
+  header.initial_state = initial_state;
+  header.number_of_sections = l.has_state_info() ? 5 : 4;
+
+  // Reserve space for the header and the section table, which are written at the end.
+  std::vector<mapped_lts_section_entry> table;
+  const std::vector<char> placeholder(sizeof(header) + header.number_of_sections * sizeof(mapped_lts_section_entry), 0);
+  stream.write(placeholder.data(), placeholder.size());
+
+  const std::string specification_data = specification.str();
+  write_section(stream, table, specification_section, specification_data.data(), specification_data.size());
+  const std::string action_label_data = action_labels.str();
+  write_section(stream, table, action_labels_section, action_label_data.data(), action_label_data.size());
+  if (l.has_state_info())
+  {
+    const std::string state_label_data = state_labels.str();
+    write_section(stream, table, state_labels_section, state_label_data.data(), state_label_data.size());
+  }
+  write_section(stream, table, offsets_section, reinterpret_cast<const char*>(index.get_offsets()),
+                (index.num_states() + 1) * sizeof(indexed_transitions::offset_type));
+  write_section(stream, table, transitions_section, reinterpret_cast<const char*>(index.get_transitions()),
+                index.size() * sizeof(label_state_pair));
+  assert(table.size() == header.number_of_sections);
+
+  stream.seekp(0);
+  stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  stream.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(mapped_lts_section_entry));
+  stream.close();
+  if (!stream)
+  {
+    std::remove(temporary_filename.c_str());
+    throw mcrl2::runtime_error("Fail to write lts correctly to the file " + filename + ".");
+  }
+  if (std::rename(temporary_filename.c_str(), filename.c_str()) != 0)
+  {
+    // Renaming does not replace an existing file on all platforms.
+    std::remove(filename.c_str());
+    if (std::rename(temporary_filename.c_str(), filename.c_str()) != 0)
+    {
+      std::remove(temporary_filename.c_str());
+      throw mcrl2::runtime_error("Fail to write lts correctly to the file " + filename + ".");
+    }
+  }
+}
+
+} // namespace detail
+
+mapped_lts_file::mapped_lts_file(const std::string& filename)
+  : m_file(std::make_shared<const detail::mapped_file>(filename)),
+    m_filename(filename)
+{
+  using namespace detail;
+
+  const char* data = m_file->data();
+  const std::size_t size = m_file->size();
+  mapped_lts_header header;
+  if (size < sizeof(header) || std::memcmp(data, mapped_lts_magic, sizeof(mapped_lts_magic)) != 0)
+  {
+    throw mcrl2::runtime_error("The file " + filename + " does not contain an lts in the memory mapped format.");
+  }
+  std::memcpy(&header, data, sizeof(header));
+  if (header.byte_order != mapped_lts_byte_order)
+  {
+    throw mcrl2::runtime_error("The lts in " + filename + " is written on a machine with a different byte order.");
+  }
+  if (header.version != mapped_lts_version)
+  {
+    throw mcrl2::runtime_error("The lts in " + filename + " has version " + std::to_string(header.version) +
+                               " of the memory mapped format, which is not supported.");
+  }
+  if (header.number_of_sections > (size - sizeof(header)) / sizeof(mapped_lts_section_entry))
+  {
+    throw mcrl2::runtime_error("The section table of the lts in " + filename + " is truncated.");
+  }
+
+  m_num_states = header.number_of_states;
+  m_num_transitions = header.number_of_transitions;
+  m_num_action_labels = header.number_of_action_labels;
+  m_initial_state = header.initial_state;
+
+  for (std::size_t i = 0; i < header.number_of_sections; ++i)
+  {
+    mapped_lts_section_entry entry;
+    std::memcpy(&entry, data + sizeof(header) + i * sizeof(entry), sizeof(entry));
+    if (entry.offset > size || entry.size > size - entry.offset)
+    {
+      throw mcrl2::runtime_error("A section of the lts in " + filename + " lies outside the file.");
+    }
+    const section s { data + entry.offset, static_cast<std::size_t>(entry.size) };
+    switch (entry.kind)
+    {
+      case specification_section: m_specification = s; break;
+      case action_labels_section: m_action_labels = s; break;
+      case state_labels_section: m_state_labels = s; break;
+      case offsets_section: m_offsets = s; break;
+      case transitions_section: m_transitions = s; break;
+      default: break;
+    }
+  }
+
+  if (m_specification.data == nullptr || m_action_labels.data == nullptr ||
+      m_offsets.data == nullptr || m_transitions.data == nullptr)
+  {
+    throw mcrl2::runtime_error("The lts in " + filename + " lacks a required section.");
+  }
+  // The number of states and transitions is compared to the sizes of the sections without multiplying them,
+  // as the multiplication can overflow for a number from a damaged file.
+  if (m_offsets.size % sizeof(indexed_transitions::offset_type) != 0 ||
+      m_offsets.size / sizeof(indexed_transitions::offset_type) != m_num_states + 1 ||
+      m_num_states + 1 == 0 ||
+      m_transitions.size % sizeof(label_state_pair) != 0 ||
+      m_transitions.size / sizeof(label_state_pair) != m_num_transitions ||
+      reinterpret_cast<std::uintptr_t>(m_offsets.data) % alignof(indexed_transitions::offset_type) != 0 ||
+      reinterpret_cast<std::uintptr_t>(m_transitions.data) % alignof(label_state_pair) != 0)
+  {
+    throw mcrl2::runtime_error("The transitions of the lts in " + filename + " are not stored correctly.");
+  }
+  const indexed_transitions::offset_type* offsets = reinterpret_cast<const indexed_transitions::offset_type*>(m_offsets.data);
+  if (m_num_states == 0 || m_initial_state >= m_num_states || offsets[0] != 0 || offsets[m_num_states] != m_num_transitions)
+  {
+    throw mcrl2::runtime_error("The lts in " + filename + " has an inconsistent header.");
+  }
+}
+
+bool mapped_lts_file::is_mapped_lts_file(const std::string& filename)
+{
+  if (filename.empty())
+  {
+    return false;
+  }
+  std::ifstream stream(filename, std::ifstream::in | std::ifstream::binary);
+  char magic[sizeof(detail::mapped_lts_magic)];
+  return stream.read(magic, sizeof(magic)) && std::memcmp(magic, detail::mapped_lts_magic, sizeof(magic)) == 0;
+}
+
+std::shared_ptr<const indexed_transitions> mapped_lts_file::outgoing_transitions() const
+{
+  return std::make_shared<const indexed_transitions>(
+           m_file,
+           reinterpret_cast<const indexed_transitions::offset_type*>(m_offsets.data),
+           reinterpret_cast<const label_state_pair*>(m_transitions.data),
+           m_num_states,
+           true);
+}
+
+void mapped_lts_file::check_transitions() const
+{
+  for (std::size_t s = 0; s < m_num_states; ++s)
+  {
+    check_transitions(s);
+  }
+}
+
+void mapped_lts_file::check_transitions(const std::size_t s) const
+{
+  assert(s < m_num_states);
+  const indexed_transitions::offset_type* offsets = reinterpret_cast<const indexed_transitions::offset_type*>(m_offsets.data);
+  const label_state_pair* transitions = reinterpret_cast<const label_state_pair*>(m_transitions.data);
+  if (offsets[s] > offsets[s + 1] || offsets[s + 1] > m_num_transitions)
+  {
+    throw mcrl2::runtime_error("The transitions of the lts in " + m_filename + " are not stored correctly.");
+  }
+  for (std::size_t i = offsets[s]; i < offsets[s + 1]; ++i)
+  {
+    if (transitions[i].label() >= m_num_action_labels || transitions[i].state() >= m_num_states)
+    {
+      throw mcrl2::runtime_error("The lts in " + m_filename + " contains a transition with a non existing label or target state.");
+    }
+  }
+}
+
+void mapped_lts_file::read_specification(data::data_specification& data,
+                                         data::variable_list& process_parameters,
+                                         process::action_label_list& action_label_declarations) const
+{
+  detail::memory_streambuf buffer(m_specification.data, m_specification.size);
+  std::istream is(&buffer);
+  atermpp::binary_aterm_istream stream(is);
+  stream >> data::detail::add_index_impl;
+
+  atermpp::aterm marker;
+  stream >> marker;
+  stream >> data;
+  stream >> process_parameters;
+  stream >> action_label_declarations;
+}
+
+std::vector<action_label_lts> mapped_lts_file::read_action_labels() const
+{
+  std::vector<action_label_lts> result;
+  result.reserve(m_num_action_labels);
+  result.push_back(action_label_lts::tau_action());
+
+  detail::memory_streambuf buffer(m_action_labels.data, m_action_labels.size);
+  std::istream is(&buffer);
+  atermpp::binary_aterm_istream stream(is);
+  stream >> data::detail::add_index_impl;
+  for (std::size_t i = 1; i < m_num_action_labels; ++i)
+  {
+    process::timed_multi_action action;
+    stream >> action;
+    result.emplace_back(lps::multi_action(action.actions(), action.time()));
+  }
+  return result;
+}
+
+std::vector<state_label_lts> mapped_lts_file::read_state_labels() const
+{
+  std::vector<state_label_lts> result;
+  if (!has_state_labels())
+  {
+    return result;
+  }
+  result.reserve(m_num_states);
+
+  detail::memory_streambuf buffer(m_state_labels.data, m_state_labels.size);
+  std::istream is(&buffer);
+  atermpp::binary_aterm_istream stream(is);
+  stream >> data::detail::add_index_impl;
+  for (std::size_t i = 0; i < m_num_states; ++i)
+  {
+    atermpp::aterm label;
+    stream >> label;
+    result.push_back(atermpp::down_cast<state_label_lts>(label));
+  }
+  return result;
+}
+
+void save_mapped_lts(const lts_lts_t& l, const std::string& filename)
+{
+  mCRL2log(log::verbose) << "Starting to save an lts in the memory mapped format to the file " << filename << ".\n";
+  if (l.hidden_label_set().empty())
+  {
+    detail::write_mapped_lts(l, *l.outgoing_transitions(), l.initial_state(), filename);
+    return;
+  }
+
+  std::vector<transition> transitions;
+  transitions.reserve(l.num_transitions());
+  for (const transition& t: l.get_transitions())
+  {
+    transitions.emplace_back(t.from(), l.apply_hidden_label_map(t.label()), t.to());
+  }
+  detail::write_mapped_lts(l, indexed_transitions(transitions, l.num_states(), true), l.initial_state(), filename);
+}
+
+void save_mapped_lts(const probabilistic_lts_lts_t& l, const std::string& filename)
+{
+  mCRL2log(log::verbose) << "Starting to save a probabilistic lts in the memory mapped format to the file " << filename << ".\n";
+  const auto state_of = [&](const probabilistic_lts_lts_t::probabilistic_state_t& s)
+  {
+    if (s.size() != 1)
+    {
+      throw mcrl2::runtime_error("An lts with probabilistic transitions cannot be saved in the memory mapped format.");
+    }
+    return s.begin()->state();
+  };
+
+  std::vector<transition> transitions;
+  transitions.reserve(l.num_transitions());
+  for (const transition& t: l.get_transitions())
+  {
+    transitions.emplace_back(t.from(), l.apply_hidden_label_map(t.label()), state_of(l.probabilistic_state(t.to())));
+  }
+  detail::write_mapped_lts(l, indexed_transitions(transitions, l.num_states(), true), state_of(l.initial_probabilistic_state()), filename);
+}
+
+// Set the data, the action labels, the state labels and the transitions of l. The transitions are validated,
+// such that algorithms can use them without checks, but they are not copied.
+template <class LTS>
+static void load_mapped_lts_labels(LTS& l, const mapped_lts_file& file)
+{
+  data::data_specification data;
+  data::variable_list process_parameters;
+  process::action_label_list action_label_declarations;
+  file.read_specification(data, process_parameters, action_label_declarations);
+  l.set_data(data);
+  l.set_process_parameters(process_parameters);
+  l.set_action_label_declarations(action_label_declarations);
+
+  const std::vector<action_label_lts> action_labels = file.read_action_labels();
+  l.clear_actions();
+  l.set_num_action_labels(action_labels.size());
+  for (std::size_t i = 1; i < action_labels.size(); ++i)
+  {
+    l.set_action_label(i, action_labels[i]);
+  }
+
+  file.check_transitions();
+  l.set_num_states(file.num_states(), false);
+  l.state_labels() = file.read_state_labels();
+  l.set_outgoing_transitions(file.outgoing_transitions());
+}
+
+void load_mapped_lts(lts_lts_t& l, const std::string& filename)
+{
+  mCRL2log(log::verbose) << "Starting to load an lts in the memory mapped format from the file " << filename << ".\n";
+  const mapped_lts_file file(filename);
+  load_mapped_lts_labels(l, file);
+  l.set_initial_state(file.initial_state());
+}
+
+void load_mapped_lts(probabilistic_lts_lts_t& l, const std::string& filename)
+{
+  mCRL2log(log::verbose) << "Starting to load a probabilistic lts in the memory mapped format from the file " << filename << ".\n";
+  const mapped_lts_file file(filename);
+  load_mapped_lts_labels(l, file);
+
+  // Probabilistic state s consists of state s only, such that the targets of the transitions in the file can be used as is.
+  l.clear_probabilistic_states();
+  for (std::size_t s = 0; s < file.num_states(); ++s)
+  {
+    l.add_probabilistic_state(probabilistic_lts_lts_t::probabilistic_state_t(s));
+  }
+  l.set_initial_probabilistic_state(probabilistic_lts_lts_t::probabilistic_state_t(file.initial_state()));
+}
+
+} // namespace mcrl2::lts
@@ -9,6 +9,8 @@
 #define BOOST_TEST_MODULE compare
 #include <boost/test/included/unit_test_framework.hpp>
 
+#include "mcrl2/lps/parse.h"
+#include "mcrl2/lts/detail/liblts_on_the_fly_refinement.h"
 #include "mcrl2/lts/lts_algorithm.h"
 
 using namespace mcrl2::lts;
@@ -132,6 +134,19 @@ BOOST_AUTO_TEST_CASE(test_sim_1_4)
   BOOST_CHECK(!compare(l4,l1,lts_eq_sim));
 }
 
+BOOST_AUTO_TEST_CASE(test_sim_par)
+{
+  const std::string* ltss[] = { &l1, &l2, &l2a, &l3, &l4, &a, &b };
+  for (const std::string* s1: ltss)
+  {
+    for (const std::string* s2: ltss)
+    {
+      BOOST_CHECK_EQUAL(preorder_compare(*s1,*s2,lts_pre_sim_par), preorder_compare(*s1,*s2,lts_pre_sim));
+      BOOST_CHECK_EQUAL(compare(*s1,*s2,lts_eq_sim_par), compare(*s1,*s2,lts_eq_sim));
+    }
+  }
+}
+
 
 BOOST_AUTO_TEST_CASE(test_ready_sim_1_2)
 {
@@ -423,3 +438,78 @@ BOOST_AUTO_TEST_CASE(properly_order_multiactions)
 
   BOOST_CHECK(compare(ab, ba, lts_eq_bisim)); // These transition systems must be equal. 
 }
+
+// Translates a transition system in aut format to a linear process of which the parameter is the state number.
+static mcrl2::lps::specification aut_to_lps(const std::string& s)
+{
+  const lts_aut_t l = parse_aut(s);
+  std::set<std::string> action_names;
+  std::string summands;
+  for (const transition& t: l.get_transitions())
+  {
+    const std::string label = pp(l.action_label(t.label()));
+    std::string::size_type begin = 0;
+    for (std::string::size_type end = label.find('|'); begin != std::string::npos; end = label.find('|', begin))
+    {
+      const std::string name = label.substr(begin, end == std::string::npos ? end : end - begin);
+      if (name != "tau")
+      {
+        action_names.insert(name);
+      }
+      begin = (end == std::string::npos ? end : end + 1);
+    }
+    summands += (summands.empty() ? "" : " + ") + std::string("(s == ") + std::to_string(t.from()) + ") -> " + label + " . P(s = " + std::to_string(t.to()) + ")";
+  }
+
+  std::string text;
+  for (const std::string& name: action_names)
+  {
+    text += (text.empty() ? "act " : ", ") + name;
+  }
+  text += ";\nproc P(s: Nat) = " + summands + ";\ninit P(" + std::to_string(l.initial_state()) + ");\n";
+  return mcrl2::lps::parse_linear_process_specification(text);
+}
+
+// The on-the-fly refinement checks on linear processes must give the same answers as the checks on transition systems.
+BOOST_AUTO_TEST_CASE(on_the_fly_refinement_test)
+{
+  const std::vector<std::string> ltss = { l1, l2, l2a, l3, l4, a, b, ababc, a_taub_tauc, abc_div, lts_impl, lts_spec, aPtauP, bP };
+  const std::vector<lts_preorder> preorders = { lts_pre_trace_anti_chain, lts_pre_weak_trace_anti_chain, lts_pre_failures_refinement,
+                                                lts_pre_weak_failures_refinement, lts_pre_failures_divergence_refinement };
+  std::vector<mcrl2::lps::specification> specs;
+  for (const std::string& l: ltss)
+  {
+    specs.push_back(aut_to_lps(l));
+  }
+
+  for (std::size_t i = 0; i < ltss.size(); ++i)
+  {
+    for (std::size_t j = 0; j < ltss.size(); ++j)
+    {
+      for (const lts_preorder pre: preorders)
+      {
+        BOOST_CHECK_MESSAGE(on_the_fly_compare(specs[i], specs[j], pre, false) == preorder_compare(ltss[i], ltss[j], pre),
+                            "on-the-fly " << description(pre) << " check of " << i << " and " << j);
+      }
+    }
+  }
+
+  BOOST_CHECK(on_the_fly_compare(specs[0], specs[1], lts_eq_trace, false));
+  BOOST_CHECK(!on_the_fly_compare(specs[0], specs[3], lts_eq_trace, false));
+  BOOST_CHECK(on_the_fly_compare(specs[0], specs[3], lts_eq_weak_trace, false));
+}
+
+// The implementation has an infinite state space, but a counterexample is found after a few steps.
+BOOST_AUTO_TEST_CASE(on_the_fly_infinite_implementation)
+{
+  const mcrl2::lps::specification impl = mcrl2::lps::parse_linear_process_specification(
+    "act a, b;\n"
+    "proc P(n: Nat) = a . P(n = n + 1) + (n == 3) -> b . P(n = n);\n"
+    "init P(0);\n");
+  const mcrl2::lps::specification spec = aut_to_lps(
+    "des (0,1,1)\n"
+    "(0,\"a\",0)\n");
+
+  BOOST_CHECK(!on_the_fly_compare(impl, spec, lts_pre_trace_anti_chain, false));
+  BOOST_CHECK(!on_the_fly_compare(impl, spec, lts_pre_weak_failures_refinement, false, false, mcrl2::lps::es_depth));
+}
@@ -16,8 +16,13 @@
 #define BOOST_TEST_MODULE lps2lts_test
 #include <boost/test/included/unit_test_framework.hpp>
 
+#include <fstream>
+#include <functional>
+#include <limits>
+
 #include "mcrl2/data/detail/rewrite_strategies.h"
 #include "mcrl2/lts/detail/exploration.h"
+#include "mcrl2/lts/lts_mapped.h"
 #include "mcrl2/lps/is_stochastic.h"
 #include "mcrl2/lts/state_space_generator.h"
 #include "mcrl2/lts/stochastic_lts_builder.h"
@@ -73,7 +78,8 @@ void run_generatelts(
   lps::exploration_strategy estrategy,
   lts::lts_type output_format,
   const std::string& outputfile,
-  const std::string& priority_action
+  const std::string& priority_action,
+  const std::function<void(lps::explorer_options&)>& set_options = [](lps::explorer_options&) {}
 )
 {
   lps::explorer_options options;
@@ -82,6 +88,7 @@ void run_generatelts(
   options.rewrite_strategy = rstrategy;
   options.search_strategy = estrategy;
   options.save_at_end = true;
+  set_options(options);
 
   bool is_timed = stochastic_lpsspec.process().has_time();
 
@@ -143,6 +150,47 @@ void check_lts(
   BOOST_CHECK_EQUAL(result2.num_transitions(), expected_transitions);
   BOOST_CHECK_EQUAL(result2.num_action_labels(), expected_labels);
 
+  // The variants of the exploration must result in the same state space.
+  struct variant
+  {
+    std::string name;
+    std::function<void(lps::explorer_options&)> set_options;
+    bool same_state_numbering; // the states must be discovered in the same order
+  };
+  std::vector<variant> variants = {
+    { "compressed", [](lps::explorer_options& options) { options.tree_compression = true; }, true },
+    // A small enumeration cache, of which entries are replaced frequently.
+    { "cached", [](lps::explorer_options& options) { options.cached = true; options.cache_size = 4; }, false }
+  };
+  if (estrategy == lps::es_breadth)
+  {
+    // Storing the todo list on disk.
+    variants.push_back({ "disk", [](lps::explorer_options& options) { options.tree_compression = true; options.todo_disk_threshold = 2; }, false });
+  }
+  if (atermpp::detail::GlobalThreadSafe)
+  {
+    variants.push_back({ "parallel", [](lps::explorer_options& options) { options.number_of_threads = 2; }, false });
+  }
+
+  for (const variant& v: variants)
+  {
+    LTSType result;
+    std::string outputfile = static_cast<std::string>(boost::unit_test::framework::current_test_case().p_name) + ".generatelts_" + v.name + file_extension(output_format);
+    run_generatelts(stochastic_lpsspec, rstrategy, estrategy, output_format, outputfile, priority_action, v.set_options);
+    result.load(outputfile);
+    BOOST_CHECK_EQUAL(result.num_states(), expected_states);
+    BOOST_CHECK_EQUAL(result.num_transitions(), expected_transitions);
+    BOOST_CHECK_EQUAL(result.num_action_labels(), expected_labels);
+    if (v.same_state_numbering && result2.has_state_info() && result.has_state_info())
+    {
+      for (std::size_t i = 0; i < result2.num_states(); ++i)
+      {
+        BOOST_CHECK(result2.state_label(i) == result.state_label(i));
+      }
+    }
+    std::remove(outputfile.c_str());
+  }
+
   std::remove(outputfile1.c_str());
   std::remove(outputfile2.c_str());
 }
@@ -469,6 +517,105 @@ BOOST_AUTO_TEST_CASE(test_max_states)
   BOOST_CHECK_LT(result.num_states(), 10u);
 }
 
+BOOST_AUTO_TEST_CASE(test_mapped_lts)
+{
+  std::string spec(
+    "act a: Nat;\n"
+    "     b;\n"
+    "proc P(s: Nat) =\n"
+    "  (s < 10) -> a(s) . P(s+1) +\n"
+    "  (s > 0) -> b . P(Int2Nat(s-1)) +\n"
+    "  tau . P(0);\n"
+    "init P(0);\n");
+
+  lps::stochastic_specification specification;
+  parse_lps(spec, specification);
+  const std::string lts_file = utilities::temporary_filename("lps2lts_test_file") + ".lts";
+  const std::string mapped_file = utilities::temporary_filename("lps2lts_test_file") + ".mlts";
+  run_generatelts(specification, data::jitty, lps::es_breadth, lts::lts_lts, lts_file, "");
+  run_generatelts(specification, data::jitty, lps::es_breadth, lts::lts_lts, mapped_file, "");
+  BOOST_CHECK(!lts::mapped_lts_file::is_mapped_lts_file(lts_file));
+  BOOST_CHECK(lts::mapped_lts_file::is_mapped_lts_file(mapped_file));
+  BOOST_CHECK(lts::detail::guess_format(mapped_file) == lts::lts_lts);
+
+  lts::lts_lts_t expected;
+  expected.load(lts_file);
+  lts::lts_lts_t result;
+  result.load(mapped_file);
+
+  BOOST_CHECK_EQUAL(result.num_states(), 11u);
+  BOOST_CHECK_EQUAL(result.num_states(), expected.num_states());
+  BOOST_CHECK_EQUAL(result.num_transitions(), expected.num_transitions());
+  BOOST_CHECK_EQUAL(result.num_action_labels(), expected.num_action_labels());
+  BOOST_CHECK_EQUAL(result.initial_state(), expected.initial_state());
+  BOOST_CHECK(result.data() == expected.data());
+  BOOST_CHECK(result.process_parameters() == expected.process_parameters());
+  for (std::size_t i = 0; i < expected.num_action_labels(); ++i)
+  {
+    BOOST_CHECK(result.action_label(i) == expected.action_label(i));
+  }
+  BOOST_CHECK(result.has_state_info());
+  for (std::size_t i = 0; i < expected.num_state_labels(); ++i)
+  {
+    BOOST_CHECK(result.state_label(i) == expected.state_label(i));
+  }
+
+  // The transitions of the mapped file are sorted per state, and must match those of the lts.
+  const std::shared_ptr<const lts::indexed_transitions> expected_index = expected.outgoing_transitions();
+  const std::shared_ptr<const lts::indexed_transitions> result_index = result.outgoing_transitions();
+  BOOST_CHECK(std::equal(result_index->begin(0), result_index->end(result.num_states() - 1),
+                         expected_index->begin(0), expected_index->end(expected.num_states() - 1)));
+
+  // The loaded lts refers to the mapped file, and only copies its transitions when they are requested.
+  BOOST_CHECK(result.outgoing_transitions() == result_index);
+  std::vector<lts::transition> result_transitions = result.get_transitions();
+  std::vector<lts::transition> expected_transitions = expected.get_transitions();
+  std::sort(result_transitions.begin(), result_transitions.end());
+  std::sort(expected_transitions.begin(), expected_transitions.end());
+  BOOST_CHECK(result_transitions == expected_transitions);
+
+  // In a probabilistic lts every state is a probabilistic state on its own.
+  lts::probabilistic_lts_lts_t probabilistic;
+  probabilistic.load(mapped_file);
+  BOOST_CHECK_EQUAL(probabilistic.num_probabilistic_states(), expected.num_states());
+  BOOST_CHECK_EQUAL(probabilistic.num_transitions(), expected.num_transitions());
+  for (std::size_t s = 0; s < probabilistic.num_probabilistic_states(); ++s)
+  {
+    BOOST_CHECK(probabilistic.probabilistic_state(s).size() == 1 && probabilistic.probabilistic_state(s).begin()->state() == s);
+  }
+
+  // Saving the loaded lts again must result in the same lts.
+  result.save(mapped_file);
+  lts::mapped_lts_file file(mapped_file);
+  file.check_transitions();
+  BOOST_CHECK_EQUAL(file.num_states(), expected.num_states());
+  BOOST_CHECK_EQUAL(file.num_transitions(), expected.num_transitions());
+
+  // A file with a transition to a non existing state is rejected when it is loaded. The transitions are the
+  // last section of the file, and the target state is the last field of a transition.
+  {
+    std::fstream stream(mapped_file, std::ios::in | std::ios::out | std::ios::binary);
+    const std::uint64_t state = expected.num_states();
+    stream.seekp(-static_cast<std::streamoff>(sizeof(state)), std::ios::end);
+    stream.write(reinterpret_cast<const char*>(&state), sizeof(state));
+  }
+  lts::lts_lts_t damaged;
+  BOOST_CHECK_THROW(damaged.load(mapped_file), mcrl2::runtime_error);
+
+  // A number of states for which the size of the offsets overflows to the actual size is rejected as well.
+  // It directly follows the magic number, the version and the byte order in the header.
+  {
+    std::fstream stream(mapped_file, std::ios::in | std::ios::out | std::ios::binary);
+    const std::uint64_t number_of_states = expected.num_states() + std::numeric_limits<std::uint64_t>::max() / sizeof(std::uint64_t) + 1;
+    stream.seekp(16);
+    stream.write(reinterpret_cast<const char*>(&number_of_states), sizeof(number_of_states));
+  }
+  BOOST_CHECK_THROW(lts::mapped_lts_file{mapped_file}, mcrl2::runtime_error);
+
+  std::remove(lts_file.c_str());
+  std::remove(mapped_file.c_str());
+}
+
 BOOST_AUTO_TEST_CASE(test_interaction_sum_and_assignment_notation1)
 {
   std::string spec(
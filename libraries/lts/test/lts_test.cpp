@@ -12,7 +12,11 @@
 #define BOOST_TEST_MODULE lts_test
 #include <boost/test/included/unit_test_framework.hpp>
 
+#include "mcrl2/lps/parse.h"
 #include "mcrl2/lts/lts_algorithm.h"
+#include "mcrl2/lts/lts_stream.h"
+#include "mcrl2/utilities/test_utilities.h"
+#include "parallel_reduction_test.h"
 
 using namespace mcrl2;
 
@@ -81,6 +85,9 @@ static void reduce_lts_in_various_ways(const std::string& test_description,
   reduce(l,lts::lts_eq_bisim_sigref);
   test_lts(test_description + " (bisimulation signature [Blom/Orzan 2003])",l, expected.labels_bisimulation,expected.states_bisimulation, expected.transitions_bisimulation);
   l=l_in;
+  reduce(l,lts::lts_eq_bisim_par);
+  test_lts(test_description + " (bisimulation parallel partition refinement)",l, expected.labels_bisimulation,expected.states_bisimulation, expected.transitions_bisimulation);
+  l=l_in;
   reduce(l,lts::lts_eq_branching_bisim);
   test_lts(test_description + " (branching bisimulation [Jansen/Groote/Keiren/Wijs 2019])",l, expected.labels_branching_bisimulation,expected.states_branching_bisimulation, expected.transitions_branching_bisimulation);
   l=l_in;
@@ -93,6 +100,9 @@ static void reduce_lts_in_various_ways(const std::string& test_description,
   reduce(l,lts::lts_eq_branching_bisim_sigref);
   test_lts(test_description + " (branching bisimulation signature [Blom/Orzan 2003])",l, expected.labels_branching_bisimulation,expected.states_branching_bisimulation, expected.transitions_branching_bisimulation);
   l=l_in;
+  reduce(l,lts::lts_eq_branching_bisim_par);
+  test_lts(test_description + " (branching bisimulation parallel partition refinement)",l, expected.labels_branching_bisimulation,expected.states_branching_bisimulation, expected.transitions_branching_bisimulation);
+  l=l_in;
   reduce(l,lts::lts_eq_divergence_preserving_branching_bisim);
   test_lts(test_description + " (divergence-preserving branching bisimulation [Jansen/Groote/Keiren/Wijs 2019])",l,
                                       expected.labels_divergence_preserving_branching_bisimulation,
@@ -117,6 +127,12 @@ static void reduce_lts_in_various_ways(const std::string& test_description,
                                       expected.states_divergence_preserving_branching_bisimulation,
                                       expected.transitions_divergence_preserving_branching_bisimulation);
   l=l_in;
+  reduce(l,lts::lts_eq_divergence_preserving_branching_bisim_par);
+  test_lts(test_description + " (divergence-preserving branching bisimulation parallel partition refinement)",l,
+                                      expected.labels_divergence_preserving_branching_bisimulation,
+                                      expected.states_divergence_preserving_branching_bisimulation,
+                                      expected.transitions_divergence_preserving_branching_bisimulation);
+  l=l_in;
   reduce(l,lts::lts_eq_weak_bisim);
   test_lts(test_description + " (weak bisimulation)",l, expected.labels_weak_bisimulation,expected.states_weak_bisimulation, expected.transitions_weak_bisimulation);
   l=l_in;
@@ -129,6 +145,9 @@ static void reduce_lts_in_various_ways(const std::string& test_description,
   reduce(l,lts::lts_eq_sim);
   test_lts(test_description + " (simulation equivalence)",l, expected.labels_simulation,expected.states_simulation, expected.transitions_simulation);
   l=l_in;
+  reduce(l,lts::lts_eq_sim_par);
+  test_lts(test_description + " (simulation equivalence using a parallel bit matrix)",l, expected.labels_simulation,expected.states_simulation, expected.transitions_simulation);
+  l=l_in;
   reduce(l,lts::lts_eq_trace);
   test_lts(test_description + " (trace equivalence)",l, expected.labels_trace_equivalence,expected.states_trace_equivalence, expected.transitions_trace_equivalence);
   l=l_in;
@@ -503,6 +522,9 @@ static void failing_test_groote_wijs_algorithm()
   l=l_gw;
   reduce(l,lts::lts_eq_branching_bisim_sigref);
   test_lts("gw problem (branching bisimulation signature [Blom/Orzan 2003])",l,expected_label_count, expected_state_count, expected_transition_count);
+  l=l_gw;
+  reduce(l,lts::lts_eq_branching_bisim_par);
+  test_lts("gw problem (branching bisimulation parallel partition refinement)",l,expected_label_count, expected_state_count, expected_transition_count);
 }
 
 // The following counterexample was taken from
@@ -856,6 +878,355 @@ void test_is_deterministic()
   is_deterministic_test2();
 }
 
+void test_indexed_transitions()
+{
+  std::string automaton =
+    "des(0,5,3)\n"
+    "(0,\"b\",2)\n"
+    "(0,\"a\",1)\n"
+    "(1,\"tau\",2)\n"
+    "(0,\"a\",0)\n"
+    "(2,\"a\",0)\n";
+
+  std::istringstream is(automaton);
+  lts::lts_aut_t l;
+  l.load(is);
+  const std::size_t a = std::find(l.action_labels().begin(), l.action_labels().end(), lts::action_label_string("a")) - l.action_labels().begin();
+
+  const std::shared_ptr<const lts::indexed_transitions> outgoing = l.outgoing_transitions();
+  BOOST_CHECK(outgoing->size() == 5 && outgoing->num_states() == 3);
+  BOOST_CHECK(outgoing->transitions(0).size() == 3 && outgoing->transitions(1).size() == 1 && outgoing->transitions(2).size() == 1);
+  BOOST_CHECK(std::is_sorted(outgoing->begin(0), outgoing->end(0)));
+  const auto range = outgoing->equal_range(0, a);
+  BOOST_CHECK(range.second - range.first == 2 && range.first->state() == 0 && (range.first + 1)->state() == 1);
+
+  const std::shared_ptr<const lts::indexed_transitions> incoming = l.incoming_transitions();
+  BOOST_CHECK(incoming->transitions(0).size() == 2 && incoming->transitions(1).size() == 1 && incoming->transitions(2).size() == 2);
+  for (const lts::label_state_pair& p: incoming->transitions(2))
+  {
+    BOOST_CHECK(p.state() == 0 || p.state() == 1);
+  }
+
+  // An index of the internal transitions only.
+  std::vector<bool> is_tau(l.num_action_labels(), false);
+  is_tau[l.tau_label_index()] = true;
+  const lts::indexed_transitions tau_outgoing(std::as_const(l).get_transitions(), l.num_states(), true, is_tau);
+  BOOST_CHECK(tau_outgoing.size() == 1 && tau_outgoing.transitions(1).size() == 1 && tau_outgoing.begin(1)->state() == 2);
+  BOOST_CHECK(tau_outgoing.transitions(0).empty() && tau_outgoing.transitions(2).empty());
+
+  // The indices are kept in the lts until the transitions can be changed. An index that was obtained
+  // before does not change with the transitions, but a new index reflects the change.
+  BOOST_CHECK(l.outgoing_transitions() == outgoing && l.incoming_transitions() == incoming);
+  l.add_transition(lts::transition(2, a, 1));
+  BOOST_CHECK(outgoing->size() == 5 && l.outgoing_transitions()->size() == 6);
+  BOOST_CHECK(l.outgoing_transitions() != outgoing && l.incoming_transitions() != incoming);
+  l.get_transitions().emplace_back(1, a, 1);
+  BOOST_CHECK(l.outgoing_transitions()->size() == 7 && l.incoming_transitions()->transitions(1).size() == 3);
+
+  // Labels and states need not fit in 32 bits.
+  const std::size_t large = std::size_t(1) << 40;
+  const lts::label_state_pair p(large, large + 1);
+  BOOST_CHECK(p.label() == large && p.state() == large + 1);
+}
+
+// Reading an .aut file must give the same lts as reading it from a stream, also when it is split in parts.
+template <class LTS_TYPE>
+static void check_aut_file(const std::string& automaton)
+{
+  const std::string filename = utilities::temporary_filename("lts_test_file") + ".aut";
+  {
+    std::ofstream os(filename, std::ofstream::binary);
+    os << automaton;
+  }
+
+  LTS_TYPE expected;
+  std::istringstream is(automaton);
+  expected.load(is);
+  LTS_TYPE result;
+  result.load(filename);
+
+  BOOST_CHECK_EQUAL(result.num_states(), expected.num_states());
+  BOOST_CHECK(result.action_labels() == expected.action_labels());
+  BOOST_CHECK(result.get_transitions() == expected.get_transitions());
+
+  // Writing and reading the lts again does not change it.
+  result.save(filename);
+  LTS_TYPE reloaded;
+  reloaded.load(filename);
+  BOOST_CHECK(reloaded.action_labels() == expected.action_labels());
+  BOOST_CHECK(reloaded.get_transitions() == expected.get_transitions());
+  std::remove(filename.c_str());
+}
+
+void test_aut_files()
+{
+  check_aut_file<lts::lts_aut_t>("des (0,4,3)\n(0,\"a\",1)\n(1,\"b c\",2)\n(2,\"tau\",0)\n(2,\"a\",2)\n");
+  // Unquoted labels, carriage returns, spaces and a missing newline at the end.
+  check_aut_file<lts::lts_aut_t>("des (0,3,2)\r\n( 0 , a b ,1)  \r\n(1,tau,0)\r\n(1,\"a\", 1)");
+  // A transition spanning two lines, and a file followed by an EOT character.
+  check_aut_file<lts::lts_aut_t>("des (1,2,2)\n(0,\"a\",\n1)\n(1,\"b\",0)\n\x04(5,\"c\",3)\n");
+  check_aut_file<lts::probabilistic_lts_aut_t>("des (0,3,3)\n(0,\"a\",1)\n(1,\"b\",2 1/3 0)\n(2,\"a\",1)\n");
+
+  // A file of a few megabytes, which is read in several parts.
+  std::ostringstream automaton;
+  const std::size_t number_of_states = 100000;
+  automaton << "des (0," << 2 * number_of_states << "," << number_of_states << ")\n";
+  for (std::size_t i = 0; i < number_of_states; ++i)
+  {
+    automaton << "(" << i << ",\"a(" << i % 1000 << ")\"," << (i + 1) % number_of_states << ")\n";
+    automaton << "(" << i << ",\"tau\"," << (i * 7) % number_of_states << ")\n";
+  }
+  check_aut_file<lts::lts_aut_t>(automaton.str());
+  check_aut_file<lts::probabilistic_lts_aut_t>(automaton.str());
+
+  // A file with an incorrect number of transitions is not accepted.
+  const std::string filename = utilities::temporary_filename("lts_test_file") + ".aut";
+  {
+    std::ofstream os(filename);
+    os << "des (0,3,2)\n(0,\"a\",1)\n(1,\"b\",0)\n";
+  }
+  lts::lts_aut_t l;
+  BOOST_CHECK_THROW(l.load(filename), mcrl2::runtime_error);
+  std::remove(filename.c_str());
+}
+
+// Converts the lts in the file to aut format while it is read, and checks that the result is the
+// same as when the lts is loaded, its actions are hidden, and it is converted.
+template <class LTS_TYPE>
+static void check_stream_conversion(const std::string& filename, const std::vector<std::string>& tau_actions)
+{
+  LTS_TYPE l;
+  l.load(filename);
+  l.record_hidden_actions(tau_actions);
+  l.apply_hidden_actions();
+  lts::lts_aut_t expected;
+  lts::detail::lts_convert(l, expected);
+
+  const std::string aut_filename = utilities::temporary_filename("lts_test_file") + ".aut";
+  {
+    lts::aut_stream_writer writer(aut_filename);
+    lts::lts_stream_convertor<LTS_TYPE, lts::lts_aut_t> convertor(writer, data::data_specification(), process::action_label_list(), data::variable_list(), false);
+    lts::lts_stream_filter<LTS_TYPE> filter(convertor, tau_actions, false);
+    lts::read_lts_stream(filename, filter);
+  }
+  lts::lts_aut_t result;
+  result.load(aut_filename);
+  std::remove(aut_filename.c_str());
+
+  BOOST_CHECK_EQUAL(result.num_states(), expected.num_states());
+  BOOST_CHECK_EQUAL(result.initial_state(), expected.initial_state());
+  BOOST_REQUIRE_EQUAL(result.num_transitions(), expected.num_transitions());
+  for (std::size_t i = 0; i < result.num_transitions(); ++i)
+  {
+    const lts::transition& t = result.get_transitions()[i];
+    const lts::transition& u = expected.get_transitions()[i];
+    BOOST_CHECK(t.from() == u.from() && t.to() == u.to());
+    BOOST_CHECK_EQUAL(result.action_label(t.label()), expected.action_label(u.label()));
+  }
+}
+
+// Checks that the parallel partition refinement algorithms yield the same result as the sequential algorithms on
+// an LTS that is large enough to use multiple threads, and that the result does not depend on the number of threads.
+void test_parallel_partition_refinement()
+{
+  const std::size_t n = 20000;
+  const lts::lts_aut_t l = generate_lts(n, [&](const std::size_t i, auto add)
+  {
+    const char* labels[] = { "tau", "a", "b" };
+    add(labels[(i % 5) % 3], (i + 1) % n);
+    if (i % 5 == 0 || i % 11 == 3)
+    {
+      add("tau", (i + 5) % n);
+    }
+    if (i % 13 == 4 && i < n / 2)
+    {
+      add("a", (i * 17) % n);
+    }
+    if (i % 97 == 0)
+    {
+      add("tau", i);
+    }
+  });
+
+  check_parallel_reduction(l, lts::lts_eq_bisim_par, lts::lts_eq_bisim);
+  check_parallel_reduction(l, lts::lts_eq_branching_bisim_par, lts::lts_eq_branching_bisim);
+  check_parallel_reduction(l, lts::lts_eq_divergence_preserving_branching_bisim_par, lts::lts_eq_divergence_preserving_branching_bisim);
+}
+
+// Checks that the parallel simulation algorithm agrees with the sequential one on an LTS with enough states
+// to use multiple threads, and that the result does not depend on the number of threads.
+void test_parallel_simulation()
+{
+  const std::size_t n = 3000;
+  lts::lts_aut_t l = generate_lts(n, [&](const std::size_t i, auto add)
+  {
+    const char* labels[] = { "a", "b", "c" };
+    add(labels[i % 3], (i * 7 + 1) % n);
+    if (i % 4 == 1)
+    {
+      add(labels[(i / 4) % 3], (i * 13 + 5) % n);
+    }
+    if (i % 9 == 2)
+    {
+      add("a", (i + 1) % n);
+    }
+  });
+
+  const lts::lts_aut_t parallel = check_parallel_reduction(l, lts::lts_eq_sim_par, lts::lts_eq_sim);
+  BOOST_CHECK(compare(l, parallel, lts::lts_eq_sim_par, false, false, 4));
+  BOOST_CHECK(compare(l, parallel, lts::lts_pre_sim_par, false, false, lps::es_breadth, true, 4));
+
+  // The bit matrix for this number of states cannot be represented, which is reported as an error.
+  typedef lts::detail::sim_partitioner_par<lts::lts_aut_t> sim_partitioner;
+  lts::lts_aut_t huge;
+  huge.set_num_states(std::size_t(1) << 40, false);
+  BOOST_CHECK_THROW(sim_partitioner partitioner(huge), mcrl2::runtime_error);
+}
+
+// Returns the equivalence classes of the states.
+static std::vector<std::size_t> scc_classes(lts::lts_aut_t& l, std::size_t number_of_threads)
+{
+  lts::detail::scc_partitioner<lts::lts_aut_t> partitioner(l, number_of_threads);
+  std::vector<std::size_t> classes(l.num_states());
+  for (std::size_t s = 0; s < l.num_states(); ++s)
+  {
+    classes[s] = partitioner.get_eq_class(s);
+  }
+  return classes;
+}
+
+void test_scc_partitioning()
+{
+  // A cycle of internal transitions that is too long for a recursive depth first search.
+  const std::size_t n = 1000000;
+  std::stringstream cycle;
+  cycle << "des (0," << n + 1 << "," << n << ")\n";
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    cycle << "(" << i << ",\"tau\"," << (i + 1) % n << ")\n";
+  }
+  cycle << "(" << n / 2 << ",\"a\"," << 0 << ")\n";
+  lts::lts_aut_t l;
+  l.load(cycle);
+  lts::lts_aut_t l_parallel = l;
+  lts::lts_aut_t l_divergent = l;
+  scc_reduce(l);
+  BOOST_CHECK_EQUAL(l.num_states(), 1u);
+  BOOST_CHECK_EQUAL(l.num_transitions(), 1u);
+  scc_reduce(l_parallel, false, 4);
+  BOOST_CHECK_EQUAL(l_parallel.num_states(), 1u);
+  BOOST_CHECK_EQUAL(l_parallel.num_transitions(), 1u);
+  scc_reduce(l_divergent, true);
+  BOOST_CHECK_EQUAL(l_divergent.num_states(), 1u);
+  BOOST_CHECK_EQUAL(l_divergent.num_transitions(), 2u);
+
+  // Many small components, connected by internal transitions and a visible action.
+  const std::size_t m = 50000;
+  std::stringstream components;
+  components << "des (0," << 3 * m << "," << m << ")\n";
+  for (std::size_t i = 0; i < m; ++i)
+  {
+    components << "(" << i << ",\"tau\"," << (i % 10 == 9 ? i - 9 : i + 1) << ")\n";
+    components << "(" << i << ",\"tau\"," << (i * 7 + 3) % m << ")\n";
+    components << "(" << i << ",\"a\"," << (i + 10) % m << ")\n";
+  }
+  l = lts::lts_aut_t();
+  l.load(components);
+  const std::vector<std::size_t> sequential = scc_classes(l, 1);
+  BOOST_CHECK(scc_classes(l, 4) == sequential);
+  l_parallel = l;
+  scc_reduce(l, true);
+  scc_reduce(l_parallel, true, 4);
+  BOOST_CHECK(l.get_transitions() == l_parallel.get_transitions());
+  BOOST_CHECK_EQUAL(l.initial_state(), l_parallel.initial_state());
+}
+
+void test_stream_conversion()
+{
+  const std::string filename = utilities::temporary_filename("lts_test_file");
+
+  // A large .aut file, which is read in several parts, where one of the last parts must be read by the stream parser.
+  {
+    std::ofstream os(filename + ".aut");
+    const std::size_t number_of_states = 100000;
+    os << "des (3," << 2 * number_of_states << "," << number_of_states << ")\n";
+    for (std::size_t i = 0; i < number_of_states; ++i)
+    {
+      os << "(" << i << ",\"a(" << i % 1000 << ")\"," << (i + 1) % number_of_states << ")\n";
+      os << (i == number_of_states - 10 ? "(+" : "(") << i << ",b," << (i * 7) % number_of_states << ")\n";
+    }
+  }
+  check_stream_conversion<lts::lts_aut_t>(filename + ".aut", {});
+  check_stream_conversion<lts::lts_aut_t>(filename + ".aut", { "b" });
+
+  // An .fsm file with state labels.
+  {
+    std::ofstream os(filename + ".fsm");
+    os << "b(2) Bool \"false\" \"true\"\n---\n0\n1\n1\n---\n1 2 \"a\"\n2 3 \"b\"\n3 1 \"tau\"\n2 4 \"a\"\n";
+  }
+  check_stream_conversion<lts::lts_fsm_t>(filename + ".fsm", { "a" });
+
+  // An .lts file, of which the state labels are kept when it is converted to an .lts file.
+  const lps::specification spec = lps::parse_linear_process_specification("act a: Nat; b; proc P(n: Nat) = a(n).P(n); init P(0);");
+  lts::lts_aut_t aut;
+  std::istringstream is("des (0,4,3)\n(0,\"a(1)\",1)\n(1,\"b\",2)\n(2,\"tau\",0)\n(2,\"a(2)\",2)\n");
+  aut.load(is);
+  lts::lts_lts_t l;
+  lts::detail::lts_convert(aut, l, spec.data(), spec.action_labels(), spec.process().process_parameters());
+  for (std::size_t i = 0; i < l.num_states(); ++i)
+  {
+    l.state_labels().push_back(lts::state_label_lts(data::data_expression_list({ data::sort_nat::nat(i) })));
+  }
+  l.save(filename + ".lts");
+  check_stream_conversion<lts::lts_lts_t>(filename + ".lts", { "a" });
+
+  {
+    lts::lts_lts_stream_writer writer(filename + ".copy.lts");
+    lts::lts_stream_filter<lts::lts_lts_t> filter(writer, { "b" }, false);
+    lts::read_lts_stream(filename + ".lts", filter);
+  }
+  lts::lts_lts_t copy;
+  copy.load(filename + ".copy.lts");
+  l.record_hidden_actions({ "b" });
+  l.apply_hidden_actions();
+  l.save(filename + ".lts");
+  lts::lts_lts_t expected;
+  expected.load(filename + ".lts");
+  BOOST_CHECK_EQUAL(copy.num_states(), expected.num_states());
+  BOOST_CHECK(copy.get_transitions() == expected.get_transitions());
+  BOOST_CHECK(copy.action_labels() == expected.action_labels());
+  BOOST_CHECK(copy.state_labels() == expected.state_labels());
+
+  std::remove((filename + ".aut").c_str());
+  std::remove((filename + ".fsm").c_str());
+  std::remove((filename + ".lts").c_str());
+  std::remove((filename + ".copy.lts").c_str());
+}
+
+// The information that is collected while an lts is read must match that of the loaded lts.
+void test_stream_statistics()
+{
+  const std::string filename = utilities::temporary_filename("lts_test_file") + ".aut";
+  {
+    std::ofstream os(filename);
+    os << "des (0,5,5)\n(0,\"a\",1)\n(1,\"b\",2)\n(1,\"b\",0)\n(2,\"tau\",0)\n(4,\"a\",0)\n";
+  }
+  lts::lts_aut_t l;
+  l.load(filename);
+
+  lts::lts_stream_statistics<lts::lts_aut_t> statistics(false, true);
+  lts::read_lts_stream(filename, statistics);
+  BOOST_CHECK_EQUAL(statistics.num_states(), l.num_states());
+  BOOST_CHECK_EQUAL(statistics.num_transitions(), l.num_transitions());
+  BOOST_CHECK_EQUAL(statistics.num_action_labels(), l.num_action_labels());
+  BOOST_CHECK_EQUAL(statistics.initial_state(), l.initial_state());
+  BOOST_CHECK(statistics.is_reachable() == reachability_check(l));
+  BOOST_CHECK(statistics.is_deterministic() == is_deterministic(l));
+  BOOST_CHECK(!statistics.is_reachable() && !statistics.is_deterministic());
+  BOOST_CHECK(statistics.branching_factor() == std::vector<std::uint64_t>({ 1, 2, 1, 0, 1 }));
+  std::remove(filename.c_str());
+}
+
 BOOST_AUTO_TEST_CASE(test_main)
 {
   reduce_simple_loop();
@@ -865,6 +1236,13 @@ BOOST_AUTO_TEST_CASE(test_main)
   reduce_peterson();
   test_reachability();
   test_is_deterministic();
+  test_indexed_transitions();
+  test_aut_files();
+  test_stream_conversion();
+  test_stream_statistics();
+  test_parallel_partition_refinement();
+  test_parallel_simulation();
+  test_scc_partitioning();
   failing_test_groote_wijs_algorithm();
   counterexample_jk_1(3);
   counterexample_postprocessing();
@@ -16,6 +16,7 @@
 #include <boost/test/included/unit_test_framework.hpp>
 
 #include "mcrl2/lts/lts_algorithm.h"
+#include "parallel_reduction_test.h"
 
 using namespace mcrl2::lts;
 
@@ -704,3 +705,30 @@ BOOST_AUTO_TEST_CASE(test_state_space_reductions)
  }
 }
 
+
+// Generates an LTS with n states that is large enough to be reduced by the signature refinement
+// algorithms using multiple threads. It has many inert tau transitions.
+static lts_aut_t generate_large_lts(std::size_t n)
+{
+  return generate_lts(n, [&](const std::size_t i, auto add)
+  {
+    const char* labels[] = { "tau", "a", "b" };
+    add(labels[(i % 7) % 3], (i + 1) % n);
+    if (i % 7 == 0 || i % 7 == 3)
+    {
+      add("tau", (i + 7) % n);
+    }
+    if (i % 7 == 5 && i < n / 2)
+    {
+      add("a", (i * 13) % n);
+    }
+  });
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_signature_refinement)
+{
+  const lts_aut_t l = generate_large_lts(14000);
+  check_parallel_reduction(l, lts_eq_bisim_sigref, lts_eq_bisim);
+  check_parallel_reduction(l, lts_eq_branching_bisim_sigref, lts_eq_branching_bisim);
+  check_parallel_reduction(l, lts_eq_divergence_preserving_branching_bisim_sigref, lts_eq_divergence_preserving_branching_bisim);
+}
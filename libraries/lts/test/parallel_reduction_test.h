@@ -0,0 +1,67 @@
+// Author(s): Jan Friso Groote
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file parallel_reduction_test.h
+/// \brief Generation of large lts'es and the comparison of sequential and parallel reductions on them.
+/// \details Must be included after the Boost.Test header.
+
+#ifndef MCRL2_LTS_TEST_PARALLEL_REDUCTION_TEST_H
+#define MCRL2_LTS_TEST_PARALLEL_REDUCTION_TEST_H
+
+#include <sstream>
+#include <string>
+
+#include "mcrl2/lts/lts_algorithm.h"
+
+/// \brief Generates an lts with the n states 0 up to n-1, of which 0 is the initial state.
+/// \details For each state i, the call transitions_of(i, add) must call add(label, target) for each
+///          outgoing transition of state i. Labels are strings, of which "tau" is the internal action.
+template <typename TRANSITIONS>
+inline mcrl2::lts::lts_aut_t generate_lts(const std::size_t n, TRANSITIONS transitions_of)
+{
+  std::stringstream transitions;
+  std::size_t number_of_transitions = 0;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    transitions_of(i, [&](const std::string& label, const std::size_t target)
+    {
+      transitions << "(" << i << ",\"" << label << "\"," << target << ")\n";
+      ++number_of_transitions;
+    });
+  }
+  std::stringstream is;
+  is << "des (0," << number_of_transitions << "," << n << ")\n" << transitions.str();
+  mcrl2::lts::lts_aut_t l;
+  l.load(is);
+  return l;
+}
+
+/// \brief Checks that reducing l with parallel_equivalence using one thread yields the same lts as reducing
+///        it with equivalence, up to the numbering of states, and that four threads give exactly the same lts.
+/// \return The lts reduced with parallel_equivalence using four threads.
+inline mcrl2::lts::lts_aut_t check_parallel_reduction(const mcrl2::lts::lts_aut_t& l,
+                                                      const mcrl2::lts::lts_equivalence parallel_equivalence,
+                                                      const mcrl2::lts::lts_equivalence equivalence)
+{
+  mcrl2::lts::lts_aut_t expected = l;
+  reduce(expected, equivalence);
+
+  mcrl2::lts::lts_aut_t sequential = l;
+  reduce(sequential, parallel_equivalence, 1);
+  BOOST_CHECK_EQUAL(sequential.num_states(), expected.num_states());
+  BOOST_CHECK_EQUAL(sequential.num_transitions(), expected.num_transitions());
+  BOOST_CHECK(compare(sequential, expected, mcrl2::lts::lts_eq_bisim));
+
+  mcrl2::lts::lts_aut_t parallel = l;
+  reduce(parallel, parallel_equivalence, 4);
+  BOOST_CHECK(parallel.get_transitions() == sequential.get_transitions());
+  BOOST_CHECK_EQUAL(parallel.initial_state(), sequential.initial_state());
+  return parallel;
+}
+
+#endif // MCRL2_LTS_TEST_PARALLEL_REDUCTION_TEST_H
@@ -113,11 +113,11 @@ class pbesinst_lazy_todo
       todo.push_back(x);
     }
 
+    /// \brief Adds the elements of [first, last) that are irrelevant or have not been discovered to the todo list.
+    /// \details The undiscovered elements are added to discovered as well, such that each element is looked up only once.
     template <typename FwdIter>
-    void insert(FwdIter first, FwdIter last, const std::unordered_set<propositional_variable_instantiation>& discovered)
+    void insert(FwdIter first, FwdIter last, std::unordered_set<propositional_variable_instantiation>& discovered)
     {
-      using utilities::detail::contains;
-
       for (FwdIter i = first; i != last; ++i)
       {
         auto j = irrelevant.find(*i);
@@ -126,7 +126,7 @@ class pbesinst_lazy_todo
           todo.push_back(*j);
           irrelevant.erase(j);
         }
-        else if (!contains(discovered, *i))
+        else if (discovered.insert(*i).second)
         {
           todo.push_back(*i);
         }
@@ -287,7 +287,12 @@ class pbesinst_lazy_algorithm
        m_pbes(preprocess(p)),
        m_equation_index(p),
        R(datar, p.data())
-    { }
+    {
+      if (m_options.enumeration_cache_size > 0)
+      {
+        R.enable_cache(m_options.enumeration_cache_size);
+      }
+    }
 
     virtual ~pbesinst_lazy_algorithm() = default;
 
@@ -379,7 +384,6 @@ class pbesinst_lazy_algorithm
 
         std::set<propositional_variable_instantiation> occ = find_propositional_variable_instantiations(psi_e);
         todo.insert(occ.begin(), occ.end(), discovered);
-        discovered.insert(occ.begin(), occ.end());
         on_discovered_elements(occ);
 
         if (solution_found(init))
@@ -387,6 +391,11 @@ class pbesinst_lazy_algorithm
           break;
         }
       }
+      if (R.cache())
+      {
+        mCRL2log(log::verbose) << "the quantifier enumeration cache contains " << R.cache()->size() << " entries; "
+                               << R.cache()->metric(0).message() << std::endl;
+      }
       on_end_while_loop();
     }
 
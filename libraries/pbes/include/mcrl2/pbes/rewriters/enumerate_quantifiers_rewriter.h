@@ -13,14 +13,20 @@
 #define MCRL2_PBES_REWRITERS_ENUMERATE_QUANTIFIERS_REWRITER_H
 
 #include "mcrl2/data/detail/split_finite_variables.h"
+#include "mcrl2/data/enumeration_cache.h"
 #include "mcrl2/pbes/enumerator.h"
+#include "mcrl2/pbes/find.h"
 #include "mcrl2/pbes/rewriters/simplify_rewriter.h"
+#include <memory>
 #include <numeric>
 
 namespace mcrl2 {
 
 namespace pbes_system {
 
+/// \brief A cache for the results of eliminating quantifiers by enumeration.
+typedef data::enumeration_cache<pbes_expression> enumerate_quantifiers_cache;
+
 namespace detail {
 
 // Simplifying PBES rewriter that eliminates quantifiers using enumeration.
@@ -45,18 +51,23 @@ struct enumerate_quantifiers_builder: public simplify_data_rewriter_builder<Deri
   /// The enumerator
   data::enumerator_algorithm<self> E;
 
+  /// If not equal to nullptr, the results of quantifier elimination are stored in this cache.
+  enumerate_quantifiers_cache* m_cache;
+
   /// \brief Constructor.
   /// \param r A data rewriter.
   /// \param sigma A mutable substitution.
   /// \param dataspec A data specification.
   /// \param id_generator A generator to generate fresh variable names.
   /// \param enumerate_infinite_sorts If true, quantifier variables of infinite sort are enumerated as well.
+  /// \param cache An optional cache for the results of quantifier elimination.
   enumerate_quantifiers_builder(const DataRewriter& r,
                                 MutableSubstitution& sigma,
                                 const data::data_specification& dataspec,
                                 data::enumerator_identifier_generator& id_generator,
-                                bool enumerate_infinite_sorts = true)
-    : super(r, sigma), m_dataspec(dataspec), m_enumerate_infinite_sorts(enumerate_infinite_sorts), E(*this, m_dataspec, r, id_generator, (std::numeric_limits<std::size_t>::max)())
+                                bool enumerate_infinite_sorts = true,
+                                enumerate_quantifiers_cache* cache = nullptr)
+    : super(r, sigma), m_dataspec(dataspec), m_enumerate_infinite_sorts(enumerate_infinite_sorts), E(*this, m_dataspec, r, id_generator, (std::numeric_limits<std::size_t>::max)()), m_cache(cache)
   { }
 
   Derived& derived()
@@ -124,7 +135,39 @@ struct enumerate_quantifiers_builder: public simplify_data_rewriter_builder<Deri
     return result;
   }
 
+  // Returns a key for the cache that consists of x and the values of its free variables.
+  atermpp::aterm cache_key(const pbes_expression& x)
+  {
+    std::set<data::variable> FV = pbes_system::find_free_variables(x);
+    std::vector<atermpp::aterm> arguments;
+    arguments.reserve(FV.size() + 1);
+    arguments.push_back(x);
+    for (const data::variable& v: FV)
+    {
+      arguments.push_back(sigma(v));
+    }
+    return atermpp::aterm_appl(atermpp::function_symbol("@quantifier", arguments.size()), arguments.begin(), arguments.end());
+  }
+
   pbes_expression apply(const forall& x)
+  {
+    if (m_cache)
+    {
+      return m_cache->find_or_compute(cache_key(x), 0, [&]() { return rewrite_forall(x); });
+    }
+    return rewrite_forall(x);
+  }
+
+  pbes_expression apply(const exists& x)
+  {
+    if (m_cache)
+    {
+      return m_cache->find_or_compute(cache_key(x), 0, [&]() { return rewrite_exists(x); });
+    }
+    return rewrite_exists(x);
+  }
+
+  pbes_expression rewrite_forall(const forall& x)
   {
     pbes_expression result;
     if (m_enumerate_infinite_sorts)
@@ -152,7 +195,7 @@ struct enumerate_quantifiers_builder: public simplify_data_rewriter_builder<Deri
     return result;
   }
 
-  pbes_expression apply(const exists& x)
+  pbes_expression rewrite_exists(const exists& x)
   {
     pbes_expression result;
     if (m_enumerate_infinite_sorts)
@@ -194,16 +237,16 @@ struct apply_enumerate_builder: public Builder<apply_enumerate_builder<Builder,
   using super::enter;
   using super::leave;
 
-  apply_enumerate_builder(const DataRewriter& R, MutableSubstitution& sigma, const data::data_specification& dataspec, data::enumerator_identifier_generator& id_generator, bool enumerate_infinite_sorts)
-    : super(R, sigma, dataspec, id_generator, enumerate_infinite_sorts)
+  apply_enumerate_builder(const DataRewriter& R, MutableSubstitution& sigma, const data::data_specification& dataspec, data::enumerator_identifier_generator& id_generator, bool enumerate_infinite_sorts, enumerate_quantifiers_cache* cache = nullptr)
+    : super(R, sigma, dataspec, id_generator, enumerate_infinite_sorts, cache)
   {}
 };
 
 template <template <class, class, class> class Builder, class DataRewriter, class MutableSubstitution>
 apply_enumerate_builder<Builder, DataRewriter, MutableSubstitution>
-make_apply_enumerate_builder(const DataRewriter& R, MutableSubstitution& sigma, const data::data_specification& dataspec, data::enumerator_identifier_generator& id_generator, bool enumerate_infinite_sorts)
+make_apply_enumerate_builder(const DataRewriter& R, MutableSubstitution& sigma, const data::data_specification& dataspec, data::enumerator_identifier_generator& id_generator, bool enumerate_infinite_sorts, enumerate_quantifiers_cache* cache = nullptr)
 {
-  return apply_enumerate_builder<Builder, DataRewriter, MutableSubstitution>(R, sigma, dataspec, id_generator, enumerate_infinite_sorts);
+  return apply_enumerate_builder<Builder, DataRewriter, MutableSubstitution>(R, sigma, dataspec, id_generator, enumerate_infinite_sorts, cache);
 }
 
 } // namespace detail
@@ -223,6 +266,9 @@ struct enumerate_quantifiers_rewriter
 
     mutable data::enumerator_identifier_generator m_id_generator;
 
+    /// \brief An optional cache for the results of quantifier elimination. N.B. Copies of the rewriter share the cache.
+    std::shared_ptr<enumerate_quantifiers_cache> m_cache;
+
   public:
     typedef pbes_expression term_type;
     typedef data::variable variable_type;
@@ -234,19 +280,33 @@ struct enumerate_quantifiers_rewriter
     pbes_expression operator()(const pbes_expression& x) const
     {
       data::rewriter::substitution_type sigma;
-      return detail::apply_enumerate_builder<detail::enumerate_quantifiers_builder, data::rewriter, data::rewriter::substitution_type>(m_rewriter, sigma, m_dataspec, m_id_generator, m_enumerate_infinite_sorts).apply(x);
+      return detail::apply_enumerate_builder<detail::enumerate_quantifiers_builder, data::rewriter, data::rewriter::substitution_type>(m_rewriter, sigma, m_dataspec, m_id_generator, m_enumerate_infinite_sorts, m_cache.get()).apply(x);
     }
 
     template <typename MutableSubstitution>
     pbes_expression operator()(const pbes_expression& x, MutableSubstitution& sigma) const
     {
-      return detail::apply_enumerate_builder<detail::enumerate_quantifiers_builder, data::rewriter, MutableSubstitution>(m_rewriter, sigma, m_dataspec, m_id_generator, m_enumerate_infinite_sorts).apply(x);
+      return detail::apply_enumerate_builder<detail::enumerate_quantifiers_builder, data::rewriter, MutableSubstitution>(m_rewriter, sigma, m_dataspec, m_id_generator, m_enumerate_infinite_sorts, m_cache.get()).apply(x);
     }
 
     void clear_identifier_generator()
     {
       m_id_generator.clear();
     }
+
+    /// \brief Stores the results of eliminating quantifiers in a cache with at most max_size entries, where 0 means
+    /// that the number of entries is unbounded. A quantifier is only eliminated again if the values of its free
+    /// variables differ from those of the cached entries.
+    void enable_cache(std::size_t max_size)
+    {
+      m_cache = std::make_shared<enumerate_quantifiers_cache>(max_size);
+    }
+
+    /// \brief Returns the cache for the results of quantifier elimination, or nullptr if it is not enabled.
+    const enumerate_quantifiers_cache* cache() const
+    {
+      return m_cache.get();
+    }
 };
 
 } // namespace pbes_system
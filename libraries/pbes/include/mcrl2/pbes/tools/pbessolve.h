@@ -67,6 +67,10 @@ class pbessolve_tool: public rewriter_tool<pbes_input_tool<input_tool>>
                       "be an LTS.",
                       'f');
       desc.add_option("prune-todo-list", "Prune the todo list periodically.");
+      desc.add_option("enumeration-cache",
+                      utilities::make_mandatory_argument("NUM"),
+                      "Store the results of eliminating quantifiers by enumeration in a cache with at most NUM entries, "
+                      "such that a quantifier is only enumerated once for the same values of its free variables.");
       desc.add_hidden_option("no-remove-unused-rewrite-rules", "do not remove unused rewrite rules. ", 'u');
       desc.add_option("evidence-file",
                       utilities::make_file_argument("NAME"),
@@ -113,6 +117,14 @@ class pbessolve_tool: public rewriter_tool<pbes_input_tool<input_tool>>
       options.prune_todo_list = parser.has_option("prune-todo-list");
       options.prune_todo_alternative = parser.has_option("prune-todo-alternative");
       options.exploration_strategy = parser.option_argument_as<mcrl2::pbes_system::search_strategy>("search-strategy");
+      if (parser.has_option("enumeration-cache"))
+      {
+        options.enumeration_cache_size = parser.option_argument_as<std::size_t>("enumeration-cache");
+        if (options.enumeration_cache_size == 0)
+        {
+          parser.error("The size of the enumeration cache must be positive.");
+        }
+      }
       options.rewrite_strategy = rewrite_strategy();
 
       if (parser.has_option("file"))
@@ -499,6 +499,35 @@ BOOST_AUTO_TEST_CASE(test_substitutions2)
   test_expressions(R, expr1, R, expr2, var_decl, sigma);
 }
 
+BOOST_AUTO_TEST_CASE(test_enumerate_quantifiers_rewriter_cache)
+{
+  std::cout << "<test_enumerate_quantifiers_rewriter_cache>" << std::endl;
+  data::data_specification data_spec;
+  data_spec.add_context_sort(data::sort_nat::nat());
+  data::rewriter datar(data_spec);
+  pbes_system::enumerate_quantifiers_rewriter R(datar, data_spec);
+  R.enable_cache(4);
+
+  std::string var_decl =
+    "datavar         \n"
+    "  b: Bool;      \n"
+    "                \n"
+    "predvar         \n"
+    "  X: Bool, Bool;\n"
+    ;
+  std::string expr1 = "forall c: Bool. X(c, b)";
+
+  // The cached results must depend on the values of the free variables of the quantifier.
+  for (int i = 0; i < 3; i++)
+  {
+    test_expressions(R, expr1, R, "X(false, false) && X(true, false)", var_decl, "b: Bool := false");
+    test_expressions(R, expr1, R, "X(false, true) && X(true, true)", var_decl, "b: Bool := true");
+    test_expressions(R, "exists b: Bool, c: Bool. val(b && c)", R, "val(true)", var_decl, "");
+  }
+  BOOST_CHECK(R.cache() != nullptr);
+  BOOST_CHECK(R.cache()->size() > 0);
+}
+
 BOOST_AUTO_TEST_CASE(test_substitutions3)
 {
   std::cout << "<test_substitutions3>" << std::endl;
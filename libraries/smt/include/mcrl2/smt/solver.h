@@ -14,12 +14,17 @@
 #include "mcrl2/smt/child_process.h"
 #include "mcrl2/smt/native_translation.h"
 #include "mcrl2/smt/answer.h"
+#include "mcrl2/utilities/cache_metric.h"
+#include "mcrl2/utilities/fixed_size_cache.h"
+#include "mcrl2/utilities/hash_utility.h"
 
 namespace mcrl2
 {
 namespace smt
 {
 
+/// \brief An incremental session with the SMT solver Z3. The translation of the data specification is sent to the
+/// solver once; every query is checked between a push and a pop of the solver's assertion stack.
 class smt_solver
 {
 protected:
@@ -27,14 +32,31 @@ protected:
   std::unordered_map<data::data_expression, std::string> m_cache;
   child_process z3;
 
+  /// \brief The answers SAT and UNSAT to earlier queries, indexed by the declared variables and the assertion. When
+  /// the cache is full, the oldest answer is removed.
+  utilities::fifo_cache<std::pair<data::variable_list, data::data_expression>, answer> m_answers;
+  utilities::cache_metric m_answers_metric;
+
 protected:
 
   answer execute_and_check(const std::string& command, const std::chrono::microseconds& timeout) const;
 
 public:
+  /// \brief The maximal number of answers that is kept.
+  static constexpr std::size_t answer_cache_size = 1 << 14;
+
   smt_solver(const data::data_specification& dataspec);
 
+  /// \brief Checks whether expr is satisfiable for some valuation of the variables in vars. Queries that were answered
+  /// with SAT or UNSAT recently are answered without consulting the solver; UNKNOWN is not cached, since it may be
+  /// caused by the timeout.
   answer solve(const data::variable_list& vars, const data::data_expression& expr, const std::chrono::microseconds& timeout = std::chrono::microseconds::zero());
+
+  /// \brief The number of queries that were answered from the cache (hits) and by the solver (misses).
+  const utilities::cache_metric& answer_cache_metric() const
+  {
+    return m_answers_metric;
+  }
 };
 
 } // namespace smt
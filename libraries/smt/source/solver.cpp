@@ -44,6 +44,7 @@ answer smt_solver::execute_and_check(const std::string& s, const std::chrono::mi
 smt_solver::smt_solver(const data::data_specification& dataspec)
 : m_native(initialise_native_translation(dataspec))
 , z3("Z3")
+, m_answers(answer_cache_size)
 {
   std::ostringstream out;
   translate_data_specification(dataspec, out, m_cache, m_native);
@@ -52,6 +53,15 @@ smt_solver::smt_solver(const data::data_specification& dataspec)
 
 answer smt_solver::solve(const data::variable_list& vars, const data::data_expression& expr, const std::chrono::microseconds& timeout)
 {
+  const std::pair<data::variable_list, data::data_expression> query(vars, expr);
+  const auto i = m_answers.find(query);
+  if(i != m_answers.end())
+  {
+    m_answers_metric.hit();
+    return i->second;
+  }
+  m_answers_metric.miss();
+
   z3.write("(push)\n");
   std::ostringstream out;
   translate_variable_declaration(vars, out, m_cache, m_native);
@@ -59,6 +69,10 @@ answer smt_solver::solve(const data::variable_list& vars, const data::data_expre
   out << "(check-sat)\n";
   answer result = execute_and_check(out.str(), timeout);
   z3.write("(pop)\n");
+  if(result != answer::UNKNOWN)
+  {
+    m_answers.emplace(query, result);
+  }
   return result;
 }
 
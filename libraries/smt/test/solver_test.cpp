@@ -0,0 +1,53 @@
+// Author(s): Thomas Neele
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file solver_test.cpp
+/// \brief Tests that repeated queries are answered without consulting Z3.
+
+#define BOOST_TEST_MODULE solver_test
+#include <boost/test/included/unit_test_framework.hpp>
+
+#include <cstdlib>
+
+#include "mcrl2/data/parse.h"
+#include "mcrl2/smt/solver.h"
+
+using namespace mcrl2;
+
+/// \brief The solver Z3 is not part of the toolset, so the test is skipped if it cannot be found.
+static bool z3_is_available()
+{
+  return std::system("z3 -version > /dev/null 2>&1") == 0;
+}
+
+BOOST_AUTO_TEST_CASE(test_repeated_query)
+{
+  if (!z3_is_available())
+  {
+    BOOST_TEST_MESSAGE("Z3 is not available, the test is skipped.");
+    return;
+  }
+
+  const data::data_specification dataspec;
+  const data::variable x("x", data::sort_nat::nat());
+  const data::variable_list vars({ x });
+  const data::data_expression satisfiable = data::parse_data_expression("x > 2", vars, dataspec);
+  const data::data_expression unsatisfiable = data::parse_data_expression("x > 2 && x < 1", vars, dataspec);
+
+  smt::smt_solver solver(dataspec);
+  BOOST_CHECK(solver.solve(vars, satisfiable) == smt::answer::SAT);
+  BOOST_CHECK(solver.solve(vars, unsatisfiable) == smt::answer::UNSAT);
+  BOOST_CHECK_EQUAL(solver.answer_cache_metric().misses(), 2u);
+  BOOST_CHECK_EQUAL(solver.answer_cache_metric().hits(), 0u);
+
+  // The repeated queries are not sent to Z3.
+  BOOST_CHECK(solver.solve(vars, satisfiable) == smt::answer::SAT);
+  BOOST_CHECK(solver.solve(vars, unsatisfiable) == smt::answer::UNSAT);
+  BOOST_CHECK_EQUAL(solver.answer_cache_metric().misses(), 2u);
+  BOOST_CHECK_EQUAL(solver.answer_cache_metric().hits(), 2u);
+}
@@ -0,0 +1,73 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/concurrent_indexed_set.h"
+#include "mcrl2/utilities/indexed_set.h"
+#include "mcrl2/utilities/stopwatch.h"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mcrl2::utilities;
+
+/// \brief Benchmark the insertion of keys into an indexed_set and a concurrent_indexed_set. Every key is inserted
+///        twice, such that half of the insertions find an existing key. The optional argument is the number of
+///        threads that share the concurrent_indexed_set.
+int main(int argc, char* argv[])
+{
+  const std::size_t amount = 10000000;
+  const std::size_t number_of_threads = argc > 1 ? std::stoul(argv[1]) : std::max(1u, std::thread::hardware_concurrency());
+
+  {
+    stopwatch timer;
+    indexed_set<std::size_t> set;
+    for (std::size_t k = 0; k < 2; ++k)
+    {
+      for (std::size_t i = 0; i < amount; ++i)
+      {
+        set.insert(i);
+      }
+    }
+    std::cerr << "indexed_set: inserting " << amount << " keys took " << timer.time() << " milliseconds.\n";
+  }
+
+  for (std::size_t n = 1; n <= number_of_threads; n *= 2)
+  {
+    stopwatch timer;
+    concurrent_indexed_set<std::size_t> set;
+
+    // Every thread inserts its own part of the keys twice.
+    auto insert_keys = [&set, amount, n](std::size_t id)
+      {
+        for (std::size_t k = 0; k < 2; ++k)
+        {
+          for (std::size_t i = 0; i < amount / n; ++i)
+          {
+            set.insert((i + id * (amount / n)) % amount);
+          }
+        }
+      };
+
+    std::vector<std::thread> threads;
+    for (std::size_t id = 1; id < n; ++id)
+    {
+      threads.emplace_back(insert_keys, id);
+    }
+    insert_keys(0);
+    for (std::thread& thread : threads)
+    {
+      thread.join();
+    }
+
+    std::cerr << "concurrent_indexed_set: inserting " << set.size() << " keys with " << n << " threads took " << timer.time() << " milliseconds.\n";
+  }
+}
@@ -28,6 +28,12 @@ public:
   /// \brief Should be called when searching the cache was a miss.
   void miss() { ++m_miss_count; }
 
+  /// \returns The number of hits.
+  std::size_t hits() const { return m_hit_count; }
+
+  /// \returns The number of misses.
+  std::size_t misses() const { return m_miss_count; }
+
   /// \brief Resets the cache counters.
   void reset()
   {
@@ -35,6 +41,14 @@ public:
     m_miss_count = 0;
   }
 
+  /// \brief Adds the hits and misses of another metric to this one.
+  cache_metric& operator+=(const cache_metric& other)
+  {
+    m_hit_count += other.m_hit_count;
+    m_miss_count += other.m_miss_count;
+    return *this;
+  }
+
   /// \returns A message stating x hits, y misses (z %), where x,y,z indicate the number of hits, misses and percentage respectively.
   std::string message() const;
 
@@ -11,6 +11,9 @@
 #define MCRL2_UTILITIES_CACHE_POLICY_H
 
 #include <forward_list>
+#include <list>
+#include <unordered_map>
+#include <vector>
 
 #include <cassert>
 
@@ -123,6 +126,155 @@ private:
   typename std::forward_list<key_type>::iterator m_last_element_it;
 };
 
+/// \brief A policy that replaces the least recently used element, where both an insertion and a lookup count as a use.
+template<typename Map>
+class lru_policy final : public replacement_policy<Map>
+{
+public:
+  using key_type = typename Map::key_type;
+
+  lru_policy() = default;
+
+  lru_policy(const lru_policy& other)
+    : m_queue(other.m_queue)
+  {
+    update_positions();
+  }
+
+  lru_policy& operator=(const lru_policy& other)
+  {
+    m_queue = other.m_queue;
+    update_positions();
+    return *this;
+  }
+
+  // Moving a std::list keeps the iterators to its elements valid.
+  lru_policy(lru_policy&& other) noexcept = default;
+  lru_policy& operator=(lru_policy&& other) noexcept = default;
+
+  void clear() override
+  {
+    m_queue.clear();
+    m_position.clear();
+  }
+
+  typename Map::iterator replacement_candidate(Map& map) override
+  {
+    assert(!m_queue.empty());
+    // The element at the back of the queue has been used least recently.
+    auto it = map.find(m_queue.back());
+    m_position.erase(m_queue.back());
+    m_queue.pop_back();
+    assert(it != map.end());
+    return it;
+  }
+
+  void inserted(const key_type& key) override
+  {
+    m_queue.push_front(key);
+    m_position[key] = m_queue.begin();
+  }
+
+  void touch(const key_type& key) override
+  {
+    auto it = m_position.find(key);
+    if (it != m_position.end())
+    {
+      m_queue.splice(m_queue.begin(), m_queue, it->second);
+    }
+  }
+
+private:
+  void update_positions()
+  {
+    m_position.clear();
+    for (auto it = m_queue.begin(); it != m_queue.end(); ++it)
+    {
+      m_position[*it] = it;
+    }
+  }
+
+  std::list<key_type> m_queue; ///< The keys ordered from most to least recently used.
+  std::unordered_map<key_type, typename std::list<key_type>::iterator> m_position; ///< The position of each key in m_queue.
+};
+
+/// \brief A policy that approximates least recently used replacement by the CLOCK (second chance) algorithm.
+/// \details Every key has a reference bit that is set when it is found. To find a replacement candidate a hand
+///          sweeps over the keys, clearing the reference bits, until it finds a key of which the bit was not set.
+///          Compared to the lru_policy a lookup only sets a bit, instead of reordering a list.
+template<typename Map>
+class clock_policy final : public replacement_policy<Map>
+{
+public:
+  using key_type = typename Map::key_type;
+
+  void clear() override
+  {
+    m_keys.clear();
+    m_referenced.clear();
+    m_slot.clear();
+    m_hand = 0;
+    m_free_slot = no_slot;
+  }
+
+  typename Map::iterator replacement_candidate(Map& map) override
+  {
+    assert(!m_keys.empty() && m_free_slot == no_slot);
+    while (m_referenced[m_hand])
+    {
+      m_referenced[m_hand] = false;
+      advance_hand();
+    }
+
+    auto it = map.find(m_keys[m_hand]);
+    m_slot.erase(m_keys[m_hand]);
+    m_free_slot = m_hand;
+    advance_hand();
+    assert(it != map.end());
+    return it;
+  }
+
+  void inserted(const key_type& key) override
+  {
+    if (m_free_slot == no_slot)
+    {
+      m_slot[key] = m_keys.size();
+      m_keys.push_back(key);
+      m_referenced.push_back(false);
+    }
+    else
+    {
+      m_slot[key] = m_free_slot;
+      m_keys[m_free_slot] = key;
+      m_referenced[m_free_slot] = false;
+      m_free_slot = no_slot;
+    }
+  }
+
+  void touch(const key_type& key) override
+  {
+    auto it = m_slot.find(key);
+    if (it != m_slot.end())
+    {
+      m_referenced[it->second] = true;
+    }
+  }
+
+private:
+  static constexpr std::size_t no_slot = std::size_t(-1);
+
+  void advance_hand()
+  {
+    m_hand = (m_hand + 1) % m_keys.size();
+  }
+
+  std::vector<key_type> m_keys;                    ///< The keys in the cache, in the order in which the hand visits them.
+  std::vector<bool> m_referenced;                  ///< The reference bit of the key in the same slot of m_keys.
+  std::unordered_map<key_type, std::size_t> m_slot; ///< The slot of every key in m_keys.
+  std::size_t m_hand = 0;                          ///< The slot that is inspected next for replacement.
+  std::size_t m_free_slot = no_slot;               ///< The slot of the last replaced key, which is reused by the next insertion.
+};
+
 } // namespace utilities
 } // namespace mcrl2
 
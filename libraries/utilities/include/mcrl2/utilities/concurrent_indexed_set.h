@@ -0,0 +1,183 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef MCRL2_UTILITIES_CONCURRENT_INDEXED_SET_H
+#define MCRL2_UTILITIES_CONCURRENT_INDEXED_SET_H
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "mcrl2/utilities/noncopyable.h"
+
+namespace mcrl2
+{
+namespace utilities
+{
+
+/// \brief A set that assigns each element an unique index, and that can be used by multiple threads concurrently.
+/// \details The interface is the same as the one of indexed_set. Elements obtain consecutive indices in the order
+///          in which they are inserted, and the index of an element never changes. Finding and inserting an element
+///          does not require a lock. Instead, a free position in the hash table is reserved by a compare-and-swap
+///          and only the threads that look for an element at that position wait until it has been stored.
+///
+///          The hash table is resized by the thread that inserts the element that exceeds half of its capacity. The
+///          other threads keep on inserting elements into the old table while the new table is being filled. Only
+///          the elements that were inserted during that time are moved while the other threads wait. The old tables
+///          are released by clear() or the destructor, which means that the total size of all tables is at most
+///          twice the size of the current table. To prevent that elements are added to a table that is being
+///          replaced, the number of elements is stored together with the generation of the current table and an
+///          index is only assigned when the generation of the table in which the element is inserted is current.
+///
+///          The keys are stored in blocks of increasing size, which means that references to the keys remain
+///          valid until clear() is called. The functions clear() and the destructor may not be called concurrently
+///          with any other function.
+template<typename Key,
+         typename Hash = std::hash<Key>,
+         typename Equals = std::equal_to<Key>,
+         typename Allocator = std::allocator<Key>>
+class concurrent_indexed_set : private noncopyable
+{
+public:
+  typedef Key key_type;
+  typedef std::size_t size_type;
+  typedef Equals key_equal;
+  typedef Hash hasher;
+
+  /// \brief Value returned when an element does not exist in the set.
+  static constexpr size_type npos = std::numeric_limits<std::size_t>::max();
+
+  /// \brief The smallest size of the hashtable, which should exceed four times the number of threads.
+  static constexpr size_type minimal_hashtable_size = 1024;
+
+  /// \brief Constructor of an empty indexed set. Starts with a hashtable of size 1024.
+  concurrent_indexed_set();
+
+  /// \brief Constructor of an empty indexed set. Starts with a hashtable of (at least) the indicated size.
+  /// \param initial_hashtable_size The initial size of the hashtable.
+  /// \param hash The hash function.
+  /// \param equals The comparison function for its elements.
+  explicit concurrent_indexed_set(std::size_t initial_hashtable_size,
+    const hasher& hash = hasher(),
+    const key_equal& equals = key_equal());
+
+  ~concurrent_indexed_set();
+
+  /// \brief Returns the index of the given key.
+  /// \details Returns npos if there is no element with the given key.
+  size_type index(const key_type& key) const;
+
+  /// \brief Returns a reference to the key at the given index.
+  /// \details Throws an out_of_range exception if there is no element with the given index.
+  const key_type& at(size_type index) const;
+
+  /// \brief Returns a reference to the key at the given index.
+  /// \details The index should have been returned by insert or index.
+  const key_type& operator[](size_type index) const;
+
+  /// \brief Insert a key in the indexed set and return its index.
+  /// \details If the element was already in the set, the resulting bool is false, and the existing index is returned.
+  ///          Otherwise, the key is inserted in the set, and the next available index is assigned to it.
+  /// \return The index of the key and a boolean indicating whether the element was actually inserted.
+  std::pair<size_type, bool> insert(const key_type& key);
+
+  /// \brief Removes all elements from the set. This function is not thread-safe.
+  void clear();
+
+  /// \brief The number of indices that have been assigned.
+  /// \details An index is assigned slightly before the corresponding insert returns. Whenever no insert is in
+  ///          progress this is exactly the number of elements.
+  size_type size() const
+  {
+    return m_counter.load() & count_mask;
+  }
+
+  bool empty() const
+  {
+    return size() == 0;
+  }
+
+private:
+  /// \brief A block of keys together with flags that indicate whether the corresponding key has been constructed.
+  struct block
+  {
+    Key* keys;
+    std::unique_ptr<std::atomic<bool>[]> ready;
+  };
+
+  struct table
+  {
+    table(std::size_t size, std::size_t generation);
+
+    std::size_t mask;
+    std::unique_ptr<std::atomic<std::size_t>[]> buckets;
+
+    /// \brief Indices can only be assigned to elements of this table as long as the generation of m_counter is equal to this value.
+    std::size_t generation;
+
+    std::size_t capacity() const
+    {
+      return mask + 1;
+    }
+  };
+
+  /// \brief The values of a bucket that does not contain an index.
+  static constexpr std::size_t EMPTY = npos;
+  static constexpr std::size_t RESERVED = npos - 1;
+
+  /// \brief The number of elements in the first block, the block with index b has first_block_size * 2^b elements.
+  static constexpr std::size_t first_block_size = 1024;
+  static constexpr std::size_t number_of_blocks = 40;
+
+  /// \brief The counter consists of the generation of the current table in the upper bits and the number of elements in the lower bits.
+  static constexpr std::size_t number_of_generations = 256;
+  static constexpr std::size_t generation_shift = sizeof(std::size_t) * 8 - 8;
+  static constexpr std::size_t count_mask = (std::size_t(1) << generation_shift) - 1;
+
+  std::array<std::atomic<block*>, number_of_blocks> m_blocks;
+  std::atomic<table*> m_table;
+  std::vector<std::unique_ptr<table>> m_retired_tables;
+  std::atomic<bool> m_resizing{false};
+  std::atomic<std::size_t> m_counter{0};
+
+  Allocator m_allocator;
+  Hash m_hasher;
+  Equals m_equals;
+
+  /// \returns The key with the given index, which must have been constructed.
+  const Key& get_key(std::size_t index) const;
+
+  /// \brief Constructs the key with the given index, allocates its block if necessary.
+  void construct_key(std::size_t index, const Key& key);
+
+  /// \returns The key with the given index after it has been constructed by the inserting thread.
+  const Key& wait_for_key(std::size_t index) const;
+
+  /// \brief Stores the given index in a table that is not yet shared with other threads.
+  void put_in_table(table& t, std::size_t index);
+
+  /// \brief Waits until the given table has been replaced by a larger table.
+  void wait_for_table(const table* t);
+
+  /// \brief Replaces the current table by a table of twice its size, unless another thread is already doing so.
+  void resize_table();
+
+  /// \returns The first position in the given table at which the key should be searched.
+  std::size_t start_position(const table& t, const Key& key) const;
+};
+
+} // end namespace utilities
+} // end namespace mcrl2
+
+#include "mcrl2/utilities/detail/concurrent_indexed_set.h"
+
+#endif // MCRL2_UTILITIES_CONCURRENT_INDEXED_SET_H
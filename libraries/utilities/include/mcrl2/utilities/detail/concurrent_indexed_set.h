@@ -0,0 +1,391 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MCRL2_UTILITIES_DETAIL_CONCURRENT_INDEXED_SET_H
+#define MCRL2_UTILITIES_DETAIL_CONCURRENT_INDEXED_SET_H
+
+#include "mcrl2/utilities/concurrent_indexed_set.h" // necessary for header test.
+#include "mcrl2/utilities/power_of_two.h"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace mcrl2
+{
+namespace utilities
+{
+namespace detail
+{
+
+/// \returns The position of the most significant bit that is set in the given non-zero value.
+inline std::size_t most_significant_bit(std::size_t value)
+{
+  assert(value != 0);
+#if defined(__GNUC__) || defined(__clang__)
+  return sizeof(unsigned long long) * 8 - 1 - static_cast<std::size_t>(__builtin_clzll(value));
+#else
+  std::size_t result = 0;
+  while (value >>= 1)
+  {
+    ++result;
+  }
+  return result;
+#endif
+}
+
+/// \returns The block that contains the given index, where block b contains first_block_size * 2^b indices,
+///          and assigns the position of the index within that block to offset.
+inline std::size_t concurrent_indexed_set_block(std::size_t index, std::size_t first_block_size, std::size_t& offset)
+{
+  const std::size_t block = most_significant_bit(index / first_block_size + 1);
+  offset = index - first_block_size * ((std::size_t(1) << block) - 1);
+  return block;
+}
+
+} // namespace detail
+
+template <class Key, typename Hash, typename Equals, typename Allocator>
+concurrent_indexed_set<Key, Hash, Equals, Allocator>::table::table(std::size_t size, std::size_t generation_)
+  : mask(size - 1),
+    buckets(new std::atomic<std::size_t>[size]),
+    generation(generation_)
+{
+  assert(is_power_of_two(size));
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    buckets[i].store(EMPTY, std::memory_order_relaxed);
+  }
+}
+
+template <class Key, typename Hash, typename Equals, typename Allocator>
+concurrent_indexed_set<Key, Hash, Equals, Allocator>::concurrent_indexed_set()
+  : concurrent_indexed_set(minimal_hashtable_size)
+{}
+
+template <class Key, typename Hash, typename Equals, typename Allocator>
+concurrent_indexed_set<Key, Hash, Equals, Allocator>::concurrent_indexed_set(std::size_t initial_hashtable_size,
+  const hasher& hash,
+  const key_equal& equals)
+  : m_hasher(hash),
+    m_equals(equals)
+{
+  for (std::atomic<block*>& b : m_blocks)
+  {
+    b.store(nullptr);
+  }
+  m_table.store(new table(round_up_to_power_of_two(std::max(initial_hashtable_size, minimal_hashtable_size)), 0));
+}
+
+template <class Key, typename Hash, typename Equals, typename Allocator>
+concurrent_indexed_set<Key, Hash, Equals, Allocator>::~concurrent_indexed_set()
+{
+  clear();
+
+  for (std::size_t i = 0; i < number_of_blocks; ++i)
+  {
+    block* b = m_blocks[i].load();
+    if (b != nullptr)
+    {
+      std::allocator_traits<Allocator>::deallocate(m_allocator, b->keys, first_block_size << i);
+      delete b;
+    }
+  }
+
+  delete m_table.load();
+}
+
+template <class Key, typename Hash, typename Equals, typename Allocator>
+inline std::size_t concurrent_indexed_set<Key, Hash, Equals, Allocator>::start_position(const table& t, const Key& key) const
+{
+  const std::size_t hash = m_hasher(key) * 999953;
+  return (hash ^ (hash >> (sizeof(std::size_t) * 4))) & t.mask;
+}
+
+template <class Key, typename Hash, typename Equals, typename Allocator>
+inline const Key& concurrent_indexed_set<Key, Hash, Equals, Allocator>::get_key(std::size_t index) const
+{
+  std::size_t offset;
+  const block* b = m_blocks[detail::concurrent_indexed_set_block(index, first_block_size, offset)].load(std::memory_order_acquire);
+  assert(b != nullptr && b->ready[offset].load());
+  return b->keys[offset];
+}
+
+template <class Key, typename Hash, typename Equals, typename Allocator>
+void concurrent_indexed_set<Key, Hash, Equals, Allocator>::construct_key(std::size_t index, const Key& key)
+{
+  std::size_t offset;
+  const std::size_t i = detail::concurrent_indexed_set_block(index, first_block_size, offset);
+  assert(i < number_of_blocks);
+
+  block* b = m_blocks[i].load(std::memory_order_acquire);
+  if (b == nullptr)
+  {
+    // Allocate the block, where only the first thread that stores its block succeeds.
+    const std::size_t size = first_block_size << i;
+    block* new_block = new block{std::allocator_traits<Allocator>::allocate(m_allocator, size), std::unique_ptr<std::atomic<bool>[]>(new std::atomic<bool>[size])};
+    for (std::size_t j = 0; j < size; ++j)
+    {
+      new_block->ready[j].store(false, std::memory_order_relaxed);
+    }
+
+    if (m_blocks[i].compare_exchange_strong(b, new_block))
+    {
+      b = new_block;
+    }
+    else
+    {
+      std::allocator_traits<Allocator>::deallocate(m_allocator, new_block->keys, size);
+      delete new_block;
+    }
+  }
+
+  std::allocator_traits<Allocator>::construct(m_allocator, b->keys + offset, key);
+  b->ready[offset].store(true, std::memory_order_release);
+}
+
+template <class Key, typename Hash, typename Equals, typename Allocator>
+const Key& concurrent_indexed_set<Key, Hash, Equals, Allocator>::wait_for_key(std::size_t index) const
+{
+  std::size_t offset;
+  const std::atomic<block*>& b = m_blocks[detail::concurrent_indexed_set_block(index, first_block_size, offset)];
+
+  while (true)
+  {
+    const block* current = b.load(std::memory_order_acquire);
+    if (current != nullptr && current->ready[offset].load(std::memory_order_acquire))
+    {
+      return current->keys[offset];
+    }
+    std::this_thread::yield();
+  }
+}
+
+template <class Key, typename Hash, typename Equals, typename Allocator>
+void concurrent_indexed_set<Key, Hash, Equals, Allocator>::put_in_table(table& t, std::size_t index)
+{
+  std::size_t position = start_position(t, wait_for_key(index));
+  while (t.buckets[position].load(std::memory_order_relaxed) != EMPTY)
+  {
+    position = (position + 1) & t.mask;
+  }
+  t.buckets[position].store(index, std::memory_order_relaxed);
+}
+
+template <class Key, typename Hash, typename Equals, typename Allocator>
+void concurrent_indexed_set<Key, Hash, Equals, Allocator>::wait_for_table(const table* t)
+{
+  while (m_table.load(std::memory_order_acquire) == t)
+  {
+    if (!m_resizing.load())
+    {
+      resize_table();
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+}
+
+template <class Key, typename Hash, typename Equals, typename Allocator>
+void concurrent_indexed_set<Key, Hash, Equals, Allocator>::resize_table()
+{
+  bool expected = false;
+  if (!m_resizing.compare_exchange_strong(expected, true))
+  {
+    // Another thread is already resizing.
+    return;
+  }
+
+  table* old_table = m_table.load();
+  if (size() < old_table->capacity() / 2)
+  {
+    // The table has already been resized.
+    m_resizing.store(false);
+    return;
+  }
+
+  const std::size_t generation = (old_table->generation + 1) % number_of_generations;
+  std::unique_ptr<table> new_table(new table(old_table->capacity() * 2, generation));
+
+  // Move the elements that are present now, while the other threads continue with the old table.
+  const std::size_t n = size();
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    put_in_table(*new_table, i);
+  }
+
+  // Change the generation such that no more indices are assigned to elements of the old table. The elements
+  // that obtained an index before are moved once they have been constructed.
+  std::size_t counter = m_counter.load();
+  while (!m_counter.compare_exchange_weak(counter, (generation << generation_shift) | (counter & count_mask)))
+  {}
+
+  const std::size_t m = counter & count_mask;
+  for (std::size_t i = n; i < m; ++i)
+  {
+    put_in_table(*new_table, i);
+  }
+
+  m_table.store(new_table.release(), std::memory_order_release);
+  m_retired_tables.emplace_back(old_table);
+  m_resizing.store(false);
+}
+
+template <class Key, typename Hash, typename Equals, typename Allocator>
+typename concurrent_indexed_set<Key, Hash, Equals, Allocator>::size_type
+concurrent_indexed_set<Key, Hash, Equals, Allocator>::index(const key_type& key) const
+{
+  const table* t = m_table.load(std::memory_order_acquire);
+  std::size_t position = start_position(*t, key);
+
+  while (true)
+  {
+    const std::size_t value = t->buckets[position].load(std::memory_order_acquire);
+    if (value == EMPTY)
+    {
+      return npos; // Not found.
+    }
+    else if (value == RESERVED)
+    {
+      // Another thread is inserting an element at this position, which might be equal to key.
+      std::this_thread::yield();
+    }
+    else
+    {
+      if (m_equals(get_key(value), key))
+      {
+        return value;
+      }
+      position = (position + 1) & t->mask;
+    }
+  }
+}
+
+template <class Key, typename Hash, typename Equals, typename Allocator>
+const Key& concurrent_indexed_set<Key, Hash, Equals, Allocator>::at(size_type index) const
+{
+  if (index >= size())
+  {
+    throw std::out_of_range("concurrent_indexed_set: index too large: " + std::to_string(index) + " > " + std::to_string(size()) + ".");
+  }
+
+  return wait_for_key(index);
+}
+
+template <class Key, typename Hash, typename Equals, typename Allocator>
+inline const Key& concurrent_indexed_set<Key, Hash, Equals, Allocator>::operator[](size_type index) const
+{
+  assert(index < size());
+  return get_key(index);
+}
+
+template <class Key, typename Hash, typename Equals, typename Allocator>
+std::pair<std::size_t, bool> concurrent_indexed_set<Key, Hash, Equals, Allocator>::insert(const Key& key)
+{
+  while (true)
+  {
+    table* t = m_table.load(std::memory_order_acquire);
+    std::size_t position = start_position(*t, key);
+
+    while (true)
+    {
+      std::atomic<std::size_t>& bucket = t->buckets[position];
+      std::size_t value = bucket.load(std::memory_order_acquire);
+
+      if (value == RESERVED)
+      {
+        // Another thread is inserting an element at this position, which might be equal to key.
+        std::this_thread::yield();
+        continue;
+      }
+
+      if (value != EMPTY)
+      {
+        if (m_equals(get_key(value), key))
+        {
+          return std::make_pair(value, false);
+        }
+        position = (position + 1) & t->mask;
+        continue;
+      }
+
+      // The key does not occur in this table, the table can hold at most three quarters of its capacity (plus the
+      // number of threads) such that it never becomes full while it is being replaced.
+      if (size() >= (t->capacity() / 4) * 3)
+      {
+        wait_for_table(t);
+        break;
+      }
+
+      if (!bucket.compare_exchange_strong(value, RESERVED))
+      {
+        // Another thread has taken this position, so check it again.
+        continue;
+      }
+
+      // Obtain the next index, unless the elements of this table are being moved to a new table.
+      std::size_t counter = m_counter.load();
+      do
+      {
+        if ((counter >> generation_shift) != t->generation)
+        {
+          break;
+        }
+      }
+      while (!m_counter.compare_exchange_weak(counter, counter + 1));
+
+      if ((counter >> generation_shift) != t->generation)
+      {
+        bucket.store(EMPTY, std::memory_order_release);
+        wait_for_table(t);
+        break;
+      }
+
+      const std::size_t index = counter & count_mask;
+      construct_key(index, key);
+      bucket.store(index, std::memory_order_release);
+
+      if (index + 1 >= t->capacity() / 2 && !m_resizing.load())
+      {
+        resize_table();
+      }
+      return std::make_pair(index, true);
+    }
+  }
+}
+
+template <class Key, typename Hash, typename Equals, typename Allocator>
+void concurrent_indexed_set<Key, Hash, Equals, Allocator>::clear()
+{
+  const std::size_t n = size();
+  for (std::size_t index = 0; index < n; ++index)
+  {
+    std::size_t offset;
+    block* b = m_blocks[detail::concurrent_indexed_set_block(index, first_block_size, offset)].load();
+    std::allocator_traits<Allocator>::destroy(m_allocator, b->keys + offset);
+    b->ready[offset].store(false);
+  }
+
+  table* t = m_table.load();
+  m_counter.store(t->generation << generation_shift);
+  for (std::size_t i = 0; i < t->capacity(); ++i)
+  {
+    t->buckets[i].store(EMPTY, std::memory_order_relaxed);
+  }
+  m_retired_tables.clear();
+}
+
+} // namespace utilities
+} // namespace mcrl2
+
+#endif // MCRL2_UTILITIES_DETAIL_CONCURRENT_INDEXED_SET_H
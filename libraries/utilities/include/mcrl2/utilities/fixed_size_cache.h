@@ -45,6 +45,9 @@ public:
     }
   }
 
+  iterator begin() { return m_map.begin(); }
+  iterator end() { return m_map.end(); }
+
   const_iterator begin() const { return m_map.begin(); }
   const_iterator end() const { return m_map.end(); }
 
@@ -52,20 +55,29 @@ public:
 
   std::size_t count(const key_type& key) const { return m_map.count(key); }
 
+  std::size_t size() const { return m_map.size(); }
+
+  /// \brief Returns an iterator to the element with the given key, or end() if it is not cached. A found
+  ///        element counts as a use for the replacement policy.
   iterator find(const key_type& key)
   {
-    return m_map.find(key);
+    auto result = m_map.find(key);
+    if (result != m_map.end())
+    {
+      m_policy.touch(key);
+    }
+    return result;
   }
 
   /// \brief Stores the given key-value pair in the cache. Depending on the cache policy and capacity an existing element
   ///        might be removed.
   template<typename ...Args>
-  std::pair<iterator, bool> emplace(Args&&... args)
+  std::pair<iterator, bool> emplace(const key_type& key, Args&&... args)
   {
     // The reason to split the find and emplace is that when we insert an element the replacement_candidate should not be
     // the key that we just inserted. The other way around, when an element that we are looking for was first removed and
     // then searched for also leads to unnecessary inserts.
-    auto result = find(args...);
+    auto result = find(key);
     if (result == m_map.end())
     {
       // If the cache would be full after an inserted.
@@ -76,7 +88,7 @@ public:
       }
 
       // Insert an element and inform the policy that an element was inserted.
-      auto emplace_result = m_map.emplace(std::forward<Args>(args)...);
+      auto emplace_result = m_map.try_emplace(key, std::forward<Args>(args)...);
       m_policy.inserted((*emplace_result.first).first);
       return emplace_result;
     }
@@ -148,6 +160,12 @@ private:
 template<typename Key, typename T>
 using fifo_cache = fixed_size_cache<fifo_policy<mcrl2::utilities::unordered_map<Key, T>>>;
 
+template<typename Key, typename T>
+using lru_cache = fixed_size_cache<lru_policy<mcrl2::utilities::unordered_map<Key, T>>>;
+
+template<typename Key, typename T>
+using clock_cache = fixed_size_cache<clock_policy<mcrl2::utilities::unordered_map<Key, T>>>;
+
 template<typename F, typename Args>
 using fifo_function_cache = function_cache<
   fifo_policy<mcrl2::utilities::unordered_map<Args, decltype(std::declval<F>()(std::declval<Args>()))>>,
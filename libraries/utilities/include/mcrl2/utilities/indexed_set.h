@@ -154,8 +154,9 @@ public:
   void clear();
 
   /// \brief Insert a key in the indexed set and return its index. 
-  /// \details If the element was already in the set, the resulting bool is true, and the existing index is returned.
-  ///         Otherwise, the key is inserted in the set, and the next available index is assigned to it. 
+  /// \details If the element was already in the set, the resulting bool is false, and the existing index is returned.
+  ///         Otherwise, the key is inserted in the set, and the next available index is assigned to it. The hash
+  ///         table is probed only once, so there is no need to call index() before inserting a key. 
   /// \param  key The key to be inserted in the set.
   /// \return The index of the key and a boolean indicating whether the element was actually inserted. 
   std::pair<size_type, bool> insert(const key_type& key);
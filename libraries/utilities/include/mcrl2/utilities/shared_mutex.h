@@ -0,0 +1,143 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MCRL2_UTILITIES_SHARED_MUTEX_H_
+#define MCRL2_UTILITIES_SHARED_MUTEX_H_
+
+#include "mcrl2/utilities/noncopyable.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mcrl2
+{
+namespace utilities
+{
+
+class shared_mutex;
+
+/// \brief The data that is shared between all shared_mutex instances of the same group.
+struct shared_mutex_data
+{
+  /// \brief The instances that belong to this group.
+  std::vector<shared_mutex*> instances;
+
+  /// \brief Serialises exclusive sections and modifications of the instances.
+  std::mutex mutex;
+
+  /// \brief Set whenever an exclusive lock has been requested or is being held.
+  std::atomic<bool> forbidden{false};
+};
+
+/// \brief A readers-writer lock in which every thread owns its own instance.
+/// \details All instances that share the same shared_mutex_data form a group. Obtaining a
+///          shared lock only writes to a thread local flag, which makes it cheap as long as
+///          no exclusive lock is requested. An exclusive lock waits until every other
+///          thread of the group has left its shared section, as such every point where a
+///          thread releases its (outermost) shared lock acts as a safepoint. Shared locks
+///          are reentrant, but an exclusive lock may only be requested outside of a
+///          shared section.
+class shared_mutex : private noncopyable
+{
+public:
+  explicit shared_mutex(std::shared_ptr<shared_mutex_data> shared)
+    : m_shared(std::move(shared))
+  {
+    std::lock_guard<std::mutex> guard(m_shared->mutex);
+    m_shared->instances.push_back(this);
+  }
+
+  ~shared_mutex()
+  {
+    assert(m_lock_depth == 0);
+    std::lock_guard<std::mutex> guard(m_shared->mutex);
+    auto& instances = m_shared->instances;
+    instances.erase(std::find(instances.begin(), instances.end(), this));
+  }
+
+  /// \brief Acquires a shared lock, blocks whenever an exclusive lock is held by another thread.
+  void lock_shared()
+  {
+    if (m_lock_depth == 0)
+    {
+      m_busy_flag.store(true);
+      while (m_shared->forbidden.load())
+      {
+        // Leave the shared section and wait until the exclusive section has finished.
+        m_busy_flag.store(false);
+        {
+          std::lock_guard<std::mutex> guard(m_shared->mutex);
+        }
+        m_busy_flag.store(true);
+      }
+    }
+
+    ++m_lock_depth;
+  }
+
+  /// \brief Releases the shared lock.
+  void unlock_shared()
+  {
+    assert(m_lock_depth > 0);
+    --m_lock_depth;
+
+    if (m_lock_depth == 0)
+    {
+      m_busy_flag.store(false);
+    }
+  }
+
+  /// \brief Acquires an exclusive lock, blocks until all other threads have left their shared section.
+  void lock()
+  {
+    assert(m_lock_depth == 0);
+    m_shared->mutex.lock();
+    m_shared->forbidden.store(true);
+
+    for (const shared_mutex* instance : m_shared->instances)
+    {
+      while (instance != this && instance->m_busy_flag.load())
+      {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  /// \brief Releases the exclusive lock.
+  void unlock()
+  {
+    m_shared->forbidden.store(false);
+    m_shared->mutex.unlock();
+  }
+
+  /// \returns True iff this instance currently holds a shared lock.
+  bool is_shared_locked() const noexcept
+  {
+    return m_lock_depth > 0;
+  }
+
+private:
+  std::shared_ptr<shared_mutex_data> m_shared;
+
+  /// \brief Indicates that the owning thread is inside a shared section.
+  std::atomic<bool> m_busy_flag{false};
+
+  /// \brief The number of nested shared locks, only accessed by the owning thread.
+  std::size_t m_lock_depth = 0;
+};
+
+} // namespace utilities
+} // namespace mcrl2
+
+#endif // MCRL2_UTILITIES_SHARED_MUTEX_H_
@@ -111,6 +111,20 @@ class uncompiled_library : public dynamic_library
       m_filename = m_tempfiles.back();
     }
 
+    /// \brief Uses a library that has been compiled before, instead of compiling a source file.
+    /// \details The library is removed by cleanup, like the files that are produced by compile.
+    void use_compiled(const std::string& filename)
+    {
+      m_tempfiles.push_back(filename);
+      m_filename = filename;
+    }
+
+    /// \brief The file name of the library, which is empty before compile or use_compiled has been called.
+    const std::string& filename() const
+    {
+      return m_filename;
+    }
+
     void leave_files()
     {
       m_tempfiles.clear();
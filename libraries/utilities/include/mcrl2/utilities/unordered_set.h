@@ -13,6 +13,7 @@
 #include "mcrl2/utilities/logger.h"
 #include "mcrl2/utilities/detail/bucket_list.h"
 
+#include <atomic>
 #include <cmath>
 
 namespace mcrl2::utilities
@@ -39,6 +40,10 @@ class unordered_map;
 ///          Additionally, the unordered_set supports allocators that have a specialized allocate_args(args...) to vary the allocation size based
 ///          on the arguments used. This is required to store _aterm_appl classes with the function symbol arity determined at runtime.
 ///
+///          When ThreadSafe is true the element counter is atomic and emplace never resizes the set, such that different buckets can be
+///          modified concurrently. The caller is responsible for mutual exclusion per bucket and for calling rehash() whenever no other
+///          thread accesses the set.
+///
 /// \todo Does not implement std::unordered_map equal_range and swap.
 template<typename Key,
          typename Hash = std::hash<Key>,
@@ -217,9 +222,28 @@ public:
   unordered_set(const unordered_set& set);
   unordered_set& operator=(const unordered_set& set);
 
-  // Default move operators.
-  unordered_set(unordered_set&& other) = default;
-  unordered_set& operator=(unordered_set&& other) = default;
+  // Move operators, the element counter might be atomic.
+  unordered_set(unordered_set&& other) noexcept
+    : m_number_of_elements(static_cast<size_type>(other.m_number_of_elements)),
+      m_buckets_mask(other.m_buckets_mask),
+      m_buckets(std::move(other.m_buckets)),
+      m_max_load_factor(other.m_max_load_factor),
+      m_hash(std::move(other.m_hash)),
+      m_equals(std::move(other.m_equals)),
+      m_allocator(std::move(other.m_allocator))
+  {}
+
+  unordered_set& operator=(unordered_set&& other) noexcept
+  {
+    m_number_of_elements = static_cast<size_type>(other.m_number_of_elements);
+    m_buckets_mask = other.m_buckets_mask;
+    m_buckets = std::move(other.m_buckets);
+    m_max_load_factor = other.m_max_load_factor;
+    m_hash = std::move(other.m_hash);
+    m_equals = std::move(other.m_equals);
+    m_allocator = std::move(other.m_allocator);
+    return *this;
+  }
 
   ~unordered_set();
 
@@ -348,7 +372,7 @@ private:
   static constexpr bool allow_transparent = is_transparent<Hash>() && is_transparent<Equals>();
 
   /// \brief The number of elements stored in this set.
-  size_type m_number_of_elements = 0;
+  typename std::conditional<ThreadSafe, std::atomic<size_type>, size_type>::type m_number_of_elements{0};
 
   /// \brief Always equal to m_buckets.size() - 1.
   size_type m_buckets_mask;
@@ -0,0 +1,103 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/concurrent_indexed_set.h"
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/included/unit_test_framework.hpp>
+
+#include <thread>
+
+using namespace mcrl2::utilities;
+
+BOOST_AUTO_TEST_CASE(basic_test_concurrent_indexed_set)
+{
+  concurrent_indexed_set<std::string> t(100);
+
+  std::pair<std::size_t, bool> p;
+  p = t.insert("a");
+  BOOST_CHECK(t.size() == 1);
+  BOOST_CHECK(p.first == 0 && p.second);
+  p = t.insert("b");
+  BOOST_CHECK(t.size() == 2);
+  p = t.insert("a");
+  BOOST_CHECK(t.size() == 2);
+  BOOST_CHECK(p.first == 0 && !p.second);
+
+  BOOST_CHECK(t.index("a") == 0);
+  BOOST_CHECK(t.index("b") == 1);
+  BOOST_CHECK(t.index("c") == concurrent_indexed_set<std::string>::npos);
+  BOOST_CHECK(t.at(0) == "a");
+  BOOST_CHECK(t[1] == "b");
+  BOOST_CHECK_THROW(t.at(2), std::out_of_range);
+
+  t.clear();
+  BOOST_CHECK(t.empty());
+  p = t.insert("c");
+  BOOST_CHECK(p.first == 0 && p.second);
+}
+
+BOOST_AUTO_TEST_CASE(test_resize)
+{
+  concurrent_indexed_set<std::size_t> t;
+
+  const std::size_t amount = 100000;
+  for (std::size_t i = 0; i < amount; ++i)
+  {
+    BOOST_CHECK(t.insert(i * 7).first == i);
+  }
+
+  BOOST_CHECK(t.size() == amount);
+  for (std::size_t i = 0; i < amount; ++i)
+  {
+    BOOST_CHECK(t.index(i * 7) == i);
+    BOOST_CHECK(t[i] == i * 7);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_concurrent_insert)
+{
+  concurrent_indexed_set<std::size_t> t;
+
+  // All threads insert the same keys in a different order, such that they often insert the same key concurrently.
+  const std::size_t number_of_threads = 4;
+  const std::size_t amount = 100000;
+  std::vector<std::vector<std::size_t>> indices(number_of_threads, std::vector<std::size_t>(amount));
+
+  std::vector<std::thread> threads;
+  for (std::size_t id = 0; id < number_of_threads; ++id)
+  {
+    threads.emplace_back([&, id]()
+      {
+        for (std::size_t i = 0; i < amount; ++i)
+        {
+          const std::size_t key = (id % 2 == 0) ? i : amount - i - 1;
+          indices[id][key] = t.insert(key).first;
+        }
+      });
+  }
+
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  // Every key has obtained a single index, and the indices are dense.
+  BOOST_CHECK(t.size() == amount);
+  for (std::size_t key = 0; key < amount; ++key)
+  {
+    const std::size_t index = t.index(key);
+    BOOST_REQUIRE(index < amount);
+    BOOST_CHECK(t[index] == key);
+    for (std::size_t id = 0; id < number_of_threads; ++id)
+    {
+      BOOST_CHECK(indices[id][key] == index);
+    }
+  }
+}
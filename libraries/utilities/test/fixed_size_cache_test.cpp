@@ -38,3 +38,60 @@ BOOST_AUTO_TEST_CASE(test_function_cache)
   }
 
 }
+
+BOOST_AUTO_TEST_CASE(test_fifo_cache)
+{
+  fifo_cache<int, int> cache(4);
+
+  for (int i = 0; i < 100; ++i)
+  {
+    auto result = cache.emplace(i, i * i);
+    BOOST_CHECK(result.second);
+    BOOST_CHECK_EQUAL(result.first->second, i * i);
+    BOOST_CHECK(!cache.emplace(i, 0).second);
+  }
+
+  // The cache is bounded, and the last inserted element is still present.
+  BOOST_CHECK(cache.size() < 100);
+  BOOST_CHECK_EQUAL(cache.find(99)->second, 99 * 99);
+  BOOST_CHECK(cache.find(0) == cache.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_lru_cache)
+{
+  lru_cache<int, int> cache(4);
+
+  for (int i = 0; i < 100; ++i)
+  {
+    BOOST_CHECK(cache.emplace(i, i * i).second);
+
+    // Keep using the first element, which should therefore never be replaced.
+    BOOST_CHECK(cache.find(0) != cache.end());
+  }
+
+  BOOST_CHECK(cache.size() < 100);
+  BOOST_CHECK_EQUAL(cache.find(0)->second, 0);
+  BOOST_CHECK_EQUAL(cache.find(99)->second, 99 * 99);
+  BOOST_CHECK(cache.find(1) == cache.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_clock_cache)
+{
+  clock_cache<int, int> cache(4);
+
+  for (int i = 0; i < 100; ++i)
+  {
+    BOOST_CHECK(cache.emplace(i, i * i).second);
+    BOOST_CHECK(cache.find(0) != cache.end());
+  }
+
+  BOOST_CHECK(cache.size() < 100);
+  BOOST_CHECK_EQUAL(cache.find(0)->second, 0);
+  BOOST_CHECK_EQUAL(cache.find(99)->second, 99 * 99);
+  BOOST_CHECK(cache.find(1) == cache.end());
+
+  cache.clear();
+  BOOST_CHECK_EQUAL(cache.size(), 0u);
+  BOOST_CHECK(cache.emplace(1, 1).second);
+  BOOST_CHECK_EQUAL(cache.find(1)->second, 1);
+}
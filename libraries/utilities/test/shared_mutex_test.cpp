@@ -0,0 +1,81 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/shared_mutex.h"
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/included/unit_test_framework.hpp>
+
+using namespace mcrl2::utilities;
+
+BOOST_AUTO_TEST_CASE(test_reentrant_shared_lock)
+{
+  auto data = std::make_shared<shared_mutex_data>();
+  shared_mutex mutex(data);
+
+  mutex.lock_shared();
+  mutex.lock_shared();
+  BOOST_CHECK(mutex.is_shared_locked());
+  mutex.unlock_shared();
+  BOOST_CHECK(mutex.is_shared_locked());
+  mutex.unlock_shared();
+  BOOST_CHECK(!mutex.is_shared_locked());
+
+  // An exclusive lock can be obtained when no thread is in a shared section.
+  mutex.lock();
+  mutex.unlock();
+}
+
+BOOST_AUTO_TEST_CASE(test_exclusive_section)
+{
+  auto data = std::make_shared<shared_mutex_data>();
+  const std::size_t number_of_threads = 4;
+  const std::size_t iterations = 10000;
+
+  // Every thread increments the counter in its shared section, whereas the exclusive section
+  // checks that no increment happens concurrently.
+  std::atomic<std::size_t> in_shared_section(0);
+  std::atomic<bool> violated(false);
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < number_of_threads; ++i)
+  {
+    threads.emplace_back([&, i]()
+      {
+        shared_mutex mutex(data);
+        for (std::size_t j = 0; j < iterations; ++j)
+        {
+          if (i == 0 && j % 100 == 0)
+          {
+            mutex.lock();
+            if (in_shared_section != 0)
+            {
+              violated = true;
+            }
+            mutex.unlock();
+          }
+          else
+          {
+            mutex.lock_shared();
+            ++in_shared_section;
+            --in_shared_section;
+            mutex.unlock_shared();
+          }
+        }
+      });
+  }
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  BOOST_CHECK(!violated);
+  BOOST_CHECK(data->instances.empty());
+}
@@ -80,7 +80,9 @@ class lps2lts_tool : public lps2lts_base
                    "If the jittyc rewriter is used, then the MCRL2_COMPILEREWRITER environment "
                    "variable (default value: mcrl2compilerewriter) determines the script that "
                    "compiles the rewriter, and MCRL2_COMPILEDIR (default value: '.') "
-                   "determines where temporary files are stored."
+                   "determines where temporary files are stored. If MCRL2_JITTYC_CACHE is set, "
+                   "compiled rewriters are kept in that directory and reused by later runs; "
+                   "MCRL2_JITTYC_CACHE_SIZE (default value: 32) bounds their number."
                    "\n"
                    "Note that lps2lts can deliver multiple transitions with the same "
                    "label between any pair of states. If this is not desired, such "
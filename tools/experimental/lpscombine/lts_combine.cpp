@@ -74,8 +74,10 @@ void mcrl2::combine_lts(lts::lts_lts_t& left_lts,
   std::ostream& stream)
 {
   // Calculate which states can be reached in a single outgoing step for both LTSs.
-  const lts::outgoing_transitions_per_state_t left_outgoing(left_lts.get_transitions(), left_lts.num_states(), true);
-  const lts::outgoing_transitions_per_state_t right_outgoing(right_lts.get_transitions(), right_lts.num_states(), true);
+  const std::shared_ptr<const lts::indexed_transitions> left_outgoing_ptr = left_lts.outgoing_transitions();
+  const std::shared_ptr<const lts::indexed_transitions> right_outgoing_ptr = right_lts.outgoing_transitions();
+  const lts::indexed_transitions& left_outgoing = *left_outgoing_ptr;
+  const lts::indexed_transitions& right_outgoing = *right_outgoing_ptr;
 
   // The tag action indicates that an independent action.
   process::action tag(process::action_label(std::string(prefix) += "tag", {}), {});
@@ -143,7 +145,7 @@ void mcrl2::combine_lts(lts::lts_lts_t& left_lts,
     // Consider all the outgoing transitions for the left state, t is the transition tuple (left_state, label, to).
     for (state_t t = left_outgoing.lowerbound(left_state); t < left_outgoing.upperbound(left_state); ++t)
     {
-      const lts::outgoing_pair_t& left_transition = left_outgoing.get_transitions()[t];
+      const lts::label_state_pair& left_transition = left_outgoing.get_transitions()[t];
 
       // Consider the multi-action label of this transition.
       const auto& [left_sync, left_label] = left_labels[lts::label(left_transition)];
@@ -168,7 +170,7 @@ void mcrl2::combine_lts(lts::lts_lts_t& left_lts,
         // Find corresponding synchronisation in the outgoing transitions of the right state.
         for (state_t u = right_outgoing.lowerbound(right_state); u < right_outgoing.upperbound(right_state); ++u)
         {
-          const lts::outgoing_pair_t& right_transition = right_outgoing.get_transitions()[u];
+          const lts::label_state_pair& right_transition = right_outgoing.get_transitions()[u];
 
           // Consider the multi-action label of this transition.
           const auto& [right_sync, right_label] = right_labels[lts::label(right_transition)];
@@ -195,7 +197,7 @@ void mcrl2::combine_lts(lts::lts_lts_t& left_lts,
     // Find independent transitions in the right state.
     for (state_t t = right_outgoing.lowerbound(right_state); t < right_outgoing.upperbound(right_state); ++t)
     {
-      const lts::outgoing_pair_t& right_transition = right_outgoing.get_transitions()[t];
+      const lts::label_state_pair& right_transition = right_outgoing.get_transitions()[t];
 
       // Consider the multi-action label of this transition.
       const auto& [right_sync, right_label] = right_labels[lts::label(right_transition)];
@@ -10,11 +10,13 @@
 
 #include <csignal>
 #include <memory>
+#include "mcrl2/atermpp/detail/threads_option.h"
 #include "mcrl2/data/rewriter_tool.h"
 #include "mcrl2/lps/is_stochastic.h"
 #include "mcrl2/lts/lts_io.h"
 #include "mcrl2/lts/stochastic_lts_builder.h"
 #include "mcrl2/lts/state_space_generator.h"
+#include "mcrl2/lts/swarm_state_space_generator.h"
 #include "mcrl2/utilities/input_output_tool.h"
 
 using namespace mcrl2;
@@ -51,6 +53,9 @@ class generatelts_tool: public rewriter_tool<input_output_tool>
       desc.add_option("no-probability-checking", "do not check if probabilities in stochastic specifications have sensible values");
       desc.add_hidden_option("dfs-recursive", "use recursive depth first search for divergence detection");
       desc.add_option("cached", "use enumeration caching techniques to speed up state space generation. ");
+      desc.add_option("cache-size", utilities::make_mandatory_argument("NUM"),
+                 "store at most NUM entries in the enumeration cache of option --cached, where entries that were not used "
+                 "recently are replaced first. The value 0 means that the cache is unbounded (default: 1048576). ");
       desc.add_option("todo-max", utilities::make_mandatory_argument("NUM"),
                  "keep at most NUM states in the todo list; this option is only relevant for "
                  "highway search, where NUM is the maximum number of states per level. ");
@@ -103,10 +108,28 @@ class generatelts_tool: public rewriter_tool<input_output_tool>
                    .add_value_short(lps::es_highway, "h")
         , "explore the state space using strategy NAME:"
         , 's');
+      desc.add_option("todo-disk", utilities::make_mandatory_argument("NUM"),
+                 "when the todo list of breadth-first search contains more than NUM states, store newly found states "
+                 "in temporary files on disk. This option requires --tree-compression.");
+      desc.add_option("bitstate", utilities::make_mandatory_argument("NUM"),
+                 "use bitstate hashing with a table of NUM megabytes to store the discovered states. Only a few bits are "
+                 "stored for each state, hence states may wrongly be considered to be visited and the state space may be "
+                 "explored partially. This is meant to detect deadlocks and actions in very large state spaces, and "
+                 "cannot be used to generate an LTS or traces.");
+      desc.add_option("swarm", utilities::make_mandatory_argument("NUM"),
+                 "perform NUM independent explorations with bitstate hashing, each with different hash functions and a "
+                 "different order of the summands, and report the estimated coverage. With --threads the explorations "
+                 "are performed in parallel. If --bitstate is not set, each exploration uses 64 megabytes.");
+      atermpp::detail::add_threads_option(desc, "explore the state space using NUM threads. The option is ignored for "
+                 "stochastic specifications and highway search.");
       desc.add_option("suppress","in verbose mode, do not print progress messages indicating the number of visited states and transitions.");
       desc.add_option("save-at-end", "delay saving of the generated LTS until the end. "
                  "This option only applies to .aut and .lts files, which are by default saved on the fly.");
       desc.add_option("no-info", "do not add state label information to OUTFILE. This option only applies to .lts files.");
+      desc.add_option("tree-compression", "store the discovered states using tree compression. This reduces the memory "
+                 "needed for specifications with many process parameters, but makes the exploration slower. With the "
+                 "breadth-first strategy the todo list then does not keep the states in memory either. The states are "
+                 "still kept in memory as the state labels of an .lts file, unless --no-info is used.");
     }
 
     static std::list<std::string> split_actions(const std::string& s)
@@ -211,8 +234,18 @@ class generatelts_tool: public rewriter_tool<input_output_tool>
       options.suppress_progress_messages            = parser.has_option("suppress");
       options.dfs_recursive                         = parser.has_option("dfs-recursive");
       options.discard_lts_state_labels              = parser.has_option("no-info");
+      options.tree_compression                      = parser.has_option("tree-compression");
       options.search_strategy = parser.option_argument_as<lps::exploration_strategy>("strategy");
 
+      if (parser.has_option("cache-size"))
+      {
+        options.cache_size = parser.option_argument_as<std::size_t>("cache-size");
+        if (!options.cached)
+        {
+          parser.error("Option 'cache-size' can only be used in combination with option 'cached'");
+        }
+      }
+
       // highway search
       if (parser.has_option("todo-max"))
       {
@@ -227,6 +260,26 @@ class generatelts_tool: public rewriter_tool<input_output_tool>
         parser.error("Option 'todo-max' can only be used in combination with highway search");
       }
 
+      options.number_of_threads = atermpp::detail::parse_threads_option(parser);
+
+      if (parser.has_option("todo-disk"))
+      {
+        options.todo_disk_threshold = parser.option_argument_as<std::size_t>("todo-disk");
+        if (options.search_strategy != lps::es_breadth)
+        {
+          parser.error("Option 'todo-disk' can only be used in combination with breadth-first search");
+        }
+        if (options.number_of_threads > 1)
+        {
+          parser.error("Option 'todo-disk' cannot be combined with option 'threads'");
+        }
+        if (!options.tree_compression)
+        {
+          parser.error("Option 'todo-disk' requires option 'tree-compression', since otherwise the discovered states "
+                       "that are kept in memory dominate the memory usage.");
+        }
+      }
+
       if (parser.has_option("out"))
       {
         output_format = lts::detail::parse_format(parser.option_argument("out"));
@@ -246,6 +299,38 @@ class generatelts_tool: public rewriter_tool<input_output_tool>
         }
       }
 
+      if (parser.has_option("bitstate"))
+      {
+        options.bitstate_size = parser.option_argument_as<std::size_t>("bitstate") * 8 * 1024 * 1024;
+        if (options.bitstate_size == 0)
+        {
+          parser.error("The size of the bitstate hash table must be positive.");
+        }
+      }
+      if (parser.has_option("swarm"))
+      {
+        options.swarm_size = parser.option_argument_as<std::size_t>("swarm");
+        if (options.swarm_size == 0)
+        {
+          parser.error("The number of swarm runs must be positive.");
+        }
+        if (options.bitstate_size == 0)
+        {
+          options.bitstate_size = 64 * 8 * 1024 * 1024;
+        }
+      }
+      if (options.bitstate_size > 0)
+      {
+        if (output_format != lts::lts_none)
+        {
+          parser.error("Options 'bitstate' and 'swarm' cannot be used when an LTS is generated.");
+        }
+        if (options.tree_compression || options.todo_disk_threshold != std::numeric_limits<std::size_t>::max())
+        {
+          parser.error("Options 'bitstate' and 'swarm' cannot be combined with the options 'tree-compression' and 'todo-disk'.");
+        }
+      }
+
       if (parser.has_option("action"))
       {
         options.detect_action = true;
@@ -265,6 +350,11 @@ class generatelts_tool: public rewriter_tool<input_output_tool>
       {
         options.generate_traces = true;
         options.max_traces = parser.option_argument_as<std::size_t>("trace");
+        if (options.bitstate_size > 0)
+        {
+          parser.error("Option 'trace' cannot be combined with the options 'bitstate' and 'swarm', since constructing "
+                       "traces requires that all visited states are stored.");
+        }
       }
 
       if (parser.options.count("max"))
@@ -311,6 +401,13 @@ class generatelts_tool: public rewriter_tool<input_output_tool>
     template <bool Stochastic, bool Timed, typename Specification, typename LTSBuilder>
     void generate_state_space(const Specification& lpsspec, LTSBuilder& builder)
     {
+      if (options.swarm_size > 0)
+      {
+        lts::swarm_state_space_generator<Stochastic, Timed, Specification> generator(lpsspec, options);
+        current_explorer = &generator;
+        generator.explore();
+        return;
+      }
       lts::state_space_generator<Stochastic, Timed, Specification> generator(lpsspec, options);
       current_explorer = &generator.explorer;
       generator.explore(builder);
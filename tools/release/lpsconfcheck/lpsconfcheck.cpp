@@ -14,6 +14,7 @@
 #include "mcrl2/utilities/input_output_tool.h"
 #include "mcrl2/data/rewriter_tool.h"
 #include "mcrl2/data/prover_tool.h"
+#include "mcrl2/atermpp/detail/threads_option.h"
 
 using namespace mcrl2;
 using namespace mcrl2::core;
@@ -86,6 +87,9 @@ class lpsconfcheck_tool : public prover_tool< rewriter_tool<input_output_tool> >
     /// \brief The flag indicating whether or not induction should be applied.
     bool m_apply_induction;
 
+    /// \brief The number of threads that prove confluence conditions.
+    std::size_t m_number_of_threads;
+
     /// \brief The invariant provided as input.
     /// \brief If no invariant was provided, the constant true is used as invariant.
     data_expression m_invariant;
@@ -133,6 +137,8 @@ class lpsconfcheck_tool : public prover_tool< rewriter_tool<input_output_tool> >
         m_path_eliminator = true;
       }
 
+      m_number_of_threads = atermpp::detail::parse_threads_option(parser);
+
       if (parser.options.count("conditions"))
       {
         m_conditions = parser.option_argument_as< std::string >("conditions");
@@ -180,6 +186,9 @@ class lpsconfcheck_tool : public prover_tool< rewriter_tool<input_output_tool> >
       add_option("time-limit", make_mandatory_argument("LIMIT"),
                  "spend at most LIMIT seconds on proving a single formula", 't').
       add_option("induction", "apply induction on lists", 'o');
+      atermpp::detail::add_threads_option(desc,
+                 "prove the confluence conditions of a tau-summand using NUM threads, each with its own "
+                 "prover; the output and the resulting LPS do not depend on the number of threads.");
     }
 
   public:
@@ -202,6 +211,7 @@ class lpsconfcheck_tool : public prover_tool< rewriter_tool<input_output_tool> >
       m_time_limit(0),
       m_path_eliminator(false),
       m_apply_induction(false),
+      m_number_of_threads(1),
       m_invariant(mcrl2::data::sort_bool::true_())
     {}
 
@@ -238,7 +248,7 @@ class lpsconfcheck_tool : public prover_tool< rewriter_tool<input_output_tool> >
           spec, rewrite_strategy(),
           m_time_limit, m_path_eliminator, solver_type(),
           m_apply_induction, m_check_all, m_no_sums, m_conditions,
-          m_counter_example, m_generate_invariants, m_dot_file_name);
+          m_counter_example, m_generate_invariants, m_dot_file_name, m_number_of_threads);
 
         v_confluence_checker.check_confluence_and_mark(m_invariant, m_summand_number);
         save_lps(spec, output_filename());
@@ -12,7 +12,10 @@
 #define AUTHOR "Muck van Weerdenburg"
 
 #include "mcrl2/utilities/input_tool.h"
+#include "mcrl2/atermpp/detail/threads_option.h"
 
+#include "mcrl2/lps/io.h"
+#include "mcrl2/lts/detail/liblts_on_the_fly_refinement.h"
 #include "mcrl2/lts/lts_algorithm.h"
 #include "mcrl2/lts/lts_io.h"
 
@@ -36,6 +39,8 @@ struct t_tool_options
   bool generate_counter_examples = false;
   bool structured_output = false;
   bool enable_preprocessing      = true;
+  bool on_the_fly = false;
+  std::size_t number_of_threads = 1;
 };
 
 typedef  input_tool ltscompare_base;
@@ -100,7 +105,8 @@ class ltscompare_tool : public ltscompare_base
         mCRL2log(verbose) << "comparing LTSs using " <<
                      tool_options.equivalence << "..." << std::endl;
 
-        result = destructive_compare(l1, l2, tool_options.equivalence, tool_options.generate_counter_examples, tool_options.structured_output);
+        result = destructive_compare(l1, l2, tool_options.equivalence, tool_options.generate_counter_examples, tool_options.structured_output,
+                                     tool_options.number_of_threads);
 
         mCRL2log(info) << "LTSs are " << ((result) ? "" : "not ")
                        << "equal ("
@@ -113,7 +119,8 @@ class ltscompare_tool : public ltscompare_base
                      description(tool_options.preorder) << "..."
                      " using the " << print_exploration_strategy(tool_options.strategy) << " strategy.\n";
 
-        result = destructive_compare(l1, l2, tool_options.preorder, tool_options.generate_counter_examples, tool_options.structured_output, tool_options.strategy, tool_options.enable_preprocessing);
+        result = destructive_compare(l1, l2, tool_options.preorder, tool_options.generate_counter_examples, tool_options.structured_output, tool_options.strategy, tool_options.enable_preprocessing,
+                                     tool_options.number_of_threads);
 
         if (!tool_options.structured_output)
         {
@@ -130,11 +137,61 @@ class ltscompare_tool : public ltscompare_base
       return true; // The tool terminates in a correct way.
     }
 
+    // Compare two linear process specifications, of which only the states needed for the comparison are generated.
+    bool lps_compare()
+    {
+      mcrl2::lps::specification spec1, spec2;
+      mcrl2::lps::load_lps(spec1, tool_options.name_for_first);
+      mcrl2::lps::load_lps(spec2, tool_options.name_for_second);
+
+      bool result = true;
+      if (tool_options.equivalence != lts_eq_none)
+      {
+        mCRL2log(verbose) << "comparing LPSs on-the-fly using " <<
+                     tool_options.equivalence << "..." << std::endl;
+
+        result = on_the_fly_compare(spec1, spec2, tool_options.equivalence, tool_options.generate_counter_examples, tool_options.structured_output,
+                                    tool_options.strategy, mcrl2::lps::explorer_options(), tool_options.tau_actions);
+
+        mCRL2log(info) << "LPSs are " << ((result) ? "" : "not ")
+                       << "equal ("
+                       << description(tool_options.equivalence) << ")\n";
+      }
+
+      if (tool_options.preorder != lts_pre_none)
+      {
+        mCRL2log(verbose) << "comparing LPSs on-the-fly for " <<
+                     description(tool_options.preorder) << "..."
+                     " using the " << print_exploration_strategy(tool_options.strategy) << " strategy.\n";
+
+        result = on_the_fly_compare(spec1, spec2, tool_options.preorder, tool_options.generate_counter_examples, tool_options.structured_output,
+                                    tool_options.strategy, mcrl2::lps::explorer_options(), tool_options.tau_actions);
+
+        if (!tool_options.structured_output)
+        {
+          mCRL2log(info) << "The state space of " << tool_options.name_for_first
+                         << " is " << ((result) ? "" : "not ")
+                         << "included in"
+                         << " the state space of " << tool_options.name_for_second
+                         << " (using " << description(tool_options.preorder)
+                         << ")." << std::endl;
+        }
+      }
+
+      std::cout << (tool_options.structured_output ? "result: " : "") << std::boolalpha << result << std::endl;
+      return true;
+    }
+
   public:
     bool run() override
     {
       check_preconditions();
 
+      if (tool_options.on_the_fly)
+      {
+        return lps_compare();
+      }
+
       if (tool_options.format_for_first==lts_none)
       {
         tool_options.format_for_first = guess_format(tool_options.name_for_first);
@@ -224,6 +281,7 @@ class ltscompare_tool : public ltscompare_base
                  .add_value(lts_eq_weak_bisim)
                  .add_value(lts_eq_divergence_preserving_weak_bisim)
                  .add_value(lts_eq_sim)
+                 .add_value(lts_eq_sim_par)
                  .add_value(lts_eq_ready_sim)
                  .add_value(lts_eq_trace)
                  .add_value(lts_eq_weak_trace),
@@ -231,6 +289,7 @@ class ltscompare_tool : public ltscompare_base
       add_option("preorder", make_enum_argument<lts_preorder>("NAME")
                  .add_value(lts_pre_none, true)
                  .add_value(lts_pre_sim)
+                 .add_value(lts_pre_sim_par)
                  .add_value(lts_pre_ready_sim)
                  .add_value(lts_pre_trace)
                  .add_value(lts_pre_weak_trace)
@@ -251,6 +310,13 @@ class ltscompare_tool : public ltscompare_base
                  "the input").
       add_option("counter-example",
                  "generate counter example traces if the input lts's are not equivalent",'c');
+      desc.add_option("on-the-fly",
+                 "INFILE1 and INFILE2 are linear process specifications, of which the state spaces are only generated "
+                 "as far as needed for the comparison, which stops at the first counterexample. "
+                 "This is only supported for the antichain based preorders and for (weak) trace equivalence");
+      atermpp::detail::add_threads_option(desc,
+                 "use NUM threads for the comparison. This only affects the parallel simulation "
+                 "algorithms (sim-par).", false);
       desc.add_hidden_option("structured-output",
                  "generate counter examples on stdout");
       desc.add_hidden_option("no-preprocessing",
@@ -266,7 +332,7 @@ class ltscompare_tool : public ltscompare_base
 
       if (parser.has_option("counter-example") && parser.has_option("preorder"))
       {
-        if (tool_options.preorder == lts_pre_sim)
+        if (tool_options.preorder == lts_pre_sim || tool_options.preorder == lts_pre_sim_par)
         {
           parser.error("counter examples cannot be used with simulation pre-order");
         }
@@ -296,6 +362,27 @@ class ltscompare_tool : public ltscompare_base
 
       tool_options.generate_counter_examples = parser.has_option("counter-example");
       tool_options.structured_output = parser.has_option("structured-output");
+      tool_options.on_the_fly = parser.has_option("on-the-fly");
+      tool_options.number_of_threads = atermpp::detail::parse_threads_option(parser, false);
+
+      if (tool_options.on_the_fly
+          && tool_options.preorder != lts_pre_none
+          && tool_options.preorder != lts_pre_trace_anti_chain
+          && tool_options.preorder != lts_pre_weak_trace_anti_chain
+          && tool_options.preorder != lts_pre_failures_refinement
+          && tool_options.preorder != lts_pre_weak_failures_refinement
+          && tool_options.preorder != lts_pre_failures_divergence_refinement)
+      {
+        parser.error("option --on-the-fly can only be used with antichain based preorders.");
+      }
+
+      if (tool_options.on_the_fly
+          && tool_options.equivalence != lts_eq_none
+          && tool_options.equivalence != lts_eq_trace
+          && tool_options.equivalence != lts_eq_weak_trace)
+      {
+        parser.error("option --on-the-fly can only be used with the equivalences trace and weak-trace.");
+      }
 
       if (parser.arguments.size() == 1)
       {
@@ -316,7 +403,8 @@ class ltscompare_tool : public ltscompare_base
           mCRL2log(mcrl2::log::warning) << "Generated counter example might not be the shortest with the " << print_exploration_strategy(tool_options.strategy) << " strategy.\n";
         }
 
-        if (tool_options.preorder != lts_pre_trace_anti_chain
+        if (!tool_options.on_the_fly
+            && tool_options.preorder != lts_pre_trace_anti_chain
             && tool_options.preorder != lts_pre_weak_trace_anti_chain
             && tool_options.preorder != lts_pre_failures_refinement
             && tool_options.preorder != lts_pre_weak_failures_refinement
@@ -12,8 +12,11 @@
 #define AUTHOR "Muck van Weerdenburg, Jan Friso Groote"
 
 #include "mcrl2/utilities/input_output_tool.h"
+#include "mcrl2/atermpp/detail/threads_option.h"
 #include "mcrl2/lts/lts_io.h"
 #include "mcrl2/lts/lts_algorithm.h"
+#include "mcrl2/lts/lts_mapped.h"
+#include "mcrl2/lts/lts_stream.h"
 
 using namespace mcrl2::lts;
 using namespace mcrl2::lts::detail;
@@ -35,6 +38,7 @@ class t_tool_options
     bool            remove_state_information;
     bool            determinise;
     bool            check_reach;
+    std::size_t     number_of_threads;
 
     inline t_tool_options() 
      : intype(lts_none), 
@@ -42,7 +46,8 @@ class t_tool_options
        equivalence(lts_eq_none),
        remove_state_information(false), 
        determinise(false), 
-       check_reach(true)
+       check_reach(true),
+       number_of_threads(1)
     {
     }
 
@@ -115,12 +120,61 @@ class ltsconvert_tool : public input_output_tool
 
   private:
 
+    // Returns true if the lts can be converted while it is read, without storing it in memory.
+    // This is possible if it is not reduced, and is written in aut or mCRL2 format.
+    bool can_convert_while_reading() const
+    {
+      if (tool_options.equivalence != lts_eq_none || tool_options.determinise || tool_options.check_reach)
+      {
+        return false;
+      }
+      switch (tool_options.outtype)
+      {
+        case lts_aut: return !tool_options.outfilename.empty();
+        case lts_lts: return !has_mapped_lts_extension(tool_options.outfilename);
+        default: return false;
+      }
+    }
+
+    template < class LTS_IN_TYPE, class LTS_OUT_TYPE, class WRITER >
+    bool stream_convert_and_save()
+    {
+      mcrl2::lps::specification spec;
+      if (!tool_options.lpsfile.empty())
+      {
+        load_lps(spec, tool_options.lpsfile);
+      }
+
+      mCRL2log(verbose) << "converting the LTS while it is read..." << std::endl;
+      WRITER writer(tool_options.outfilename);
+      lts_stream_convertor<LTS_IN_TYPE, LTS_OUT_TYPE> convertor(writer, spec.data(), spec.action_labels(),
+                       spec.process().process_parameters(), !tool_options.lpsfile.empty());
+      lts_stream_filter<LTS_IN_TYPE> filter(convertor, tool_options.tau_actions, tool_options.remove_state_information);
+      read_lts_stream(tool_options.infilename, filter);
+      return true;
+    }
+
+    template < class LTS_TYPE >
+    bool stream_convert_and_save()
+    {
+      if (tool_options.outtype == lts_aut)
+      {
+        return stream_convert_and_save<LTS_TYPE, lts_aut_t, aut_stream_writer>();
+      }
+      return stream_convert_and_save<LTS_TYPE, lts_lts_t, lts_lts_stream_writer>();
+    }
+
     template < class LTS_TYPE >
     bool load_convert_and_save()
     {
       using namespace mcrl2::lts;
       using namespace mcrl2::lts::detail;
 
+      if (can_convert_while_reading())
+      {
+        return stream_convert_and_save<LTS_TYPE>();
+      }
+
       LTS_TYPE l;
       l.load(tool_options.infilename);
       l.record_hidden_actions(tool_options.tau_actions);
@@ -143,7 +197,7 @@ class ltsconvert_tool : public input_output_tool
         mCRL2log(verbose) << "reducing LTS (modulo " <<  description(tool_options.equivalence) << ")..." << std::endl;
         mCRL2log(verbose) << "before reduction: " << l.num_states() << " states and " << l.num_transitions() << " transitions " << std::endl;
         timer().start("reduction");
-        reduce(l,tool_options.equivalence);
+        reduce(l,tool_options.equivalence,tool_options.number_of_threads);
         timer().finish("reduction");
         mCRL2log(verbose) << "after reduction: " << l.num_states() << " states and " << l.num_transitions() << " transitions" << std::endl;
       }
@@ -242,7 +296,9 @@ class ltsconvert_tool : public input_output_tool
       input_output_tool::add_options(desc);
 
       desc.add_option("no-reach",
-                      "do not perform a reachability check on the input LTS.");
+                      "do not perform a reachability check on the input LTS. If the LTS is not "
+                      "reduced or determinised, and is written in aut or mCRL2 format, it is then "
+                      "converted while it is read, without storing it in memory.");
       desc.add_option("no-state",
                       "remove the state information. This can be useful when state labels are huge.", 'n');
       desc.add_option("determinise", "determinise LTS", 'D');
@@ -260,17 +316,21 @@ class ltsconvert_tool : public input_output_tool
                       .add_value(lts_eq_bisim_gv)
                       .add_value(lts_eq_bisim_gjkw)
                       .add_value(lts_eq_bisim_sigref)
+                      .add_value(lts_eq_bisim_par)
                       .add_value(lts_eq_branching_bisim)
                       .add_value(lts_eq_branching_bisim_gv)
                       .add_value(lts_eq_branching_bisim_gjkw)
                       .add_value(lts_eq_branching_bisim_sigref)
+                      .add_value(lts_eq_branching_bisim_par)
                       .add_value(lts_eq_divergence_preserving_branching_bisim)
                       .add_value(lts_eq_divergence_preserving_branching_bisim_gv)
                       .add_value(lts_eq_divergence_preserving_branching_bisim_gjkw)
                       .add_value(lts_eq_divergence_preserving_branching_bisim_sigref)
+                      .add_value(lts_eq_divergence_preserving_branching_bisim_par)
                       .add_value(lts_eq_weak_bisim)
                       .add_value(lts_eq_divergence_preserving_weak_bisim)
                       .add_value(lts_eq_sim)
+                      .add_value(lts_eq_sim_par)
                       .add_value(lts_eq_ready_sim)		      
                       .add_value(lts_eq_trace)
                       .add_value(lts_eq_weak_trace)
@@ -281,6 +341,10 @@ class ltsconvert_tool : public input_output_tool
                       "consider actions with a name in the comma separated list ACTNAMES to "
                       "be internal (tau) actions in addition to those defined as such by "
                       "the input.");
+      atermpp::detail::add_threads_option(desc,
+                      "use NUM threads for the reduction. This only affects the signature "
+                      "refinement algorithms (the equivalences ending in -sig) and the parallel "
+                      "partition refinement algorithms (the equivalences ending in -par).", false);
     }
 
     void set_tau_actions(std::vector <std::string>& tau_actions, std::string const& act_names)
@@ -349,6 +413,8 @@ class ltsconvert_tool : public input_output_tool
       tool_options.check_reach                       = parser.options.count("no-reach") == 0;
       tool_options.remove_state_information          = parser.options.count("no-state") != 0;
 
+      tool_options.number_of_threads = atermpp::detail::parse_threads_option(parser, false);
+
       if (tool_options.determinise && (tool_options.equivalence != lts_eq_none))
       {
         parser.error("cannot use option -D/--determinise together with LTS reduction options\n");
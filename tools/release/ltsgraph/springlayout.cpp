@@ -12,6 +12,7 @@
 
 #include <QThread>
 #include <cstdlib>
+#include <thread>
 
 namespace Graph
 {
@@ -41,7 +42,8 @@ inline void clip(float& f, float min, float max)
 
 SpringLayout::SpringLayout(Graph& graph, GLWidget& glwidget)
   : m_speed(0.001f), m_attraction(0.13f), m_repulsion(50.0f), m_natLength(50.0f), m_controlPointWeight(0.001f),
-    m_graph(graph), m_ui(nullptr), m_forceCalculation(&SpringLayout::forceLTSGraph), m_glwidget(glwidget)
+    m_graph(graph), m_ui(nullptr), m_forceCalculation(&SpringLayout::forceLTSGraph), m_repulsionCalculation(exact),
+    m_glwidget(glwidget)
 {
   srand(time(nullptr));
 }
@@ -80,6 +82,16 @@ SpringLayout::ForceCalculation SpringLayout::forceCalculation()
   return linearsprings;
 }
 
+void SpringLayout::setRepulsionCalculation(RepulsionCalculation c)
+{
+  m_repulsionCalculation = c;
+}
+
+SpringLayout::RepulsionCalculation SpringLayout::repulsionCalculation() const
+{
+  return m_repulsionCalculation;
+}
+
 QVector3D SpringLayout::forceLTSGraph(const QVector3D& a, const QVector3D& b, float ideal)
 {
   QVector3D diff = (a - b);
@@ -102,15 +114,201 @@ QVector3D SpringLayout::forceLinearSprings(const QVector3D& a, const QVector3D&
 }
 
 inline
-QVector3D repulsionForce(const QVector3D& a, const QVector3D& b, float repulsion, float natlength)
+QVector3D noise()
+{
+  return QVector3D(fast_frand(-0.01f, 0.01f), fast_frand(-0.01f, 0.01f), fast_frand(-0.01f, 0.01f));
+}
+
+inline
+QVector3D noiselessRepulsionForce(const QVector3D& a, const QVector3D& b, float repulsion, float natlength)
 {
   QVector3D diff = a - b;
   float r = repulsion;
   r /= cube((std::max)(diff.length() / 2.0f, natlength / 10));
-  diff = diff * r + QVector3D(fast_frand(-0.01f, 0.01f), fast_frand(-0.01f, 0.01f), fast_frand(-0.01f, 0.01f));
-  return diff;
+  return diff * r;
 }
 
+inline
+QVector3D repulsionForce(const QVector3D& a, const QVector3D& b, float repulsion, float natlength)
+{
+  return noiselessRepulsionForce(a, b, repulsion, natlength) + noise();
+}
+
+/// \brief Calls f(first, last) for consecutive ranges that together form [0, n), using a thread per core.
+template <typename Function>
+void parallelFor(std::size_t n, Function f)
+{
+  const std::size_t threads = n < 1024 ? 1 : (std::max)(1, QThread::idealThreadCount());
+  const std::size_t chunk = (n + threads - 1) / threads;
+  std::vector<std::thread> workers;
+  for (std::size_t first = chunk; first < n; first += chunk)
+  {
+    workers.emplace_back(f, first, (std::min)(n, first + chunk));
+  }
+  f(0, (std::min)(n, chunk));
+  for (std::thread& worker : workers)
+  {
+    worker.join();
+  }
+}
+
+//
+// Barnes-Hut approximation
+//
+
+/// \brief An octree over a set of points, which approximates the repulsion that the points exert on a position by
+///        treating the points of a cell that is far away from that position as a single point [Barnes/Hut 1986].
+class RepulsionOctree
+{
+  private:
+    struct Point
+    {
+      QVector3D pos;
+      std::size_t index;          ///< The index of the point in the input.
+    };
+
+    struct Cell
+    {
+      QVector3D centerOfMass;
+      float mass;                 ///< The number of points in the cell.
+      float size;                 ///< The width of the cell.
+      std::size_t begin, end;     ///< The points in the cell are m_points[begin], ..., m_points[end - 1].
+      std::size_t firstChild;     ///< The children are m_cells[firstChild], ..., m_cells[firstChild + childCount - 1].
+      std::size_t childCount;
+    };
+
+    static constexpr std::size_t leafSize = 8;
+    static constexpr std::size_t maxDepth = 24;
+    static constexpr float theta = 0.5f;  ///< Cells smaller than theta times their distance are approximated.
+
+    std::vector<Point> m_points;
+    std::vector<Cell> m_cells;
+
+    /// \brief Splits the given cell, with its lowest corner at the given position, into octants.
+    void split(std::size_t cell, const QVector3D& corner, std::size_t depth)
+    {
+      const std::size_t begin = m_cells[cell].begin;
+      const std::size_t end = m_cells[cell].end;
+      QVector3D sum(0, 0, 0);
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        sum += m_points[i].pos;
+      }
+      m_cells[cell].mass = end - begin;
+      m_cells[cell].centerOfMass = sum / (end - begin);
+      m_cells[cell].firstChild = m_cells.size();
+      m_cells[cell].childCount = 0;
+      if (end - begin <= leafSize || depth == maxDepth)
+      {
+        return;
+      }
+
+      // Octant o contains the points m_points[bounds[o]], ..., m_points[bounds[o + 1] - 1]. Its x, y and z
+      // coordinates are in the upper half of the cell if the bits 4, 2 and 1 of o are set, respectively.
+      const float half = m_cells[cell].size / 2;
+      const QVector3D middle = corner + QVector3D(half, half, half);
+      auto partition = [&](std::size_t first, std::size_t last, int coordinate)
+        {
+          return std::partition(m_points.begin() + first, m_points.begin() + last,
+                                [&](const Point& p) { return p.pos[coordinate] < middle[coordinate]; }) - m_points.begin();
+        };
+      std::size_t bounds[9];
+      bounds[0] = begin;
+      bounds[8] = end;
+      bounds[4] = partition(bounds[0], bounds[8], 0);
+      bounds[2] = partition(bounds[0], bounds[4], 1);
+      bounds[6] = partition(bounds[4], bounds[8], 1);
+      for (std::size_t o = 0; o < 8; o += 2)
+      {
+        bounds[o + 1] = partition(bounds[o], bounds[o + 2], 2);
+      }
+
+      std::vector<QVector3D> corners;
+      for (std::size_t o = 0; o < 8; ++o)
+      {
+        if (bounds[o] < bounds[o + 1])
+        {
+          m_cells.push_back(Cell{ QVector3D(), 0.0f, half, bounds[o], bounds[o + 1], 0, 0 });
+          corners.push_back(corner + QVector3D(o & 4 ? half : 0, o & 2 ? half : 0, o & 1 ? half : 0));
+        }
+      }
+      m_cells[cell].childCount = corners.size();
+      const std::size_t firstChild = m_cells[cell].firstChild;
+      for (std::size_t i = 0; i < corners.size(); ++i)
+      {
+        split(firstChild + i, corners[i], depth + 1);
+      }
+    }
+
+  public:
+    /// \brief Builds the octree for the given points.
+    explicit RepulsionOctree(const std::vector<QVector3D>& points)
+    {
+      if (points.empty())
+      {
+        return;
+      }
+      QVector3D min = points[0];
+      QVector3D max = points[0];
+      m_points.reserve(points.size());
+      for (std::size_t i = 0; i < points.size(); ++i)
+      {
+        m_points.push_back(Point{ points[i], i });
+        for (int c = 0; c < 3; ++c)
+        {
+          min[c] = (std::min)(min[c], points[i][c]);
+          max[c] = (std::max)(max[c], points[i][c]);
+        }
+      }
+      const QVector3D extent = max - min;
+      const float size = (std::max)({ extent.x(), extent.y(), extent.z() }) + 1.0f;
+      m_cells.push_back(Cell{ QVector3D(), 0.0f, size, 0, m_points.size(), 0, 0 });
+      split(0, min, 0);
+    }
+
+    /// \brief Returns the approximate repulsion on the given position by all points, except the point with the given
+    ///        index. The position of that point must be given.
+    QVector3D repulsion(const QVector3D& pos, std::size_t index, float repulsion, float natlength) const
+    {
+      QVector3D result(0, 0, 0);
+      if (m_cells.empty())
+      {
+        return result;
+      }
+      // A cell that contains pos is never approximated, since theta is smaller than 1 / sqrt(3). Hence, the point
+      // with the given index is only encountered in a leaf.
+      std::size_t todo[8 * (maxDepth + 1)];
+      std::size_t todoCount = 0;
+      todo[todoCount++] = 0;
+      while (todoCount > 0)
+      {
+        const Cell& cell = m_cells[todo[--todoCount]];
+        if (cell.size < theta * (pos - cell.centerOfMass).length())
+        {
+          result += cell.mass * noiselessRepulsionForce(pos, cell.centerOfMass, repulsion, natlength);
+        }
+        else if (cell.childCount == 0)
+        {
+          for (std::size_t i = cell.begin; i < cell.end; ++i)
+          {
+            if (m_points[i].index != index)
+            {
+              result += noiselessRepulsionForce(pos, m_points[i].pos, repulsion, natlength);
+            }
+          }
+        }
+        else
+        {
+          for (std::size_t i = 0; i < cell.childCount; ++i)
+          {
+            todo[todoCount++] = cell.firstChild + i;
+          }
+        }
+      }
+      return result;
+    }
+};
+
 static QVector3D applyForce(const QVector3D& pos, const QVector3D& force, float speed)
 {
   return pos + speed * force;
@@ -131,20 +329,84 @@ void SpringLayout::apply()
     m_lforces.resize(m_graph.edgeCount());
     m_sforces.resize(m_graph.nodeCount());
 
-    for (std::size_t i = 0; i < nodeCount; ++i)
+    if (m_repulsionCalculation == barneshut)
     {
-      std::size_t n = sel ? m_graph.explorationNode(i) : i;
+      // The repulsion on each node, handle and label is computed independently, and hence in parallel.
+      std::vector<QVector3D> nodes(nodeCount);
+      for (std::size_t i = 0; i < nodeCount; ++i)
+      {
+        nodes[i] = m_graph.node(sel ? m_graph.explorationNode(i) : i).pos();
+      }
+      std::vector<QVector3D> handles(edgeCount);
+      std::vector<QVector3D> labels(edgeCount);
+      for (std::size_t i = 0; i < edgeCount; ++i)
+      {
+        std::size_t n = sel ? m_graph.explorationEdge(i) : i;
+        handles[i] = m_graph.handle(n).pos();
+        labels[i] = m_graph.transitionLabel(n).pos();
+      }
+      const RepulsionOctree nodeTree(nodes);
+      const RepulsionOctree handleTree(handles);
+      const RepulsionOctree labelTree(labels);
 
-      m_nforces[n] = QVector3D(0, 0, 0);
-      for (std::size_t j = 0; j < i; ++j)
+      parallelFor(nodeCount, [&](std::size_t first, std::size_t last)
+        {
+          for (std::size_t i = first; i < last; ++i)
+          {
+            std::size_t n = sel ? m_graph.explorationNode(i) : i;
+            m_nforces[n] = nodeTree.repulsion(nodes[i], i, m_repulsion, m_natLength) + noise();
+            m_sforces[n] = (this->*m_forceCalculation)(m_graph.node(n).pos(), m_graph.stateLabel(n).pos(), 0.0);
+          }
+        });
+      parallelFor(edgeCount, [&](std::size_t first, std::size_t last)
+        {
+          for (std::size_t i = first; i < last; ++i)
+          {
+            std::size_t n = sel ? m_graph.explorationEdge(i) : i;
+            m_hforces[n] = handleTree.repulsion(handles[i], i, m_repulsion * m_controlPointWeight, m_natLength) + noise();
+            m_lforces[n] = labelTree.repulsion(labels[i], i, m_repulsion * m_controlPointWeight, m_natLength) + noise();
+          }
+        });
+    }
+    else
+    {
+      for (std::size_t i = 0; i < nodeCount; ++i)
       {
-        std::size_t m = sel ? m_graph.explorationNode(j) : j;
+        std::size_t n = sel ? m_graph.explorationNode(i) : i;
 
-        QVector3D diff = repulsionForce(m_graph.node(n).pos(), m_graph.node(m).pos(), m_repulsion, m_natLength);
-        m_nforces[n] += diff;
-        m_nforces[m] -= diff;
+        m_nforces[n] = QVector3D(0, 0, 0);
+        for (std::size_t j = 0; j < i; ++j)
+        {
+          std::size_t m = sel ? m_graph.explorationNode(j) : j;
+
+          QVector3D diff = repulsionForce(m_graph.node(n).pos(), m_graph.node(m).pos(), m_repulsion, m_natLength);
+          m_nforces[n] += diff;
+          m_nforces[m] -= diff;
+        }
+        m_sforces[n] = (this->*m_forceCalculation)(m_graph.node(n).pos(), m_graph.stateLabel(n).pos(), 0.0);
+      }
+
+      for (std::size_t i = 0; i < edgeCount; ++i)
+      {
+        std::size_t n = sel ? m_graph.explorationEdge(i) : i;
+        m_hforces[n] = QVector3D(0, 0, 0);
+        m_lforces[n] = QVector3D(0, 0, 0);
+
+        for (std::size_t j = 0; j < i; ++j)
+        {
+          std::size_t m = sel ? m_graph.explorationEdge(j) : j;
+
+          // Handles
+          QVector3D f = repulsionForce(m_graph.handle(n).pos(), m_graph.handle(m).pos(), m_repulsion * m_controlPointWeight, m_natLength);
+          m_hforces[n] += f;
+          m_hforces[m] -= f;
+
+          // Labels
+          f = repulsionForce(m_graph.transitionLabel(n).pos(), m_graph.transitionLabel(m).pos(), m_repulsion * m_controlPointWeight, m_natLength);
+          m_lforces[n] += f;
+          m_lforces[m] -= f;
+        }
       }
-      m_sforces[n] = (this->*m_forceCalculation)(m_graph.node(n).pos(), m_graph.stateLabel(n).pos(), 0.0);
     }
 
     for (std::size_t i = 0; i < edgeCount; ++i)
@@ -153,10 +415,6 @@ void SpringLayout::apply()
 
       Edge e = m_graph.edge(n);
       QVector3D f;
-      // Variables for repulsion calculations
-
-      m_hforces[n] = QVector3D(0, 0, 0);
-      m_lforces[n] = QVector3D(0, 0, 0);
 
       if (e.is_selfloop())
       {
@@ -172,21 +430,6 @@ void SpringLayout::apply()
 
       f = (this->*m_forceCalculation)(m_graph.handle(n).pos(), m_graph.transitionLabel(n).pos(), 0.0);
       m_lforces[n] += f;
-
-      for (std::size_t j = 0; j < i; ++j)
-      {
-        std::size_t m = sel ? m_graph.explorationEdge(j) : j;
-
-        // Handles
-        f = repulsionForce(m_graph.handle(n).pos(), m_graph.handle(m).pos(), m_repulsion * m_controlPointWeight, m_natLength);
-        m_hforces[n] += f;
-        m_hforces[m] -= f;
-
-        // Labels
-        f = repulsionForce(m_graph.transitionLabel(n).pos(), m_graph.transitionLabel(m).pos(), m_repulsion * m_controlPointWeight, m_natLength);
-        m_lforces[n] += f;
-        m_lforces[m] -= f;
-      }
     }
 
     QVector3D clipmin = m_graph.getClipMin();
@@ -299,6 +542,7 @@ SpringLayoutUi::SpringLayoutUi(SpringLayout& layout, QWidget* parent)
   m_ui.sldHandleWeight->setValue(m_layout.controlPointWeight());
   m_ui.sldNatLength->setValue(m_layout.naturalTransitionLength());
   m_ui.cmbForceCalculation->setCurrentIndex(m_layout.forceCalculation());
+  m_ui.cmbRepulsionCalculation->setCurrentIndex(m_layout.repulsionCalculation());
   connect(&m_updateTimer, SIGNAL(timeout()), this, SLOT(onTimeout()));
 }
 
@@ -321,7 +565,8 @@ QByteArray SpringLayoutUi::settings()
       quint32(m_ui.sldSpeed->value()) <<
       quint32(m_ui.sldHandleWeight->value()) <<
       quint32(m_ui.sldNatLength->value()) <<
-      quint32(m_ui.cmbForceCalculation->currentIndex());
+      quint32(m_ui.cmbForceCalculation->currentIndex()) <<
+      quint32(m_ui.cmbRepulsionCalculation->currentIndex());
 
   return result;
 }
@@ -347,6 +592,14 @@ void SpringLayoutUi::setSettings(QByteArray state)
     m_ui.cmbForceCalculation->setCurrentIndex(ForceCalculation);
   }
 
+  // The repulsion calculation is absent in settings that were saved by older versions.
+  quint32 RepulsionCalculation;
+  in >> RepulsionCalculation;
+  if (in.status() == QDataStream::Ok)
+  {
+    m_ui.cmbRepulsionCalculation->setCurrentIndex(RepulsionCalculation);
+  }
+
 }
 
 void SpringLayoutUi::onAttractionChanged(int value)
@@ -389,6 +642,19 @@ void SpringLayoutUi::onForceCalculationChanged(int value)
   }
 }
 
+void SpringLayoutUi::onRepulsionCalculationChanged(int value)
+{
+  switch (value)
+  {
+    case 0:
+      m_layout.setRepulsionCalculation(SpringLayout::exact);
+      break;
+    case 1:
+      m_layout.setRepulsionCalculation(SpringLayout::barneshut);
+      break;
+  }
+}
+
 void SpringLayoutUi::onStarted()
 {
   m_ui.btnStartStop->setText("Stop");
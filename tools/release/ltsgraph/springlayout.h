@@ -41,6 +41,15 @@ class SpringLayout
       ltsgraph,                   ///< LTSGraph implementation.
       linearsprings               ///< Linear spring implementation.
     };
+
+    /**
+     * @brief An enumeration that identifies the ways in which the repulsion between nodes can be calculated.
+     */
+    enum RepulsionCalculation
+    {
+      exact,                      ///< Sum the repulsion of all pairs of nodes, which takes quadratic time.
+      barneshut                   ///< Approximate the repulsion of distant nodes using an octree [Barnes/Hut 1986].
+    };
   private:
     float m_speed;                ///< The rate of change each step.
     float m_attraction;           ///< The attraction of the edges.
@@ -53,6 +62,7 @@ class SpringLayout
     SpringLayoutUi* m_ui;         ///< The user interface generated by Qt.
 
     QVector3D(SpringLayout::*m_forceCalculation)(const QVector3D&, const QVector3D&, float);
+    RepulsionCalculation m_repulsionCalculation; ///< The way in which the repulsion is calculated.
 
     /**
      * @brief Calculate the force of a linear spring between @e a and @e b.
@@ -99,6 +109,17 @@ class SpringLayout
      */
     ForceCalculation forceCalculation();
 
+    /**
+     * @brief Set the way in which the repulsion is calculated.
+     * @param c The desired calculation (exact or Barnes-Hut)
+     */
+    void setRepulsionCalculation(RepulsionCalculation c);
+
+    /**
+     * @brief Returns the current repulsion calculation used.
+     */
+    RepulsionCalculation repulsionCalculation() const;
+
     /**
      * @brief Randomly moves nodes along the Z axis, at most [z] units
      * @param z The maximum distance that nodes are moved
@@ -225,6 +246,12 @@ class SpringLayoutUi : public QDockWidget
      */
     void onForceCalculationChanged(int value);
 
+    /**
+     * @brief Updates the repulsion calculation.
+     * @param value The new index selected.
+     */
+    void onRepulsionCalculationChanged(int value);
+
     /**
      * @brief Starts or stops the force calculation depending on the current state.
      */
@@ -14,6 +14,8 @@
 #include "mcrl2/utilities/input_tool.h"
 #include "mcrl2/lts/lts_io.h"
 #include "mcrl2/lts/lts_algorithm.h"
+#include "mcrl2/lts/lts_mapped.h"
+#include "mcrl2/lts/lts_stream.h"
 
 using namespace mcrl2::utilities::tools;
 using namespace mcrl2::utilities;
@@ -146,13 +148,13 @@ class ltsinfo_tool : public ltsinfo_base
       return t % 2 == 0;
     }
 
-    template<typename LTS>
-    void print_the_action_labels(const LTS& l) const
+    template<typename ACTION_LABEL>
+    void print_the_action_labels(const std::vector<ACTION_LABEL>& action_labels) const
     {
       if (!print_action_labels) { return; }
 
       mCRL2log(info) << "The action labels of this transition system: \n";
-      for (auto& action_label : l.action_labels())
+      for (auto& action_label : action_labels)
       {
          mCRL2log(info) << action_label << "\n";
       }
@@ -170,6 +172,13 @@ class ltsinfo_tool : public ltsinfo_base
       {
         ++branching_factor[transition.from()];
       }
+      print_the_branching_factor(branching_factor);
+    }
+
+    /// \brief Prints the min, max, median and average of the given numbers of outgoing transitions per state.
+    void print_the_branching_factor(std::vector<std::uint64_t>& branching_factor) const
+    {
+      if (branching_factor.empty()) { return; }
 
       // Sort the counts to obtain min, max and median.
       std::sort(branching_factor.begin(), branching_factor.end());
@@ -188,7 +197,7 @@ class ltsinfo_tool : public ltsinfo_base
       double average_branching_factor = 0;
       for (auto& factor : branching_factor)
       {
-        average_branching_factor += static_cast<double>(factor) / lts.num_states();
+        average_branching_factor += static_cast<double>(factor) / branching_factor.size();
       }
 
       // Print the results.
@@ -198,28 +207,28 @@ class ltsinfo_tool : public ltsinfo_base
         << " and average: " << average_branching_factor << "\n";
     }
 
-    // Code to print the state labels. There is a specialisation for an probabilistic_lts_lts_t.
-    void print_the_state_labels(const mcrl2::lts::probabilistic_lts_fsm_t& l) const
+    // Code to print the state labels. There is a specialisation for the state labels of an .lts file.
+    void print_the_state_labels(const std::vector<mcrl2::lts::state_label_fsm>& state_labels) const
     {
       if (print_state_labels)
       {
-        if (!l.has_state_info())
+        if (state_labels.empty())
         {
           mCRL2log(info) << "This transition system has no state labels. Therefore they cannot be printed.\n";
         }
         else 
         {
           mCRL2log(info) << "The state labels of this .fsm format. Note that state labels in .fsm files are only partly preserved by state space reductions.\n";
-          for(std::size_t i=0; i<l.num_states(); ++i)
+          for(std::size_t i=0; i<state_labels.size(); ++i)
           {
-            mCRL2log(info) << i << ": " << pp(l.state_label(i)) << "\n";
+            mCRL2log(info) << i << ": " << pp(state_labels[i]) << "\n";
           }
         }
       }
     }
 
-    // Code to print the state labels. There is a specialisation for an probabilistic_lts_lts_t.
-    void print_the_state_labels(const mcrl2::lts::probabilistic_lts_aut_t& ) const
+    // Code to print the state labels. There is a specialisation for the state labels of an .lts file.
+    void print_the_state_labels(const std::vector<mcrl2::lts::state_label_empty>& ) const
     {
       if (print_state_labels)
       {
@@ -227,27 +236,27 @@ class ltsinfo_tool : public ltsinfo_base
       }
     }
 
-    // Print the state labels for a probabilistic lts.
-    void print_the_state_labels(const mcrl2::lts::probabilistic_lts_lts_t& l) const
+    // Print the state labels of an .lts file.
+    void print_the_state_labels(const std::vector<mcrl2::lts::state_label_lts>& state_labels) const
     {
       if (print_state_labels)
       {
-        if (!l.has_state_info())
+        if (state_labels.empty())
         {
           mCRL2log(info) << "This transition system has no state labels. Therefore they cannot be printed.\n";
         }
         else 
         {
           mCRL2log(info) << "The state labels of this labelled transition system:\n";
-          for(std::size_t i=0; i<l.num_states(); ++i)
+          for(std::size_t i=0; i<state_labels.size(); ++i)
           {
-            if (l.state_label(i).size()==0)
+            if (state_labels[i].size()==0)
             {
               mCRL2log(info) << i << ": no label.\n";
             }
             else 
             { 
-              for(const mcrl2::lps::state& lab: l.state_label(i))
+              for(const mcrl2::lps::state& lab: state_labels[i])
               { 
                 mCRL2log(info) << i << ": (" << pp(lab) << ").\n";
               }
@@ -257,20 +266,20 @@ class ltsinfo_tool : public ltsinfo_base
       }
     }
 
-    template < class LTS_TYPE >
-    bool provide_information() const
+    /// \brief Prints the numbers of states, action labels, transitions and state labels.
+    void print_the_counts(const std::size_t number_of_states,
+                          const std::size_t number_of_action_labels,
+                          const std::size_t number_of_transitions,
+                          const std::size_t number_of_state_labels) const
     {
-      LTS_TYPE l;
-      l.load(infilename);
-
       mCRL2log(info) 
-          << "Number of states: " << l.num_states() << ".\n"
-          << "Number of action labels: " << l.num_action_labels() << " (including a tau label).\n"
-          << "Number of transitions: " << l.num_transitions() << ".\n";
+          << "Number of states: " << number_of_states << ".\n"
+          << "Number of action labels: " << number_of_action_labels << " (including a tau label).\n"
+          << "Number of transitions: " << number_of_transitions << ".\n";
 
-      if (l.has_state_info())
+      if (number_of_state_labels > 0)
       {
-        mCRL2log(info) << "Number of state labels: " << l.num_state_labels() << ".\n";
+        mCRL2log(info) << "Number of state labels: " << number_of_state_labels << ".\n";
       }
       else
       {
@@ -279,30 +288,140 @@ class ltsinfo_tool : public ltsinfo_base
           mCRL2log(info) << "There are no state labels." << std::endl;
         }
       }
+    }
 
-      mCRL2log(verbose) << "Checking reachability..." << std::endl;
-      if (!reachability_check(l))
+    /// \brief Prints the outcome of the checks for reachability and determinism.
+    static void print_the_checks(const bool is_reachable, const bool is_deterministic)
+    {
+      if (!is_reachable)
       {
         mCRL2log(info) << "Warning: some states are not reachable from the initial state! (This might result in unspecified behaviour of LTS tools.)" << std::endl;
       }
+      mCRL2log(info) << "LTS is " << (is_deterministic ? "" : "not ") << "deterministic." << std::endl;
+    }
+
+    /// \brief Provides the information after loading the lts, which is required for probabilistic lts'es.
+    template < class LTS_TYPE >
+    bool provide_information() const
+    {
+      LTS_TYPE l;
+      l.load(infilename);
+
+      print_the_counts(l.num_states(), l.num_action_labels(), l.num_transitions(), l.num_state_labels());
 
+      mCRL2log(verbose) << "Checking reachability..." << std::endl;
+      const bool is_reachable = reachability_check(l);
       mCRL2log(verbose) << "Checking whether lts is deterministic..." << std::endl;
-      mCRL2log(info) << "LTS is ";
-      if (!is_deterministic(l))
-      {
-        mCRL2log(info) << "not ";
-      }
-      mCRL2log(info) << "deterministic." << std::endl;
+      print_the_checks(is_reachable, is_deterministic(l));
 
       provide_probabilistic_information(l);
 
-      print_the_action_labels(l);
-      print_the_state_labels(l);
+      print_the_action_labels(l.action_labels());
+      print_the_state_labels(l.state_labels());
       print_the_branching_factor(l);
 
       return true;
     }
 
+    /// \brief Provides the information while the lts is read, without storing it in memory.
+    /// \details Only the transitions are kept to check reachability and determinism. An lts with
+    ///          probabilistic transitions cannot be read in this way, in which case false is returned.
+    template < class LTS_TYPE >
+    bool provide_stream_information() const
+    {
+      using namespace mcrl2::lts;
+
+      lts_stream_statistics<LTS_TYPE> statistics(print_state_labels, true);
+      try
+      {
+        read_lts_stream(infilename, statistics);
+      }
+      catch (const mcrl2::runtime_error& e)
+      {
+        mCRL2log(verbose) << e.what() << "\nThe lts cannot be read as a stream. It is loaded instead.\n";
+        return false;
+      }
+
+      print_the_counts(statistics.num_states(), statistics.num_action_labels(), statistics.num_transitions(), statistics.num_state_labels());
+      print_the_checks(statistics.is_reachable(), statistics.is_deterministic());
+
+      // Probabilistic transitions are not accepted when the lts is read as a stream.
+      mCRL2log(info) << "This lts has no probabilistic states.\n";
+
+      print_the_action_labels(statistics.action_labels());
+      print_the_state_labels(statistics.state_labels());
+      if (print_branching_factor)
+      {
+        std::vector<std::uint64_t> branching_factor = statistics.branching_factor();
+        print_the_branching_factor(branching_factor);
+      }
+
+      return true;
+    }
+
+    /// \brief Provides the information for a file in the memory mapped lts format.
+    /// \details The counts are in the header, and the transitions are used directly from the
+    ///          mapped file, so the lts is neither loaded nor read as a stream.
+    bool provide_mapped_information() const
+    {
+      using namespace mcrl2::lts;
+
+      mapped_lts_file file(infilename);
+      file.check_transitions();
+
+      std::vector<state_label_lts> state_labels;
+      if (file.has_state_labels())
+      {
+        state_labels = file.read_state_labels();
+      }
+      print_the_counts(file.num_states(), file.num_action_labels(), file.num_transitions(), state_labels.size());
+
+      const std::shared_ptr<const indexed_transitions> outgoing = file.outgoing_transitions();
+
+      mCRL2log(verbose) << "Checking reachability..." << std::endl;
+      std::vector<bool> visited(file.num_states(), false);
+      std::vector<std::size_t> todo{file.initial_state()};
+      visited[file.initial_state()] = true;
+      std::size_t number_of_visited_states = 1;
+      while (!todo.empty())
+      {
+        const std::size_t s = todo.back();
+        todo.pop_back();
+        for (const label_state_pair& t: outgoing->transitions(s))
+        {
+          if (!visited[t.state()])
+          {
+            visited[t.state()] = true;
+            ++number_of_visited_states;
+            todo.push_back(t.state());
+          }
+        }
+      }
+      mCRL2log(verbose) << "Checking whether lts is deterministic..." << std::endl;
+      print_the_checks(number_of_visited_states == file.num_states(), outgoing->is_deterministic());
+
+      // Probabilistic states that are not trivial cannot be stored in this format.
+      mCRL2log(info) << "This lts has no probabilistic states.\n";
+
+      if (print_action_labels)
+      {
+        print_the_action_labels(file.read_action_labels());
+      }
+      print_the_state_labels(state_labels);
+
+      if (print_branching_factor)
+      {
+        std::vector<std::uint64_t> branching_factor(file.num_states());
+        for (std::size_t s = 0; s < file.num_states(); ++s)
+        {
+          branching_factor[s] = outgoing->upperbound(s) - outgoing->lowerbound(s);
+        }
+        print_the_branching_factor(branching_factor);
+      }
+
+      return true;
+    }
+
   public:
 
     bool run()
@@ -319,6 +438,14 @@ class ltsinfo_tool : public ltsinfo_base
       {
         case lts_lts:
         {
+          if (!infilename.empty() && mapped_lts_file::is_mapped_lts_file(infilename))
+          {
+            return provide_mapped_information();
+          }
+          if (!infilename.empty() && provide_stream_information<lts_lts_t>())
+          {
+            return true;
+          }
           return provide_information<probabilistic_lts_lts_t>();
         }
         case lts_none:
@@ -326,10 +453,18 @@ class ltsinfo_tool : public ltsinfo_base
           [[fallthrough]];
         case lts_aut:
         {
+          if (!infilename.empty() && provide_stream_information<lts_aut_t>())
+          {
+            return true;
+          }
           return provide_information<probabilistic_lts_aut_t>();
         }
         case lts_fsm:
         {
+          if (!infilename.empty() && provide_stream_information<lts_fsm_t>())
+          {
+            return true;
+          }
           return provide_information<probabilistic_lts_fsm_t>();
         }
         case lts_dot:
@@ -17,6 +17,7 @@
 #include "mcrl2/lps/linearise.h"
 #include "mcrl2/utilities/input_output_tool.h"
 #include "mcrl2/data/rewriter_tool.h"
+#include "mcrl2/atermpp/detail/threads_option.h"
 
 // #include "gc.h"  Required for ad hoc garbage collection. This is possible with ATcollect,
 // useful to find garbage collection problems.
@@ -127,6 +128,14 @@ class mcrl22lps_tool : public rewriter_tool< input_output_tool >
       desc.add_option("balance-summands",
                       "transform inputs expressions p1 + ... + pn into a balanced tree before "
                       "linearising. Sometimes helpful in preventing stack overflow.");
+      desc.add_option("prune-alphabet",
+                      "while putting processes in parallel, do not generate summands with multi-actions that "
+                      "cannot pass the enclosing allow, block, comm, hide and rename operators. This avoids "
+                      "large intermediate sets of summands when the alphabet axioms cannot move an allow operator "
+                      "inwards. Alphabet pruning is not applied in combination with --timed or --no-deltaelm.");
+      atermpp::detail::add_threads_option(desc,
+                      "combine the summands of parallel processes and apply communication operators using NUM threads. "
+                      "The resulting LPS does not depend on the number of threads.");
     }
 
     void parse_options(const mcrl2::utilities::command_line_parser& parser)
@@ -148,9 +157,12 @@ class mcrl22lps_tool : public rewriter_tool< input_output_tool >
       m_linearisation_options.do_not_apply_constelm   = 0 < parser.options.count("no-constelm") ||
                                                         0 < parser.options.count("no-rewrite");
       m_linearisation_options.balance_summands        = 0 < parser.options.count("balance-summands");
+      m_linearisation_options.alphabet_pruning        = 0 < parser.options.count("prune-alphabet");
 
       m_linearisation_options.lin_method = parser.option_argument_as< mcrl2::lps::t_lin_method >("lin-method");
 
+      m_linearisation_options.number_of_threads = atermpp::detail::parse_threads_option(parser);
+
       //check for dangerous and illegal option combinations
       if (m_linearisation_options.newstate && m_linearisation_options.lin_method == mcrl2::lps::lmStack)
       {